@@ -69,6 +69,7 @@ enum
   D_RESOURCEPACK_IDX,
   D_DYNAMICINPUT_IDX,
   D_GRAPHICSMOD_IDX,
+  D_SHADERPACKS_IDX,
   D_GBAUSER_IDX,
   D_GBASAVES_IDX,
   D_WIISDCARDSYNCFOLDER_IDX,
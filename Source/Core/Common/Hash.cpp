@@ -9,6 +9,8 @@
 
 #include <zlib.h>
 
+#include <xxhash.h>
+
 #include "Common/BitUtils.h"
 #include "Common/CPUDetect.h"
 #include "Common/CommonFuncs.h"
@@ -427,6 +429,11 @@ u64 GetHash64(const u8* src, u32 len, u32 samples)
   return s_texture_hash_func(src, len, samples);
 }
 
+u64 HashXXH3(const u8* data, size_t len, u64 seed)
+{
+  return XXH3_64bits_withSeed(data, len, seed);
+}
+
 u32 StartCRC32()
 {
   return crc32_z(0L, Z_NULL, 0);
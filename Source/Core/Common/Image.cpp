@@ -9,9 +9,15 @@
 
 #include <spng.h>
 
+#ifdef _M_ARM_64
+#include <arm_neon.h>
+#endif
+
 #include "Common/Assert.h"
+#include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
+#include "Common/Intrinsics.h"
 #include "Common/Logging/Log.h"
 #include "Common/Timer.h"
 
@@ -120,19 +126,65 @@ bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u
   return true;
 }
 
-static std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride)
+#ifdef _M_X86_64
+// Converts groups of 16 pixels, and returns the number of pixels converted.
+FUNCTION_TARGET_SSSE3
+static u32 RGBAToRGBRowSSSE3(const u8* input, u8* output, u32 width)
+{
+  // Packs the RGB bytes of four pixels into the low 12 bytes.
+  const __m128i mask = _mm_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+
+  u32 x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    const __m128i* src = reinterpret_cast<const __m128i*>(input + x * 4);
+    const __m128i p0 = _mm_shuffle_epi8(_mm_loadu_si128(src), mask);
+    const __m128i p1 = _mm_shuffle_epi8(_mm_loadu_si128(src + 1), mask);
+    const __m128i p2 = _mm_shuffle_epi8(_mm_loadu_si128(src + 2), mask);
+    const __m128i p3 = _mm_shuffle_epi8(_mm_loadu_si128(src + 3), mask);
+
+    __m128i* dst = reinterpret_cast<__m128i*>(output + x * 3);
+    _mm_storeu_si128(dst, _mm_or_si128(p0, _mm_slli_si128(p1, 12)));
+    _mm_storeu_si128(dst + 1, _mm_or_si128(_mm_srli_si128(p1, 4), _mm_slli_si128(p2, 8)));
+    _mm_storeu_si128(dst + 2, _mm_or_si128(_mm_srli_si128(p2, 8), _mm_slli_si128(p3, 4)));
+  }
+  return x;
+}
+#elif defined(_M_ARM_64)
+static u32 RGBAToRGBRowNEON(const u8* input, u8* output, u32 width)
+{
+  u32 x = 0;
+  for (; x + 16 <= width; x += 16)
+  {
+    const uint8x16x4_t rgba = vld4q_u8(input + x * 4);
+    vst3q_u8(output + x * 3, uint8x16x3_t{{rgba.val[0], rgba.val[1], rgba.val[2]}});
+  }
+  return x;
+}
+#endif
+
+std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride)
 {
-  std::vector<u8> buffer;
-  buffer.reserve(width * height * 3);
+  std::vector<u8> buffer(size_t(width) * height * 3);
 
   for (u32 y = 0; y < height; ++y)
   {
-    const u8* pos = input + y * row_stride;
-    for (u32 x = 0; x < width; ++x)
+    const u8* pos = input + size_t(y) * row_stride;
+    u8* out = buffer.data() + size_t(y) * width * 3;
+
+    u32 x = 0;
+#ifdef _M_X86_64
+    if (cpu_info.bSSSE3)
+      x = RGBAToRGBRowSSSE3(pos, out, width);
+#elif defined(_M_ARM_64)
+    x = RGBAToRGBRowNEON(pos, out, width);
+#endif
+
+    for (; x < width; ++x)
     {
-      buffer.push_back(pos[x * 4]);
-      buffer.push_back(pos[x * 4 + 1]);
-      buffer.push_back(pos[x * 4 + 2]);
+      out[x * 3] = pos[x * 4];
+      out[x * 3 + 1] = pos[x * 4 + 1];
+      out[x * 3 + 2] = pos[x * 4 + 2];
     }
   }
   return buffer;
@@ -21,6 +21,8 @@ enum class ImageByteFormat
 
 bool SavePNG(const std::string& path, const u8* input, ImageByteFormat format, u32 width,
              u32 height, u32 stride, int level = 6);
+// Drops the alpha channel. The rows of the output are tightly packed.
+std::vector<u8> RGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride);
 bool ConvertRGBAToRGBAndSavePNG(const std::string& path, const u8* input, u32 width, u32 height,
                                 u32 stride, int level);
 }  // namespace Common
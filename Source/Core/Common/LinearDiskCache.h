@@ -5,26 +5,51 @@
 
 #include <algorithm>
 #include <cstring>
-#include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
+#include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "Common/MappedFile.h"
 #include "Common/Version.h"
 
 // On disk format:
 // header{
 // u32 'DCAC';
-// u32 version;  // svn_rev
 // u16 sizeof(key_type);
 // u16 sizeof(value_type);
+// char scm_rev[40];
+// u32 format_version;
 //}
 
-// key_value_pair{
+// record{
 // u32 value_size;
 // key_type   key;
 // value_type[value_size]   value;
+// u32 checksum;  // XXH3 of the value, seeded with the XXH3 of the key
+//}
+// ...
+
+// index_entry{  // one per live key, sorted by (key_hash, offset)
+// u64 key_hash;
+// u64 offset;
+//}
+// ...
+
+// footer{
+// u64 index_offset;
+// u32 num_entries;
+// u32 num_records;
+// u64 index_checksum;
+// u32 'DCIX';
+// u32 padding;
 //}
 
 namespace Common
@@ -36,12 +61,19 @@ public:
   virtual void Read(const K& key, const V* value, u32 value_size) = 0;
 };
 
-// Dead simple unsorted key-value store with append functionality.
-// No random read functionality, all reading is done in OpenAndRead.
+// Simple key-value store with append functionality.
 // Keys and values can contain any characters, including \0.
 //
+// The file is memory-mapped, and an index of the records is stored at the end of the file when it
+// is closed, so opening the cache does not read the values. Those can either be fetched lazily by
+// key with Lookup, or all at once with OpenAndRead.
+//
+// Appending overwrites the index, so if Dolphin exits without closing the cache, the records are
+// scanned and verified on the next open instead, and anything after the last intact record is
+// discarded. Appending an existing key replaces its value. The file is rewritten without the
+// replaced records on open once they make up a significant part of it.
+//
 // Suitable for caching generated shader bytecode between executions.
-// Not tuned for extreme performance but should be reasonably fast.
 // Does not support keys or values larger than 2GB, which should be reasonable.
 // Keys must have non-zero length; values can have zero length.
 
@@ -52,90 +84,485 @@ template <typename K, typename V>
 class LinearDiskCache
 {
 public:
-  // return number of read entries
+  // Since we're reading/writing directly to the storage of K instances,
+  // K must be trivially copyable.
+  static_assert(std::is_trivially_copyable_v<K>, "K must be a trivially copyable type");
+  // Values are read in place from the mapped file, where records are not padded.
+  static_assert(std::is_trivially_copyable_v<V> && alignof(V) == 1,
+                "V must be a trivially copyable type without alignment requirements");
+
+  LinearDiskCache() = default;
+  ~LinearDiskCache() { Close(); }
+
+  LinearDiskCache(const LinearDiskCache&) = delete;
+  LinearDiskCache& operator=(const LinearDiskCache&) = delete;
+
+  // Opens the cache, creating it if it is missing or invalid. Returns the number of entries.
+  u32 Open(const std::string& filename) { return Open(filename, true); }
+
+  // Opens the cache and passes every entry to reader, in the order they were appended.
+  // Returns the number of entries read.
+  //
+  // Unlike Lookup, this doesn't verify the checksums of the values, so reading the whole cache
+  // costs no more than it did before the cache was indexed. Records which weren't covered by a
+  // stored index have already been verified when the index was recovered.
   u32 OpenAndRead(const std::string& filename, LinearDiskCacheReader<K, V>& reader)
   {
-    // Since we're reading/writing directly to the storage of K instances,
-    // K must be trivially copyable.
-    static_assert(std::is_trivially_copyable<K>::value, "K must be a trivially copyable type");
+    if (Open(filename) == 0)
+      return 0;
+
+    std::vector<u64> offsets;
+    offsets.reserve(m_index.size());
+    for (const IndexEntry& entry : m_index)
+      offsets.push_back(entry.offset);
+    std::sort(offsets.begin(), offsets.end());
 
+    u32 num_read = 0;
+    for (const u64 offset : offsets)
+    {
+      const u8* record = GetRecord(offset);
+      if (!record)
+        continue;
+
+      K key;
+      std::memcpy(&key, record + sizeof(u32), sizeof(K));
+      reader.Read(key, GetValue(record), GetValueSize(record));
+      num_read++;
+    }
+
+    return num_read;
+  }
+
+  // Returns the value stored for key. The span stays valid until the next Append, or until the
+  // cache is closed.
+  std::optional<std::span<const V>> Lookup(const K& key) const
+  {
+    const u8* record = FindRecord(key);
+    if (!record || !VerifyRecord(record))
+      return std::nullopt;
+
+    return std::span<const V>(GetValue(record), GetValueSize(record));
+  }
+
+  bool Contains(const K& key) const { return FindRecord(key) != nullptr; }
+
+  u32 GetEntryCount() const { return static_cast<u32>(m_index.size()); }
+
+  // Writes out the appended records. The index is only written when the cache is closed.
+  void Sync() { m_file.Flush(); }
+
+  void Close()
+  {
+    if (m_file.IsOpen())
+    {
+      if (m_index_dirty)
+        WriteIndex(m_file, m_data_end, m_index, m_num_records);
+      m_file.Close();
+    }
+
+    m_mapping.Unmap();
+    m_appended_records.clear();
+    m_appended_size = 0;
+    m_index.clear();
+    m_index_dirty = false;
+    m_has_footer = false;
+    m_num_records = 0;
+    m_data_end = 0;
+  }
+
+  // Appends a key-value pair to the store, replacing the value of key if it is already present.
+  void Append(const K& key, const V* value, u32 value_size)
+  {
+    if (m_has_footer)
+    {
+      // Drop the index from the file, so it can't be mistaken for a valid one if Dolphin exits
+      // without closing the cache. Files can't be truncated while they are mapped on Windows.
+      m_mapping.Unmap();
+      const bool resized = m_file.Resize(m_data_end);
+      Remap();
+      if (!resized)
+      {
+        ERROR_LOG_FMT(COMMON, "Failed to remove the index from {}", m_filename);
+        return;
+      }
+      m_file.Seek(m_data_end, File::SeekOrigin::Begin);
+      m_has_footer = false;
+    }
+
+    std::vector<u8> record(GetRecordSize(value_size));
+    std::memcpy(record.data(), &value_size, sizeof(u32));
+    std::memcpy(record.data() + sizeof(u32), &key, sizeof(K));
+    if (value_size != 0)
+      std::memcpy(record.data() + sizeof(u32) + sizeof(K), value, value_size * sizeof(V));
+    const u32 checksum = GetRecordChecksum(record.data());
+    std::memcpy(record.data() + record.size() - sizeof(u32), &checksum, sizeof(u32));
+
+    if (!m_file.WriteBytes(record.data(), record.size()))
+      return;
+
+    const u64 offset = m_data_end;
+    m_data_end += record.size();
+    m_num_records++;
+    m_index_dirty = true;
+
+    // New records always have the highest offset, so they go at the end of their hash's range.
+    const u64 key_hash = HashKey(record.data());
+    auto [begin, end] = std::equal_range(m_index.begin(), m_index.end(), IndexEntry{key_hash, 0},
+                                         CompareKeyHash);
+    const auto existing = std::find_if(begin, end, [&](const IndexEntry& entry) {
+      const u8* existing_record = GetRecord(entry.offset);
+      return existing_record && std::memcmp(existing_record + sizeof(u32), &key, sizeof(K)) == 0;
+    });
+    if (existing != end)
+    {
+      m_appended_records.erase(existing->offset);
+      std::rotate(existing, existing + 1, end);
+      end[-1].offset = offset;
+    }
+    else
+    {
+      m_index.insert(end, IndexEntry{key_hash, offset});
+    }
+
+    // Keep a copy of the record until the mapping is extended to cover it.
+    m_appended_size += record.size();
+    m_appended_records.emplace(offset, std::move(record));
+    if (m_appended_size >= MIN_APPENDED_SIZE_FOR_REMAP)
+      Remap();
+  }
+
+  // Rewrites the cache without the records of replaced values. The cache stays open.
+  bool Compact()
+  {
+    if (!m_file.IsOpen())
+      return false;
+
+    const std::string filename = m_filename;
+    const std::string temp_filename = filename + ".tmp";
+    {
+      File::IOFile temp_file(temp_filename, "wb");
+      temp_file.WriteArray(&m_header, 1);
+
+      std::vector<IndexEntry> old_index = m_index;
+      std::sort(old_index.begin(), old_index.end(),
+                [](const IndexEntry& a, const IndexEntry& b) { return a.offset < b.offset; });
+
+      std::vector<IndexEntry> index;
+      index.reserve(old_index.size());
+      u64 offset = sizeof(Header);
+      for (const IndexEntry& entry : old_index)
+      {
+        const u8* record = GetRecord(entry.offset);
+        if (!record)
+          continue;
+
+        const u64 record_size = GetRecordSize(GetValueSize(record));
+        temp_file.WriteBytes(record, record_size);
+        index.push_back(IndexEntry{entry.key_hash, offset});
+        offset += record_size;
+      }
+
+      std::sort(index.begin(), index.end(), CompareIndexEntry);
+      WriteIndex(temp_file, offset, index, static_cast<u32>(index.size()));
+      if (!temp_file.IsGood())
+      {
+        temp_file.Close();
+        File::Delete(temp_filename);
+        return false;
+      }
+    }
+
+    // The index of the old file is still written, in case it can't be replaced.
+    Close();
+    const bool renamed = File::Rename(temp_filename, filename);
+    if (!renamed)
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to replace {} with its compacted version", filename);
+      File::Delete(temp_filename);
+    }
+    Open(filename, false);
+    return renamed;
+  }
+
+private:
+  // Compact reopens the cache without allowing another compaction, so a file which can't be
+  // replaced isn't compacted over and over.
+  u32 Open(const std::string& filename, bool allow_compaction)
+  {
     // close any currently opened file
     Close();
-    m_num_entries = 0;
+    m_filename = filename;
 
     // try opening for reading/writing
     m_file.Open(filename, "r+b");
 
-    const u64 file_size = m_file.GetSize();
-
     m_header.Init();
-    if (m_file.IsOpen() && ValidateHeader())
+    if (m_file.IsOpen() && ValidateHeader() && (LoadIndex() || RecoverIndex()))
     {
-      // good header, read some key/value pairs
-      K key;
-
-      std::unique_ptr<V[]> value = nullptr;
-      u32 value_size = 0;
-      u32 entry_number = 0;
-      u64 last_valid_value_start = m_file.Tell();
+      m_file.Seek(m_data_end, File::SeekOrigin::Begin);
 
-      while (m_file.ReadArray(&value_size, 1))
+      const u32 num_stale_records = m_num_records - static_cast<u32>(m_index.size());
+      if (allow_compaction && num_stale_records >= MIN_STALE_RECORDS_FOR_COMPACTION &&
+          num_stale_records > m_index.size() / 4)
       {
-        const u64 next_extent = m_file.Tell() + sizeof(value_size) + value_size;
-        if (next_extent > file_size)
-          break;
-
-        // TODO: use make_unique_for_overwrite in C++20
-        value = std::unique_ptr<V[]>(new V[value_size]);
-
-        // read key/value and pass to reader
-        if (m_file.ReadArray(&key, 1) && m_file.ReadArray(value.get(), value_size) &&
-            m_file.ReadArray(&entry_number, 1) && entry_number == m_num_entries + 1)
-        {
-          last_valid_value_start = m_file.Tell();
-          reader.Read(key, value.get(), value_size);
-        }
-        else
-        {
-          break;
-        }
-
-        m_num_entries++;
+        INFO_LOG_FMT(COMMON, "Compacting {}, {} of {} records are stale", filename,
+                     num_stale_records, m_num_records);
+        Compact();
       }
-      m_file.ClearError();
-      m_file.Seek(last_valid_value_start, File::SeekOrigin::Begin);
 
-      return m_num_entries;
+      return static_cast<u32>(m_index.size());
     }
 
     // failed to open file for reading or bad header
     // close and recreate file
     Close();
+    m_filename = filename;
     m_file.Open(filename, "wb");
     WriteHeader();
+    m_data_end = sizeof(Header);
     return 0;
   }
 
-  void Sync() { m_file.Flush(); }
-  void Close()
+  struct IndexEntry
   {
-    if (m_file.IsOpen())
-      m_file.Close();
+    u64 key_hash;
+    u64 offset;
+  };
+
+  struct Footer
+  {
+    u64 index_offset;
+    u32 num_entries;
+    u32 num_records;
+    u64 index_checksum;
+    u32 magic;
+    u32 padding;
+  };
+  static_assert(sizeof(Footer) == 32);
+
+  static constexpr u32 FORMAT_VERSION = 2;
+  static constexpr u32 FOOTER_MAGIC = 0x58494344;  // 'DCIX'
+  static constexpr u32 MIN_STALE_RECORDS_FOR_COMPACTION = 16;
+  static constexpr u64 MIN_APPENDED_SIZE_FOR_REMAP = 1024 * 1024;
+  static constexpr u64 RECORD_OVERHEAD = sizeof(u32) + sizeof(K) + sizeof(u32);
+
+  static bool CompareKeyHash(const IndexEntry& a, const IndexEntry& b)
+  {
+    return a.key_hash < b.key_hash;
   }
 
-  // Appends a key-value pair to the store.
-  void Append(const K& key, const V* value, u32 value_size)
+  static bool CompareIndexEntry(const IndexEntry& a, const IndexEntry& b)
   {
-    // TODO: Should do a check that we don't already have "key"? (I think each caller does that
-    // already.)
-    m_file.WriteArray(&value_size, 1);
-    m_file.WriteArray(&key, 1);
-    m_file.WriteArray(value, value_size);
-    m_num_entries++;
-    m_file.WriteArray(&m_num_entries, 1);
+    return a.key_hash < b.key_hash || (a.key_hash == b.key_hash && a.offset < b.offset);
+  }
+
+  static u64 GetRecordSize(u32 value_size) { return RECORD_OVERHEAD + u64{value_size} * sizeof(V); }
+
+  static u32 GetValueSize(const u8* record)
+  {
+    u32 value_size;
+    std::memcpy(&value_size, record, sizeof(u32));
+    return value_size;
+  }
+
+  static const V* GetValue(const u8* record)
+  {
+    return reinterpret_cast<const V*>(record + sizeof(u32) + sizeof(K));
+  }
+
+  static u64 HashKey(const u8* record) { return HashXXH3(record + sizeof(u32), sizeof(K)); }
+
+  static u32 GetRecordChecksum(const u8* record)
+  {
+    return static_cast<u32>(HashXXH3(record + sizeof(u32) + sizeof(K),
+                                     GetValueSize(record) * sizeof(V), HashKey(record)));
+  }
+
+  static bool VerifyRecord(const u8* record)
+  {
+    u32 checksum;
+    std::memcpy(&checksum, record + GetRecordSize(GetValueSize(record)) - sizeof(u32),
+                sizeof(u32));
+    return checksum == GetRecordChecksum(record);
+  }
+
+  // Maps all records written so far, so the copies of appended records can be dropped. If that
+  // fails, the copies are kept, but the other records can't be read anymore.
+  void Remap()
+  {
+    m_mapping.Unmap();
+    if (m_data_end <= sizeof(Header))
+      return;
+
+    if (!m_mapping.Map(m_file, m_data_end))
+    {
+      ERROR_LOG_FMT(COMMON, "Failed to map {}", m_filename);
+      return;
+    }
+
+    m_appended_records.clear();
+    m_appended_size = 0;
+  }
+
+  // Returns a pointer to the record at offset, or nullptr if it doesn't fit in the file.
+  const u8* GetRecord(u64 offset) const
+  {
+    if (offset >= m_mapping.GetSize())
+    {
+      const auto it = m_appended_records.find(offset);
+      return it != m_appended_records.end() ? it->second.data() : nullptr;
+    }
+
+    const u64 max_size = m_mapping.GetSize() - offset;
+    const u8* record = m_mapping.GetData() + offset;
+    if (max_size < RECORD_OVERHEAD || GetRecordSize(GetValueSize(record)) > max_size)
+      return nullptr;
+    return record;
+  }
+
+  const u8* FindRecord(const K& key) const
+  {
+    const u64 key_hash = HashXXH3(reinterpret_cast<const u8*>(&key), sizeof(K));
+    const auto [begin, end] = std::equal_range(m_index.begin(), m_index.end(),
+                                               IndexEntry{key_hash, 0}, CompareKeyHash);
+    for (auto it = begin; it != end; ++it)
+    {
+      const u8* record = GetRecord(it->offset);
+      if (record && std::memcmp(record + sizeof(u32), &key, sizeof(K)) == 0)
+        return record;
+    }
+    return nullptr;
+  }
+
+  // Reads the index written when the cache was last closed, and maps the records.
+  bool LoadIndex()
+  {
+    const u64 file_size = m_file.GetSize();
+    if (file_size < sizeof(Header) + sizeof(Footer))
+      return false;
+
+    Footer footer;
+    if (!m_file.Seek(file_size - sizeof(Footer), File::SeekOrigin::Begin) ||
+        !m_file.ReadArray(&footer, 1) || footer.magic != FOOTER_MAGIC ||
+        footer.index_offset < sizeof(Header) || footer.num_entries > footer.num_records ||
+        file_size - sizeof(Footer) - footer.index_offset !=
+            u64{footer.num_entries} * sizeof(IndexEntry))
+    {
+      return false;
+    }
+
+    m_index.resize(footer.num_entries);
+    if (!m_file.Seek(footer.index_offset, File::SeekOrigin::Begin) ||
+        !m_file.ReadArray(m_index.data(), m_index.size()) ||
+        HashXXH3(reinterpret_cast<const u8*>(m_index.data()),
+                 m_index.size() * sizeof(IndexEntry)) != footer.index_checksum ||
+        !std::is_sorted(m_index.begin(), m_index.end(), CompareIndexEntry) ||
+        !std::all_of(m_index.begin(), m_index.end(), [&](const IndexEntry& entry) {
+          return entry.offset >= sizeof(Header) && entry.offset < footer.index_offset;
+        }))
+    {
+      m_file.ClearError();
+      m_index.clear();
+      return false;
+    }
+
+    if (footer.index_offset > sizeof(Header) && !m_mapping.Map(m_file, footer.index_offset))
+    {
+      m_index.clear();
+      return false;
+    }
+
+    m_data_end = footer.index_offset;
+    m_num_records = footer.num_records;
+    m_has_footer = true;
+    return true;
+  }
+
+  // Rebuilds the index by scanning the records, stopping at the first one which is incomplete or
+  // corrupted, which is then truncated away.
+  bool RecoverIndex()
+  {
+    const u64 file_size = m_file.GetSize();
+    m_index.clear();
+    m_num_records = 0;
+    m_data_end = sizeof(Header);
+    if (file_size == sizeof(Header))
+      return true;
+
+    if (!m_mapping.Map(m_file, file_size))
+      return false;
+
+    u64 offset = sizeof(Header);
+    while (const u8* record = GetRecord(offset))
+    {
+      if (!VerifyRecord(record))
+        break;
+
+      m_index.push_back(IndexEntry{HashKey(record), offset});
+      offset += GetRecordSize(GetValueSize(record));
+      m_num_records++;
+    }
+    m_data_end = offset;
+
+    // Only keep the last record of each key.
+    std::sort(m_index.begin(), m_index.end(), CompareIndexEntry);
+    std::vector<IndexEntry> index;
+    index.reserve(m_index.size());
+    for (auto it = m_index.begin(); it != m_index.end(); ++it)
+    {
+      const auto hash_end = std::find_if(it + 1, m_index.end(), [&](const IndexEntry& entry) {
+        return entry.key_hash != it->key_hash;
+      });
+      const u8* key = GetRecord(it->offset) + sizeof(u32);
+      if (std::none_of(it + 1, hash_end, [&](const IndexEntry& entry) {
+            return std::memcmp(GetRecord(entry.offset) + sizeof(u32), key, sizeof(K)) == 0;
+          }))
+      {
+        index.push_back(*it);
+      }
+    }
+    m_index = std::move(index);
+
+    // Torn writes have to be removed before appending. Remap, as files can't be truncated while
+    // they are mapped on Windows.
+    m_mapping.Unmap();
+    if (m_data_end != file_size)
+    {
+      WARN_LOG_FMT(COMMON, "Discarding {} bytes of incomplete records from {}",
+                   file_size - m_data_end, m_filename);
+      if (!m_file.Resize(m_data_end))
+      {
+        m_index.clear();
+        return false;
+      }
+    }
+    if (m_data_end > sizeof(Header) && !m_mapping.Map(m_file, m_data_end))
+    {
+      m_index.clear();
+      return false;
+    }
+
+    // Store the index on close, so the next open is fast again.
+    m_index_dirty = m_num_records != 0;
+    return true;
+  }
+
+  static void WriteIndex(File::IOFile& file, u64 index_offset,
+                         const std::vector<IndexEntry>& index, u32 num_records)
+  {
+    Footer footer{};
+    footer.index_offset = index_offset;
+    footer.num_entries = static_cast<u32>(index.size());
+    footer.num_records = num_records;
+    footer.index_checksum =
+        HashXXH3(reinterpret_cast<const u8*>(index.data()), index.size() * sizeof(IndexEntry));
+    footer.magic = FOOTER_MAGIC;
+
+    file.Seek(index_offset, File::SeekOrigin::Begin);
+    file.WriteArray(index.data(), index.size());
+    file.WriteArray(&footer, 1);
   }
 
-private:
   void WriteHeader() { m_file.WriteArray(&m_header, 1); }
   bool ValidateHeader()
   {
@@ -159,10 +586,20 @@ private:
     const u16 key_t_size = sizeof(K);
     const u16 value_t_size = sizeof(V);
     char ver[40] = {};
+    const u32 format_version = FORMAT_VERSION;
 
   } m_header;
 
+  std::string m_filename;
   File::IOFile m_file;
-  u32 m_num_entries = 0;
+  MappedFile m_mapping;
+  // Records appended since the mapping was last extended, which are not covered by it.
+  std::unordered_map<u64, std::vector<u8>> m_appended_records;
+  u64 m_appended_size = 0;
+  std::vector<IndexEntry> m_index;
+  u64 m_data_end = 0;
+  u32 m_num_records = 0;
+  bool m_index_dirty = false;
+  bool m_has_footer = false;
 };
 }  // namespace Common
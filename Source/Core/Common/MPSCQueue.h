@@ -0,0 +1,89 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+// a lockless thread-safe,
+// multiple producer, single consumer queue
+//
+// Producers only ever perform a single atomic exchange to link their element, so pushing never
+// blocks and never waits on other producers. An element becomes visible to the consumer once its
+// producer has finished linking it; elements pushed by the same thread are popped in order.
+
+#include <atomic>
+#include <utility>
+
+namespace Common
+{
+template <typename T>
+class MPSCQueue
+{
+public:
+  MPSCQueue()
+  {
+    ElementPtr* stub = new ElementPtr();
+    m_write_ptr.store(stub);
+    m_read_ptr = stub;
+  }
+  ~MPSCQueue() { FreeElements(); }
+
+  MPSCQueue(const MPSCQueue&) = delete;
+  MPSCQueue& operator=(const MPSCQueue&) = delete;
+
+  // may be called from any thread
+  template <typename Arg>
+  void Push(Arg&& t)
+  {
+    ElementPtr* new_ptr = new ElementPtr();
+    new_ptr->current = std::forward<Arg>(t);
+    // claim the tail of the queue, then publish the element by linking it to the previous tail
+    ElementPtr* prev_ptr = m_write_ptr.exchange(new_ptr, std::memory_order_acq_rel);
+    prev_ptr->next.store(new_ptr, std::memory_order_release);
+  }
+
+  // consumer only
+  bool Empty() const { return !m_read_ptr->next.load(std::memory_order_acquire); }
+
+  // consumer only
+  bool Pop(T& t)
+  {
+    ElementPtr* next_ptr = m_read_ptr->next.load(std::memory_order_acquire);
+    if (!next_ptr)
+      return false;
+
+    // the popped element becomes the new stub
+    t = std::move(next_ptr->current);
+    delete m_read_ptr;
+    m_read_ptr = next_ptr;
+    return true;
+  }
+
+  // not thread-safe
+  void Clear()
+  {
+    FreeElements();
+    m_read_ptr = new ElementPtr();
+    m_write_ptr.store(m_read_ptr);
+  }
+
+private:
+  struct ElementPtr
+  {
+    T current{};
+    std::atomic<ElementPtr*> next{nullptr};
+  };
+
+  void FreeElements()
+  {
+    while (ElementPtr* next_ptr = m_read_ptr->next.load())
+    {
+      delete m_read_ptr;
+      m_read_ptr = next_ptr;
+    }
+    delete m_read_ptr;
+  }
+
+  std::atomic<ElementPtr*> m_write_ptr;
+  ElementPtr* m_read_ptr;
+};
+}  // namespace Common
@@ -0,0 +1,81 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Common/MappedFile.h"
+
+#include <cstdio>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+#include "Common/CommonFuncs.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+
+namespace Common
+{
+MappedFile::~MappedFile()
+{
+  Unmap();
+}
+
+bool MappedFile::Map(File::IOFile& file, u64 size)
+{
+  Unmap();
+
+  if (size == 0 || size != static_cast<size_t>(size) || !file.IsOpen() || !file.Flush())
+    return false;
+
+#ifdef _WIN32
+  const HANDLE file_handle = reinterpret_cast<HANDLE>(_get_osfhandle(_fileno(file.GetHandle())));
+  const HANDLE mapping = CreateFileMappingW(file_handle, nullptr, PAGE_READONLY,
+                                            static_cast<DWORD>(size >> 32),
+                                            static_cast<DWORD>(size), nullptr);
+  if (!mapping)
+  {
+    ERROR_LOG_FMT(COMMON, "CreateFileMapping failed: {}", GetLastError());
+    return false;
+  }
+
+  // The view keeps the mapping object alive.
+  void* const data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, static_cast<size_t>(size));
+  CloseHandle(mapping);
+  if (!data)
+  {
+    ERROR_LOG_FMT(COMMON, "MapViewOfFile failed: {}", GetLastError());
+    return false;
+  }
+#else
+  void* const data =
+      mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fileno(file.GetHandle()), 0);
+  if (data == MAP_FAILED)
+  {
+    ERROR_LOG_FMT(COMMON, "mmap failed: {}", LastStrerrorString());
+    return false;
+  }
+#endif
+
+  m_data = static_cast<const u8*>(data);
+  m_size = size;
+  return true;
+}
+
+void MappedFile::Unmap()
+{
+  if (!m_data)
+    return;
+
+#ifdef _WIN32
+  UnmapViewOfFile(m_data);
+#else
+  munmap(const_cast<u8*>(m_data), static_cast<size_t>(m_size));
+#endif
+
+  m_data = nullptr;
+  m_size = 0;
+}
+}  // namespace Common
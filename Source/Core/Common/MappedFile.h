@@ -0,0 +1,40 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Common/CommonTypes.h"
+
+namespace File
+{
+class IOFile;
+}
+
+namespace Common
+{
+// A read-only memory mapping of the start of an open file.
+// The file may keep being written to through the IOFile while it is mapped, but only bytes which
+// are not overwritten afterwards should be read through the mapping.
+class MappedFile
+{
+public:
+  MappedFile() = default;
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  // Maps the first size bytes of file, which must be open for reading. Buffered writes are
+  // flushed first. Fails for empty mappings.
+  bool Map(File::IOFile& file, u64 size);
+  void Unmap();
+
+  bool IsMapped() const { return m_data != nullptr; }
+  const u8* GetData() const { return m_data; }
+  u64 GetSize() const { return m_size; }
+
+private:
+  const u8* m_data = nullptr;
+  u64 m_size = 0;
+};
+}  // namespace Common
@@ -0,0 +1,123 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Thread.h"
+
+// A fixed set of threads which run a function together with the calling thread.
+//
+// This is meant for splitting short pieces of work which are repeated very often (e.g. every draw
+// call) across cores, where creating threads for each piece would cost more than it saves. The
+// function is responsible for distributing the work between the threads, typically by pulling
+// items from a shared atomic counter.
+
+namespace Common
+{
+class WorkerPool
+{
+public:
+  WorkerPool() = default;
+  WorkerPool(const std::string_view name, u32 worker_count) { Reset(name, worker_count); }
+  ~WorkerPool() { Shutdown(); }
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+  // Shuts the current workers down (if any) and starts worker_count new ones.
+  void Reset(const std::string_view name, u32 worker_count)
+  {
+    Shutdown();
+    std::lock_guard lg(m_lock);
+    m_thread_name = name;
+    m_shutdown = false;
+    for (u32 i = 0; i < worker_count; ++i)
+      m_threads.emplace_back(&WorkerPool::ThreadLoop, this, i + 1, m_generation);
+  }
+
+  void Shutdown()
+  {
+    {
+      std::lock_guard lg(m_lock);
+      m_shutdown = true;
+      m_worker_cond_var.notify_all();
+    }
+
+    for (std::thread& thread : m_threads)
+      thread.join();
+    m_threads.clear();
+  }
+
+  // Number of threads besides the calling thread.
+  u32 GetWorkerCount() const { return static_cast<u32>(m_threads.size()); }
+
+  // Calls function(index) once on every worker (index 1 to GetWorkerCount()) and once on the
+  // calling thread (index 0), and returns when all of these calls have returned.
+  void Run(const std::function<void(u32)>& function)
+  {
+    if (m_threads.empty())
+    {
+      function(0);
+      return;
+    }
+
+    {
+      std::lock_guard lg(m_lock);
+      m_function = &function;
+      m_pending = GetWorkerCount();
+      ++m_generation;
+      m_worker_cond_var.notify_all();
+    }
+
+    function(0);
+
+    std::unique_lock lg(m_lock);
+    m_done_cond_var.wait(lg, [&] { return m_pending == 0; });
+    m_function = nullptr;
+  }
+
+private:
+  void ThreadLoop(u32 index, u64 seen_generation)
+  {
+    Common::SetCurrentThreadName(m_thread_name.c_str());
+
+    while (true)
+    {
+      const std::function<void(u32)>* function;
+      {
+        std::unique_lock lg(m_lock);
+        m_worker_cond_var.wait(lg, [&] { return m_shutdown || m_generation != seen_generation; });
+        if (m_shutdown)
+          return;
+        seen_generation = m_generation;
+        function = m_function;
+      }
+
+      (*function)(index);
+
+      std::lock_guard lg(m_lock);
+      if (--m_pending == 0)
+        m_done_cond_var.notify_one();
+    }
+  }
+
+  std::string m_thread_name;
+  std::vector<std::thread> m_threads;
+  std::mutex m_lock;
+  std::condition_variable m_worker_cond_var;
+  std::condition_variable m_done_cond_var;
+  const std::function<void(u32)>* m_function = nullptr;
+  u64 m_generation = 0;
+  u32 m_pending = 0;
+  bool m_shutdown = false;
+};
+}  // namespace Common
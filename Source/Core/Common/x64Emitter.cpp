@@ -1840,12 +1840,11 @@ static int GetVEXpp(u8 opPrefix)
 }
 
 void XEmitter::WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   int mmmmm = GetVEXmmmmm(op);
   int pp = GetVEXpp(opPrefix);
-  // FIXME: we currently don't support 256-bit instructions, and "size" is not the vector size here
-  arg.WriteVEX(this, regOp1, regOp2, 0, pp, mmmmm, W);
+  arg.WriteVEX(this, regOp1, regOp2, L, pp, mmmmm, W);
   Write8(op & 0xFF);
   arg.WriteRest(this, extrabytes, regOp1);
 }
@@ -1858,11 +1857,11 @@ void XEmitter::WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
 }
 
 void XEmitter::WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
-                          int W, int extrabytes)
+                          int W, int extrabytes, int L)
 {
   if (!cpu_info.bAVX)
     PanicAlertFmt("Trying to use AVX on a system that doesn't support it. Bad programmer.");
-  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes);
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, W, extrabytes, L);
 }
 
 void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
@@ -1873,6 +1872,15 @@ void XEmitter::WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, co
   WriteVEXOp4(opPrefix, op, regOp1, regOp2, arg, regOp3, W);
 }
 
+// All of the AVX2 instructions we emit are 256-bit.
+void XEmitter::WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                           int extrabytes)
+{
+  if (!cpu_info.bAVX2)
+    PanicAlertFmt("Trying to use AVX2 on a system that doesn't support it. Bad programmer.");
+  WriteVEXOp(opPrefix, op, regOp1, regOp2, arg, 0, extrabytes, 1);
+}
+
 void XEmitter::WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W)
 {
   if (!cpu_info.bFMA)
@@ -3029,6 +3037,74 @@ void XEmitter::VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
   WriteAVXOp(0x66, 0xEF, regOp1, regOp2, arg);
 }
 
+void XEmitter::VMOVD_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x66, 0x6E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVQ_xmm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x7E, dest, INVALID_REG, arg);
+}
+void XEmitter::VMOVQ_xmm(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x66, 0xD6, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVSS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0xF3, 0x11, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVUPS(const OpArg& arg, X64Reg src)
+{
+  WriteAVXOp(0x00, 0x11, src, INVALID_REG, arg);
+}
+void XEmitter::VMOVDQU(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0xF3, 0x6F, dest, INVALID_REG, arg);
+}
+void XEmitter::VEXTRACTPS(const OpArg& arg, X64Reg src, u8 subreg)
+{
+  WriteAVXOp(0x66, 0x3A17, src, INVALID_REG, arg, 0, 1);
+  Write8(subreg);
+}
+void XEmitter::VZEROUPPER()
+{
+  if (!cpu_info.bAVX)
+    PanicAlertFmt("Trying to use AVX on a system that doesn't support it. Bad programmer.");
+  Write8(0xC5);
+  Write8(0xF8);
+  Write8(0x77);
+}
+
+void XEmitter::VCVTDQ2PS_ymm(X64Reg dest, const OpArg& arg)
+{
+  WriteAVXOp(0x00, 0x5B, dest, INVALID_REG, arg, 0, 0, 1);
+}
+void XEmitter::VMULPS_ymm(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVXOp(0x00, sseMUL, regOp1, regOp2, arg, 0, 0, 1);
+}
+
+void XEmitter::VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane)
+{
+  WriteAVX2Op(0x66, 0x3A38, regOp1, regOp2, arg, 1);
+  Write8(lane);
+}
+void XEmitter::VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane)
+{
+  WriteAVX2Op(0x66, 0x3A39, src, INVALID_REG, arg, 1);
+  Write8(lane);
+}
+void XEmitter::VPSHUFB_ymm(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
+{
+  WriteAVX2Op(0x66, 0x3800, regOp1, regOp2, arg);
+}
+void XEmitter::VPSRAD_ymm(X64Reg dest, X64Reg src, u8 shift)
+{
+  // The destination goes into VEX.vvvv, the reg field of ModRM selects the shift type.
+  WriteAVX2Op(0x66, 0x72, static_cast<X64Reg>(4), dest, R(src), 1);
+  Write8(shift);
+}
+
 void XEmitter::VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg)
 {
   WriteFMA3Op(0x98, regOp1, regOp2, arg);
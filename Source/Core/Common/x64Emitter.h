@@ -357,13 +357,15 @@ private:
   void WriteSSSE3Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteSSE41Op(u8 opPrefix, u16 op, X64Reg regOp, const OpArg& arg, int extrabytes = 0);
   void WriteVEXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteVEXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
   void WriteAVXOp(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0,
-                  int extrabytes = 0);
+                  int extrabytes = 0, int L = 0);
   void WriteAVXOp4(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
                    X64Reg regOp3, int W = 0);
+  void WriteAVX2Op(u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
+                   int extrabytes = 0);
   void WriteFMA3Op(u8 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
   void WriteFMA4Op(u8 op, X64Reg dest, X64Reg regOp1, X64Reg regOp2, const OpArg& arg, int W = 0);
   void WriteBMIOp(int size, u8 opPrefix, u16 op, X64Reg regOp1, X64Reg regOp2, const OpArg& arg,
@@ -877,6 +879,26 @@ public:
   void VPOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VPXOR(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
 
+  // VEX encoded moves, for code which mixes them with 256-bit instructions
+  void VMOVD_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVQ_xmm(X64Reg dest, const OpArg& arg);
+  void VMOVQ_xmm(const OpArg& arg, X64Reg src);
+  void VMOVSS(const OpArg& arg, X64Reg src);
+  void VMOVUPS(const OpArg& arg, X64Reg src);
+  void VMOVDQU(X64Reg dest, const OpArg& arg);
+  void VEXTRACTPS(const OpArg& arg, X64Reg src, u8 subreg);
+  void VZEROUPPER();
+
+  // 256-bit instructions, these take YMM registers
+  void VCVTDQ2PS_ymm(X64Reg dest, const OpArg& arg);
+  void VMULPS_ymm(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+
+  // AVX2
+  void VINSERTI128(X64Reg regOp1, X64Reg regOp2, const OpArg& arg, u8 lane);
+  void VEXTRACTI128(const OpArg& arg, X64Reg src, u8 lane);
+  void VPSHUFB_ymm(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
+  void VPSRAD_ymm(X64Reg dest, X64Reg src, u8 shift);
+
   // FMA3
   void VFMADD132PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
   void VFMADD213PS(X64Reg regOp1, X64Reg regOp2, const OpArg& arg);
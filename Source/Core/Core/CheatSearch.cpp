@@ -3,11 +3,17 @@
 
 #include "Core/CheatSearch.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <bit>
+#include <cstring>
 #include <functional>
+#include <future>
 #include <memory>
 #include <optional>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <variant>
 #include <vector>
@@ -15,6 +21,7 @@
 #include "Common/Align.h"
 #include "Common/Assert.h"
 #include "Common/StringUtil.h"
+#include "Common/Swap.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/Core.h"
@@ -200,17 +207,49 @@ TryReadValueFromEmulatedMemory(const Core::CPUThreadGuard& guard, u32 addr,
 }
 }  // namespace
 
+namespace
+{
+// Values are compared in batches of this many. The comparisons of a batch are collected into a bit
+// mask first, which keeps the hot loop free of branches so the compiler can vectorize the loads,
+// byte swaps and compares.
+constexpr u32 SCAN_BATCH_SIZE = 64;
+
+// Directly readable memory is split into chunks of at most this many values, which are then spread
+// across threads.
+constexpr u64 SCAN_CHUNK_VALUES = 64 * 1024;
+
+// Searches touching fewer directly readable values than this run on the calling thread only.
+constexpr u64 MIN_PARALLEL_SCAN_VALUES = 256 * 1024;
+
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NewSearch(const Core::CPUThreadGuard& guard,
-                  const std::vector<Cheats::MemoryRange>& memory_ranges,
-                  PowerPC::RequestedAddressSpace address_space, bool aligned,
-                  const std::function<bool(const T& value)>& validator)
+T LoadBigEndian(const u8* src)
+{
+  using U = std::conditional_t<sizeof(T) == 1, u8,
+                               std::conditional_t<sizeof(T) == 2, u16,
+                                                  std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+  U value;
+  std::memcpy(&value, src, sizeof(U));
+  return std::bit_cast<T>(Common::FromBigEndian(value));
+}
+
+// The value state of reads which HostTryRead* would have performed in the given address space.
+Cheats::SearchResultValueState GetValueState(const Core::CPUThreadGuard& guard,
+                                             PowerPC::RequestedAddressSpace address_space)
+{
+  const bool translated =
+      address_space == PowerPC::RequestedAddressSpace::Virtual ||
+      (address_space == PowerPC::RequestedAddressSpace::Effective &&
+       guard.GetSystem().GetPPCState().msr.DR);
+  return translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                      Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+}
+
+Cheats::SearchErrorCode CheckSearchPreconditions(const Core::CPUThreadGuard& guard,
+                                                 PowerPC::RequestedAddressSpace address_space)
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
   auto& system = guard.GetSystem();
-  std::vector<Cheats::SearchResult<T>> results;
   const Core::State core_state = Core::GetState(system);
   if (core_state != Core::State::Running && core_state != Core::State::Paused)
     return Cheats::SearchErrorCode::NoEmulationActive;
@@ -219,12 +258,184 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
   if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
     return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
 
+  return Cheats::SearchErrorCode::Success;
+}
+
+// Calls process(segment) for every segment. Segments with a host pointer only read host memory, so
+// if parallel is set they are shared with worker threads if there are enough of them. All other
+// segments have to go through the MMU and are always processed on the calling thread.
+template <typename Segment, typename Process>
+void ProcessSegments(std::vector<Segment>& segments, u64 direct_values, bool parallel,
+                     const Process& process)
+{
+  std::atomic<size_t> next_segment = 0;
+  const auto process_direct_segments = [&] {
+    for (size_t i = next_segment++; i < segments.size(); i = next_segment++)
+    {
+      if (segments[i].host)
+        process(segments[i]);
+    }
+  };
+
+  std::vector<std::future<void>> workers;
+  if (parallel && direct_values >= MIN_PARALLEL_SCAN_VALUES)
+  {
+    const u64 max_workers = direct_values / SCAN_CHUNK_VALUES;
+    const unsigned int worker_count = static_cast<unsigned int>(std::min<u64>(
+        max_workers, std::max<unsigned int>(1, std::thread::hardware_concurrency()) - 1));
+    for (unsigned int i = 0; i < worker_count; ++i)
+      workers.emplace_back(std::async(std::launch::async, process_direct_segments));
+  }
+
+  for (Segment& segment : segments)
+  {
+    if (!segment.host)
+      process(segment);
+  }
+  process_direct_segments();
+
+  for (std::future<void>& worker : workers)
+    worker.get();
+}
+
+template <typename T, typename Segment>
+std::vector<Cheats::SearchResult<T>> CollectResults(std::vector<Segment>& segments)
+{
+  size_t count = 0;
+  for (const Segment& segment : segments)
+    count += segment.results.size();
+
+  std::vector<Cheats::SearchResult<T>> results;
+  results.reserve(count);
+  for (Segment& segment : segments)
+  {
+    results.insert(results.end(), segment.results.begin(), segment.results.end());
+    segment.results = {};
+  }
+  return results;
+}
+
+template <typename T>
+struct NewSearchSegment
+{
+  // Address of the first value and the number of values, spaced by the search increment.
+  u32 address;
+  u64 count;
+  // Host memory backing the values, or nullptr if they have to be read through the MMU.
+  const u8* host;
+  std::vector<Cheats::SearchResult<T>> results;
+};
+
+// Splits the given values into runs which can be read straight from host memory and runs which
+// have to be read through the MMU. Pages which aren't RAM are skipped, since HostTryRead* would
+// fail for every value starting in them anyway.
+template <typename T>
+void SplitIntoSegments(const Core::CPUThreadGuard& guard,
+                       PowerPC::RequestedAddressSpace address_space, u32 start_address, u64 count,
+                       u32 increment, std::vector<NewSearchSegment<T>>& segments,
+                       u64& direct_values)
+{
+  u64 address = start_address;
+  u64 remaining = count;
+
+  const auto add_segment = [&](u64 values, const u8* host) {
+    while (values != 0)
+    {
+      const u64 chunk = host ? std::min(values, SCAN_CHUNK_VALUES) : values;
+      segments.push_back(NewSearchSegment<T>{static_cast<u32>(address), chunk, host, {}});
+      if (host)
+      {
+        direct_values += chunk;
+        host += chunk * increment;
+      }
+      address += chunk * increment;
+      remaining -= chunk;
+      values -= chunk;
+    }
+  };
+
+  // Number of the remaining values which start before the given address.
+  const auto values_before = [&](u64 end) {
+    return end <= address ? 0 : std::min(remaining, (end - address + increment - 1) / increment);
+  };
+
+  while (remaining != 0)
+  {
+    const u64 page = address & ~PowerPC::HW_PAGE_MASK;
+    const u8* host = PowerPC::MMU::HostGetPagePointer(guard, static_cast<u32>(page), address_space);
+    if (!host)
+    {
+      const u64 values = values_before(page + PowerPC::HW_PAGE_SIZE);
+      if (PowerPC::MMU::HostIsRAMAddress(guard, static_cast<u32>(page), address_space))
+      {
+        add_segment(values, nullptr);
+      }
+      else
+      {
+        address += values * increment;
+        remaining -= values;
+      }
+      continue;
+    }
+
+    // Extend the run over the following pages as long as they're contiguous in host memory.
+    const u64 last_value_end = address + (remaining - 1) * increment + sizeof(T);
+    u64 run_end = page + PowerPC::HW_PAGE_SIZE;
+    while (run_end < last_value_end && run_end <= 0xFFFFFFFF &&
+           PowerPC::MMU::HostGetPagePointer(guard, static_cast<u32>(run_end), address_space) ==
+               host + (run_end - page))
+    {
+      run_end += PowerPC::HW_PAGE_SIZE;
+    }
+
+    add_segment(values_before(run_end - sizeof(T) + 1), host + (address - page));
+
+    // Values crossing the end of the run are read through the MMU.
+    add_segment(values_before(run_end), nullptr);
+  }
+}
+
+template <typename T, u32 stride, typename Validator>
+void ScanHostMemory(const u8* host, u32 address, u64 count, Cheats::SearchResultValueState state,
+                    const Validator& validator, std::vector<Cheats::SearchResult<T>>& results)
+{
+  for (u64 base = 0; base < count; base += SCAN_BATCH_SIZE)
+  {
+    const u8* batch = host + base * stride;
+    const u32 batch_size = static_cast<u32>(std::min<u64>(SCAN_BATCH_SIZE, count - base));
+
+    u64 matches = 0;
+    for (u32 i = 0; i < batch_size; ++i)
+      matches |= u64(validator(LoadBigEndian<T>(batch + i * stride))) << i;
+
+    while (matches != 0)
+    {
+      const u32 i = static_cast<u32>(std::countr_zero(matches));
+      matches &= matches - 1;
+
+      auto& r = results.emplace_back();
+      r.m_value = LoadBigEndian<T>(batch + i * stride);
+      r.m_value_state = state;
+      r.m_address = address + static_cast<u32>((base + i) * stride);
+    }
+  }
+}
+
+template <typename T, typename Validator>
+std::vector<Cheats::SearchResult<T>>
+ScanNewSearch(const Core::CPUThreadGuard& guard,
+              const std::vector<Cheats::MemoryRange>& memory_ranges,
+              PowerPC::RequestedAddressSpace address_space, bool aligned,
+              const Validator& validator, bool parallel)
+{
+  const u32 increment_per_loop = aligned ? sizeof(T) : 1;
+  std::vector<NewSearchSegment<T>> segments;
+  u64 direct_values = 0;
   for (const Cheats::MemoryRange& range : memory_ranges)
   {
     if (range.m_length < sizeof(T))
       continue;
 
-    const u32 increment_per_loop = aligned ? sizeof(T) : 1;
     const u32 start_address = aligned ? Common::AlignUp(range.m_start, sizeof(T)) : range.m_start;
     const u64 aligned_length = range.m_length - (start_address - range.m_start);
 
@@ -232,16 +443,38 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
       continue;
 
     const u64 length = aligned_length - (sizeof(T) - 1);
-    for (u64 i = 0; i < length; i += increment_per_loop)
+    const u64 count = (length + increment_per_loop - 1) / increment_per_loop;
+    SplitIntoSegments<T>(guard, address_space, start_address, count, increment_per_loop, segments,
+                         direct_values);
+  }
+
+  const Cheats::SearchResultValueState direct_state = GetValueState(guard, address_space);
+  ProcessSegments(segments, direct_values, parallel, [&](NewSearchSegment<T>& segment) {
+    if (segment.host)
+    {
+      if (aligned)
+      {
+        ScanHostMemory<T, sizeof(T)>(segment.host, segment.address, segment.count, direct_state,
+                                     validator, segment.results);
+      }
+      else
+      {
+        ScanHostMemory<T, 1>(segment.host, segment.address, segment.count, direct_state,
+                             validator, segment.results);
+      }
+      return;
+    }
+
+    for (u64 i = 0; i < segment.count; ++i)
     {
-      const u32 addr = start_address + i;
+      const u32 addr = segment.address + static_cast<u32>(i * increment_per_loop);
       const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
       if (!current_value)
         continue;
 
       if (validator(current_value->value))
       {
-        auto& r = results.emplace_back();
+        auto& r = segment.results.emplace_back();
         r.m_value = current_value->value;
         r.m_value_state = current_value->translated ?
                               Cheats::SearchResultValueState::ValueFromVirtualMemory :
@@ -249,54 +482,172 @@ Cheats::NewSearch(const Core::CPUThreadGuard& guard,
         r.m_address = addr;
       }
     }
-  }
-  return results;
+  });
+
+  return CollectResults<T>(segments);
 }
 
 template <typename T>
-Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
-Cheats::NextSearch(const Core::CPUThreadGuard& guard,
-                   const std::vector<Cheats::SearchResult<T>>& previous_results,
-                   PowerPC::RequestedAddressSpace address_space,
-                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+struct NextSearchSegment
 {
-  if (AchievementManager::GetInstance().IsHardcoreModeActive())
-    return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  auto& system = guard.GetSystem();
+  // Range of indices into the previous results.
+  size_t begin;
+  size_t end;
+  // Host memory backing the page all of these results are in, or nullptr if they have to be read
+  // through the MMU.
+  const u8* host;
   std::vector<Cheats::SearchResult<T>> results;
-  const Core::State core_state = Core::GetState(system);
-  if (core_state != Core::State::Running && core_state != Core::State::Paused)
-    return Cheats::SearchErrorCode::NoEmulationActive;
-
-  const auto& ppc_state = system.GetPPCState();
-  if (address_space == PowerPC::RequestedAddressSpace::Virtual && !ppc_state.msr.DR)
-    return Cheats::SearchErrorCode::VirtualAddressesCurrentlyNotAccessible;
-
-  for (const auto& previous_result : previous_results)
+};
+
+template <typename T, typename Validator>
+std::vector<Cheats::SearchResult<T>>
+ScanNextSearch(const Core::CPUThreadGuard& guard,
+               const std::vector<Cheats::SearchResult<T>>& previous_results,
+               PowerPC::RequestedAddressSpace address_space, const Validator& validator,
+               bool parallel)
+{
+  // Group the results by page, so the address only has to be translated once per page.
+  std::vector<NextSearchSegment<T>> segments;
+  u64 direct_values = 0;
+  for (size_t begin = 0; begin < previous_results.size();)
   {
-    const u32 addr = previous_result.m_address;
-    const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
-    if (!current_value)
+    const u32 page = previous_results[begin].m_address & ~PowerPC::HW_PAGE_MASK;
+    const u8* host = PowerPC::MMU::HostGetPagePointer(guard, page, address_space);
+
+    size_t end = begin;
+    while (end < previous_results.size() &&
+           (previous_results[end].m_address & ~PowerPC::HW_PAGE_MASK) == page &&
+           (!host ||
+            (previous_results[end].m_address & PowerPC::HW_PAGE_MASK) + sizeof(T) <=
+                PowerPC::HW_PAGE_SIZE))
     {
-      auto& r = results.emplace_back();
-      r.m_address = addr;
-      r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
-      continue;
+      ++end;
     }
 
-    // if the previous state was invalid we always update the value to avoid getting stuck in an
-    // invalid state
-    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
+    // A value crossing into the next page is read through the MMU.
+    if (end == begin)
     {
-      auto& r = results.emplace_back();
-      r.m_value = current_value->value;
-      r.m_value_state = current_value->translated ?
-                            Cheats::SearchResultValueState::ValueFromVirtualMemory :
-                            Cheats::SearchResultValueState::ValueFromPhysicalMemory;
-      r.m_address = addr;
+      host = nullptr;
+      ++end;
     }
+
+    if (host)
+      direct_values += end - begin;
+    segments.push_back(NextSearchSegment<T>{begin, end, host, {}});
+    begin = end;
   }
-  return results;
+
+  const Cheats::SearchResultValueState direct_state = GetValueState(guard, address_space);
+  ProcessSegments(segments, direct_values, parallel, [&](NextSearchSegment<T>& segment) {
+    for (size_t i = segment.begin; i < segment.end; ++i)
+    {
+      const auto& previous_result = previous_results[i];
+      const u32 addr = previous_result.m_address;
+
+      T value;
+      Cheats::SearchResultValueState state = direct_state;
+      if (segment.host)
+      {
+        value = LoadBigEndian<T>(segment.host + (addr & PowerPC::HW_PAGE_MASK));
+      }
+      else
+      {
+        const auto current_value = TryReadValueFromEmulatedMemory<T>(guard, addr, address_space);
+        if (!current_value)
+        {
+          auto& r = segment.results.emplace_back();
+          r.m_address = addr;
+          r.m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+          continue;
+        }
+        value = current_value->value;
+        state = current_value->translated ?
+                    Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                    Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+      }
+
+      // if the previous state was invalid we always update the value to avoid getting stuck in an
+      // invalid state
+      if (!previous_result.IsValueValid() || validator(value, previous_result.m_value))
+      {
+        auto& r = segment.results.emplace_back();
+        r.m_value = value;
+        r.m_value_state = state;
+        r.m_address = addr;
+      }
+    }
+  });
+
+  return CollectResults<T>(segments);
+}
+
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+NewSearchImpl(const Core::CPUThreadGuard& guard,
+              const std::vector<Cheats::MemoryRange>& memory_ranges,
+              PowerPC::RequestedAddressSpace address_space, bool aligned,
+              const Validator& validator, bool parallel)
+{
+  const Cheats::SearchErrorCode error = CheckSearchPreconditions(guard, address_space);
+  if (error != Cheats::SearchErrorCode::Success)
+    return error;
+
+  return ScanNewSearch<T>(guard, memory_ranges, address_space, aligned, validator, parallel);
+}
+
+template <typename T, typename Validator>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+NextSearchImpl(const Core::CPUThreadGuard& guard,
+               const std::vector<Cheats::SearchResult<T>>& previous_results,
+               PowerPC::RequestedAddressSpace address_space, const Validator& validator,
+               bool parallel)
+{
+  const Cheats::SearchErrorCode error = CheckSearchPreconditions(guard, address_space);
+  if (error != Cheats::SearchErrorCode::Success)
+    return error;
+
+  return ScanNextSearch<T>(guard, previous_results, address_space, validator, parallel);
+}
+}  // namespace
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NewSearch(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& memory_ranges,
+                  PowerPC::RequestedAddressSpace address_space, bool aligned,
+                  const std::function<bool(const T& value)>& validator)
+{
+  return NewSearchImpl<T>(guard, memory_ranges, address_space, aligned, validator, false);
+}
+
+template <typename T>
+Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>
+Cheats::NextSearch(const Core::CPUThreadGuard& guard,
+                   const std::vector<Cheats::SearchResult<T>>& previous_results,
+                   PowerPC::RequestedAddressSpace address_space,
+                   const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  return NextSearchImpl<T>(guard, previous_results, address_space, validator, false);
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+Cheats::NewSearchUnchecked(const Core::CPUThreadGuard& guard,
+                           const std::vector<Cheats::MemoryRange>& memory_ranges,
+                           PowerPC::RequestedAddressSpace address_space, bool aligned,
+                           const std::function<bool(const T& value)>& validator, bool parallel)
+{
+  return ScanNewSearch<T>(guard, memory_ranges, address_space, aligned, validator, parallel);
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>> Cheats::NextSearchUnchecked(
+    const Core::CPUThreadGuard& guard,
+    const std::vector<Cheats::SearchResult<T>>& previous_results,
+    PowerPC::RequestedAddressSpace address_space,
+    const std::function<bool(const T& new_value, const T& old_value)>& validator, bool parallel)
+{
+  return ScanNextSearch<T>(guard, previous_results, address_space, validator, parallel);
 }
 
 Cheats::CheatSearchSessionBase::~CheatSearchSessionBase() = default;
@@ -374,51 +725,52 @@ void Cheats::CheatSearchSession<T>::ResetResults()
   m_search_results.clear();
 }
 
-template <typename T>
-static std::function<bool(const T& new_value)>
-MakeCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value)
+// Calls func with a comparison function object for the given operation, so the search loops can
+// be instantiated with a concrete comparison instead of calling through a std::function per value.
+template <typename T, typename Func>
+static auto VisitCompareFunctionForSpecificValue(Cheats::CompareType op, const T& old_value,
+                                                 const Func& func)
 {
   switch (op)
   {
   case Cheats::CompareType::Equal:
-    return [&](const T& new_value) { return new_value == old_value; };
+    return func([&](const T& new_value) { return new_value == old_value; });
   case Cheats::CompareType::NotEqual:
-    return [&](const T& new_value) { return new_value != old_value; };
+    return func([&](const T& new_value) { return new_value != old_value; });
   case Cheats::CompareType::Less:
-    return [&](const T& new_value) { return new_value < old_value; };
+    return func([&](const T& new_value) { return new_value < old_value; });
   case Cheats::CompareType::LessOrEqual:
-    return [&](const T& new_value) { return new_value <= old_value; };
+    return func([&](const T& new_value) { return new_value <= old_value; });
   case Cheats::CompareType::Greater:
-    return [&](const T& new_value) { return new_value > old_value; };
+    return func([&](const T& new_value) { return new_value > old_value; });
   case Cheats::CompareType::GreaterOrEqual:
-    return [&](const T& new_value) { return new_value >= old_value; };
+    return func([&](const T& new_value) { return new_value >= old_value; });
   default:
     DEBUG_ASSERT(false);
-    return nullptr;
+    return func([](const T& new_value) { return false; });
   }
 }
 
-template <typename T>
-static std::function<bool(const T& old_value, const T& new_value)>
-MakeCompareFunctionForLastValue(Cheats::CompareType op)
+template <typename T, typename Func>
+static auto VisitCompareFunctionForLastValue(Cheats::CompareType op, const Func& func)
 {
   switch (op)
   {
   case Cheats::CompareType::Equal:
-    return std::equal_to<T>();
+    return func(std::equal_to<T>());
   case Cheats::CompareType::NotEqual:
-    return std::not_equal_to<T>();
+    return func(std::not_equal_to<T>());
   case Cheats::CompareType::Less:
-    return std::less<T>();
+    return func(std::less<T>());
   case Cheats::CompareType::LessOrEqual:
-    return std::less_equal<T>();
+    return func(std::less_equal<T>());
   case Cheats::CompareType::Greater:
-    return std::greater<T>();
+    return func(std::greater<T>());
   case Cheats::CompareType::GreaterOrEqual:
-    return std::greater_equal<T>();
+    return func(std::greater_equal<T>());
   default:
     DEBUG_ASSERT(false);
-    return nullptr;
+    return func([](const T& new_value, const T& old_value) { return false; });
   }
 }
 
@@ -427,44 +779,49 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
 {
   if (AchievementManager::GetInstance().IsHardcoreModeActive())
     return Cheats::SearchErrorCode::DisabledInHardcoreMode;
-  Common::Result<SearchErrorCode, std::vector<SearchResult<T>>> result =
-      Cheats::SearchErrorCode::InvalidParameters;
+  using SearchResultType = Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>;
+  SearchResultType result = Cheats::SearchErrorCode::InvalidParameters;
   if (m_filter_type == FilterType::CompareAgainstSpecificValue)
   {
     if (!m_value)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    auto func = MakeCompareFunctionForSpecificValue<T>(m_compare_type, *m_value);
-    if (m_first_search_done)
-    {
-      result = Cheats::NextSearch<T>(
-          guard, m_search_results, m_address_space,
-          [&func](const T& new_value, const T& old_value) { return func(new_value); });
-    }
-    else
-    {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned, func);
-    }
+    result = VisitCompareFunctionForSpecificValue<T>(
+        m_compare_type, *m_value, [&](const auto& func) -> SearchResultType {
+          if (m_first_search_done)
+          {
+            return NextSearchImpl<T>(
+                guard, m_search_results, m_address_space,
+                [&func](const T& new_value, const T& old_value) { return func(new_value); },
+                true);
+          }
+          return NewSearchImpl<T>(guard, m_memory_ranges, m_address_space, m_aligned, func,
+                                  true);
+        });
   }
   else if (m_filter_type == FilterType::CompareAgainstLastValue)
   {
     if (!m_first_search_done)
       return Cheats::SearchErrorCode::InvalidParameters;
 
-    result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                   MakeCompareFunctionForLastValue<T>(m_compare_type));
+    result = VisitCompareFunctionForLastValue<T>(
+        m_compare_type, [&](const auto& func) -> SearchResultType {
+          return NextSearchImpl<T>(guard, m_search_results, m_address_space, func, true);
+        });
   }
   else if (m_filter_type == FilterType::DoNotFilter)
   {
     if (m_first_search_done)
     {
-      result = Cheats::NextSearch<T>(guard, m_search_results, m_address_space,
-                                     [](const T& v1, const T& v2) { return true; });
+      result = NextSearchImpl<T>(
+          guard, m_search_results, m_address_space,
+          [](const T& v1, const T& v2) { return true; }, true);
     }
     else
     {
-      result = Cheats::NewSearch<T>(guard, m_memory_ranges, m_address_space, m_aligned,
-                                    [](const T& v) { return true; });
+      result = NewSearchImpl<T>(
+          guard, m_memory_ranges, m_address_space, m_aligned, [](const T& v) { return true; },
+          true);
     }
   }
 
@@ -478,6 +835,54 @@ Cheats::SearchErrorCode Cheats::CheatSearchSession<T>::RunSearch(const Core::CPU
   return result.Error();
 }
 
+template <typename T>
+bool Cheats::CheatSearchSession<T>::RefreshFromSnapshot(
+    const Memory::MemorySnapshot::View& snapshot)
+{
+  if (AchievementManager::GetInstance().IsHardcoreModeActive() || !m_first_search_done)
+    return false;
+
+  std::vector<SearchResult<T>> results = m_search_results;
+  for (SearchResult<T>& result : results)
+  {
+    std::array<u8, sizeof(T)> data;
+    bool translated;
+    if (!snapshot.Read(result.m_address, data.data(), sizeof(T), m_address_space, &translated))
+      return false;
+
+    result.m_value = LoadBigEndian<T>(data.data());
+    result.m_value_state = translated ? SearchResultValueState::ValueFromVirtualMemory :
+                                        SearchResultValueState::ValueFromPhysicalMemory;
+  }
+
+  m_search_results = std::move(results);
+  return true;
+}
+
+template <typename T>
+std::vector<Memory::MemorySnapshot::RangeID>
+Cheats::CheatSearchSession<T>::AddSnapshotRanges(Memory::MemorySnapshot& snapshot,
+                                                 size_t begin_index, size_t end_index) const
+{
+  std::vector<Memory::MemorySnapshot::RangeID> ids;
+  end_index = std::min(end_index, m_search_results.size());
+
+  // Results of one memory range are sorted by address, so neighbouring values can share a range.
+  for (size_t i = begin_index; i < end_index;)
+  {
+    const u32 start = m_search_results[i].m_address;
+    u64 end = u64(start) + sizeof(T);
+    for (++i; i < end_index && m_search_results[i].m_address >= start &&
+              m_search_results[i].m_address <= end;
+         ++i)
+      end = std::max<u64>(end, u64(m_search_results[i].m_address) + sizeof(T));
+
+    ids.push_back(snapshot.AddRange(start, static_cast<u32>(end - start), m_address_space));
+  }
+
+  return ids;
+}
+
 template <typename T>
 size_t Cheats::CheatSearchSession<T>::GetMemoryRangeCount() const
 {
@@ -621,6 +1026,42 @@ Cheats::CheatSearchSession<T>::ClonePartial(const size_t begin_index, const size
   return c;
 }
 
+#define INSTANTIATE_SEARCH_FUNCTIONS(T)                                                           \
+  template Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>          \
+  Cheats::NewSearch(const Core::CPUThreadGuard& guard,                                            \
+                    const std::vector<Cheats::MemoryRange>& memory_ranges,                        \
+                    PowerPC::RequestedAddressSpace address_space, bool aligned,                   \
+                    const std::function<bool(const T& value)>& validator);                        \
+  template Common::Result<Cheats::SearchErrorCode, std::vector<Cheats::SearchResult<T>>>          \
+  Cheats::NextSearch(                                                                             \
+      const Core::CPUThreadGuard& guard,                                                          \
+      const std::vector<Cheats::SearchResult<T>>& previous_results,                               \
+      PowerPC::RequestedAddressSpace address_space,                                               \
+      const std::function<bool(const T& new_value, const T& old_value)>& validator);              \
+  template std::vector<Cheats::SearchResult<T>> Cheats::NewSearchUnchecked(                       \
+      const Core::CPUThreadGuard& guard, const std::vector<Cheats::MemoryRange>& memory_ranges,   \
+      PowerPC::RequestedAddressSpace address_space, bool aligned,                                 \
+      const std::function<bool(const T& value)>& validator, bool parallel);                       \
+  template std::vector<Cheats::SearchResult<T>> Cheats::NextSearchUnchecked(                      \
+      const Core::CPUThreadGuard& guard,                                                          \
+      const std::vector<Cheats::SearchResult<T>>& previous_results,                               \
+      PowerPC::RequestedAddressSpace address_space,                                               \
+      const std::function<bool(const T& new_value, const T& old_value)>& validator,               \
+      bool parallel);
+
+INSTANTIATE_SEARCH_FUNCTIONS(u8)
+INSTANTIATE_SEARCH_FUNCTIONS(u16)
+INSTANTIATE_SEARCH_FUNCTIONS(u32)
+INSTANTIATE_SEARCH_FUNCTIONS(u64)
+INSTANTIATE_SEARCH_FUNCTIONS(s8)
+INSTANTIATE_SEARCH_FUNCTIONS(s16)
+INSTANTIATE_SEARCH_FUNCTIONS(s32)
+INSTANTIATE_SEARCH_FUNCTIONS(s64)
+INSTANTIATE_SEARCH_FUNCTIONS(float)
+INSTANTIATE_SEARCH_FUNCTIONS(double)
+
+#undef INSTANTIATE_SEARCH_FUNCTIONS
+
 template class Cheats::CheatSearchSession<u8>;
 template class Cheats::CheatSearchSession<u16>;
 template class Cheats::CheatSearchSession<u32>;
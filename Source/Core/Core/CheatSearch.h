@@ -12,6 +12,7 @@
 
 #include "Common/CommonTypes.h"
 #include "Common/Result.h"
+#include "Core/HW/MemorySnapshot.h"
 #include "Core/PowerPC/MMU.h"
 
 namespace Core
@@ -113,7 +114,7 @@ DataType GetDataType(const SearchValue& value);
 std::vector<u8> GetValueAsByteVector(const SearchValue& value);
 
 // Do a new search across the given memory region in the given address space, only keeping values
-// for which the given validator returns true.
+// for which the given validator returns true. The validator is only called on the calling thread.
 template <typename T>
 Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
 NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
@@ -121,13 +122,28 @@ NewSearch(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& mem
           const std::function<bool(const T& value)>& validator);
 
 // Refresh the values for the given results in the given address space, only keeping values for
-// which the given validator returns true.
+// which the given validator returns true. The validator is only called on the calling thread.
 template <typename T>
 Common::Result<SearchErrorCode, std::vector<SearchResult<T>>>
 NextSearch(const Core::CPUThreadGuard& guard, const std::vector<SearchResult<T>>& previous_results,
            PowerPC::RequestedAddressSpace address_space,
            const std::function<bool(const T& new_value, const T& old_value)>& validator);
 
+// Same as NewSearch and NextSearch, except that the emulation state isn't checked, so the caller
+// has to make sure that memory is initialized. If parallel is set, memory which can be read
+// directly is scanned on several threads and the validator must be safe to call concurrently.
+template <typename T>
+std::vector<SearchResult<T>>
+NewSearchUnchecked(const Core::CPUThreadGuard& guard, const std::vector<MemoryRange>& memory_ranges,
+                   PowerPC::RequestedAddressSpace address_space, bool aligned,
+                   const std::function<bool(const T& value)>& validator, bool parallel);
+
+template <typename T>
+std::vector<SearchResult<T>> NextSearchUnchecked(
+    const Core::CPUThreadGuard& guard, const std::vector<SearchResult<T>>& previous_results,
+    PowerPC::RequestedAddressSpace address_space,
+    const std::function<bool(const T& new_value, const T& old_value)>& validator, bool parallel);
+
 class CheatSearchSessionBase
 {
 public:
@@ -148,6 +164,17 @@ public:
   // Run either a new search or a next search based on the current state of this session.
   virtual SearchErrorCode RunSearch(const Core::CPUThreadGuard& guard) = 0;
 
+  // Refresh the values of all results from a memory snapshot instead of emulated memory, like
+  // RunSearch with FilterType::DoNotFilter after the first search. Returns false without changing
+  // anything if the snapshot doesn't cover every result or if cheats are disabled.
+  virtual bool RefreshFromSnapshot(const Memory::MemorySnapshot::View& snapshot) = 0;
+
+  // Register the memory of the results with indices in the given range with the snapshot, so that
+  // RefreshFromSnapshot on them can succeed from its next update on.
+  virtual std::vector<Memory::MemorySnapshot::RangeID>
+  AddSnapshotRanges(Memory::MemorySnapshot& snapshot, size_t begin_index,
+                    size_t end_index) const = 0;
+
   virtual size_t GetMemoryRangeCount() const = 0;
   virtual MemoryRange GetMemoryRange(size_t index) const = 0;
   virtual PowerPC::RequestedAddressSpace GetAddressSpace() const = 0;
@@ -193,6 +220,10 @@ public:
 
   void ResetResults() override;
   SearchErrorCode RunSearch(const Core::CPUThreadGuard& guard) override;
+  bool RefreshFromSnapshot(const Memory::MemorySnapshot::View& snapshot) override;
+  std::vector<Memory::MemorySnapshot::RangeID>
+  AddSnapshotRanges(Memory::MemorySnapshot& snapshot, size_t begin_index,
+                    size_t end_index) const override;
 
   size_t GetMemoryRangeCount() const override;
   MemoryRange GetMemoryRange(size_t index) const override;
@@ -468,6 +468,8 @@ const Info<bool> MAIN_GAMELIST_COLUMN_TAGS{{System::Main, "GameList", "ColumnTag
 const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY{{System::Main, "FifoPlayer", "LoopReplay"}, true};
 const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES{
     {System::Main, "FifoPlayer", "EarlyMemoryUpdates"}, false};
+const Info<bool> MAIN_FIFOPLAYER_DEDUPLICATE_MEMORY_UPDATES{
+    {System::Main, "FifoPlayer", "DeduplicateMemoryUpdates"}, true};
 
 // Main.AutoUpdate
 
@@ -304,6 +304,7 @@ extern const Info<bool> MAIN_GAMELIST_COLUMN_TAGS;
 
 extern const Info<bool> MAIN_FIFOPLAYER_LOOP_REPLAY;
 extern const Info<bool> MAIN_FIFOPLAYER_EARLY_MEMORY_UPDATES;
+extern const Info<bool> MAIN_FIFOPLAYER_DEDUPLICATE_MEMORY_UPDATES;
 
 // Main.AutoUpdate
 
@@ -59,6 +59,7 @@
 #include "Core/HW/GCKeyboard.h"
 #include "Core/HW/GCPad.h"
 #include "Core/HW/HW.h"
+#include "Core/HW/Memmap.h"
 #include "Core/HW/SystemTimers.h"
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/Wiimote.h"
@@ -168,6 +169,15 @@ void FrameUpdateOnCPUThread()
 
 void OnFrameEnd(Core::System& system)
 {
+  auto& snapshot = system.GetMemory().GetSnapshot();
+  if (snapshot.HasRanges())
+  {
+    ASSERT(IsCPUThread());
+    const CPUThreadGuard guard(system);
+
+    snapshot.Update(guard);
+  }
+
 #ifdef USE_MEMORYWATCHER
   if (s_memory_watcher)
   {
@@ -4,7 +4,6 @@
 #include "Core/CoreTiming.h"
 
 #include <algorithm>
-#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -14,7 +13,7 @@
 #include "Common/Assert.h"
 #include "Common/ChunkFile.h"
 #include "Common/Logging/Log.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 
 #include "Core/AchievementManager.h"
 #include "Core/CPUThreadConfigCallback.h"
@@ -118,10 +117,10 @@ void CoreTimingManager::Init()
 
 void CoreTimingManager::Shutdown()
 {
-  std::lock_guard lk(m_ts_write_lock);
   MoveEvents();
   ClearPendingEvents();
   UnregisterAllEvents();
+  m_ts_epoch.fetch_add(1, std::memory_order_release);
   CPUThreadConfigCallback::RemoveConfigChangedCallback(m_registered_config_callback_id);
 }
 
@@ -152,7 +151,6 @@ void CoreTimingManager::RefreshConfig()
 
 void CoreTimingManager::DoState(PointerWrap& p)
 {
-  std::lock_guard lk(m_ts_write_lock);
   p.Do(m_globals.slice_length);
   p.Do(m_globals.global_timer);
   p.Do(m_idled_cycles);
@@ -210,6 +208,9 @@ void CoreTimingManager::DoState(PointerWrap& p)
     // The stave state has changed the time, so our previous Throttle targets are invalid.
     // Especially when global_time goes down; So we create a fake throttle update.
     ResetThrottle(m_globals.global_timer);
+
+    // Drop the events other threads scheduled with the old timer since MoveEvents() above.
+    m_ts_epoch.fetch_add(1, std::memory_order_release);
   }
 }
 
@@ -275,8 +276,11 @@ void CoreTimingManager::ScheduleEvent(s64 cycles_into_future, EventType* event_t
                     *event_type->name);
     }
 
-    std::lock_guard lk(m_ts_write_lock);
-    m_ts_queue.Push(Event{m_globals.global_timer + cycles_into_future, 0, userdata, event_type});
+    // The epoch is read before the timer, so an event that has the new epoch of a loaded state
+    // also has its timer.
+    const u64 epoch = m_ts_epoch.load(std::memory_order_acquire);
+    m_ts_queue.Push(
+        Event{m_globals.global_timer + cycles_into_future, epoch, userdata, event_type});
   }
 }
 
@@ -313,8 +317,12 @@ void CoreTimingManager::ForceExceptionCheck(s64 cycles)
 
 void CoreTimingManager::MoveEvents()
 {
+  const u64 epoch = m_ts_epoch.load(std::memory_order_relaxed);
   for (Event ev; m_ts_queue.Pop(ev);)
   {
+    if (ev.fifo_order != epoch)
+      continue;
+
     ev.fifo_order = m_event_fifo_id++;
     m_event_queue.emplace_back(std::move(ev));
     std::push_heap(m_event_queue.begin(), m_event_queue.end(), std::greater<Event>());
@@ -16,13 +16,13 @@
 // inside callback:
 //   ScheduleEvent(periodInCycles - cyclesLate, callback, "whatever")
 
-#include <mutex>
+#include <atomic>
 #include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "Common/CommonTypes.h"
-#include "Common/SPSCQueue.h"
+#include "Common/MPSCQueue.h"
 #include "Core/CPUThreadConfigCallback.h"
 
 class PointerWrap;
@@ -169,8 +169,14 @@ private:
   // by the standard adaptor class.
   std::vector<Event> m_event_queue;
   u64 m_event_fifo_id = 0;
-  std::mutex m_ts_write_lock;
-  Common::SPSCQueue<Event, false> m_ts_queue;
+  // Events scheduled from other threads. The CPU thread drains the queue into m_event_queue in
+  // MoveEvents(), which is where they are assigned their fifo_order. Until then, their fifo_order
+  // holds the m_ts_epoch they were scheduled in.
+  // Loading a state and Shutdown advance the epoch once the old events are gone, and MoveEvents()
+  // drops events from an older epoch, which may have been pushed with the old timer meanwhile.
+  // Producers only read the epoch, so they never wait on the CPU thread or on each other.
+  std::atomic<u64> m_ts_epoch = 0;
+  Common::MPSCQueue<Event> m_ts_queue;
 
   float m_last_oc_factor = 0.0f;
 
@@ -6,21 +6,31 @@
 #include <algorithm>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
+#include <zstd.h>
+
+#include "Common/Hash.h"
 #include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
 #include "Common/MsgHandler.h"
 #include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
 constexpr u32 FILE_ID = 0x0d01f1f0;
-constexpr u32 VERSION_NUMBER = 5;
-constexpr u32 MIN_LOADER_VERSION = 1;
-// This value is only used if the DFF file was created with overridden RAM sizes.
-// If the MIN_LOADER_VERSION ever exceeds this, it's alright to remove it.
-constexpr u32 MIN_LOADER_VERSION_FOR_RAM_OVERRIDE = 5;
+constexpr u32 VERSION_NUMBER = 6;
+// Version 6 replaced the uncompressed frames with compressed chunks.
+constexpr u32 MIN_LOADER_VERSION = 6;
+
+constexpr int COMPRESSION_LEVEL = 5;
+// Memory updates at least this big are deduplicated.
+constexpr size_t DEDUPLICATION_MIN_SIZE = 1024;
+// Number of frames after the requested one which are decompressed in the background.
+constexpr u32 READ_AHEAD_FRAMES = 2;
 
 #pragma pack(push, 1)
 
@@ -46,10 +56,14 @@ struct FileHeader
   // will crash and burn with mismatched settings.  See PR #8722.
   u32 mem1_size;
   u32 mem2_size;
-  u8 reserved[32];
+  // Added in version 6.
+  u64 blobListOffset;
+  u32 blobCount;
+  u8 reserved[20];
 };
 static_assert(sizeof(FileHeader) == 128, "FileHeader should be 128 bytes");
 
+// Used before version 6.
 struct FileFrameInfo
 {
   u64 fifoDataOffset;
@@ -62,6 +76,7 @@ struct FileFrameInfo
 };
 static_assert(sizeof(FileFrameInfo) == 64, "FileFrameInfo should be 64 bytes");
 
+// Used before version 6.
 struct FileMemoryUpdate
 {
   u32 fifoPosition;
@@ -73,11 +88,79 @@ struct FileMemoryUpdate
 };
 static_assert(sizeof(FileMemoryUpdate) == 24, "FileMemoryUpdate should be 24 bytes");
 
+// Each frame is a zstd compressed chunk, containing the FIFO data, followed by the memory update
+// list, followed by the data of the memory updates which aren't stored as blobs.
+struct FileFrameChunk
+{
+  u64 chunkOffset;
+  u32 chunkSize;
+  u32 uncompressedSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u32 fifoDataSize;
+  u32 numMemoryUpdates;
+  // Total size of the memory update data, including data stored as blobs.
+  u64 memoryUpdateSize;
+  u8 reserved[24];
+};
+static_assert(sizeof(FileFrameChunk) == 64, "FileFrameChunk should be 64 bytes");
+
+struct ChunkMemoryUpdate
+{
+  static constexpr u32 INLINE_DATA = 0xffffffff;
+
+  u32 fifoPosition;
+  u32 address;
+  u32 dataSize;
+  // Index into the blob list, or INLINE_DATA if the data follows the list in the chunk.
+  u32 blob;
+  u8 type;
+  u8 reserved[3];
+};
+static_assert(sizeof(ChunkMemoryUpdate) == 20, "ChunkMemoryUpdate should be 20 bytes");
+
+// Data which several memory updates share, compressed on its own.
+struct FileBlob
+{
+  u64 offset;
+  u32 compressedSize;
+  u32 size;
+};
+static_assert(sizeof(FileBlob) == 16, "FileBlob should be 16 bytes");
+
 #pragma pack(pop)
 
+static std::optional<std::vector<u8>> Compress(const u8* data, size_t size)
+{
+  std::vector<u8> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size =
+      ZSTD_compress(compressed.data(), compressed.size(), data, size, COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
+  {
+    ERROR_LOG_FMT(CORE, "Failed to compress FIFO log data: {}",
+                  ZSTD_getErrorName(compressed_size));
+    return std::nullopt;
+  }
+
+  compressed.resize(compressed_size);
+  compressed.shrink_to_fit();
+  return compressed;
+}
+
+static bool Decompress(const std::vector<u8>& compressed, std::vector<u8>& data, size_t size)
+{
+  data.resize(size);
+  const size_t result = ZSTD_decompress(data.data(), size, compressed.data(), compressed.size());
+  return !ZSTD_isError(result) && result == size;
+}
+
 FifoDataFile::FifoDataFile() = default;
 
-FifoDataFile::~FifoDataFile() = default;
+FifoDataFile::~FifoDataFile()
+{
+  m_compress_thread.Shutdown();
+  m_read_ahead_thread.Shutdown(true);
+}
 
 bool FifoDataFile::ShouldGenerateFakeVIUpdates() const
 {
@@ -99,13 +182,88 @@ bool FifoDataFile::GetIsWii() const
   return GetFlag(FLAG_IS_WII);
 }
 
-void FifoDataFile::AddFrame(const FifoFrameInfo& frameInfo)
+void FifoDataFile::AddFrame(FifoFrameInfo frameInfo)
 {
-  m_Frames.push_back(frameInfo);
+  FrameEntry entry;
+  entry.fifo_start = frameInfo.fifoStart;
+  entry.fifo_end = frameInfo.fifoEnd;
+  entry.fifo_data_size = static_cast<u32>(frameInfo.fifoData.size());
+  entry.num_memory_updates = static_cast<u32>(frameInfo.memoryUpdates.size());
+  for (const MemoryUpdate& update : frameInfo.memoryUpdates)
+    entry.memory_update_size += update.data.size();
+  entry.uncompressed = std::make_shared<const FifoFrameInfo>(std::move(frameInfo));
+
+  u32 frame;
+  {
+    std::lock_guard lk(m_lock);
+    frame = static_cast<u32>(m_frames.size());
+    m_frames.push_back(std::move(entry));
+  }
+
+  if (!m_compress_thread_started)
+  {
+    m_compress_thread.Reset("FIFO Log Compression",
+                            [this](u32 queued_frame) { CompressQueuedFrame(queued_frame); });
+    m_compress_thread_started = true;
+  }
+  m_compress_thread.Push(frame);
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::GetFrame(u32 frame) const
+{
+  std::shared_ptr<const FifoFrameInfo> frame_info;
+  u32 frame_count;
+  {
+    std::lock_guard lk(m_lock);
+    m_requested_frame = frame;
+    frame_count = static_cast<u32>(m_frames.size());
+    if (const auto it = m_frame_cache.find(frame); it != m_frame_cache.end())
+      frame_info = it->second;
+    else
+      frame_info = m_frames[frame].uncompressed;
+  }
+
+  if (!frame_info)
+  {
+    frame_info = LoadFrame(frame);
+    if (frame_info)
+      CacheFrame(frame, frame_info);
+  }
+
+  if (m_file)
+  {
+    for (u32 i = frame + 1; i <= frame + READ_AHEAD_FRAMES && i < frame_count; ++i)
+      m_read_ahead_thread.Push(i);
+  }
+
+  return frame_info;
+}
+
+u32 FifoDataFile::GetFrameCount() const
+{
+  std::lock_guard lk(m_lock);
+  return static_cast<u32>(m_frames.size());
+}
+
+u32 FifoDataFile::GetFrameFifoSize(u32 frame) const
+{
+  std::lock_guard lk(m_lock);
+  return m_frames[frame].fifo_data_size;
+}
+
+u64 FifoDataFile::GetFrameMemoryUpdateSize(u32 frame) const
+{
+  std::lock_guard lk(m_lock);
+  return m_frames[frame].memory_update_size;
 }
 
 bool FifoDataFile::Save(const std::string& filename)
 {
+  // Every frame needs to be compressed, so they can be written out as they are.
+  m_compress_thread.WaitForCompletion();
+  if (!LoadAllFrames())
+    return false;
+
   File::IOFile file;
   if (!file.Open(filename, "wb"))
     return false;
@@ -113,10 +271,6 @@ bool FifoDataFile::Save(const std::string& filename)
   // Add space for header
   PadFile(sizeof(FileHeader), file);
 
-  // Add space for frame list
-  u64 frameListOffset = file.Tell();
-  PadFile(m_Frames.size() * sizeof(FileFrameInfo), file);
-
   u64 bpMemOffset = file.Tell();
   file.WriteArray(m_BPMem);
 
@@ -132,15 +286,46 @@ bool FifoDataFile::Save(const std::string& filename)
   u64 texMemOffset = file.Tell();
   file.WriteArray(m_TexMem);
 
+  std::lock_guard lk(m_lock);
+
+  std::vector<FileBlob> blobs(m_blobs.size());
+  for (size_t i = 0; i < m_blobs.size(); ++i)
+  {
+    blobs[i].offset = file.Tell();
+    blobs[i].compressedSize = static_cast<u32>(m_blobs[i].compressed->size());
+    blobs[i].size = m_blobs[i].size;
+    file.WriteBytes(m_blobs[i].compressed->data(), m_blobs[i].compressed->size());
+  }
+
+  std::vector<FileFrameChunk> frames(m_frames.size());
+  for (size_t i = 0; i < m_frames.size(); ++i)
+  {
+    const FrameEntry& srcFrame = m_frames[i];
+    FileFrameChunk& dstFrame = frames[i];
+    dstFrame = {};
+    dstFrame.chunkOffset = file.Tell();
+    dstFrame.chunkSize = static_cast<u32>(srcFrame.chunk->size());
+    dstFrame.uncompressedSize = srcFrame.uncompressed_size;
+    dstFrame.fifoStart = srcFrame.fifo_start;
+    dstFrame.fifoEnd = srcFrame.fifo_end;
+    dstFrame.fifoDataSize = srcFrame.fifo_data_size;
+    dstFrame.numMemoryUpdates = srcFrame.num_memory_updates;
+    dstFrame.memoryUpdateSize = srcFrame.memory_update_size;
+    file.WriteBytes(srcFrame.chunk->data(), srcFrame.chunk->size());
+  }
+
+  // The frame and blob lists are written last, so the chunks can be written out in one go.
+  u64 frameListOffset = file.Tell();
+  file.WriteArray(frames.data(), frames.size());
+
+  u64 blobListOffset = file.Tell();
+  file.WriteArray(blobs.data(), blobs.size());
+
   // Write header
-  FileHeader header;
+  FileHeader header{};
   header.fileId = FILE_ID;
   header.file_version = VERSION_NUMBER;
-  // Maintain backwards compatability so long as the RAM sizes aren't overridden.
-  if (Config::Get(Config::MAIN_RAM_OVERRIDE_ENABLE))
-    header.min_loader_version = MIN_LOADER_VERSION_FOR_RAM_OVERRIDE;
-  else
-    header.min_loader_version = MIN_LOADER_VERSION;
+  header.min_loader_version = MIN_LOADER_VERSION;
 
   header.bpMemOffset = bpMemOffset;
   header.bpMemSize = BP_MEM_SIZE;
@@ -158,7 +343,10 @@ bool FifoDataFile::Save(const std::string& filename)
   header.texMemSize = TEX_MEM_SIZE;
 
   header.frameListOffset = frameListOffset;
-  header.frameCount = (u32)m_Frames.size();
+  header.frameCount = static_cast<u32>(frames.size());
+
+  header.blobListOffset = blobListOffset;
+  header.blobCount = static_cast<u32>(blobs.size());
 
   header.flags = m_Flags;
 
@@ -170,33 +358,8 @@ bool FifoDataFile::Save(const std::string& filename)
   file.Seek(0, File::SeekOrigin::Begin);
   file.WriteBytes(&header, sizeof(FileHeader));
 
-  // Write frames list
-  for (unsigned int i = 0; i < m_Frames.size(); ++i)
-  {
-    const FifoFrameInfo& srcFrame = m_Frames[i];
-
-    // Write FIFO data
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcFrame.fifoData.data(), srcFrame.fifoData.size());
-
-    u64 memoryUpdatesOffset = WriteMemoryUpdates(srcFrame.memoryUpdates, file);
-
-    FileFrameInfo dstFrame;
-    dstFrame.fifoDataSize = static_cast<u32>(srcFrame.fifoData.size());
-    dstFrame.fifoDataOffset = dataOffset;
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
-    dstFrame.memoryUpdatesOffset = memoryUpdatesOffset;
-    dstFrame.numMemoryUpdates = static_cast<u32>(srcFrame.memoryUpdates.size());
-
-    // Write frame info
-    u64 frameOffset = frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstFrame, sizeof(FileFrameInfo));
-  }
-
-  if (!file.Close())
+  const bool good = file.IsGood();
+  if (!file.Close() || !good)
     return false;
 
   return true;
@@ -316,32 +479,77 @@ std::unique_ptr<FifoDataFile> FifoDataFile::Load(const std::string& filename, bo
   dataFile->m_ram_size_real = header.mem1_size;
   dataFile->m_exram_size_real = header.mem2_size;
 
-  // Read frames
-  for (u32 i = 0; i < header.frameCount; ++i)
+  if (header.file_version >= 6)
   {
-    u64 frameOffset = header.frameListOffset + (i * sizeof(FileFrameInfo));
-    file.Seek(frameOffset, File::SeekOrigin::Begin);
-    FileFrameInfo srcFrame;
-    if (!file.ReadBytes(&srcFrame, sizeof(FileFrameInfo)))
-      return panic_failed_to_read();
-
-    FifoFrameInfo dstFrame;
-    dstFrame.fifoData.resize(srcFrame.fifoDataSize);
-    dstFrame.fifoStart = srcFrame.fifoStart;
-    dstFrame.fifoEnd = srcFrame.fifoEnd;
+    std::vector<FileFrameChunk> frames(header.frameCount);
+    file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+    file.ReadArray(frames.data(), frames.size());
 
-    file.Seek(srcFrame.fifoDataOffset, File::SeekOrigin::Begin);
-    file.ReadBytes(dstFrame.fifoData.data(), srcFrame.fifoDataSize);
-
-    ReadMemoryUpdates(srcFrame.memoryUpdatesOffset, srcFrame.numMemoryUpdates,
-                      dstFrame.memoryUpdates, file);
+    std::vector<FileBlob> blobs(header.blobCount);
+    file.Seek(header.blobListOffset, File::SeekOrigin::Begin);
+    file.ReadArray(blobs.data(), blobs.size());
 
     if (!file.IsGood())
       return panic_failed_to_read();
 
-    dataFile->AddFrame(dstFrame);
+    dataFile->m_frames.resize(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+      const FileFrameChunk& srcFrame = frames[i];
+      FrameEntry& dstFrame = dataFile->m_frames[i];
+      dstFrame.fifo_start = srcFrame.fifoStart;
+      dstFrame.fifo_end = srcFrame.fifoEnd;
+      dstFrame.fifo_data_size = srcFrame.fifoDataSize;
+      dstFrame.num_memory_updates = srcFrame.numMemoryUpdates;
+      dstFrame.memory_update_size = srcFrame.memoryUpdateSize;
+      dstFrame.file_offset = srcFrame.chunkOffset;
+      dstFrame.chunk_size = srcFrame.chunkSize;
+      dstFrame.uncompressed_size = srcFrame.uncompressedSize;
+    }
+
+    dataFile->m_blobs.resize(blobs.size());
+    for (size_t i = 0; i < blobs.size(); ++i)
+    {
+      dataFile->m_blobs[i].file_offset = blobs[i].offset;
+      dataFile->m_blobs[i].compressed_size = blobs[i].compressedSize;
+      dataFile->m_blobs[i].size = blobs[i].size;
+    }
+  }
+  else
+  {
+    // Only the frame list is read here. The frames are read when they are requested.
+    std::vector<FileFrameInfo> frames(header.frameCount);
+    file.Seek(header.frameListOffset, File::SeekOrigin::Begin);
+    if (!file.ReadArray(frames.data(), frames.size()))
+      return panic_failed_to_read();
+
+    dataFile->m_frames.resize(frames.size());
+    std::vector<FileMemoryUpdate> updates;
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+      const FileFrameInfo& srcFrame = frames[i];
+      FrameEntry& dstFrame = dataFile->m_frames[i];
+      dstFrame.fifo_start = srcFrame.fifoStart;
+      dstFrame.fifo_end = srcFrame.fifoEnd;
+      dstFrame.fifo_data_size = srcFrame.fifoDataSize;
+      dstFrame.num_memory_updates = srcFrame.numMemoryUpdates;
+      dstFrame.file_offset = srcFrame.fifoDataOffset;
+      dstFrame.memory_updates_offset = srcFrame.memoryUpdatesOffset;
+
+      updates.resize(srcFrame.numMemoryUpdates);
+      file.Seek(srcFrame.memoryUpdatesOffset, File::SeekOrigin::Begin);
+      if (!file.ReadArray(updates.data(), updates.size()))
+        return panic_failed_to_read();
+      for (const FileMemoryUpdate& update : updates)
+        dstFrame.memory_update_size += update.dataSize;
+    }
   }
 
+  dataFile->m_file = std::make_unique<File::IOFile>(std::move(file));
+  FifoDataFile* const data_file = dataFile.get();
+  dataFile->m_read_ahead_thread.Reset("FIFO Log Read-Ahead",
+                                      [data_file](u32 frame) { data_file->ReadAhead(frame); });
+
   return dataFile;
 }
 
@@ -364,35 +572,300 @@ bool FifoDataFile::GetFlag(u32 flag) const
   return !!(m_Flags & flag);
 }
 
-u64 FifoDataFile::WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates,
-                                     File::IOFile& file)
+void FifoDataFile::CompressQueuedFrame(u32 frame)
 {
-  // Add space for memory update list
-  u64 updateListOffset = file.Tell();
-  PadFile(memUpdates.size() * sizeof(FileMemoryUpdate), file);
-
-  for (unsigned int i = 0; i < memUpdates.size(); ++i)
+  std::shared_ptr<const FifoFrameInfo> frame_info;
   {
-    const MemoryUpdate& srcUpdate = memUpdates[i];
+    std::lock_guard lk(m_lock);
+    frame_info = m_frames[frame].uncompressed;
+  }
+
+  u32 uncompressed_size;
+  std::optional<std::vector<u8>> chunk = CompressFrame(*frame_info, &uncompressed_size);
+  // The frame stays uncompressed, and is compressed again when the file is saved.
+  if (!chunk)
+    return;
+
+  std::lock_guard lk(m_lock);
+  FrameEntry& entry = m_frames[frame];
+  entry.chunk = std::make_shared<const std::vector<u8>>(std::move(*chunk));
+  entry.uncompressed_size = uncompressed_size;
+  entry.uncompressed.reset();
+}
 
-    // Write memory
-    file.Seek(0, File::SeekOrigin::End);
-    u64 dataOffset = file.Tell();
-    file.WriteBytes(srcUpdate.data.data(), srcUpdate.data.size());
+std::optional<std::vector<u8>> FifoDataFile::CompressFrame(const FifoFrameInfo& frameInfo,
+                                                           u32* uncompressedSize)
+{
+  std::vector<u8> data(frameInfo.fifoData);
+
+  const size_t update_list_offset = data.size();
+  data.resize(update_list_offset + frameInfo.memoryUpdates.size() * sizeof(ChunkMemoryUpdate));
+  for (size_t i = 0; i < frameInfo.memoryUpdates.size(); ++i)
+  {
+    const MemoryUpdate& srcUpdate = frameInfo.memoryUpdates[i];
 
-    FileMemoryUpdate dstUpdate;
+    ChunkMemoryUpdate dstUpdate{};
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.address = srcUpdate.address;
-    dstUpdate.dataOffset = dataOffset;
     dstUpdate.dataSize = static_cast<u32>(srcUpdate.data.size());
-    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
     dstUpdate.type = static_cast<u8>(srcUpdate.type);
 
-    u64 updateOffset = updateListOffset + (i * sizeof(FileMemoryUpdate));
-    file.Seek(updateOffset, File::SeekOrigin::Begin);
-    file.WriteBytes(&dstUpdate, sizeof(FileMemoryUpdate));
+    if (m_deduplicate_memory_updates && srcUpdate.data.size() >= DEDUPLICATION_MIN_SIZE)
+    {
+      const std::optional<u32> blob = AddBlob(srcUpdate.data);
+      if (!blob)
+        return std::nullopt;
+      dstUpdate.blob = *blob;
+    }
+    else
+    {
+      dstUpdate.blob = ChunkMemoryUpdate::INLINE_DATA;
+      data.insert(data.end(), srcUpdate.data.begin(), srcUpdate.data.end());
+    }
+
+    std::memcpy(&data[update_list_offset + i * sizeof(ChunkMemoryUpdate)], &dstUpdate,
+                sizeof(ChunkMemoryUpdate));
+  }
+
+  *uncompressedSize = static_cast<u32>(data.size());
+  return Compress(data.data(), data.size());
+}
+
+std::optional<u32> FifoDataFile::AddBlob(const std::vector<u8>& data)
+{
+  // Two differently seeded hashes, so that a collision is practically impossible.
+  const auto key = std::make_tuple(Common::HashXXH3(data.data(), data.size(), 0),
+                                   Common::HashXXH3(data.data(), data.size(), 1),
+                                   static_cast<u32>(data.size()));
+  if (const auto it = m_blob_index.find(key); it != m_blob_index.end())
+    return it->second;
+
+  std::optional<std::vector<u8>> compressed = Compress(data.data(), data.size());
+  if (!compressed)
+    return std::nullopt;
+
+  Blob blob;
+  blob.compressed = std::make_shared<const std::vector<u8>>(std::move(*compressed));
+  blob.compressed_size = static_cast<u32>(blob.compressed->size());
+  blob.size = static_cast<u32>(data.size());
+
+  std::lock_guard lk(m_lock);
+  const u32 index = static_cast<u32>(m_blobs.size());
+  m_blobs.push_back(std::move(blob));
+  m_blob_index.emplace(key, index);
+  return index;
+}
+
+bool FifoDataFile::LoadAllFrames()
+{
+  const u32 frame_count = GetFrameCount();
+  for (u32 i = 0; i < frame_count; ++i)
+  {
+    FrameEntry entry;
+    {
+      std::lock_guard lk(m_lock);
+      entry = m_frames[i];
+    }
+    if (entry.chunk)
+      continue;
+
+    std::optional<std::vector<u8>> chunk;
+    u32 uncompressed_size = entry.uncompressed_size;
+    if (entry.uncompressed)
+    {
+      chunk = CompressFrame(*entry.uncompressed, &uncompressed_size);
+    }
+    else if (m_Version >= 6)
+    {
+      chunk.emplace(entry.chunk_size);
+      if (!ReadFromFile(entry.file_offset, chunk->data(), chunk->size()))
+        return false;
+    }
+    else
+    {
+      FifoFrameInfo frame_info;
+      if (!ReadUncompressedFrame(entry, frame_info))
+        return false;
+      chunk = CompressFrame(frame_info, &uncompressed_size);
+    }
+
+    if (!chunk)
+    {
+      ERROR_LOG_FMT(CORE, "Failed to compress frame {} of the FIFO log", i);
+      return false;
+    }
+
+    std::lock_guard lk(m_lock);
+    FrameEntry& stored_entry = m_frames[i];
+    stored_entry.chunk = std::make_shared<const std::vector<u8>>(std::move(*chunk));
+    stored_entry.uncompressed_size = uncompressed_size;
+    stored_entry.uncompressed.reset();
+  }
+
+  // Blobs are only added by this thread now, so the list can't change under us.
+  for (Blob& blob : m_blobs)
+  {
+    if (blob.compressed)
+      continue;
+
+    std::vector<u8> compressed(blob.compressed_size);
+    if (!ReadFromFile(blob.file_offset, compressed.data(), compressed.size()))
+      return false;
+
+    std::lock_guard lk(m_lock);
+    blob.compressed = std::make_shared<const std::vector<u8>>(std::move(compressed));
+  }
+
+  return true;
+}
+
+std::shared_ptr<const FifoFrameInfo> FifoDataFile::LoadFrame(u32 frame) const
+{
+  FrameEntry entry;
+  {
+    std::lock_guard lk(m_lock);
+    entry = m_frames[frame];
+  }
+
+  // The frame may have been added after the caller checked.
+  if (entry.uncompressed)
+    return entry.uncompressed;
+
+  auto frame_info = std::make_shared<FifoFrameInfo>();
+  frame_info->fifoStart = entry.fifo_start;
+  frame_info->fifoEnd = entry.fifo_end;
+
+  bool success;
+  if (entry.chunk)
+  {
+    success = UnpackFrame(*entry.chunk, entry, *frame_info);
+  }
+  else if (m_Version >= 6)
+  {
+    std::vector<u8> chunk(entry.chunk_size);
+    success = ReadFromFile(entry.file_offset, chunk.data(), chunk.size()) &&
+              UnpackFrame(chunk, entry, *frame_info);
+  }
+  else
+  {
+    success = ReadUncompressedFrame(entry, *frame_info);
+  }
+
+  if (!success)
+  {
+    ERROR_LOG_FMT(CORE, "Failed to read frame {} of the FIFO log", frame);
+    return nullptr;
   }
 
-  return updateListOffset;
+  return frame_info;
+}
+
+bool FifoDataFile::UnpackFrame(const std::vector<u8>& chunk, const FrameEntry& entry,
+                               FifoFrameInfo& frameInfo) const
+{
+  std::vector<u8> data;
+  if (!Decompress(chunk, data, entry.uncompressed_size))
+    return false;
+
+  const size_t update_list_offset = entry.fifo_data_size;
+  size_t inline_data_offset =
+      update_list_offset + size_t(entry.num_memory_updates) * sizeof(ChunkMemoryUpdate);
+  if (inline_data_offset > data.size())
+    return false;
+
+  frameInfo.fifoData.assign(data.begin(), data.begin() + update_list_offset);
+  frameInfo.memoryUpdates.resize(entry.num_memory_updates);
+  for (u32 i = 0; i < entry.num_memory_updates; ++i)
+  {
+    ChunkMemoryUpdate srcUpdate;
+    std::memcpy(&srcUpdate, &data[update_list_offset + i * sizeof(ChunkMemoryUpdate)],
+                sizeof(ChunkMemoryUpdate));
+
+    MemoryUpdate& dstUpdate = frameInfo.memoryUpdates[i];
+    dstUpdate.fifoPosition = srcUpdate.fifoPosition;
+    dstUpdate.address = srcUpdate.address;
+    dstUpdate.type = static_cast<MemoryUpdate::Type>(srcUpdate.type);
+
+    if (srcUpdate.blob == ChunkMemoryUpdate::INLINE_DATA)
+    {
+      if (srcUpdate.dataSize > data.size() - inline_data_offset)
+        return false;
+      dstUpdate.data.assign(data.begin() + inline_data_offset,
+                            data.begin() + inline_data_offset + srcUpdate.dataSize);
+      inline_data_offset += srcUpdate.dataSize;
+    }
+    else if (!ReadBlob(srcUpdate.blob, dstUpdate.data) ||
+             dstUpdate.data.size() != srcUpdate.dataSize)
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool FifoDataFile::ReadUncompressedFrame(const FrameEntry& entry, FifoFrameInfo& frameInfo) const
+{
+  std::lock_guard lk(m_file_lock);
+  frameInfo.fifoData.resize(entry.fifo_data_size);
+  m_file->Seek(entry.file_offset, File::SeekOrigin::Begin);
+  m_file->ReadBytes(frameInfo.fifoData.data(), entry.fifo_data_size);
+
+  ReadMemoryUpdates(entry.memory_updates_offset, entry.num_memory_updates, frameInfo.memoryUpdates,
+                    *m_file);
+
+  return m_file->IsGood();
+}
+
+bool FifoDataFile::ReadBlob(u32 blob, std::vector<u8>& data) const
+{
+  Blob entry;
+  {
+    std::lock_guard lk(m_lock);
+    if (blob >= m_blobs.size())
+      return false;
+    entry = m_blobs[blob];
+  }
+
+  if (entry.compressed)
+    return Decompress(*entry.compressed, data, entry.size);
+
+  std::vector<u8> compressed(entry.compressed_size);
+  return ReadFromFile(entry.file_offset, compressed.data(), compressed.size()) &&
+         Decompress(compressed, data, entry.size);
+}
+
+bool FifoDataFile::ReadFromFile(u64 offset, void* data, size_t size) const
+{
+  std::lock_guard lk(m_file_lock);
+  return m_file->Seek(offset, File::SeekOrigin::Begin) && m_file->ReadBytes(data, size);
+}
+
+void FifoDataFile::ReadAhead(u32 frame) const
+{
+  {
+    std::lock_guard lk(m_lock);
+    if (!IsInCacheWindow(frame) || m_frame_cache.contains(frame))
+      return;
+  }
+
+  if (auto frame_info = LoadFrame(frame))
+    CacheFrame(frame, std::move(frame_info));
+}
+
+void FifoDataFile::CacheFrame(u32 frame, std::shared_ptr<const FifoFrameInfo> frameInfo) const
+{
+  std::lock_guard lk(m_lock);
+
+  // The previous frame is kept as well, for the analyzer.
+  std::erase_if(m_frame_cache, [this](const auto& entry) { return !IsInCacheWindow(entry.first); });
+  if (IsInCacheWindow(frame))
+    m_frame_cache.emplace(frame, std::move(frameInfo));
+}
+
+bool FifoDataFile::IsInCacheWindow(u32 frame) const
+{
+  return frame + 1 >= m_requested_frame && frame <= m_requested_frame + READ_AHEAD_FRAMES;
 }
 
 void FifoDataFile::ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
@@ -4,11 +4,16 @@
 #pragma once
 
 #include <array>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include "Common/CommonTypes.h"
+#include "Common/WorkQueueThread.h"
 #include "VideoCommon/XFMemory.h"
 
 namespace File
@@ -57,6 +62,10 @@ public:
   static_assert((XF_MEM_SIZE + XF_REGS_SIZE) * sizeof(u32) == sizeof(XFMemory));
 
   FifoDataFile();
+  FifoDataFile(const FifoDataFile&) = delete;
+  FifoDataFile(FifoDataFile&&) = delete;
+  FifoDataFile& operator=(const FifoDataFile&) = delete;
+  FifoDataFile& operator=(FifoDataFile&&) = delete;
   ~FifoDataFile();
 
   void SetIsWii(bool isWii);
@@ -64,6 +73,13 @@ public:
   bool HasBrokenEFBCopies() const;
   bool ShouldGenerateFakeVIUpdates() const;
 
+  // Memory updates with the same data as an earlier one are only stored once.
+  // Must be set before the first frame is added.
+  void SetDeduplicateMemoryUpdates(bool deduplicate)
+  {
+    m_deduplicate_memory_updates = deduplicate;
+  }
+
   u32* GetBPMem() { return m_BPMem.data(); }
   u32* GetCPMem() { return m_CPMem.data(); }
   u32* GetXFMem() { return m_XFMem.data(); }
@@ -72,9 +88,19 @@ public:
   u32 GetRamSizeReal() { return m_ram_size_real; }
   u32 GetExRamSizeReal() { return m_exram_size_real; }
 
-  void AddFrame(const FifoFrameInfo& frameInfo);
-  const FifoFrameInfo& GetFrame(u32 frame) const { return m_Frames[frame]; }
-  u32 GetFrameCount() const { return static_cast<u32>(m_Frames.size()); }
+  // Frames are compressed on a background thread, so adding one doesn't stall the caller.
+  void AddFrame(FifoFrameInfo frameInfo);
+
+  // Frames are only kept compressed, or on disk for loaded files, and are decompressed when they
+  // are requested. The frames following a requested one are read ahead in the background.
+  // Returns nullptr if the frame can't be read or decompressed.
+  std::shared_ptr<const FifoFrameInfo> GetFrame(u32 frame) const;
+  u32 GetFrameCount() const;
+  // These don't need the frame to be decompressed.
+  u32 GetFrameFifoSize(u32 frame) const;
+  u64 GetFrameMemoryUpdateSize(u32 frame) const;
+
+  // Fails if any frame can't be compressed.
   bool Save(const std::string& filename);
 
   static std::unique_ptr<FifoDataFile> Load(const std::string& filename, bool flagsOnly);
@@ -85,12 +111,56 @@ private:
     FLAG_IS_WII = 1
   };
 
+  // A frame is held uncompressed until the compression thread gets to it, then as a compressed
+  // chunk. Frames of loaded files stay in the file until they are requested.
+  struct FrameEntry
+  {
+    u32 fifo_start = 0;
+    u32 fifo_end = 0;
+    u32 fifo_data_size = 0;
+    u32 num_memory_updates = 0;
+    u64 memory_update_size = 0;
+
+    std::shared_ptr<const FifoFrameInfo> uncompressed;
+    std::shared_ptr<const std::vector<u8>> chunk;
+    u64 file_offset = 0;
+    u32 chunk_size = 0;
+    u32 uncompressed_size = 0;
+
+    // Files older than version 6 store the frames uncompressed.
+    u64 memory_updates_offset = 0;
+  };
+
+  // Data of a deduplicated memory update, compressed on its own.
+  struct Blob
+  {
+    std::shared_ptr<const std::vector<u8>> compressed;
+    u64 file_offset = 0;
+    u32 compressed_size = 0;
+    u32 size = 0;
+  };
+
   void PadFile(size_t numBytes, File::IOFile& file);
 
   void SetFlag(u32 flag, bool set);
   bool GetFlag(u32 flag) const;
 
-  u64 WriteMemoryUpdates(const std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
+  void CompressQueuedFrame(u32 frame);
+  std::optional<std::vector<u8>> CompressFrame(const FifoFrameInfo& frameInfo,
+                                               u32* uncompressedSize);
+  std::optional<u32> AddBlob(const std::vector<u8>& data);
+  bool LoadAllFrames();
+
+  std::shared_ptr<const FifoFrameInfo> LoadFrame(u32 frame) const;
+  bool UnpackFrame(const std::vector<u8>& chunk, const FrameEntry& entry,
+                   FifoFrameInfo& frameInfo) const;
+  bool ReadUncompressedFrame(const FrameEntry& entry, FifoFrameInfo& frameInfo) const;
+  bool ReadBlob(u32 blob, std::vector<u8>& data) const;
+  bool ReadFromFile(u64 offset, void* data, size_t size) const;
+  void ReadAhead(u32 frame) const;
+  void CacheFrame(u32 frame, std::shared_ptr<const FifoFrameInfo> frameInfo) const;
+  bool IsInCacheWindow(u32 frame) const;
+
   static void ReadMemoryUpdates(u64 fileOffset, u32 numUpdates,
                                 std::vector<MemoryUpdate>& memUpdates, File::IOFile& file);
 
@@ -105,5 +175,22 @@ private:
   u32 m_Flags = 0;
   u32 m_Version = 0;
 
-  std::vector<FifoFrameInfo> m_Frames;
+  // Guards the frame and blob lists, and the decompressed frames.
+  mutable std::mutex m_lock;
+  std::vector<FrameEntry> m_frames;
+  std::vector<Blob> m_blobs;
+  mutable std::map<u32, std::shared_ptr<const FifoFrameInfo>> m_frame_cache;
+  mutable u32 m_requested_frame = 0;
+
+  // Only used by the compression thread, and by Save once it is idle.
+  std::map<std::tuple<u64, u64, u32>, u32> m_blob_index;
+  bool m_deduplicate_memory_updates = false;
+
+  mutable std::mutex m_file_lock;
+  std::unique_ptr<File::IOFile> m_file;
+
+  // Declared last, so the threads are stopped before anything they use is destroyed.
+  bool m_compress_thread_started = false;
+  Common::WorkQueueThread<u32> m_compress_thread;
+  mutable Common::WorkQueueThread<u32> m_read_ahead_thread;
 };
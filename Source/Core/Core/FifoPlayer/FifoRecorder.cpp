@@ -10,6 +10,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/Thread.h"
 
+#include "Core/Config/MainSettings.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
 
@@ -223,6 +224,8 @@ void FifoRecorder::StartRecording(s32 numFrames, CallbackFunc finishedCb)
   std::lock_guard lk(m_mutex);
 
   m_File = std::make_unique<FifoDataFile>();
+  m_File->SetDeduplicateMemoryUpdates(
+      Config::Get(Config::MAIN_FIFOPLAYER_DEDUPLICATE_MEMORY_UPDATES));
 
   // TODO: This, ideally, would be deallocated when done recording.
   //       However, care needs to be taken since global state
@@ -338,15 +341,14 @@ void FifoRecorder::WriteGPCommand(const u8* data, u32 size)
     {
       std::lock_guard lk(m_mutex);
 
-      // Copy frame to file
-      // The file will be responsible for freeing the memory allocated for each frame's fifoData
-      m_File->AddFrame(m_CurrentFrame);
+      // The file compresses the frame on its own thread
+      m_File->AddFrame(std::move(m_CurrentFrame));
+      m_CurrentFrame = {};
 
       if (m_FinishedCb && m_RequestedRecordingEnd)
         m_FinishedCb();
     }
 
-    m_CurrentFrame.memoryUpdates.clear();
     m_FifoData.clear();
     m_FrameEnded = false;
   }
@@ -34,6 +34,7 @@
 #include "Core/HW/VideoInterface.h"
 #include "Core/HW/WII_IPC.h"
 #include "Core/PowerPC/JitCommon/JitBase.h"
+#include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 #include "VideoCommon/CommandProcessor.h"
@@ -354,6 +355,9 @@ void MemoryManager::Shutdown()
   }
   m_arena.ReleaseSHMSegment();
   m_mmio_mapping.reset();
+  m_snapshot.Invalidate();
+  // The MMU may still be holding pointers into the views released above.
+  m_system.GetMMU().InvalidateHostPageCache();
   INFO_LOG_FMT(MEMMAP, "Memory system shut down.");
 }
 
@@ -13,6 +13,7 @@
 #include "Common/MathUtil.h"
 #include "Common/MemArena.h"
 #include "Common/Swap.h"
+#include "Core/HW/MemorySnapshot.h"
 #include "Core/PowerPC/MMU.h"
 
 // Global declarations
@@ -91,6 +92,8 @@ public:
 
   MMIO::Mapping* GetMMIOMapping() const { return m_mmio_mapping.get(); }
 
+  MemorySnapshot& GetSnapshot() { return m_snapshot; }
+
   // Init and Shutdown
   bool IsInitialized() const { return m_is_initialized; }
   void Init();
@@ -204,6 +207,9 @@ private:
   // MMIO mapping object.
   std::unique_ptr<MMIO::Mapping> m_mmio_mapping;
 
+  // Per-frame copies of guest memory for observers on other threads.
+  MemorySnapshot m_snapshot{*this};
+
   // The MemArena class
   Common::MemArena m_arena;
 
@@ -0,0 +1,180 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Core/HW/MemorySnapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+#include "Core/Core.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+
+namespace Memory
+{
+MemorySnapshot::View::View(View&& other) noexcept
+    : m_buffer(std::exchange(other.m_buffer, nullptr))
+{
+}
+
+MemorySnapshot::View& MemorySnapshot::View::operator=(View&& other) noexcept
+{
+  if (this != &other)
+  {
+    if (m_buffer)
+      m_buffer->readers.fetch_sub(1);
+    m_buffer = std::exchange(other.m_buffer, nullptr);
+  }
+  return *this;
+}
+
+MemorySnapshot::View::~View()
+{
+  if (m_buffer)
+    m_buffer->readers.fetch_sub(1);
+}
+
+u64 MemorySnapshot::View::GetFrame() const
+{
+  return m_buffer ? m_buffer->frame : 0;
+}
+
+bool MemorySnapshot::View::Read(u32 address, void* data, u32 size,
+                                PowerPC::RequestedAddressSpace space, bool* translated) const
+{
+  if (!m_buffer)
+    return false;
+
+  for (const BufferRange& range : m_buffer->ranges)
+  {
+    if (!range.valid || range.space != space || address < range.address ||
+        address - range.address >= range.size || size > range.size - (address - range.address))
+    {
+      continue;
+    }
+
+    std::memcpy(data, &m_buffer->data[range.offset + (address - range.address)], size);
+    if (translated)
+      *translated = range.translated;
+    return true;
+  }
+
+  return false;
+}
+
+MemorySnapshot::MemorySnapshot(MemoryManager& memory) : m_memory(memory)
+{
+}
+
+MemorySnapshot::~MemorySnapshot() = default;
+
+MemorySnapshot::RangeID MemorySnapshot::AddRange(u32 address, u32 size,
+                                                 PowerPC::RequestedAddressSpace space)
+{
+  std::lock_guard lk(m_ranges_lock);
+  const RangeID id = m_next_range_id++;
+  m_ranges.push_back(Range{id, address, size, space});
+  m_has_ranges.store(true, std::memory_order_relaxed);
+  return id;
+}
+
+void MemorySnapshot::RemoveRange(RangeID id)
+{
+  std::lock_guard lk(m_ranges_lock);
+  std::erase_if(m_ranges, [id](const Range& range) { return range.id == id; });
+  m_has_ranges.store(!m_ranges.empty(), std::memory_order_relaxed);
+}
+
+bool MemorySnapshot::HasRanges() const
+{
+  return m_has_ranges.load(std::memory_order_relaxed);
+}
+
+void MemorySnapshot::Update(const Core::CPUThreadGuard& guard)
+{
+  if (!HasRanges() || !m_memory.IsInitialized())
+    return;
+
+  // Find a buffer which is neither published nor pinned by a reader. Readers pin a buffer before
+  // checking that it's still the published one, so once we see that a non-published buffer has no
+  // readers, no reader can start using it until we publish it again.
+  const u32 current = m_current.load();
+  Buffer* target = nullptr;
+  u32 target_index = NO_BUFFER;
+  for (u32 i = 0; i < BUFFER_COUNT; ++i)
+  {
+    if (i != current && m_buffers[i].readers.load() == 0)
+    {
+      target = &m_buffers[i];
+      target_index = i;
+      break;
+    }
+  }
+  if (!target)
+    return;
+
+  target->ranges.clear();
+  {
+    std::lock_guard lk(m_ranges_lock);
+    u32 offset = 0;
+    for (const Range& range : m_ranges)
+    {
+      target->ranges.push_back(
+          BufferRange{range.address, range.size, offset, range.space, false, false});
+      offset += range.size;
+    }
+    target->data.resize(offset);
+  }
+
+  const bool data_translation = guard.GetSystem().GetPPCState().msr.DR;
+  for (BufferRange& range : target->ranges)
+  {
+    range.translated = range.space == PowerPC::RequestedAddressSpace::Virtual ||
+                       (range.space == PowerPC::RequestedAddressSpace::Effective &&
+                        data_translation);
+
+    // Copy page by page, since contiguous effective pages needn't be contiguous in host memory.
+    range.valid = true;
+    for (u32 copied = 0; copied < range.size && range.valid;)
+    {
+      const u32 address = range.address + copied;
+      const u32 page_offset = address & u32(PowerPC::HW_PAGE_MASK);
+      const u32 size =
+          std::min<u32>(range.size - copied, u32(PowerPC::HW_PAGE_SIZE) - page_offset);
+      const u8* page = PowerPC::MMU::HostGetPagePointer(guard, address, range.space);
+      range.valid = page != nullptr;
+      if (range.valid)
+        std::memcpy(&target->data[range.offset + copied], page + page_offset, size);
+      copied += size;
+    }
+  }
+
+  target->frame = ++m_frame;
+  m_current.store(target_index);
+}
+
+void MemorySnapshot::Invalidate()
+{
+  m_current.store(NO_BUFFER);
+}
+
+MemorySnapshot::View MemorySnapshot::Acquire() const
+{
+  while (true)
+  {
+    const u32 current = m_current.load();
+    if (current == NO_BUFFER)
+      return View{};
+
+    const Buffer& buffer = m_buffers[current];
+    buffer.readers.fetch_add(1);
+    if (m_current.load() == current)
+      return View{&buffer};
+
+    // Update() published another buffer in the meantime; that buffer may be rewritten now.
+    buffer.readers.fetch_sub(1);
+  }
+}
+}  // namespace Memory
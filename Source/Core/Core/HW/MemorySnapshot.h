@@ -0,0 +1,148 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Swap.h"
+#include "Core/PowerPC/MMU.h"
+
+namespace Core
+{
+class CPUThreadGuard;
+}
+
+namespace Memory
+{
+class MemoryManager;
+
+// Keeps copies of selected ranges of guest memory which are refreshed once per frame on the CPU
+// thread, so that memory observers such as the cheat search can read them from any thread without
+// pausing emulation.
+//
+// Readers never block: Acquire() pins the most recently published copy and Update() only ever
+// writes into a copy which is neither published nor pinned. If every spare copy is still pinned,
+// Update() skips the frame instead of waiting.
+class MemorySnapshot
+{
+  struct Buffer;
+
+public:
+  using RangeID = u32;
+
+  // A pinned copy of all ranges as of the end of a frame. Reads outside of the registered ranges,
+  // or from ranges which weren't backed by memory at the time of the update, fail.
+  class View
+  {
+  public:
+    View() = default;
+    View(const View&) = delete;
+    View& operator=(const View&) = delete;
+    View(View&& other) noexcept;
+    View& operator=(View&& other) noexcept;
+    ~View();
+
+    bool IsValid() const { return m_buffer != nullptr; }
+    u64 GetFrame() const;
+
+    // Copies size bytes starting at the given address. Returns false if the range isn't fully
+    // covered by a single snapshot range registered for the same address space. If translated is
+    // given, it's set to whether the copy was made with address translation on.
+    bool Read(u32 address, void* data, u32 size,
+              PowerPC::RequestedAddressSpace space = PowerPC::RequestedAddressSpace::Physical,
+              bool* translated = nullptr) const;
+
+    template <typename T>
+    std::optional<T>
+    Read(u32 address,
+         PowerPC::RequestedAddressSpace space = PowerPC::RequestedAddressSpace::Physical) const
+    {
+      static_assert(std::is_arithmetic_v<T>);
+      using U = std::conditional_t<
+          sizeof(T) == 1, u8,
+          std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+      U value;
+      if (!Read(address, &value, sizeof(U), space))
+        return std::nullopt;
+      return std::bit_cast<T>(Common::FromBigEndian(value));
+    }
+
+  private:
+    friend class MemorySnapshot;
+    explicit View(const Buffer* buffer) : m_buffer(buffer) {}
+
+    const Buffer* m_buffer = nullptr;
+  };
+
+  explicit MemorySnapshot(MemoryManager& memory);
+  MemorySnapshot(const MemorySnapshot&) = delete;
+  MemorySnapshot& operator=(const MemorySnapshot&) = delete;
+  ~MemorySnapshot();
+
+  // May be called from any thread. Changes take effect at the next Update(). Ranges in the
+  // effective or virtual address space are translated with the MMU state at the time of the
+  // update; a range is only captured if all of its pages can be read directly.
+  RangeID AddRange(u32 address, u32 size,
+                   PowerPC::RequestedAddressSpace space = PowerPC::RequestedAddressSpace::Physical);
+  void RemoveRange(RangeID id);
+  bool HasRanges() const;
+
+  // Copies all ranges and publishes the copies. CPU thread only.
+  void Update(const Core::CPUThreadGuard& guard);
+  // Unpublishes the current copy, e.g. when memory is shut down. Views stay valid.
+  void Invalidate();
+
+  // May be called from any thread.
+  View Acquire() const;
+
+private:
+  struct Range
+  {
+    RangeID id;
+    u32 address;
+    u32 size;
+    PowerPC::RequestedAddressSpace space;
+  };
+
+  struct BufferRange
+  {
+    u32 address;
+    u32 size;
+    u32 offset;
+    PowerPC::RequestedAddressSpace space;
+    bool valid;
+    bool translated;
+  };
+
+  struct Buffer
+  {
+    std::vector<BufferRange> ranges;
+    std::vector<u8> data;
+    u64 frame = 0;
+    mutable std::atomic<u32> readers = 0;
+  };
+
+  static constexpr u32 BUFFER_COUNT = 3;
+  static constexpr u32 NO_BUFFER = BUFFER_COUNT;
+
+  MemoryManager& m_memory;
+
+  mutable std::mutex m_ranges_lock;
+  std::vector<Range> m_ranges;
+  RangeID m_next_range_id = 0;
+  std::atomic<bool> m_has_ranges = false;
+
+  std::array<Buffer, BUFFER_COUNT> m_buffers;
+  std::atomic<u32> m_current = NO_BUFFER;
+  u64 m_frame = 0;
+};
+}  // namespace Memory
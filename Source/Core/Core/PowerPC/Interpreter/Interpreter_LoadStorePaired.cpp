@@ -14,6 +14,7 @@
 #include "Common/MathUtil.h"
 #include "Core/PowerPC/Interpreter/ExceptionUtils.h"
 #include "Core/PowerPC/Interpreter/Interpreter_FPUtils.h"
+#include "Core/PowerPC/Interpreter/Interpreter_PairedUtils.h"
 #include "Core/PowerPC/MMU.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
@@ -58,16 +59,6 @@ const float m_quantizeTable[] = {
     1.0 / (1ULL << 4),  1.0 / (1ULL << 3),  1.0 / (1ULL << 2),  1.0 / (1ULL << 1),
 };
 
-template <typename SType>
-SType ScaleAndClamp(double ps, u32 st_scale)
-{
-  const float conv_ps = float(ps) * m_quantizeTable[st_scale];
-  constexpr float min = float(std::numeric_limits<SType>::min());
-  constexpr float max = float(std::numeric_limits<SType>::max());
-
-  return SType(std::clamp(conv_ps, min, max));
-}
-
 template <typename T>
 static T ReadUnpaired(PowerPC::MMU& mmu, u32 addr);
 
@@ -160,15 +151,15 @@ void QuantizeAndStore(PowerPC::MMU& mmu, double ps0, double ps1, u32 addr, u32 i
 {
   using U = std::make_unsigned_t<T>;
 
-  const U conv_ps0 = U(ScaleAndClamp<T>(ps0, st_scale));
+  const float scale = m_quantizeTable[st_scale];
   if (instW)
   {
-    WriteUnpaired<U>(mmu, conv_ps0, addr);
+    WriteUnpaired<U>(mmu, U(ScaleAndClamp<T>(ps0, scale)), addr);
   }
   else
   {
-    const U conv_ps1 = U(ScaleAndClamp<T>(ps1, st_scale));
-    WritePair<U>(mmu, conv_ps0, conv_ps1, addr);
+    const auto [conv_ps0, conv_ps1] = QuantizePair<T>(ps0, ps1, scale);
+    WritePair<U>(mmu, U(conv_ps0), U(conv_ps1), addr);
   }
 }
 
@@ -232,21 +223,16 @@ std::pair<double, double> LoadAndDequantize(PowerPC::MMU& mmu, u32 addr, u32 ins
 {
   using U = std::make_unsigned_t<T>;
 
-  float ps0, ps1;
+  const float scale = m_dequantizeTable[ld_scale];
   if (instW != 0)
   {
     const U value = ReadUnpaired<U>(mmu, addr);
-    ps0 = float(T(value)) * m_dequantizeTable[ld_scale];
-    ps1 = 1.0f;
+    // ps0 always contains a finite and normal number. So we can just cast it to double
+    return {static_cast<double>(float(T(value)) * scale), 1.0};
   }
-  else
-  {
-    const auto [first, second] = ReadPair<U>(mmu, addr);
-    ps0 = float(T(first)) * m_dequantizeTable[ld_scale];
-    ps1 = float(T(second)) * m_dequantizeTable[ld_scale];
-  }
-  // ps0 and ps1 always contain finite and normal numbers. So we can just cast them to double
-  return {static_cast<double>(ps0), static_cast<double>(ps1)};
+
+  const auto [first, second] = ReadPair<U>(mmu, addr);
+  return DequantizePair<T>(T(first), T(second), scale);
 }
 
 static void Helper_Dequantize(PowerPC::MMU& mmu, PowerPC::PowerPCState* ppcs, u32 addr, u32 instI,
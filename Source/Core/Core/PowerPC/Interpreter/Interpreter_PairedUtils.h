@@ -0,0 +1,86 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#include "Common/CommonTypes.h"
+
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#elif defined(_M_ARM_64)
+#include <arm_neon.h>
+#endif
+
+// Helpers for converting both slots of a paired single at once, as done by psq_l and psq_st.
+//
+// The scalar versions are the reference implementation. The vector versions perform the exact same
+// sequence of IEEE operations (int -> float, float * scale, float -> double, and double -> float,
+// float * scale, clamp, truncate respectively) so that they are bit-exact with the scalar ones
+// regardless of the host rounding mode.
+
+template <typename SType>
+SType ScaleAndClamp(double ps, float scale)
+{
+  const float conv_ps = float(ps) * scale;
+  constexpr float min = float(std::numeric_limits<SType>::min());
+  constexpr float max = float(std::numeric_limits<SType>::max());
+
+  return SType(std::clamp(conv_ps, min, max));
+}
+
+template <typename SType>
+std::pair<SType, SType> QuantizePairScalar(double ps0, double ps1, float scale)
+{
+  return {ScaleAndClamp<SType>(ps0, scale), ScaleAndClamp<SType>(ps1, scale)};
+}
+
+template <typename SType>
+std::pair<double, double> DequantizePairScalar(SType first, SType second, float scale)
+{
+  // The results are always finite and normal numbers, so they can just be cast to double
+  return {static_cast<double>(float(first) * scale), static_cast<double>(float(second) * scale)};
+}
+
+template <typename SType>
+std::pair<SType, SType> QuantizePair(double ps0, double ps1, float scale)
+{
+  constexpr float min = float(std::numeric_limits<SType>::min());
+  constexpr float max = float(std::numeric_limits<SType>::max());
+
+#if defined(_M_X86_64)
+  const __m128 values = _mm_mul_ps(_mm_cvtpd_ps(_mm_set_pd(ps1, ps0)), _mm_set1_ps(scale));
+  // MINPS/MAXPS return their second operand if either operand is NaN. Passing the value second
+  // lets a NaN through just like std::clamp does.
+  const __m128 clamped = _mm_max_ps(_mm_set1_ps(min), _mm_min_ps(_mm_set1_ps(max), values));
+  const __m128i result = _mm_cvttps_epi32(clamped);
+  return {SType(_mm_cvtsi128_si32(result)), SType(_mm_cvtsi128_si32(_mm_srli_si128(result, 4)))};
+#elif defined(_M_ARM_64)
+  const float64x2_t doubles = vcombine_f64(vdup_n_f64(ps0), vdup_n_f64(ps1));
+  const float32x2_t values = vmul_n_f32(vcvt_f32_f64(doubles), scale);
+  const float32x2_t clamped = vmax_f32(vmin_f32(values, vdup_n_f32(max)), vdup_n_f32(min));
+  const int32x2_t result = vcvt_s32_f32(clamped);
+  return {SType(vget_lane_s32(result, 0)), SType(vget_lane_s32(result, 1))};
+#else
+  return QuantizePairScalar<SType>(ps0, ps1, scale);
+#endif
+}
+
+template <typename SType>
+std::pair<double, double> DequantizePair(SType first, SType second, float scale)
+{
+#if defined(_M_X86_64)
+  const __m128i ints = _mm_setr_epi32(s32(first), s32(second), 0, 0);
+  const __m128d result = _mm_cvtps_pd(_mm_mul_ps(_mm_cvtepi32_ps(ints), _mm_set1_ps(scale)));
+  return {_mm_cvtsd_f64(result), _mm_cvtsd_f64(_mm_unpackhi_pd(result, result))};
+#elif defined(_M_ARM_64)
+  const int32x2_t ints = vset_lane_s32(s32(second), vdup_n_s32(s32(first)), 1);
+  const float64x2_t result = vcvt_f64_f32(vmul_n_f32(vcvt_f32_s32(ints), scale));
+  return {vgetq_lane_f64(result, 0), vgetq_lane_f64(result, 1)};
+#else
+  return DequantizePairScalar<SType>(first, second, scale);
+#endif
+}
@@ -169,10 +169,25 @@ T MMU::ReadFromHardware(u32 em_address)
     return static_cast<T>(var);
   }
 
+  const u32 effective_address = em_address;
+  const bool translate =
+      !never_translate &&
+      (IsOpcodeFlag(flag) ? m_ppc_state.msr.IR.Value() : m_ppc_state.msr.DR.Value());
+
+  if (!IsOpcodeFlag(flag) && translate)
+  {
+    if (const u8* host_page = LookupHostPage(effective_address))
+    {
+      T value;
+      std::memcpy(&value, &host_page[effective_address & HW_PAGE_MASK], sizeof(T));
+      return bswap(value);
+    }
+  }
+
   bool wi = false;
+  bool cacheable = !IsOpcodeFlag(flag) && translate;
 
-  if (!never_translate &&
-      (IsOpcodeFlag(flag) ? m_ppc_state.msr.IR.Value() : m_ppc_state.msr.DR.Value()))
+  if (translate)
   {
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
@@ -183,8 +198,11 @@ T MMU::ReadFromHardware(u32 em_address)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    cacheable &= translated_addr.result == TranslateAddressResultEnum::BAT_TRANSLATED;
   }
 
+  cacheable &= !wi && !m_ppc_state.m_enable_dcache;
+
   if (flag == XCheckTLBFlag::Read && (em_address & 0xF8000000) == 0x08000000)
   {
     if (em_address < 0x0c000000)
@@ -202,6 +220,12 @@ T MMU::ReadFromHardware(u32 em_address)
   if (m_memory.GetL1Cache() && (em_address >> 28) == 0xE &&
       (em_address < (0xE0000000 + m_memory.GetL1CacheSize())))
   {
+    if (cacheable)
+    {
+      UpdateHostPage(effective_address,
+                     &m_memory.GetL1Cache()[em_address & 0x0FFFFFFF & ~HW_PAGE_MASK]);
+    }
+
     T value;
     std::memcpy(&value, &m_memory.GetL1Cache()[em_address & 0x0FFFFFFF], sizeof(T));
     return bswap(value);
@@ -214,6 +238,9 @@ T MMU::ReadFromHardware(u32 em_address)
     T value;
     em_address &= m_memory.GetRamMask();
 
+    if (cacheable)
+      UpdateHostPage(effective_address, &m_memory.GetRAM()[em_address & ~HW_PAGE_MASK]);
+
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetRAM()[em_address], sizeof(T));
@@ -233,6 +260,11 @@ T MMU::ReadFromHardware(u32 em_address)
     T value;
     em_address &= 0x0FFFFFFF;
 
+    if (cacheable)
+    {
+      UpdateHostPage(effective_address, &m_memory.GetEXRAM()[em_address & ~HW_PAGE_MASK]);
+    }
+
     if (!m_ppc_state.m_enable_dcache || wi)
     {
       std::memcpy(&value, &m_memory.GetEXRAM()[em_address], sizeof(T));
@@ -251,6 +283,13 @@ T MMU::ReadFromHardware(u32 em_address)
   // [0x7E000000, 0x80000000).
   if (m_memory.GetFakeVMEM() && ((em_address & 0xFE000000) == 0x7E000000))
   {
+    if (cacheable)
+    {
+      UpdateHostPage(
+          effective_address,
+          &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask() & ~HW_PAGE_MASK]);
+    }
+
     T value;
     std::memcpy(&value, &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()],
                 sizeof(T));
@@ -288,9 +327,20 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     return;
   }
 
+  const u32 effective_address = em_address;
+  const bool translate = !never_translate && m_ppc_state.msr.DR;
+
+  if (u8* host_page = translate ? LookupHostPage(effective_address) : nullptr)
+  {
+    const u32 swapped_data = Common::swap32(std::rotr(data, size * 8));
+    std::memcpy(&host_page[effective_address & HW_PAGE_MASK], &swapped_data, size);
+    return;
+  }
+
   bool wi = false;
+  bool cacheable = translate;
 
-  if (!never_translate && m_ppc_state.msr.DR)
+  if (translate)
   {
     auto translated_addr = TranslateAddress<flag>(em_address);
     if (!translated_addr.Success())
@@ -301,8 +351,11 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     }
     em_address = translated_addr.address;
     wi = translated_addr.wi;
+    cacheable = translated_addr.result == TranslateAddressResultEnum::BAT_TRANSLATED;
   }
 
+  cacheable &= !wi && !m_ppc_state.m_enable_dcache;
+
   // Check for a gather pipe write (which are not implemented through the MMIO system).
   //
   // Note that we must mask the address to correctly emulate certain games; Pac-Man World 3
@@ -375,6 +428,12 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   if (m_memory.GetL1Cache() && (em_address >> 28 == 0xE) &&
       (em_address < (0xE0000000 + m_memory.GetL1CacheSize())))
   {
+    if (cacheable)
+    {
+      UpdateHostPage(effective_address,
+                     &m_memory.GetL1Cache()[em_address & 0x0FFFFFFF & ~HW_PAGE_MASK]);
+    }
+
     std::memcpy(&m_memory.GetL1Cache()[em_address & 0x0FFFFFFF], &swapped_data, size);
     return;
   }
@@ -411,6 +470,9 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
     // mirrors of memory).
     em_address &= m_memory.GetRamMask();
 
+    if (cacheable)
+      UpdateHostPage(effective_address, &m_memory.GetRAM()[em_address & ~HW_PAGE_MASK]);
+
     if (m_ppc_state.m_enable_dcache && !wi)
       m_ppc_state.dCache.Write(m_memory, em_address, &swapped_data, size, HID0(m_ppc_state).DLOCK);
 
@@ -425,6 +487,11 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   {
     em_address &= 0x0FFFFFFF;
 
+    if (cacheable)
+    {
+      UpdateHostPage(effective_address, &m_memory.GetEXRAM()[em_address & ~HW_PAGE_MASK]);
+    }
+
     if (m_ppc_state.m_enable_dcache && !wi)
     {
       m_ppc_state.dCache.Write(m_memory, em_address + 0x10000000, &swapped_data, size,
@@ -442,6 +509,13 @@ void MMU::WriteToHardware(u32 em_address, const u32 data, const u32 size)
   // [0x7E000000, 0x80000000).
   if (m_memory.GetFakeVMEM() && ((em_address & 0xFE000000) == 0x7E000000))
   {
+    if (cacheable)
+    {
+      UpdateHostPage(
+          effective_address,
+          &m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask() & ~HW_PAGE_MASK]);
+    }
+
     std::memcpy(&m_memory.GetFakeVMEM()[em_address & m_memory.GetFakeVMemMask()], &swapped_data,
                 size);
     return;
@@ -990,6 +1064,65 @@ bool MMU::HostIsRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
   return false;
 }
 
+const u8* MMU::GetHostPagePointer(u32 address, bool translate)
+{
+  bool wi = false;
+  if (translate)
+  {
+    auto translate_address = TranslateAddress<XCheckTLBFlag::NoException>(address);
+    if (!translate_address.Success())
+      return nullptr;
+    address = translate_address.address;
+    wi = translate_address.wi;
+  }
+
+  address &= ~HW_PAGE_MASK;
+
+  // Same regions as IsRAMAddress. RAM and EXRAM reads have to go through the data cache if it's
+  // enabled, so those can't be read directly.
+  const u32 segment = address >> 28;
+  const bool bypass_dcache = !m_ppc_state.m_enable_dcache || wi;
+  if (m_memory.GetRAM() && segment == 0x0 && (address & 0x0FFFFFFF) < m_memory.GetRamSizeReal())
+  {
+    return bypass_dcache ? &m_memory.GetRAM()[address] : nullptr;
+  }
+  else if (m_memory.GetEXRAM() && segment == 0x1 &&
+           (address & 0x0FFFFFFF) < m_memory.GetExRamSizeReal())
+  {
+    return bypass_dcache ? &m_memory.GetEXRAM()[address & 0x0FFFFFFF] : nullptr;
+  }
+  else if (m_memory.GetFakeVMEM() && ((address & 0xFE000000) == 0x7E000000))
+  {
+    return &m_memory.GetFakeVMEM()[address & m_memory.GetFakeVMemMask()];
+  }
+  else if (m_memory.GetL1Cache() && segment == 0xE &&
+           (address < (0xE0000000 + m_memory.GetL1CacheSize())))
+  {
+    return &m_memory.GetL1Cache()[address & 0x0FFFFFFF];
+  }
+  return nullptr;
+}
+
+const u8* MMU::HostGetPagePointer(const Core::CPUThreadGuard& guard, u32 address,
+                                  RequestedAddressSpace space)
+{
+  auto& mmu = guard.GetSystem().GetMMU();
+  switch (space)
+  {
+  case RequestedAddressSpace::Effective:
+    return mmu.GetHostPagePointer(address, mmu.m_ppc_state.msr.DR);
+  case RequestedAddressSpace::Physical:
+    return mmu.GetHostPagePointer(address, false);
+  case RequestedAddressSpace::Virtual:
+    if (!mmu.m_ppc_state.msr.DR)
+      return nullptr;
+    return mmu.GetHostPagePointer(address, true);
+  }
+
+  ASSERT(false);
+  return nullptr;
+}
+
 bool MMU::HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                                       RequestedAddressSpace space)
 {
@@ -1627,6 +1760,7 @@ void MMU::UpdateFakeMMUBat(BatTable& bat_table, u32 start_addr)
 
 void MMU::DBATUpdated()
 {
+  InvalidateHostPageCache();
   m_dbat_table = {};
   UpdateBATs(m_dbat_table, SPR_DBAT0U);
   bool extended_bats = m_system.IsWii() && HID4(m_ppc_state).SBE;
@@ -1663,6 +1797,30 @@ void MMU::IBATUpdated()
   m_system.GetJitInterface().ClearSafe();
 }
 
+void MMU::InvalidateHostPageCache()
+{
+  m_host_page_cache.fill({});
+}
+
+u8* MMU::LookupHostPage(u32 em_address) const
+{
+  // Toggling the data cache emulation doesn't go through DBATUpdated, so check it here.
+  if (m_ppc_state.m_enable_dcache)
+    return nullptr;
+
+  const u32 page = em_address >> HW_PAGE_INDEX_SHIFT;
+  const HostPageCacheEntry& entry = m_host_page_cache[page % HOST_PAGE_CACHE_SIZE];
+  return entry.tag == page ? entry.host_page : nullptr;
+}
+
+void MMU::UpdateHostPage(u32 em_address, u8* host_page)
+{
+  const u32 page = em_address >> HW_PAGE_INDEX_SHIFT;
+  HostPageCacheEntry& entry = m_host_page_cache[page % HOST_PAGE_CACHE_SIZE];
+  entry.tag = page;
+  entry.host_page = host_page;
+}
+
 // Translate effective address using BAT or PAT.  Returns 0 if the address cannot be translated.
 // Through the hardware looks up BAT and TLB in parallel, BAT is used first if available.
 // So we first check if there is a matching BAT entry, else we look for the TLB in
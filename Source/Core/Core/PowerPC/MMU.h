@@ -207,6 +207,13 @@ public:
   HostIsInstructionRAMAddress(const Core::CPUThreadGuard& guard, u32 address,
                               RequestedAddressSpace space = RequestedAddressSpace::Effective);
 
+  // Returns a host pointer to the start of the HW_PAGE_SIZE page containing the given address if
+  // reads from that page can be served by reading host memory directly, or nullptr otherwise (the
+  // page isn't RAM, or reads from it go through the emulated data cache). The pointer stays valid
+  // only as long as the guard is held and the address translation doesn't change.
+  static const u8* HostGetPagePointer(const Core::CPUThreadGuard& guard, u32 address,
+                                      RequestedAddressSpace space = RequestedAddressSpace::Effective);
+
   // Routines for the CPU core to access memory.
 
   // Used by interpreter to read instructions, uses iCache
@@ -241,6 +248,7 @@ public:
   void InvalidateTLBEntry(u32 address);
   void DBATUpdated();
   void IBATUpdated();
+  void InvalidateHostPageCache();
 
   // Result changes based on the BAT registers and MSR.DR.  Returns whether
   // it's safe to optimize a read or write to this address to an unguarded
@@ -311,6 +319,10 @@ private:
   void WriteToHardware(u32 em_address, const u32 data, const u32 size);
   template <XCheckTLBFlag flag>
   bool IsRAMAddress(u32 address, bool translate);
+  const u8* GetHostPagePointer(u32 address, bool translate);
+
+  u8* LookupHostPage(u32 em_address) const;
+  void UpdateHostPage(u32 em_address, u8* host_page);
 
   template <typename T>
   static std::optional<ReadResult<T>> HostTryReadUX(const Core::CPUThreadGuard& guard,
@@ -326,6 +338,23 @@ private:
 
   BatTable m_ibat_table;
   BatTable m_dbat_table;
+
+  // Direct-mapped cache of host pointers for data pages, used by ReadFromHardware and
+  // WriteToHardware to skip address translation and the memory region checks. Only pages whose
+  // accesses are plain memcpys are cached: translated through a BAT (page table translations have
+  // to update the R and C bits), neither write-through nor cache-inhibited, backed by RAM, EXRAM,
+  // locked L1 or fake VMEM, and with the data cache not being emulated. Accesses with translation
+  // off are already as cheap as a cache hit, so they neither use nor fill the cache, and MSR
+  // changes don't require an invalidation; BAT changes do.
+  struct HostPageCacheEntry
+  {
+    static constexpr u32 INVALID_TAG = 0xffffffff;
+
+    u32 tag = INVALID_TAG;
+    u8* host_page = nullptr;
+  };
+  static constexpr u32 HOST_PAGE_CACHE_SIZE = 1024;
+  std::array<HostPageCacheEntry, HOST_PAGE_CACHE_SIZE> m_host_page_cache{};
 };
 
 void ClearDCacheLineFromJit(MMU& mmu, u32 address);
@@ -0,0 +1,130 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinNoGUI/FifoBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Config/Config.h"
+#include "Core/Config/MainSettings.h"
+#include "Core/FifoPlayer/FifoPlayer.h"
+#include "Core/System.h"
+#include "VideoCommon/FrameProfiler.h"
+
+namespace FifoBenchmark
+{
+using Clock = std::chrono::steady_clock;
+
+static u32 s_loop_count = 0;
+static u32 s_frames_written = 0;
+static bool s_finished = false;
+static Clock::time_point s_start_time;
+static Clock::time_point s_end_time;
+static std::vector<VideoCommon::FrameProfile> s_frames;
+static std::function<void()> s_on_finished;
+
+void Start(Core::System& system, u32 loop_count, std::function<void()> on_finished)
+{
+  s_loop_count = loop_count;
+  s_frames_written = 0;
+  s_finished = false;
+  s_frames.clear();
+  s_on_finished = std::move(on_finished);
+
+  Config::SetCurrent(Config::MAIN_FIFOPLAYER_LOOP_REPLAY, true);
+  Config::SetCurrent(Config::MAIN_EMULATION_SPEED, 0.0f);
+
+  VideoCommon::g_frame_profiler.SetEnabled(true);
+
+  FifoPlayer& fifo_player = system.GetFifoPlayer();
+  fifo_player.SetFrameWrittenCallback([&fifo_player] {
+    if (s_finished)
+      return;
+
+    // This is called right before a frame is written, so it tells us when a loop has finished.
+    const u32 frames_per_loop =
+        fifo_player.GetFrameRangeEnd() - fifo_player.GetFrameRangeStart() + 1;
+    const u32 frames_written = s_frames_written++;
+    if (frames_written == frames_per_loop)
+    {
+      // Drop the warm-up
+      VideoCommon::g_frame_profiler.TakeFrames();
+      s_start_time = Clock::now();
+    }
+    else if (frames_written == frames_per_loop * (s_loop_count + 1))
+    {
+      s_end_time = Clock::now();
+      s_frames = VideoCommon::g_frame_profiler.TakeFrames();
+      VideoCommon::g_frame_profiler.SetEnabled(false);
+      s_finished = true;
+      s_on_finished();
+    }
+  });
+}
+
+static double ToMilliseconds(u64 ns)
+{
+  return ns / 1000000.0;
+}
+
+static void PrintRow(const char* name, const std::vector<u64>& values, u64 total_ns)
+{
+  u64 sum = 0;
+  for (const u64 value : values)
+    sum += value;
+
+  const auto [min, max] = std::minmax_element(values.begin(), values.end());
+  fmt::print("{:<20} {:>10.3f} {:>10.3f} {:>10.3f} {:>9.1f}%\n", name,
+             ToMilliseconds(sum / values.size()), ToMilliseconds(*min), ToMilliseconds(*max),
+             total_ns ? sum * 100.0 / total_ns : 0.0);
+}
+
+bool PrintReport()
+{
+  if (!s_finished)
+  {
+    fmt::print(stderr, "The FIFO benchmark did not finish.\n");
+    return false;
+  }
+
+  const double seconds = std::chrono::duration<double>(s_end_time - s_start_time).count();
+  fmt::print("Replayed the FIFO log {} times: {} frames in {:.3f} s ({:.1f} FPS)\n", s_loop_count,
+             s_frames.size(), seconds, seconds > 0 ? s_frames.size() / seconds : 0.0);
+
+  if (s_frames.empty())
+    return true;
+
+  std::vector<u64> frame_ns(s_frames.size());
+  std::transform(s_frames.begin(), s_frames.end(), frame_ns.begin(),
+                 [](const VideoCommon::FrameProfile& frame) { return frame.frame_ns; });
+  u64 total_ns = 0;
+  for (const u64 ns : frame_ns)
+    total_ns += ns;
+
+  fmt::print("\n{:<20} {:>10} {:>10} {:>10} {:>10}\n", "Per frame", "mean ms", "min ms", "max ms",
+             "share");
+
+  std::vector<u64> values(s_frames.size());
+  std::vector<u64> measured_ns(s_frames.size());
+  for (u32 phase = 0; phase < VideoCommon::FRAME_PROFILER_PHASE_COUNT; ++phase)
+  {
+    for (size_t i = 0; i < s_frames.size(); ++i)
+    {
+      values[i] = s_frames[i].phase_ns[phase];
+      measured_ns[i] += values[i];
+    }
+    const auto name =
+        VideoCommon::GetFrameProfilerPhaseName(static_cast<VideoCommon::FrameProfilerPhase>(phase));
+    PrintRow(name, values, total_ns);
+  }
+
+  PrintRow("Measured total", measured_ns, total_ns);
+  PrintRow("Frame time", frame_ns, total_ns);
+  return true;
+}
+}  // namespace FifoBenchmark
@@ -0,0 +1,25 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <functional>
+
+#include "Common/CommonTypes.h"
+
+namespace Core
+{
+class System;
+}
+
+// Replays a FIFO log as fast as possible and measures how much time the video front-end spends
+// on each frame. The first playback of the log is used to warm up caches and isn't measured.
+namespace FifoBenchmark
+{
+// Must be called before the FIFO log is booted. on_finished is called on the CPU thread once the
+// log has been replayed loop_count times after the warm-up.
+void Start(Core::System& system, u32 loop_count, std::function<void()> on_finished);
+
+// Prints the results to stdout. Returns false if the benchmark didn't finish.
+bool PrintReport();
+}  // namespace FifoBenchmark
@@ -4,11 +4,13 @@
 #include "DolphinNoGUI/Platform.h"
 
 #include <OptionParser.h>
+#include <algorithm>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <signal.h>
 #include <string>
+#include <variant>
 #include <vector>
 
 #ifndef _WIN32
@@ -26,6 +28,8 @@
 #include "Core/Host.h"
 #include "Core/System.h"
 
+#include "DolphinNoGUI/FifoBenchmark.h"
+
 #include "UICommon/CommandLineParse.h"
 #ifdef USE_DISCORD_PRESENCE
 #include "UICommon/DiscordPresence.h"
@@ -216,6 +220,12 @@ int main(int argc, char* argv[])
             "macos"
 #endif
       });
+  parser->add_option("--fifo-benchmark")
+      .action("store")
+      .metavar("<count>")
+      .type("int")
+      .help("Replay the given FIFO log this many times as fast as possible, then print how much "
+            "time the video front-end spent per frame");
 
   optparse::Values& options = CommandLineParse::ParseArguments(parser.get(), argc, argv);
   std::vector<std::string> args = parser->args();
@@ -262,6 +272,13 @@ int main(int argc, char* argv[])
     return 0;
   }
 
+  const bool fifo_benchmark = options.is_set("fifo_benchmark");
+  if (fifo_benchmark && !std::holds_alternative<BootParameters::DFF>(boot->parameters))
+  {
+    fprintf(stderr, "The FIFO benchmark requires a FIFO log (.dff) to be specified.\n");
+    return 1;
+  }
+
   std::string user_directory;
   if (options.is_set("user"))
     user_directory = static_cast<const char*>(options.get("user"));
@@ -310,6 +327,13 @@ int main(int argc, char* argv[])
 
   DolphinAnalytics::Instance().ReportDolphinStart("nogui");
 
+  if (fifo_benchmark)
+  {
+    const int loop_count = std::max(static_cast<int>(options.get("fifo_benchmark")), 1);
+    FifoBenchmark::Start(Core::System::GetInstance(), loop_count,
+                         [] { s_platform->RequestShutdown(); });
+  }
+
   if (!BootManager::BootCore(Core::System::GetInstance(), std::move(boot), wsi))
   {
     fprintf(stderr, "Could not boot the specified file\n");
@@ -326,6 +350,9 @@ int main(int argc, char* argv[])
   Core::Shutdown(Core::System::GetInstance());
   s_platform.reset();
 
+  if (fifo_benchmark && !FifoBenchmark::PrintReport())
+    return 1;
+
   return 0;
 }
 
@@ -36,6 +36,7 @@
 #include "Core/CheatSearch.h"
 #include "Core/ConfigManager.h"
 #include "Core/Core.h"
+#include "Core/HW/Memmap.h"
 #include "Core/PowerPC/PowerPC.h"
 #include "Core/System.h"
 
@@ -69,6 +70,8 @@ CheatSearchWidget::CheatSearchWidget(Core::System& system,
 
 CheatSearchWidget::~CheatSearchWidget()
 {
+  ClearSnapshotRows();
+
   auto& settings = Settings::GetQSettings();
   settings.setValue(QStringLiteral("cheatsearchwidget/displayhex"),
                     m_display_values_in_hex_checkbox->isChecked());
@@ -402,20 +405,60 @@ bool CheatSearchWidget::UpdateTableRows(const Core::CPUThreadGuard& guard, const
     return false;
   }
 
-  const bool show_in_hex = m_display_values_in_hex_checkbox->isChecked();
-  const size_t result_count_to_display = tmp->GetResultCount();
-  for (size_t i = 0; i < result_count_to_display; ++i)
-  {
-    m_address_table_current_values[tmp->GetResultAddress(i)] =
-        tmp->GetResultValueAsString(i, show_in_hex);
-  }
-
+  StoreCurrentValues(*tmp);
   RefreshGUICurrentValues(begin_index, end_index);
   if (update_status_text)
     m_info_label_1->setText(tr("Refreshed current values."));
   return true;
 }
 
+void CheatSearchWidget::UpdateTableRowsFromSnapshot(const Memory::MemorySnapshot::View& snapshot,
+                                                    const size_t begin_index,
+                                                    const size_t end_index)
+{
+  auto tmp = m_session->ClonePartial(begin_index, end_index);
+  if (!tmp->RefreshFromSnapshot(snapshot))
+    return;
+
+  StoreCurrentValues(*tmp);
+  RefreshGUICurrentValues(begin_index, end_index);
+}
+
+void CheatSearchWidget::StoreCurrentValues(const Cheats::CheatSearchSessionBase& results)
+{
+  const bool show_in_hex = m_display_values_in_hex_checkbox->isChecked();
+  const size_t result_count = results.GetResultCount();
+  for (size_t i = 0; i < result_count; ++i)
+  {
+    m_address_table_current_values[results.GetResultAddress(i)] =
+        results.GetResultValueAsString(i, show_in_hex);
+  }
+}
+
+void CheatSearchWidget::SetSnapshotRows(const int begin_index, const int end_index)
+{
+  if (begin_index == m_snapshot_rows_begin && end_index == m_snapshot_rows_end)
+    return;
+
+  ClearSnapshotRows();
+
+  auto& snapshot = m_system.GetMemory().GetSnapshot();
+  m_snapshot_ranges = m_session->AddSnapshotRanges(snapshot, begin_index, end_index);
+  m_snapshot_rows_begin = begin_index;
+  m_snapshot_rows_end = end_index;
+}
+
+void CheatSearchWidget::ClearSnapshotRows()
+{
+  auto& snapshot = m_system.GetMemory().GetSnapshot();
+  for (const Memory::MemorySnapshot::RangeID id : m_snapshot_ranges)
+    snapshot.RemoveRange(id);
+
+  m_snapshot_ranges.clear();
+  m_snapshot_rows_begin = -1;
+  m_snapshot_rows_end = -1;
+}
+
 void CheatSearchWidget::UpdateTableVisibleCurrentValues(const UpdateSource source)
 {
   if (source == UpdateSource::Auto && !m_autoupdate_current_values->isChecked())
@@ -424,8 +467,20 @@ void CheatSearchWidget::UpdateTableVisibleCurrentValues(const UpdateSource sourc
   if (m_address_table->rowCount() == 0)
     return;
 
-  UpdateTableRows(Core::CPUThreadGuard{m_system}, GetVisibleRowsBeginIndex(),
-                  GetVisibleRowsEndIndex(), source);
+  const int begin_index = GetVisibleRowsBeginIndex();
+  const int end_index = GetVisibleRowsEndIndex();
+  if (source == UpdateSource::Auto)
+  {
+    // Automatic updates happen every frame, so they only read the values from the memory snapshot
+    // and never pause emulation. If the snapshot can't copy these rows, e.g. because the data
+    // cache is emulated, the values are left as they are until the user refreshes them.
+    SetSnapshotRows(begin_index, end_index);
+    UpdateTableRowsFromSnapshot(m_system.GetMemory().GetSnapshot().Acquire(), begin_index,
+                                end_index);
+    return;
+  }
+
+  UpdateTableRows(Core::CPUThreadGuard{m_system}, begin_index, end_index, source);
 }
 
 bool CheatSearchWidget::UpdateTableAllCurrentValues(const UpdateSource source)
@@ -615,6 +670,8 @@ void CheatSearchWidget::RecreateGUITable()
 {
   const QSignalBlocker blocker(m_address_table);
 
+  ClearSnapshotRows();
+
   m_address_table->clear();
   m_address_table->setColumnCount(4);
   m_address_table->setHorizontalHeaderLabels(
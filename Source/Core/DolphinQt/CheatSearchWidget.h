@@ -75,6 +75,11 @@ private:
   void RefreshGUICurrentValues(size_t begin_index, size_t end_index);
   bool UpdateTableRows(const Core::CPUThreadGuard& guard, size_t begin_index, size_t end_index,
                        UpdateSource source);
+  void UpdateTableRowsFromSnapshot(const Memory::MemorySnapshot::View& snapshot,
+                                   size_t begin_index, size_t end_index);
+  void StoreCurrentValues(const Cheats::CheatSearchSessionBase& results);
+  void SetSnapshotRows(int begin_index, int end_index);
+  void ClearSnapshotRows();
   void RecreateGUITable();
   void GenerateARCodes();
   int GetVisibleRowsBeginIndex() const;
@@ -91,6 +96,11 @@ private:
   // this is intentionally NOT cleared when updating values or resetting or similar
   std::unordered_map<u32, CheatSearchTableUserData> m_address_table_user_data;
 
+  // The rows whose memory is registered with the memory snapshot.
+  std::vector<Memory::MemorySnapshot::RangeID> m_snapshot_ranges;
+  int m_snapshot_rows_begin = -1;
+  int m_snapshot_rows_end = -1;
+
   QComboBox* m_compare_type_dropdown;
   QComboBox* m_value_source_dropdown;
   QLineEdit* m_given_value_text;
@@ -20,6 +20,7 @@
 #include "DolphinQt/Config/ARCodeWidget.h"
 #include "DolphinQt/Config/GeckoCodeWidget.h"
 #include "DolphinQt/QtUtils/PartiallyClosableTabWidget.h"
+#include "DolphinQt/QtUtils/QueueOnObject.h"
 #include "DolphinQt/Settings.h"
 
 #include "VideoCommon/VideoEvents.h"
@@ -55,16 +56,25 @@ void CheatsManager::OnStateChanged(Core::State state)
 
 void CheatsManager::OnFrameEnd()
 {
-  if (!isVisible())
+  // This is called on the CPU thread. The table is updated on the GUI thread from the memory
+  // snapshot instead, so emulation doesn't wait for it; frames that end while an update is still
+  // queued are skipped.
+  if (m_frame_update_pending.exchange(true))
     return;
 
-  auto* const selected_cheat_search_widget =
-      qobject_cast<CheatSearchWidget*>(m_tab_widget->currentWidget());
-  if (selected_cheat_search_widget != nullptr)
-  {
-    selected_cheat_search_widget->UpdateTableVisibleCurrentValues(
-        CheatSearchWidget::UpdateSource::Auto);
-  }
+  QueueOnObject(this, [this] {
+    m_frame_update_pending = false;
+    if (!isVisible())
+      return;
+
+    auto* const selected_cheat_search_widget =
+        qobject_cast<CheatSearchWidget*>(m_tab_widget->currentWidget());
+    if (selected_cheat_search_widget != nullptr)
+    {
+      selected_cheat_search_widget->UpdateTableVisibleCurrentValues(
+          CheatSearchWidget::UpdateSource::Auto);
+    }
+  });
 }
 
 void CheatsManager::UpdateAllCheatSearchWidgetCurrentValues()
@@ -0,0 +1,132 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "DolphinTool/ShaderPackCommand.h"
+
+#include <cstdlib>
+#include <list>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <OptionParser.h>
+#include <fmt/format.h>
+#include <fmt/ostream.h>
+
+#include "Common/StringUtil.h"
+#include "VideoCommon/ShaderCachePack.h"
+
+namespace DolphinTool
+{
+static VideoCommon::ShaderCachePack::Result LoadInput(const std::string& path)
+{
+  std::string extension;
+  SplitPath(path, nullptr, nullptr, &extension);
+  Common::ToLower(&extension);
+
+  // UID caches are read as packs containing only their own kind of UID.
+  if (extension == ".uidcache" || extension == ".uberuidcache")
+    return VideoCommon::ShaderCachePack::ImportUIDCache(path);
+  return VideoCommon::ShaderCachePack::Load(path);
+}
+
+int ShaderPackCommand(const std::vector<std::string>& args)
+{
+  optparse::OptionParser parser;
+
+  parser.usage("usage: shaderpack [options]...\n\n"
+               "Validates shader cache packs (.dsp), and merges them together with the UID caches "
+               "(.uidcache, .uberuidcache) from the Cache folder of any number of users.");
+
+  parser.add_option("-i", "--input")
+      .type("string")
+      .action("append")
+      .help("Path to an input pack or UID cache. Can be given multiple times.")
+      .metavar("FILE");
+
+  parser.add_option("-o", "--output")
+      .type("string")
+      .action("store")
+      .help("Optional. Path to write the merged pack to. If not set, the inputs are only "
+            "validated.")
+      .metavar("FILE");
+
+  parser.add_option("-g", "--game_id")
+      .type("string")
+      .action("store")
+      .help("Optional. Game ID of the merged pack. If not set, all inputs must be for the same "
+            "game.");
+
+  optparse::Values& options = parser.parse_args(args);
+
+  // Validate options
+  const std::list<std::string>& input_file_paths = options.all("input");
+  if (input_file_paths.empty())
+  {
+    fmt::print(std::cerr, "Error: No input set\n");
+    return EXIT_FAILURE;
+  }
+
+  std::optional<VideoCommon::ShaderCachePack> merged;
+  if (options.is_set("game_id"))
+    merged.emplace(options["game_id"]);
+
+  bool all_valid = true;
+  size_t total_uids = 0;
+  for (const std::string& path : input_file_paths)
+  {
+    const VideoCommon::ShaderCachePack::Result pack = LoadInput(path);
+    if (!pack)
+    {
+      fmt::print(std::cerr, "Error: {}: {}\n", path,
+                 VideoCommon::ShaderCachePack::GetErrorString(pack.Error()));
+      all_valid = false;
+      continue;
+    }
+
+    fmt::print(std::cout, "{}: game {}, {} pipeline UIDs, {} ubershader pipeline UIDs\n", path,
+               pack->GetGameID(), pack->GetPipelineUIDs().size(),
+               pack->GetUberPipelineUIDs().size());
+    total_uids += pack->GetPipelineUIDs().size() + pack->GetUberPipelineUIDs().size();
+
+    if (!merged)
+    {
+      merged.emplace(pack->GetGameID());
+    }
+    else if (!options.is_set("game_id") && pack->GetGameID() != merged->GetGameID())
+    {
+      fmt::print(std::cerr, "Error: {} is for game {}, but the previous inputs are for {}\n", path,
+                 pack->GetGameID(), merged->GetGameID());
+      all_valid = false;
+      continue;
+    }
+
+    merged->Merge(*pack);
+  }
+
+  if (!all_valid)
+    return EXIT_FAILURE;
+
+  const size_t merged_uids =
+      merged->GetPipelineUIDs().size() + merged->GetUberPipelineUIDs().size();
+  if (input_file_paths.size() > 1)
+  {
+    fmt::print(std::cout, "Merged: {} pipeline UIDs, {} ubershader pipeline UIDs, {} duplicates\n",
+               merged->GetPipelineUIDs().size(), merged->GetUberPipelineUIDs().size(),
+               total_uids - merged_uids);
+  }
+
+  if (!options.is_set("output"))
+    return EXIT_SUCCESS;
+
+  const std::string& output_file_path = options["output"];
+  if (!merged->Save(output_file_path))
+  {
+    fmt::print(std::cerr, "Error: Failed to write {}\n", output_file_path);
+    return EXIT_FAILURE;
+  }
+
+  fmt::print(std::cout, "Wrote {} for game {}\n", output_file_path, merged->GetGameID());
+  return EXIT_SUCCESS;
+}
+}  // namespace DolphinTool
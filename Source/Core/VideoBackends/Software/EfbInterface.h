@@ -58,5 +58,6 @@ void EncodeXFB(u8* xfb_in_ram, u32 memory_stride, const MathUtil::Rectangle<int>
 
 u32 GetPerfQueryResult(PerfQueryType type);
 void ResetPerfQuery();
-void IncPerfCounterQuadCount(PerfQueryType type);
+// Counts the given number of pixels towards the given perf query.
+void AddPerfCounterQuadCount(PerfQueryType type, u32 count);
 }  // namespace EfbInterface
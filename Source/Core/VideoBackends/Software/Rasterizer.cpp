@@ -4,11 +4,15 @@
 #include "VideoBackends/Software/Rasterizer.h"
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstring>
+#include <memory>
 #include <vector>
 
 #include "Common/Assert.h"
 #include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
 
 #include "VideoBackends/Software/EfbInterface.h"
 #include "VideoBackends/Software/NativeVertexFormat.h"
@@ -96,21 +100,98 @@ struct Slope
   }
 };
 
-static Slope ZSlope;
-static Slope WSlope;
-static Slope ColorSlopes[2][4];
-static Slope TexSlopes[8][3];
+// The EFB is split into tiles of this size when rasterizing on several threads. Each tile is only
+// ever drawn by one thread, which processes the triangles overlapping it in the order they were
+// submitted, so the result is exactly the same as drawing all triangles one after another.
+static constexpr s32 TILE_SIZE = 32;
+static constexpr s32 TILES_X = (EFB_WIDTH + TILE_SIZE - 1) / TILE_SIZE;
+static constexpr s32 TILES_Y = (EFB_HEIGHT + TILE_SIZE - 1) / TILE_SIZE;
+static_assert(TILE_SIZE % BLOCK_SIZE == 0, "Blocks must not cross tiles");
+
+// Batches whose triangles cover fewer pixels than this are drawn on the GPU thread only, since
+// waking up the workers would take longer than drawing.
+static constexpr s64 MIN_PARALLEL_PIXELS = 16 * 1024;
+
+// Everything needed to rasterize a triangle within one scissor rectangle. This is computed when the
+// triangle is submitted, so that it can be drawn later on any thread.
+struct TriangleSetup
+{
+  Slope ZSlope;
+  Slope WSlope;
+  Slope ColorSlopes[2][4];
+  Slope TexSlopes[8][3];
+
+  // Bounding rectangle, clipped to the scissor rectangle
+  s32 minx;
+  s32 maxx;
+  s32 miny;
+  s32 maxy;
+
+  // Deltas and half-edge constants, in 28.4 fixed point
+  s32 DX12;
+  s32 DX23;
+  s32 DX31;
+  s32 DY12;
+  s32 DY23;
+  s32 DY31;
+  s32 C1;
+  s32 C2;
+  s32 C3;
+};
 
-static Tev tev;
-static RasterBlock rasterBlock;
+// Per-thread drawing state.
+struct DrawContext
+{
+  Tev tev;
+  RasterBlock rasterBlock;
+};
+
+static Slope ZSlope;
 
 static std::vector<BPFunctions::ScissorRect> scissors;
 
+// Index 0 is used by the GPU thread, the others by the workers with the same index.
+static std::vector<std::unique_ptr<DrawContext>> drawContexts;
+static Common::WorkerPool workers;
+
+// Triangles of the current batch, and for each tile the indices of the triangles overlapping it.
+static std::vector<TriangleSetup> binnedTriangles;
+static std::array<std::vector<u32>, TILES_X * TILES_Y> tileBins;
+static std::vector<u32> usedTiles;
+static s64 binnedPixels = 0;
+
+static void ResizeWorkers(u32 worker_count)
+{
+  if (!drawContexts.empty() && workers.GetWorkerCount() == worker_count)
+    return;
+
+  workers.Reset("Software Rasterizer", worker_count);
+  drawContexts.resize(worker_count + 1);
+  for (auto& context : drawContexts)
+  {
+    if (!context)
+      context = std::make_unique<DrawContext>();
+  }
+}
+
 void Init()
 {
   // The other slopes are set each for each primitive drawn, but zfreeze means that the z slope
   // needs to be set to an (untested) default value.
   ZSlope = Slope();
+
+  ResizeWorkers(g_ActiveConfig.GetSWRasterizerThreads());
+}
+
+void Shutdown()
+{
+  workers.Shutdown();
+  drawContexts.clear();
+  binnedTriangles.clear();
+  for (std::vector<u32>& bin : tileBins)
+    bin.clear();
+  usedTiles.clear();
+  binnedPixels = 0;
 }
 
 void ScissorChanged()
@@ -140,31 +221,37 @@ static inline int iround(float x)
   return t;
 }
 
-void SetTevKonstColors()
+void SetupTev()
 {
-  tev.SetKonstColors();
+  for (auto& context : drawContexts)
+  {
+    context->tev.SetKonstColors();
+    context->tev.SetupStages();
+  }
 }
 
-static void Draw(s32 x, s32 y, s32 xi, s32 yi)
+static void Draw(DrawContext& context, const TriangleSetup& triangle, s32 x, s32 y, s32 xi, s32 yi)
 {
-  INCSTAT(g_stats.this_frame.rasterized_pixels);
+  Tev& tev = context.tev;
+  tev.IncRasterizedPixels();
 
-  s32 z = (s32)std::clamp<float>(ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
+  s32 z = (s32)std::clamp<float>(triangle.ZSlope.GetValue(x, y), 0.0f, 16777215.0f);
 
   if (bpmem.GetEmulatedZ() == EmulatedZ::Early)
   {
     // TODO: Test if perf regs are incremented even if test is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
+    tev.IncPerfCounterQuadCount(PQ_ZCOMP_INPUT_ZCOMPLOC);
     if (bpmem.zmode.testenable)
     {
       // early z
       if (!EfbInterface::ZCompare(x, y, z))
         return;
     }
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
+    tev.IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT_ZCOMPLOC);
   }
 
-  RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
+  const RasterBlock& rasterBlock = context.rasterBlock;
+  const RasterBlockPixel& pixel = rasterBlock.Pixel[xi][yi];
 
   tev.Position[0] = x;
   tev.Position[1] = y;
@@ -175,7 +262,7 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   {
     for (int comp = 0; comp < 4; comp++)
     {
-      u16 color = (u16)ColorSlopes[i][comp].GetValue(x, y);
+      u16 color = (u16)triangle.ColorSlopes[i][comp].GetValue(x, y);
 
       // clamp color value to 0
       u16 mask = ~(color >> 8);
@@ -207,7 +294,8 @@ static void Draw(s32 x, s32 y, s32 xi, s32 yi)
   tev.Draw();
 }
 
-static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoord)
+static inline void CalculateLOD(const RasterBlock& rasterBlock, s32* lodp, bool* linear, u32 texmap,
+                                u32 texcoord)
 {
   auto texUnit = bpmem.tex.GetUnit(texmap);
 
@@ -218,9 +306,9 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
 
   float sDelta, tDelta;
 
-  float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
-  float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
-  float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
+  const float* uv00 = rasterBlock.Pixel[0][0].Uv[texcoord];
+  const float* uv10 = rasterBlock.Pixel[1][0].Uv[texcoord];
+  const float* uv01 = rasterBlock.Pixel[0][1].Uv[texcoord];
 
   float dudx = fabsf(uv00[0] - uv10[0]);
   float dvdx = fabsf(uv00[1] - uv10[1]);
@@ -258,7 +346,8 @@ static inline void CalculateLOD(s32* lodp, bool* linear, u32 texmap, u32 texcoor
   *lodp = lod;
 }
 
-static void BuildBlock(s32 blockX, s32 blockY)
+static void BuildBlock(RasterBlock& rasterBlock, const TriangleSetup& triangle, s32 blockX,
+                       s32 blockY)
 {
   for (s32 yi = 0; yi < BLOCK_SIZE; yi++)
   {
@@ -269,19 +358,19 @@ static void BuildBlock(s32 blockX, s32 blockY)
       s32 x = xi + blockX;
       s32 y = yi + blockY;
 
-      float invW = 1.0f / WSlope.GetValue(x, y);
+      float invW = 1.0f / triangle.WSlope.GetValue(x, y);
       pixel.InvW = invW;
 
       // tex coords
       for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
       {
         float projection = invW;
-        float q = TexSlopes[i][2].GetValue(x, y) * invW;
+        float q = triangle.TexSlopes[i][2].GetValue(x, y) * invW;
         if (q != 0.0f)
           projection = invW / q;
 
-        pixel.Uv[i][0] = TexSlopes[i][0].GetValue(x, y) * projection;
-        pixel.Uv[i][1] = TexSlopes[i][1].GetValue(x, y) * projection;
+        pixel.Uv[i][0] = triangle.TexSlopes[i][0].GetValue(x, y) * projection;
+        pixel.Uv[i][1] = triangle.TexSlopes[i][1].GetValue(x, y) * projection;
       }
     }
   }
@@ -291,7 +380,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
     u32 texmap = bpmem.tevindref.getTexMap(i);
     u32 texcoord = bpmem.tevindref.getTexCoord(i);
 
-    CalculateLOD(&rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap, texcoord);
+    CalculateLOD(rasterBlock, &rasterBlock.IndirectLod[i], &rasterBlock.IndirectLinear[i], texmap,
+                 texcoord);
   }
 
   for (unsigned int i = 0; i <= bpmem.genMode.numtevstages; i++)
@@ -303,7 +393,8 @@ static void BuildBlock(s32 blockX, s32 blockY)
       u32 texmap = order.getTexMap(stageOdd);
       u32 texcoord = order.getTexCoord(stageOdd);
 
-      CalculateLOD(&rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap, texcoord);
+      CalculateLOD(rasterBlock, &rasterBlock.TextureLod[i], &rasterBlock.TextureLinear[i], texmap,
+                   texcoord);
     }
   }
 }
@@ -320,9 +411,10 @@ void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
   }
 }
 
-static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
-                                  const OutputVertexData* v2,
-                                  const BPFunctions::ScissorRect& scissor)
+// Returns false if the triangle doesn't cover any pixels within the scissor rectangle.
+static bool SetupTriangle(const OutputVertexData* v0, const OutputVertexData* v1,
+                          const OutputVertexData* v2, const BPFunctions::ScissorRect& scissor,
+                          TriangleSetup* triangle)
 {
   // The zslope should be updated now, even if the triangle is rejected by the scissor test, as
   // zfreeze depends on it
@@ -349,15 +441,6 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   const s32 DY23 = Y2 - Y3;
   const s32 DY31 = Y3 - Y1;
 
-  // Fixed-point deltas
-  const s32 FDX12 = DX12 * 16;
-  const s32 FDX23 = DX23 * 16;
-  const s32 FDX31 = DX31 * 16;
-
-  const s32 FDY12 = DY12 * 16;
-  const s32 FDY23 = DY23 * 16;
-  const s32 FDY31 = DY31 * 16;
-
   // Bounding rectangle
   s32 minx = (std::min(std::min(X1, X2), X3) + 0xF) >> 4;
   s32 maxx = (std::max(std::max(X1, X2), X3) + 0xF) >> 4;
@@ -376,28 +459,34 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   maxy = std::min(maxy, scissor.rect.bottom);
 
   if (minx >= maxx || miny >= maxy)
-    return;
+    return false;
 
   // Set up the remaining slopes
   const SlopeContext ctx(v0, v1, v2, (X1 + 0xF) >> 4, (Y1 + 0xF) >> 4, scissor.x_off,
                          scissor.y_off);
 
+  triangle->ZSlope = ZSlope;
+
   float w[3] = {1.0f / v0->projectedPosition.w, 1.0f / v1->projectedPosition.w,
                 1.0f / v2->projectedPosition.w};
-  WSlope = Slope(w[0], w[1], w[2], ctx);
+  triangle->WSlope = Slope(w[0], w[1], w[2], ctx);
 
   for (unsigned int i = 0; i < bpmem.genMode.numcolchans; i++)
   {
     for (int comp = 0; comp < 4; comp++)
-      ColorSlopes[i][comp] = Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    {
+      triangle->ColorSlopes[i][comp] =
+          Slope(v0->color[i][comp], v1->color[i][comp], v2->color[i][comp], ctx);
+    }
   }
 
   for (unsigned int i = 0; i < bpmem.genMode.numtexgens; i++)
   {
     for (int comp = 0; comp < 3; comp++)
     {
-      TexSlopes[i][comp] = Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
-                                 v2->texCoords[i][comp] * w[2], ctx);
+      triangle->TexSlopes[i][comp] =
+          Slope(v0->texCoords[i][comp] * w[0], v1->texCoords[i][comp] * w[1],
+                v2->texCoords[i][comp] * w[2], ctx);
     }
   }
 
@@ -414,6 +503,56 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   if (DY31 < 0 || (DY31 == 0 && DX31 > 0))
     C3++;
 
+  triangle->minx = minx;
+  triangle->maxx = maxx;
+  triangle->miny = miny;
+  triangle->maxy = maxy;
+  triangle->DX12 = DX12;
+  triangle->DX23 = DX23;
+  triangle->DX31 = DX31;
+  triangle->DY12 = DY12;
+  triangle->DY23 = DY23;
+  triangle->DY31 = DY31;
+  triangle->C1 = C1;
+  triangle->C2 = C2;
+  triangle->C3 = C3;
+  return true;
+}
+
+// Draws the part of the triangle which lies within the given rectangle. The rectangle must be
+// aligned to blocks, so that every block is drawn the same way no matter how the EFB is split up.
+static void DrawTriangle(DrawContext& context, const TriangleSetup& triangle, s32 left, s32 right,
+                         s32 top, s32 bottom)
+{
+  const s32 minx = std::max(triangle.minx, left);
+  const s32 maxx = std::min(triangle.maxx, right);
+  const s32 miny = std::max(triangle.miny, top);
+  const s32 maxy = std::min(triangle.maxy, bottom);
+
+  if (minx >= maxx || miny >= maxy)
+    return;
+
+  const s32 DX12 = triangle.DX12;
+  const s32 DX23 = triangle.DX23;
+  const s32 DX31 = triangle.DX31;
+
+  const s32 DY12 = triangle.DY12;
+  const s32 DY23 = triangle.DY23;
+  const s32 DY31 = triangle.DY31;
+
+  // Fixed-point deltas
+  const s32 FDX12 = DX12 * 16;
+  const s32 FDX23 = DX23 * 16;
+  const s32 FDX31 = DX31 * 16;
+
+  const s32 FDY12 = DY12 * 16;
+  const s32 FDY23 = DY23 * 16;
+  const s32 FDY31 = DY31 * 16;
+
+  const s32 C1 = triangle.C1;
+  const s32 C2 = triangle.C2;
+  const s32 C3 = triangle.C3;
+
   // Start in corner of 2x2 block
   s32 block_minx = minx & ~(BLOCK_SIZE - 1);
   s32 block_miny = miny & ~(BLOCK_SIZE - 1);
@@ -455,7 +594,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
       if (a == 0x0 || b == 0x0 || c == 0x0)
         continue;
 
-      BuildBlock(x, y);
+      BuildBlock(context.rasterBlock, triangle, x, y);
 
       // Accept whole block when totally covered
       // We still need to check min/max x/y because of the scissor
@@ -465,7 +604,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
         {
           for (s32 ix = 0; ix < BLOCK_SIZE; ix++)
           {
-            Draw(x + ix, y + iy, ix, iy);
+            Draw(context, triangle, x + ix, y + iy, ix, iy);
           }
         }
       }
@@ -488,7 +627,7 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
               // This check enforces the scissor rectangle, since it might not be aligned with the
               // blocks
               if (x + ix >= minx && x + ix < maxx && y + iy >= miny && y + iy < maxy)
-                Draw(x + ix, y + iy, ix, iy);
+                Draw(context, triangle, x + ix, y + iy, ix, iy);
             }
 
             CX1 -= FDY12;
@@ -505,12 +644,85 @@ static void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertex
   }
 }
 
+static void BinTriangle(const TriangleSetup& triangle)
+{
+  const u32 index = static_cast<u32>(binnedTriangles.size());
+  binnedTriangles.push_back(triangle);
+  binnedPixels += s64(triangle.maxx - triangle.minx) * (triangle.maxy - triangle.miny);
+
+  for (s32 tile_y = triangle.miny / TILE_SIZE; tile_y <= (triangle.maxy - 1) / TILE_SIZE; tile_y++)
+  {
+    for (s32 tile_x = triangle.minx / TILE_SIZE; tile_x <= (triangle.maxx - 1) / TILE_SIZE;
+         tile_x++)
+    {
+      const u32 tile = tile_y * TILES_X + tile_x;
+      if (tileBins[tile].empty())
+        usedTiles.push_back(tile);
+      tileBins[tile].push_back(index);
+    }
+  }
+}
+
+static void DrawTile(DrawContext& context, u32 tile)
+{
+  const s32 left = (tile % TILES_X) * TILE_SIZE;
+  const s32 top = (tile / TILES_X) * TILE_SIZE;
+
+  for (const u32 index : tileBins[tile])
+    DrawTriangle(context, binnedTriangles[index], left, left + TILE_SIZE, top, top + TILE_SIZE);
+}
+
+static void DrawBinnedTriangles()
+{
+  if (binnedPixels < MIN_PARALLEL_PIXELS)
+  {
+    for (const u32 tile : usedTiles)
+      DrawTile(*drawContexts[0], tile);
+  }
+  else
+  {
+    std::atomic<size_t> next_tile = 0;
+    workers.Run([&](u32 worker) {
+      DrawContext& context = *drawContexts[worker];
+      for (size_t i = next_tile++; i < usedTiles.size(); i = next_tile++)
+        DrawTile(context, usedTiles[i]);
+    });
+  }
+
+  for (const u32 tile : usedTiles)
+    tileBins[tile].clear();
+  usedTiles.clear();
+  binnedTriangles.clear();
+  binnedPixels = 0;
+}
+
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2)
 {
   INCSTAT(g_stats.this_frame.num_triangles_drawn);
 
   for (const auto& scissor : scissors)
-    DrawTriangleFrontFace(v0, v1, v2, scissor);
+  {
+    TriangleSetup triangle;
+    if (!SetupTriangle(v0, v1, v2, scissor, &triangle))
+      continue;
+
+    if (workers.GetWorkerCount() == 0)
+      DrawTriangle(*drawContexts[0], triangle, 0, EFB_WIDTH, 0, EFB_HEIGHT);
+    else
+      BinTriangle(triangle);
+  }
+}
+
+void Flush()
+{
+  if (!binnedTriangles.empty())
+    DrawBinnedTriangles();
+
+  for (auto& context : drawContexts)
+    context->tev.FlushCounters();
+
+  // Pick up changes to the thread count between batches, when no triangles are pending.
+  ResizeWorkers(g_ActiveConfig.GetSWRasterizerThreads());
 }
 }  // namespace Rasterizer
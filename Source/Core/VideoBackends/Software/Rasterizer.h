@@ -10,14 +10,18 @@ struct OutputVertexData;
 namespace Rasterizer
 {
 void Init();
+void Shutdown();
 void ScissorChanged();
 
 void UpdateZSlope(const OutputVertexData* v0, const OutputVertexData* v1,
                   const OutputVertexData* v2, s32 x_off, s32 y_off);
+// Triangles may be queued up and drawn on several threads. Flush() must be called before anything
+// else accesses the EFB, and before any state which affects drawing changes.
 void DrawTriangleFrontFace(const OutputVertexData* v0, const OutputVertexData* v1,
                            const OutputVertexData* v2);
+void Flush();
 
-void SetTevKonstColors();
+void SetupTev();
 
 struct RasterBlockPixel
 {
@@ -104,16 +104,23 @@ bool VideoSoftware::Initialize(const WindowSystemInfo& wsi)
     return false;
 
   Clipper::Init();
-  Rasterizer::Init();
 
-  return InitializeShared(std::make_unique<SWGfx>(std::move(window)),
-                          std::make_unique<SWVertexLoader>(), std::make_unique<PerfQuery>(),
-                          std::make_unique<SWBoundingBox>(), std::make_unique<SWRenderer>(),
-                          std::make_unique<TextureCache>());
+  if (!InitializeShared(std::make_unique<SWGfx>(std::move(window)),
+                        std::make_unique<SWVertexLoader>(), std::make_unique<PerfQuery>(),
+                        std::make_unique<SWBoundingBox>(), std::make_unique<SWRenderer>(),
+                        std::make_unique<TextureCache>()))
+  {
+    return false;
+  }
+
+  // The rasterizer sizes its workers from the active config, which InitializeShared() sets up.
+  Rasterizer::Init();
+  return true;
 }
 
 void VideoSoftware::Shutdown()
 {
+  Rasterizer::Shutdown();
   ShutdownShared();
 }
 }  // namespace SW
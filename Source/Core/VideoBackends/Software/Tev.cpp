@@ -7,6 +7,10 @@
 #include <cmath>
 #include <cstring>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/ChunkFile.h"
 #include "Common/CommonTypes.h"
 
@@ -33,14 +37,14 @@ static inline s16 Clamp1024(s16 in)
   return std::clamp<s16>(in, -1024, 1023);
 }
 
-void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
+void Tev::SetRasColor(RasColorChan colorChan,
+                      const Common::EnumMap<ColorChannel, ColorChannel::Alpha>& swap)
 {
   switch (colorChan)
   {
   case RasColorChan::Color0:
   {
     const u8* color = Color[0];
-    const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
     RasColor.r = color[u32(swap[ColorChannel::Red])];
     RasColor.g = color[u32(swap[ColorChannel::Green])];
     RasColor.b = color[u32(swap[ColorChannel::Blue])];
@@ -50,7 +54,6 @@ void Tev::SetRasColor(RasColorChan colorChan, u32 swaptable)
   case RasColorChan::Color1:
   {
     const u8* color = Color[1];
-    const auto& swap = bpmem.tevksel.GetSwapTable(swaptable);
     RasColor.r = color[u32(swap[ColorChannel::Red])];
     RasColor.g = color[u32(swap[ColorChannel::Green])];
     RasColor.b = color[u32(swap[ColorChannel::Blue])];
@@ -192,6 +195,181 @@ void Tev::DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const Inpu
     Reg[ac.dest].a = inputs[ALP_C].d + ((a == b) ? inputs[ALP_C].c : 0);
 }
 
+#if defined(_M_X86_64)
+void Tev::SetupCombinerConstants(const TevStageCombiner::ColorCombiner& cc,
+                                 const TevStageCombiner::AlphaCombiner& ac,
+                                 CombinerConstants* constants)
+{
+  const auto set_lanes = [](auto& lanes, auto alpha, auto color) {
+    lanes[ALP_C] = alpha;
+    lanes[BLU_C] = color;
+    lanes[GRN_C] = color;
+    lanes[RED_C] = color;
+  };
+  const auto rounding = [](TevScale scale, TevOp op) -> s32 {
+    return scale == TevScale::Divide2 ? 0 : op == TevOp::Sub ? 127 : 128;
+  };
+
+  *constants = {};
+  set_lanes(constants->scale, s16(1 << s_ScaleLShiftLUT[ac.scale]),
+            s16(1 << s_ScaleLShiftLUT[cc.scale]));
+  set_lanes(constants->bias, s_BiasLUT[ac.bias], s_BiasLUT[cc.bias]);
+  set_lanes(constants->min, s16(ac.clamp ? 0 : -1024), s16(cc.clamp ? 0 : -1024));
+  set_lanes(constants->max, s16(ac.clamp ? 255 : 1023), s16(cc.clamp ? 255 : 1023));
+  set_lanes(constants->rounding, rounding(ac.scale, ac.op), rounding(cc.scale, cc.op));
+
+  // Subtraction negates alpha before the shift, but color after it
+  set_lanes(constants->negate_before, ac.op == TevOp::Sub ? -1 : 0, 0);
+  set_lanes(constants->negate_after, 0, cc.op == TevOp::Sub ? -1 : 0);
+  set_lanes(constants->halve, s_ScaleRShiftLUT[ac.scale] ? -1 : 0,
+            s_ScaleRShiftLUT[cc.scale] ? -1 : 0);
+}
+
+// Evaluates the regular color and alpha combiners of a stage together, one channel per lane in
+// TevColor order (alpha, blue, green, red). Gives exactly the same results as DrawColorRegular and
+// DrawAlphaRegular followed by clamping.
+void Tev::DrawRegularSSE2(const StageState& stage)
+{
+  const TevStageCombiner::ColorCombiner& cc = stage.cc;
+  const TevStageCombiner::AlphaCombiner& ac = stage.ac;
+  const CombinerConstants& constants = stage.constants;
+  const auto load = [](const auto& lanes) {
+    return _mm_load_si128(reinterpret_cast<const __m128i*>(lanes));
+  };
+
+  const TevColorRef& color_a = m_ColorInputLUT[cc.a];
+  const TevColorRef& color_b = m_ColorInputLUT[cc.b];
+  const TevColorRef& color_c = m_ColorInputLUT[cc.c];
+  const TevColorRef& color_d = m_ColorInputLUT[cc.d];
+
+  // Same widths as InputRegType: a, b and c are 8 bits wide, d is 11 bits wide
+  const __m128i mask = _mm_set1_epi16(0xff);
+  const __m128i a = _mm_and_si128(
+      _mm_setr_epi16(m_AlphaInputLUT[ac.a].a, color_a.b, color_a.g, color_a.r, 0, 0, 0, 0), mask);
+  const __m128i b = _mm_and_si128(
+      _mm_setr_epi16(m_AlphaInputLUT[ac.b].a, color_b.b, color_b.g, color_b.r, 0, 0, 0, 0), mask);
+  __m128i c = _mm_and_si128(
+      _mm_setr_epi16(m_AlphaInputLUT[ac.c].a, color_c.b, color_c.g, color_c.r, 0, 0, 0, 0), mask);
+  __m128i d =
+      _mm_setr_epi16(m_AlphaInputLUT[ac.d].a, color_d.b, color_d.g, color_d.r, 0, 0, 0, 0);
+  d = _mm_srai_epi16(_mm_slli_epi16(d, 5), 5);
+
+  const __m128i scale = load(constants.scale);
+
+  // temp = (a * (256 - c) + b * c) << lshift, with the shift folded into the weights
+  c = _mm_add_epi16(c, _mm_srli_epi16(c, 7));
+  const __m128i weights =
+      _mm_mullo_epi16(_mm_unpacklo_epi16(_mm_sub_epi16(_mm_set1_epi16(256), c), c),
+                      _mm_unpacklo_epi16(scale, scale));
+  __m128i temp = _mm_madd_epi16(_mm_unpacklo_epi16(a, b), weights);
+  temp = _mm_add_epi32(temp, load(constants.rounding));
+
+  const __m128i negate_before = load(constants.negate_before);
+  const __m128i negate_after = load(constants.negate_after);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_before), negate_before);
+  temp = _mm_srai_epi32(temp, 8);
+  temp = _mm_sub_epi32(_mm_xor_si128(temp, negate_after), negate_after);
+
+  // result = (((d + bias) << lshift) + temp) >> rshift
+  __m128i result = _mm_mullo_epi16(_mm_add_epi16(d, load(constants.bias)), scale);
+  result = _mm_srai_epi32(_mm_unpacklo_epi16(result, result), 16);
+  result = _mm_add_epi32(result, temp);
+
+  const __m128i halve = load(constants.halve);
+  result = _mm_or_si128(_mm_and_si128(halve, _mm_srai_epi32(result, 1)),
+                        _mm_andnot_si128(halve, result));
+
+  // The results are well within 16 bits, so packing doesn't saturate
+  result = _mm_min_epi16(
+      _mm_max_epi16(_mm_packs_epi32(result, result), load(constants.min)), load(constants.max));
+
+  alignas(16) s16 output[8];
+  _mm_store_si128(reinterpret_cast<__m128i*>(output), result);
+  Reg[cc.dest].r = output[RED_C];
+  Reg[cc.dest].g = output[GRN_C];
+  Reg[cc.dest].b = output[BLU_C];
+  Reg[ac.dest].a = output[ALP_C];
+}
+#endif
+
+void Tev::SetupCombiners(const TevStageCombiner::ColorCombiner& cc,
+                         const TevStageCombiner::AlphaCombiner& ac, StageState* stage)
+{
+  stage->cc.hex = cc.hex;
+  stage->ac.hex = ac.hex;
+
+#if defined(_M_X86_64)
+  stage->regular = cc.bias != TevBias::Compare && ac.bias != TevBias::Compare;
+  if (stage->regular)
+    SetupCombinerConstants(cc, ac, &stage->constants);
+#endif
+}
+
+void Tev::Combine(const StageState& stage)
+{
+#if defined(_M_X86_64)
+  if (stage.regular)
+  {
+    DrawRegularSSE2(stage);
+    return;
+  }
+#endif
+
+  CombineScalar(stage);
+}
+
+void Tev::CombineScalar(const StageState& stage)
+{
+  const TevStageCombiner::ColorCombiner& cc = stage.cc;
+  const TevStageCombiner::AlphaCombiner& ac = stage.ac;
+
+  InputRegType inputs[4];
+  inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
+  inputs[BLU_C].b = m_ColorInputLUT[cc.b].b;
+  inputs[BLU_C].c = m_ColorInputLUT[cc.c].b;
+  inputs[BLU_C].d = m_ColorInputLUT[cc.d].b;
+  inputs[GRN_C].a = m_ColorInputLUT[cc.a].g;
+  inputs[GRN_C].b = m_ColorInputLUT[cc.b].g;
+  inputs[GRN_C].c = m_ColorInputLUT[cc.c].g;
+  inputs[GRN_C].d = m_ColorInputLUT[cc.d].g;
+  inputs[RED_C].a = m_ColorInputLUT[cc.a].r;
+  inputs[RED_C].b = m_ColorInputLUT[cc.b].r;
+  inputs[RED_C].c = m_ColorInputLUT[cc.c].r;
+  inputs[RED_C].d = m_ColorInputLUT[cc.d].r;
+  inputs[ALP_C].a = m_AlphaInputLUT[ac.a].a;
+  inputs[ALP_C].b = m_AlphaInputLUT[ac.b].a;
+  inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
+  inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
+
+  if (cc.bias != TevBias::Compare)
+    DrawColorRegular(cc, inputs);
+  else
+    DrawColorCompare(cc, inputs);
+
+  if (cc.clamp)
+  {
+    Reg[cc.dest].r = Clamp255(Reg[cc.dest].r);
+    Reg[cc.dest].g = Clamp255(Reg[cc.dest].g);
+    Reg[cc.dest].b = Clamp255(Reg[cc.dest].b);
+  }
+  else
+  {
+    Reg[cc.dest].r = Clamp1024(Reg[cc.dest].r);
+    Reg[cc.dest].g = Clamp1024(Reg[cc.dest].g);
+    Reg[cc.dest].b = Clamp1024(Reg[cc.dest].b);
+  }
+
+  if (ac.bias != TevBias::Compare)
+    DrawAlphaRegular(ac, inputs);
+  else
+    DrawAlphaCompare(ac, inputs);
+
+  if (ac.clamp)
+    Reg[ac.dest].a = Clamp255(Reg[ac.dest].a);
+  else
+    Reg[ac.dest].a = Clamp1024(Reg[ac.dest].a);
+}
+
 static bool AlphaCompare(int alpha, int ref, CompareMode comp)
 {
   switch (comp)
@@ -386,71 +564,20 @@ void Tev::Indirect(unsigned int stageNum, s32 s, s32 t)
   }
 }
 
-void Tev::Draw()
+void Tev::RunStages()
 {
-  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
-  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
-
-  INCSTAT(g_stats.this_frame.tev_pixels_in);
-
-  auto& system = Core::System::GetInstance();
-  auto& pixel_shader_manager = system.GetPixelShaderManager();
-
   // initial color values
   for (int i = 0; i < 4; i++)
-  {
-    Reg[static_cast<TevOutput>(i)].r = pixel_shader_manager.constants.colors[i][0];
-    Reg[static_cast<TevOutput>(i)].g = pixel_shader_manager.constants.colors[i][1];
-    Reg[static_cast<TevOutput>(i)].b = pixel_shader_manager.constants.colors[i][2];
-    Reg[static_cast<TevOutput>(i)].a = pixel_shader_manager.constants.colors[i][3];
-  }
-
-  for (unsigned int stageNum = 0; stageNum < bpmem.genMode.numindstages; stageNum++)
-  {
-    const int stageNum2 = stageNum >> 1;
-    const int stageOdd = stageNum & 1;
-
-    u32 texcoordSel = bpmem.tevindref.getTexCoord(stageNum);
-    const u32 texmap = bpmem.tevindref.getTexMap(stageNum);
+    Reg[static_cast<TevOutput>(i)] = m_initial_colors[i];
 
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    // This affects the Mario portrait in Luigi's Mansion, where the developers forgot to set
-    // the number of tex gens to 2 (bug 11462).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
-
-    const TEXSCALE& texscale = bpmem.texscale[stageNum2];
-    const s32 scaleS = stageOdd ? texscale.ss1 : texscale.ss0;
-    const s32 scaleT = stageOdd ? texscale.ts1 : texscale.ts0;
-
-    TextureSampler::Sample(Uv[texcoordSel].s >> scaleS, Uv[texcoordSel].t >> scaleT,
-                           IndirectLod[stageNum], IndirectLinear[stageNum], texmap,
-                           IndirectTex[stageNum]);
-  }
-
-  for (unsigned int stageNum = 0; stageNum <= bpmem.genMode.numtevstages; stageNum++)
+  for (u32 stageNum = 0; stageNum < m_num_tev_stages; stageNum++)
   {
-    const int stageNum2 = stageNum >> 1;
-    const int stageOdd = stageNum & 1;
-    const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
+    const StageState& stage = m_stages[stageNum];
 
-    // stage combiners
-    const TevStageCombiner::ColorCombiner& cc = bpmem.combiners[stageNum].colorC;
-    const TevStageCombiner::AlphaCombiner& ac = bpmem.combiners[stageNum].alphaC;
-
-    u32 texcoordSel = order.getTexCoord(stageOdd);
-    const u32 texmap = order.getTexMap(stageOdd);
-
-    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
-    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
-    if (texcoordSel >= bpmem.genMode.numtexgens)
-      texcoordSel = 0;
-
-    Indirect(stageNum, Uv[texcoordSel].s, Uv[texcoordSel].t);
+    Indirect(stageNum, Uv[stage.texcoord].s, Uv[stage.texcoord].t);
 
     // sample texture
-    if (order.getEnable(stageOdd))
+    if (stage.texture_enabled)
     {
       // RGBA
       u8 texel[4];
@@ -458,7 +585,7 @@ void Tev::Draw()
       if (bpmem.genMode.numtexgens > 0)
       {
         TextureSampler::Sample(TexCoord.s, TexCoord.t, TextureLod[stageNum],
-                               TextureLinear[stageNum], texmap, texel);
+                               TextureLinear[stageNum], stage.texmap, texel);
       }
       else
       {
@@ -467,7 +594,7 @@ void Tev::Draw()
         std::memset(texel, 0, 4);
       }
 
-      const auto& swap = bpmem.tevksel.GetSwapTable(ac.tswap);
+      const auto& swap = stage.texture_swap;
       TexColor.r = texel[u32(swap[ColorChannel::Red])];
       TexColor.g = texel[u32(swap[ColorChannel::Green])];
       TexColor.b = texel[u32(swap[ColorChannel::Blue])];
@@ -475,73 +602,44 @@ void Tev::Draw()
     }
 
     // set konst for this stage
-    const auto kc = bpmem.tevksel.GetKonstColor(stageNum);
-    const auto ka = bpmem.tevksel.GetKonstAlpha(stageNum);
-    StageKonst.r = m_KonstLUT[kc].r;
-    StageKonst.g = m_KonstLUT[kc].g;
-    StageKonst.b = m_KonstLUT[kc].b;
-    StageKonst.a = m_KonstLUT[ka].a;
+    StageKonst.r = m_KonstLUT[stage.konst_color].r;
+    StageKonst.g = m_KonstLUT[stage.konst_color].g;
+    StageKonst.b = m_KonstLUT[stage.konst_color].b;
+    StageKonst.a = m_KonstLUT[stage.konst_alpha].a;
 
     // set color
-    SetRasColor(order.getColorChan(stageOdd), ac.rswap);
-
-    // combine inputs
-    InputRegType inputs[4];
-    inputs[BLU_C].a = m_ColorInputLUT[cc.a].b;
-    inputs[BLU_C].b = m_ColorInputLUT[cc.b].b;
-    inputs[BLU_C].c = m_ColorInputLUT[cc.c].b;
-    inputs[BLU_C].d = m_ColorInputLUT[cc.d].b;
-    inputs[GRN_C].a = m_ColorInputLUT[cc.a].g;
-    inputs[GRN_C].b = m_ColorInputLUT[cc.b].g;
-    inputs[GRN_C].c = m_ColorInputLUT[cc.c].g;
-    inputs[GRN_C].d = m_ColorInputLUT[cc.d].g;
-    inputs[RED_C].a = m_ColorInputLUT[cc.a].r;
-    inputs[RED_C].b = m_ColorInputLUT[cc.b].r;
-    inputs[RED_C].c = m_ColorInputLUT[cc.c].r;
-    inputs[RED_C].d = m_ColorInputLUT[cc.d].r;
-    inputs[ALP_C].a = m_AlphaInputLUT[ac.a].a;
-    inputs[ALP_C].b = m_AlphaInputLUT[ac.b].a;
-    inputs[ALP_C].c = m_AlphaInputLUT[ac.c].a;
-    inputs[ALP_C].d = m_AlphaInputLUT[ac.d].a;
-
-    if (cc.bias != TevBias::Compare)
-      DrawColorRegular(cc, inputs);
-    else
-      DrawColorCompare(cc, inputs);
+    SetRasColor(stage.ras_color_chan, stage.ras_swap);
 
-    if (cc.clamp)
-    {
-      Reg[cc.dest].r = Clamp255(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp255(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp255(Reg[cc.dest].b);
-    }
-    else
-    {
-      Reg[cc.dest].r = Clamp1024(Reg[cc.dest].r);
-      Reg[cc.dest].g = Clamp1024(Reg[cc.dest].g);
-      Reg[cc.dest].b = Clamp1024(Reg[cc.dest].b);
-    }
+    Combine(stage);
+  }
+}
 
-    if (ac.bias != TevBias::Compare)
-      DrawAlphaRegular(ac, inputs);
-    else
-      DrawAlphaCompare(ac, inputs);
+void Tev::Draw()
+{
+  ASSERT(Position[0] >= 0 && Position[0] < s32(EFB_WIDTH));
+  ASSERT(Position[1] >= 0 && Position[1] < s32(EFB_HEIGHT));
 
-    if (ac.clamp)
-      Reg[ac.dest].a = Clamp255(Reg[ac.dest].a);
-    else
-      Reg[ac.dest].a = Clamp1024(Reg[ac.dest].a);
+  ++m_tev_pixels_in;
+
+  for (u32 stageNum = 0; stageNum < m_num_indirect_stages; stageNum++)
+  {
+    const IndirectStageState& stage = m_indirect_stages[stageNum];
+    TextureSampler::Sample(Uv[stage.texcoord].s >> stage.scale_s,
+                           Uv[stage.texcoord].t >> stage.scale_t, IndirectLod[stageNum],
+                           IndirectLinear[stageNum], stage.texmap, IndirectTex[stageNum]);
   }
 
+  RunStages();
+
   // convert to 8 bits per component
   // the results of the last tev stage are put onto the screen,
   // regardless of the used destination register - TODO: Verify!
-  const auto& color_index = bpmem.combiners[bpmem.genMode.numtevstages].colorC.dest;
-  const auto& alpha_index = bpmem.combiners[bpmem.genMode.numtevstages].alphaC.dest;
+  const auto& color_index = m_stages[m_num_tev_stages - 1].cc.dest;
+  const auto& alpha_index = m_stages[m_num_tev_stages - 1].ac.dest;
   u8 output[4] = {(u8)Reg[alpha_index].a, (u8)Reg[color_index].b, (u8)Reg[color_index].g,
                   (u8)Reg[color_index].r};
 
-  if (!TevAlphaTest(output[ALP_C]))
+  if (!m_alpha_test_passes[output[ALP_C]])
     return;
 
   // z texture
@@ -660,21 +758,23 @@ void Tev::Draw()
   if (bpmem.GetEmulatedZ() == EmulatedZ::Late)
   {
     // TODO: Check against hw if these values get incremented even if depth testing is disabled
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_INPUT);
 
     if (!EfbInterface::ZCompare(Position[0], Position[1], Position[2]))
       return;
 
-    EfbInterface::IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
+    IncPerfCounterQuadCount(PQ_ZCOMP_OUTPUT);
   }
 
   // The GC/Wii GPU rasterizes in 2x2 pixel groups, so bounding box values will be rounded to the
   // extents of these groups, rather than the exact pixel.
-  BBoxManager::Update(static_cast<u16>(Position[0] & ~1), static_cast<u16>(Position[0] | 1),
-                      static_cast<u16>(Position[1] & ~1), static_cast<u16>(Position[1] | 1));
+  m_bbox_left = std::min(m_bbox_left, static_cast<u16>(Position[0] & ~1));
+  m_bbox_right = std::max(m_bbox_right, static_cast<u16>(Position[0] | 1));
+  m_bbox_top = std::min(m_bbox_top, static_cast<u16>(Position[1] & ~1));
+  m_bbox_bottom = std::max(m_bbox_bottom, static_cast<u16>(Position[1] | 1));
 
-  INCSTAT(g_stats.this_frame.tev_pixels_out);
-  EfbInterface::IncPerfCounterQuadCount(PQ_BLEND_INPUT);
+  ++m_tev_pixels_out;
+  IncPerfCounterQuadCount(PQ_BLEND_INPUT);
 
   EfbInterface::BlendTev(Position[0], Position[1], output);
 }
@@ -692,3 +792,94 @@ void Tev::SetKonstColors()
     KonstantColors[i].a = pixel_shader_manager.constants.kcolors[i][3];
   }
 }
+
+void Tev::SetupStages()
+{
+  auto& system = Core::System::GetInstance();
+  auto& pixel_shader_manager = system.GetPixelShaderManager();
+
+  for (int i = 0; i < 4; i++)
+  {
+    m_initial_colors[i].r = pixel_shader_manager.constants.colors[i][0];
+    m_initial_colors[i].g = pixel_shader_manager.constants.colors[i][1];
+    m_initial_colors[i].b = pixel_shader_manager.constants.colors[i][2];
+    m_initial_colors[i].a = pixel_shader_manager.constants.colors[i][3];
+  }
+
+  m_num_indirect_stages = bpmem.genMode.numindstages;
+  for (u32 stageNum = 0; stageNum < m_num_indirect_stages; stageNum++)
+  {
+    IndirectStageState& stage = m_indirect_stages[stageNum];
+    const int stageNum2 = stageNum >> 1;
+    const int stageOdd = stageNum & 1;
+
+    stage.texcoord = bpmem.tevindref.getTexCoord(stageNum);
+    stage.texmap = bpmem.tevindref.getTexMap(stageNum);
+
+    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
+    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
+    // This affects the Mario portrait in Luigi's Mansion, where the developers forgot to set
+    // the number of tex gens to 2 (bug 11462).
+    if (stage.texcoord >= bpmem.genMode.numtexgens)
+      stage.texcoord = 0;
+
+    const TEXSCALE& texscale = bpmem.texscale[stageNum2];
+    stage.scale_s = stageOdd ? texscale.ss1 : texscale.ss0;
+    stage.scale_t = stageOdd ? texscale.ts1 : texscale.ts0;
+  }
+
+  m_num_tev_stages = bpmem.genMode.numtevstages + 1;
+  for (u32 stageNum = 0; stageNum < m_num_tev_stages; stageNum++)
+  {
+    StageState& stage = m_stages[stageNum];
+    const int stageNum2 = stageNum >> 1;
+    const int stageOdd = stageNum & 1;
+    const TwoTevStageOrders& order = bpmem.tevorders[stageNum2];
+
+    // stage combiners
+    SetupCombiners(bpmem.combiners[stageNum].colorC, bpmem.combiners[stageNum].alphaC, &stage);
+
+    stage.texcoord = order.getTexCoord(stageOdd);
+    stage.texmap = order.getTexMap(stageOdd);
+    stage.texture_enabled = order.getEnable(stageOdd);
+
+    // Quirk: when the tex coord is not less than the number of tex gens (i.e. the tex coord does
+    // not exist), then tex coord 0 is used (though sometimes glitchy effects happen on console).
+    if (stage.texcoord >= bpmem.genMode.numtexgens)
+      stage.texcoord = 0;
+
+    stage.texture_swap = bpmem.tevksel.GetSwapTable(stage.ac.tswap);
+    stage.ras_color_chan = order.getColorChan(stageOdd);
+    stage.ras_swap = bpmem.tevksel.GetSwapTable(stage.ac.rswap);
+    stage.konst_color = bpmem.tevksel.GetKonstColor(stageNum);
+    stage.konst_alpha = bpmem.tevksel.GetKonstAlpha(stageNum);
+  }
+
+  // The alpha test only depends on the 8-bit alpha value, so it can be tabulated.
+  for (u32 alpha = 0; alpha < m_alpha_test_passes.size(); alpha++)
+    m_alpha_test_passes[alpha] = TevAlphaTest(alpha);
+}
+
+void Tev::FlushCounters()
+{
+  for (u32 i = 0; i < PQ_NUM_MEMBERS; ++i)
+  {
+    if (m_perf_quad_counts[i] != 0)
+      EfbInterface::AddPerfCounterQuadCount(static_cast<PerfQueryType>(i), m_perf_quad_counts[i]);
+  }
+  m_perf_quad_counts = {};
+
+  if (m_bbox_left <= m_bbox_right)
+    BBoxManager::Update(m_bbox_left, m_bbox_right, m_bbox_top, m_bbox_bottom);
+  m_bbox_left = 0xFFFF;
+  m_bbox_right = 0;
+  m_bbox_top = 0xFFFF;
+  m_bbox_bottom = 0;
+
+  ADDSTAT(g_stats.this_frame.rasterized_pixels, m_rasterized_pixels);
+  ADDSTAT(g_stats.this_frame.tev_pixels_in, m_tev_pixels_in);
+  ADDSTAT(g_stats.this_frame.tev_pixels_out, m_tev_pixels_out);
+  m_rasterized_pixels = 0;
+  m_tev_pixels_in = 0;
+  m_tev_pixels_out = 0;
+}
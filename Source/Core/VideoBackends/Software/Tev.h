@@ -5,11 +5,16 @@
 
 #include <array>
 
+#include "Common/CommonTypes.h"
 #include "Common/EnumMap.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/PerfQueryBase.h"
 
 class Tev
 {
+  // Checks the SIMD code and the state decoded by SetupStages() against the scalar code
+  friend class TevTest;
+
   struct TevColor
   {
     constexpr TevColor() = default;
@@ -203,14 +208,90 @@ class Tev
     INDIRECT = 32
   };
 
-  void SetRasColor(RasColorChan colorChan, u32 swaptable);
+  // BP state used by Draw(), decoded once per batch by SetupStages() instead of for every pixel.
+  struct IndirectStageState
+  {
+    u32 texcoord;
+    u32 texmap;
+    s32 scale_s;
+    s32 scale_t;
+  };
+
+#if defined(_M_X86_64)
+  // Lane constants for DrawRegularSSE2(), with the lanes in TevColor order.
+  struct CombinerConstants
+  {
+    alignas(16) s16 scale[8];
+    alignas(16) s16 bias[8];
+    alignas(16) s16 min[8];
+    alignas(16) s16 max[8];
+    alignas(16) s32 rounding[4];
+    alignas(16) s32 negate_before[4];
+    alignas(16) s32 negate_after[4];
+    alignas(16) s32 halve[4];
+  };
+#endif
+
+  struct StageState
+  {
+    TevStageCombiner::ColorCombiner cc;
+    TevStageCombiner::AlphaCombiner ac;
+    u32 texcoord;
+    u32 texmap;
+    bool texture_enabled;
+    Common::EnumMap<ColorChannel, ColorChannel::Alpha> texture_swap;
+    RasColorChan ras_color_chan;
+    Common::EnumMap<ColorChannel, ColorChannel::Alpha> ras_swap;
+    KonstSel konst_color;
+    KonstSel konst_alpha;
+#if defined(_M_X86_64)
+    bool regular;
+    CombinerConstants constants;
+#endif
+  };
+
+  std::array<TevColor, 4> m_initial_colors{};
+  u32 m_num_indirect_stages = 0;
+  u32 m_num_tev_stages = 0;
+  std::array<IndirectStageState, 4> m_indirect_stages{};
+  std::array<StageState, 16> m_stages{};
+  std::array<bool, 256> m_alpha_test_passes{};
+
+  void SetRasColor(RasColorChan colorChan,
+                   const Common::EnumMap<ColorChannel, ColorChannel::Alpha>& swap);
 
   void DrawColorRegular(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawColorCompare(const TevStageCombiner::ColorCombiner& cc, const InputRegType inputs[4]);
   void DrawAlphaRegular(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
   void DrawAlphaCompare(const TevStageCombiner::AlphaCombiner& ac, const InputRegType inputs[4]);
 
+#if defined(_M_X86_64)
+  static void SetupCombinerConstants(const TevStageCombiner::ColorCombiner& cc,
+                                     const TevStageCombiner::AlphaCombiner& ac,
+                                     CombinerConstants* constants);
+  void DrawRegularSSE2(const StageState& stage);
+#endif
+  // Sets the combiners of a stage, along with everything precomputed from them.
+  static void SetupCombiners(const TevStageCombiner::ColorCombiner& cc,
+                             const TevStageCombiner::AlphaCombiner& ac, StageState* stage);
+  void Combine(const StageState& stage);
+  void CombineScalar(const StageState& stage);
+
   void Indirect(unsigned int stageNum, s32 s, s32 t);
+  // Runs every TEV stage for the current pixel, starting from the initial register values.
+  // The indirect textures have to be sampled already.
+  void RunStages();
+
+  // Side effects which aren't tied to a single pixel are collected here, and only applied by
+  // FlushCounters(), so that several Tevs can draw into disjoint parts of the EFB at once.
+  std::array<u32, PQ_NUM_MEMBERS> m_perf_quad_counts{};
+  u16 m_bbox_left = 0xFFFF;
+  u16 m_bbox_right = 0;
+  u16 m_bbox_top = 0xFFFF;
+  u16 m_bbox_bottom = 0;
+  u32 m_rasterized_pixels = 0;
+  u32 m_tev_pixels_in = 0;
+  u32 m_tev_pixels_out = 0;
 
 public:
   s32 Position[3]{};
@@ -230,5 +311,13 @@ public:
   };
 
   void SetKonstColors();
+  // Must be called whenever BP memory may have changed, before drawing.
+  void SetupStages();
   void Draw();
+
+  void IncPerfCounterQuadCount(PerfQueryType type) { ++m_perf_quad_counts[type]; }
+  void IncRasterizedPixels() { ++m_rasterized_pixels; }
+  // Applies the perf query counts, bounding box and statistics of everything drawn since the last
+  // call. Must not be called while any Tev is drawing.
+  void FlushCounters();
 };
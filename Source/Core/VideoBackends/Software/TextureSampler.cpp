@@ -5,8 +5,13 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <span>
 
+#if defined(_M_X86_64)
+#include <emmintrin.h>
+#endif
+
 #include "Common/CommonTypes.h"
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
@@ -54,20 +59,43 @@ static inline void WrapCoord(int* coordp, WrapMode wrap_mode, int image_size)
   *coordp = coord;
 }
 
-static inline void SetTexel(const u8* inTexel, u32* outTexel, u32 fract)
+void FilterTexelsScalar(const u8 (&texels)[4][4], const u32 (&weights)[4], int shift, u8* sample)
 {
-  outTexel[0] = inTexel[0] * fract;
-  outTexel[1] = inTexel[1] * fract;
-  outTexel[2] = inTexel[2] * fract;
-  outTexel[3] = inTexel[3] * fract;
+  for (int channel = 0; channel < 4; channel++)
+  {
+    u32 sum = 0;
+    for (int i = 0; i < 4; i++)
+      sum += texels[i][channel] * weights[i];
+    sample[channel] = (u8)(sum >> shift);
+  }
 }
 
-static inline void AddTexel(const u8* inTexel, u32* outTexel, u32 fract)
+void FilterTexels(const u8 (&texels)[4][4], const u32 (&weights)[4], int shift, u8* sample)
 {
-  outTexel[0] += inTexel[0] * fract;
-  outTexel[1] += inTexel[1] * fract;
-  outTexel[2] += inTexel[2] * fract;
-  outTexel[3] += inTexel[3] * fract;
+#if defined(_M_X86_64)
+  const auto load = [&](int index) {
+    u32 texel;
+    std::memcpy(&texel, texels[index], sizeof(u32));
+    return _mm_cvtsi32_si128(texel);
+  };
+
+  // Interleave the channels of two texels so that pmaddwd can apply both weights at once.
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i texels01 = _mm_unpacklo_epi8(_mm_unpacklo_epi8(load(0), load(1)), zero);
+  const __m128i texels23 = _mm_unpacklo_epi8(_mm_unpacklo_epi8(load(2), load(3)), zero);
+  const __m128i weights01 = _mm_set1_epi32(weights[0] | (weights[1] << 16));
+  const __m128i weights23 = _mm_set1_epi32(weights[2] | (weights[3] << 16));
+
+  __m128i sum =
+      _mm_add_epi32(_mm_madd_epi16(texels01, weights01), _mm_madd_epi16(texels23, weights23));
+  sum = _mm_srl_epi32(sum, _mm_cvtsi32_si128(shift));
+  sum = _mm_packus_epi16(_mm_packs_epi32(sum, sum), sum);
+
+  const u32 result = _mm_cvtsi128_si32(sum);
+  std::memcpy(sample, &result, sizeof(u32));
+#else
+  FilterTexelsScalar(texels, weights, shift, sample);
+#endif
 }
 
 void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
@@ -94,19 +122,13 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample)
 
   if (mipLinear)
   {
-    u8 sampledTex[4];
-    u32 texel[4];
-
-    SampleMip(s, t, baseMip, linear, texmap, sampledTex);
-    SetTexel(sampledTex, texel, (16 - lodFract));
+    u8 sampledTex[4][4]{};
 
-    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex);
-    AddTexel(sampledTex, texel, lodFract);
+    SampleMip(s, t, baseMip, linear, texmap, sampledTex[0]);
+    SampleMip(s, t, baseMip + 1, linear, texmap, sampledTex[1]);
 
-    sample[0] = (u8)(texel[0] >> 4);
-    sample[1] = (u8)(texel[1] >> 4);
-    sample[2] = (u8)(texel[2] >> 4);
-    sample[3] = (u8)(texel[3] >> 4);
+    const u32 weights[4] = {u32(16 - lodFract), u32(lodFract), 0, 0};
+    FilterTexels(sampledTex, weights, 4, sample);
   }
   else
 #endif
@@ -194,8 +216,7 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
     int imageTPlus1 = imageT + 1;
     const int fractT = t & 0x7f;
 
-    u8 sampledTex[4];
-    u32 texel[4];
+    u8 sampledTex[4][4];
 
     WrapCoord(&imageS, tm0.wrap_s, image_width_minus_1 + 1);
     WrapCoord(&imageT, tm0.wrap_t, image_height_minus_1 + 1);
@@ -204,45 +225,30 @@ void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample)
 
     if (!(texfmt == TextureFormat::RGBA8 && texUnit.texImage1.cache_manually_managed))
     {
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageT, image_width_minus_1, texfmt,
+      TexDecoder_DecodeTexel(sampledTex[0], image_src, imageS, imageT, image_width_minus_1, texfmt,
                              tlut, tlutfmt);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageT, image_width_minus_1,
-                             texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageS, imageTPlus1, image_width_minus_1,
+      TexDecoder_DecodeTexel(sampledTex[1], image_src, imageSPlus1, imageT, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexel(sampledTex, image_src, imageSPlus1, imageTPlus1, image_width_minus_1,
+      TexDecoder_DecodeTexel(sampledTex[2], image_src, imageS, imageTPlus1, image_width_minus_1,
                              texfmt, tlut, tlutfmt);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
+      TexDecoder_DecodeTexel(sampledTex[3], image_src, imageSPlus1, imageTPlus1,
+                             image_width_minus_1, texfmt, tlut, tlutfmt);
     }
     else
     {
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageT,
-                                          image_width_minus_1);
-      SetTexel(sampledTex, texel, (128 - fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1, imageT,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[0], image_src, image_src_odd, imageS, imageT,
                                           image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (128 - fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageS, imageTPlus1,
-                                          image_width_minus_1);
-      AddTexel(sampledTex, texel, (128 - fractS) * (fractT));
-
-      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex, image_src, image_src_odd, imageSPlus1,
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[1], image_src, image_src_odd, imageSPlus1,
+                                          imageT, image_width_minus_1);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[2], image_src, image_src_odd, imageS,
+                                          imageTPlus1, image_width_minus_1);
+      TexDecoder_DecodeTexelRGBA8FromTmem(sampledTex[3], image_src, image_src_odd, imageSPlus1,
                                           imageTPlus1, image_width_minus_1);
-      AddTexel(sampledTex, texel, (fractS) * (fractT));
     }
 
-    sample[0] = (u8)(texel[0] >> 14);
-    sample[1] = (u8)(texel[1] >> 14);
-    sample[2] = (u8)(texel[2] >> 14);
-    sample[3] = (u8)(texel[3] >> 14);
+    const u32 weights[4] = {u32((128 - fractS) * (128 - fractT)), u32(fractS * (128 - fractT)),
+                            u32((128 - fractS) * fractT), u32(fractS * fractT)};
+    FilterTexels(sampledTex, weights, 14, sample);
   }
   else
   {
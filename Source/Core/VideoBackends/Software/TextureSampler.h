@@ -11,6 +11,12 @@ void Sample(s32 s, s32 t, s32 lod, bool linear, u8 texmap, u8* sample);
 
 void SampleMip(s32 s, s32 t, s32 mip, bool linear, u8 texmap, u8* sample);
 
+// Returns the weighted sum of four RGBA texels, shifted right by the given amount. Each weight
+// must fit in 15 bits, and the weights must not add up to more than 1 << shift.
+void FilterTexels(const u8 (&texels)[4][4], const u32 (&weights)[4], int shift, u8* sample);
+// Same as FilterTexels, without SIMD.
+void FilterTexelsScalar(const u8 (&texels)[4][4], const u32 (&weights)[4], int shift, u8* sample);
+
 enum
 {
   RED_SMP,
@@ -23,6 +23,17 @@ bool CustomAsset::Load()
   return load_information.m_bytes_loaded != 0;
 }
 
+void CustomAsset::Unload()
+{
+  UnloadImpl();
+
+  // Clearing the load time makes the next load look like a change to anything that cached the
+  // data, so it picks up the data again
+  std::lock_guard lk(m_info_lock);
+  m_bytes_loaded = 0;
+  m_last_loaded_time = {};
+}
+
 CustomAssetLibrary::TimeType CustomAsset::GetLastWriteTime() const
 {
   return m_owning_library->GetLastAssetWriteTime(m_asset_id);
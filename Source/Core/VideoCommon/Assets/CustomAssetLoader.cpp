@@ -3,7 +3,10 @@
 
 #include "VideoCommon/Assets/CustomAssetLoader.h"
 
+#include <algorithm>
+
 #include "Common/MemoryUtil.h"
+#include "Common/Thread.h"
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
 
 namespace VideoCommon
@@ -37,53 +40,188 @@ void CustomAssetLoader::Init()
           const auto write_time = ptr->GetLastWriteTime();
           if (write_time > ptr->GetLastLoadedTime())
           {
-            (void)ptr->Load();
+            const std::size_t old_memory_size = ptr->GetByteSizeInMemory();
+            if (ptr->Load())
+            {
+              m_total_bytes_loaded -= old_memory_size;
+              m_total_bytes_loaded += ptr->GetByteSizeInMemory();
+            }
           }
         }
       }
     }
   });
 
-  m_asset_load_thread.Reset("Custom Asset Loader", [this](std::weak_ptr<CustomAsset> asset) {
-    if (auto ptr = asset.lock())
-    {
-      if (m_memory_exceeded)
-        return;
-
-      if (ptr->Load())
-      {
-        std::lock_guard lk(m_asset_load_lock);
-        const std::size_t asset_memory_size = ptr->GetByteSizeInMemory();
-        m_total_bytes_loaded += asset_memory_size;
-        m_assets_to_monitor.try_emplace(ptr->GetAssetId(), ptr);
-        if (m_total_bytes_loaded > m_max_memory_available)
-        {
-          ERROR_LOG_FMT(VIDEO,
-                        "Asset memory exceeded with asset '{}', future assets won't load until "
-                        "memory is available.",
-                        ptr->GetAssetId());
-          m_memory_exceeded = true;
-        }
-      }
-    }
-  });
+  // Decoding is what takes the time for most assets, so spread it over a few threads
+  const u32 num_load_threads = std::clamp(std::thread::hardware_concurrency() / 2, 1u, 4u);
+  m_load_threads_shutdown = false;
+  for (u32 i = 0; i < num_load_threads; i++)
+    m_asset_load_threads.emplace_back(&CustomAssetLoader::LoadThread, this);
 }
 
 void CustomAssetLoader ::Shutdown()
 {
-  m_asset_load_thread.Shutdown(true);
+  {
+    std::lock_guard lk(m_load_queue_lock);
+    m_load_threads_shutdown = true;
+    m_load_queue.clear();
+  }
+  m_load_queue_changed.notify_all();
+  for (std::thread& thread : m_asset_load_threads)
+    thread.join();
+  m_asset_load_threads.clear();
 
   m_asset_monitor_thread_shutdown.Set();
   m_asset_monitor_thread.join();
   m_assets_to_monitor.clear();
+  m_pending_assets.clear();
+  m_evicted_assets.clear();
+  m_lru_assets.clear();
+  m_lru_lookup.clear();
   m_total_bytes_loaded = 0;
 }
 
+void CustomAssetLoader::SetMemoryBudget(std::size_t max_memory_available)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  m_max_memory_available = max_memory_available;
+}
+
+void CustomAssetLoader::UseAsset(const std::shared_ptr<CustomAsset>& asset)
+{
+  std::lock_guard lk(m_asset_load_lock);
+  if (const auto iter = m_lru_lookup.find(asset.get()); iter != m_lru_lookup.end())
+  {
+    m_lru_assets.splice(m_lru_assets.end(), m_lru_assets, iter->second);
+  }
+  else if (m_evicted_assets.erase(asset.get()) != 0)
+  {
+    m_pending_assets.insert(asset.get());
+    QueueLoad(asset, true);
+  }
+  else if (m_pending_assets.contains(asset.get()))
+  {
+    QueueLoad(asset, true);
+  }
+}
+
+void CustomAssetLoader::QueueLoad(std::weak_ptr<CustomAsset> asset, bool high_priority)
+{
+  {
+    std::lock_guard lk(m_load_queue_lock);
+    if (high_priority)
+      m_load_queue.push_front(std::move(asset));
+    else
+      m_load_queue.push_back(std::move(asset));
+  }
+  m_load_queue_changed.notify_one();
+}
+
+void CustomAssetLoader::LoadThread()
+{
+  Common::SetCurrentThreadName("Custom Asset Loader");
+
+  while (true)
+  {
+    std::weak_ptr<CustomAsset> asset;
+    {
+      std::unique_lock lk(m_load_queue_lock);
+      m_load_queue_changed.wait(
+          lk, [this] { return m_load_threads_shutdown || !m_load_queue.empty(); });
+      if (m_load_threads_shutdown)
+        return;
+
+      asset = std::move(m_load_queue.front());
+      m_load_queue.pop_front();
+    }
+
+    if (auto ptr = asset.lock())
+      LoadAsset(ptr);
+  }
+}
+
+void CustomAssetLoader::LoadAsset(const std::shared_ptr<CustomAsset>& asset)
+{
+  {
+    std::lock_guard lk(m_asset_load_lock);
+
+    // Another copy of this queue entry got to it first
+    if (m_pending_assets.erase(asset.get()) == 0)
+      return;
+
+    if (m_memory_exceeded)
+    {
+      if (m_evictable_assets.contains(asset.get()))
+        m_evicted_assets.insert(asset.get());
+      return;
+    }
+  }
+
+  if (!asset->Load())
+    return;
+
+  std::lock_guard lk(m_asset_load_lock);
+  const std::size_t asset_memory_size = asset->GetByteSizeInMemory();
+  m_total_bytes_loaded += asset_memory_size;
+  m_assets_to_monitor.try_emplace(asset->GetAssetId(), asset);
+  if (m_evictable_assets.contains(asset.get()))
+    m_lru_lookup.emplace(asset.get(), m_lru_assets.insert(m_lru_assets.end(), asset.get()));
+
+  if (m_total_bytes_loaded > m_max_memory_available)
+    EvictAssets(asset.get());
+}
+
+void CustomAssetLoader::EvictAssets(const CustomAsset* loaded_asset)
+{
+  u32 num_evicted = 0;
+  while (m_total_bytes_loaded > m_max_memory_available && !m_lru_assets.empty() &&
+         m_lru_assets.front() != loaded_asset)
+  {
+    CustomAsset* const asset = m_lru_assets.front();
+    m_lru_assets.pop_front();
+    m_lru_lookup.erase(asset);
+
+    m_total_bytes_loaded -= asset->GetByteSizeInMemory();
+    m_assets_to_monitor.erase(asset->GetAssetId());
+    asset->Unload();
+    m_evicted_assets.insert(asset);
+    num_evicted++;
+  }
+
+  if (num_evicted != 0)
+  {
+    INFO_LOG_FMT(VIDEO, "Asset memory exceeded, evicted {} least recently used assets.",
+                 num_evicted);
+  }
+
+  if (m_total_bytes_loaded > m_max_memory_available)
+  {
+    ERROR_LOG_FMT(VIDEO,
+                  "Asset memory exceeded with asset '{}', future assets won't load until "
+                  "memory is available.",
+                  loaded_asset->GetAssetId());
+    m_memory_exceeded = true;
+  }
+}
+
+void CustomAssetLoader::ForgetAsset(const CustomAsset* asset)
+{
+  m_evictable_assets.erase(asset);
+  m_pending_assets.erase(asset);
+  m_evicted_assets.erase(asset);
+  if (const auto iter = m_lru_lookup.find(asset); iter != m_lru_lookup.end())
+  {
+    m_lru_assets.erase(iter->second);
+    m_lru_lookup.erase(iter);
+  }
+}
+
 std::shared_ptr<GameTextureAsset>
 CustomAssetLoader::LoadGameTexture(const CustomAssetLibrary::AssetID& asset_id,
                                    std::shared_ptr<CustomAssetLibrary> library)
 {
-  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library));
+  return LoadOrCreateAsset<GameTextureAsset>(asset_id, m_game_textures, std::move(library),
+                                             true);
 }
 
 std::shared_ptr<PixelShaderAsset>
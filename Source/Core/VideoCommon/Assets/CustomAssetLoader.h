@@ -4,14 +4,19 @@
 #pragma once
 
 #include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <list>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include "Common/Flag.h"
 #include "Common/Logging/Log.h"
-#include "Common/WorkQueueThread.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/Assets/MaterialAsset.h"
 #include "VideoCommon/Assets/MeshAsset.h"
@@ -22,6 +27,8 @@ namespace VideoCommon
 {
 // This class is responsible for loading data asynchronously when requested
 // and watches that data asynchronously reloading it if it changes
+// Game textures are evicted, least recently used first, when the loaded assets
+// go over the memory budget, and are loaded again when they are used next
 class CustomAssetLoader
 {
 public:
@@ -35,6 +42,10 @@ public:
   void Init();
   void Shutdown();
 
+  // Init sets the memory budget from the amount of physical memory
+  // A new budget is enforced when the next asset is loaded
+  void SetMemoryBudget(std::size_t max_memory_available);
+
   // The following Load* functions will load or create an asset associated
   // with the given asset id
   // Loads happen asynchronously where the data will be set now or in the future
@@ -52,26 +63,35 @@ public:
   std::shared_ptr<MeshAsset> LoadMesh(const CustomAssetLibrary::AssetID& asset_id,
                                       std::shared_ptr<CustomAssetLibrary> library);
 
+  // Marks an asset as used, which makes it the last to be evicted
+  // An evicted asset is loaded again, and one which is still waiting to load is moved
+  // ahead of the assets which weren't used yet
+  void UseAsset(const std::shared_ptr<CustomAsset>& asset);
+
 private:
   // TODO C++20: use a 'derived_from' concept against 'CustomAsset' when available
   template <typename AssetType>
   std::shared_ptr<AssetType>
   LoadOrCreateAsset(const CustomAssetLibrary::AssetID& asset_id,
                     std::map<CustomAssetLibrary::AssetID, std::weak_ptr<AssetType>>& asset_map,
-                    std::shared_ptr<CustomAssetLibrary> library)
+                    std::shared_ptr<CustomAssetLibrary> library, bool evictable = false)
   {
     auto [it, inserted] = asset_map.try_emplace(asset_id);
     if (!inserted)
     {
       auto shared = it->second.lock();
       if (shared)
+      {
+        UseAsset(shared);
         return shared;
+      }
     }
     std::shared_ptr<AssetType> ptr(new AssetType(std::move(library), asset_id), [&](AssetType* a) {
       {
         std::lock_guard lk(m_asset_load_lock);
         m_total_bytes_loaded -= a->GetByteSizeInMemory();
         m_assets_to_monitor.erase(a->GetAssetId());
+        ForgetAsset(a);
         if (m_max_memory_available >= m_total_bytes_loaded && m_memory_exceeded)
         {
           INFO_LOG_FMT(VIDEO, "Asset memory went below limit, new assets can begin loading.");
@@ -81,10 +101,22 @@ private:
       delete a;
     });
     it->second = ptr;
-    m_asset_load_thread.Push(it->second);
+    {
+      std::lock_guard lk(m_asset_load_lock);
+      if (evictable)
+        m_evictable_assets.insert(ptr.get());
+      m_pending_assets.insert(ptr.get());
+    }
+    QueueLoad(ptr, false);
     return ptr;
   }
 
+  void QueueLoad(std::weak_ptr<CustomAsset> asset, bool high_priority);
+  void LoadThread();
+  void LoadAsset(const std::shared_ptr<CustomAsset>& asset);
+  void EvictAssets(const CustomAsset* loaded_asset);
+  void ForgetAsset(const CustomAsset* asset);
+
   static constexpr auto TIME_BETWEEN_ASSET_MONITOR_CHECKS = std::chrono::milliseconds{500};
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<GameTextureAsset>> m_game_textures;
@@ -100,9 +132,26 @@ private:
 
   std::map<CustomAssetLibrary::AssetID, std::weak_ptr<CustomAsset>> m_assets_to_monitor;
 
+  // The assets are only used as keys here, each asset removes itself when it is destroyed
+  std::unordered_set<const CustomAsset*> m_evictable_assets;
+  // Assets which are queued, but haven't started loading yet
+  std::unordered_set<const CustomAsset*> m_pending_assets;
+  // Assets which were evicted or skipped because the memory budget was exceeded
+  std::unordered_set<const CustomAsset*> m_evicted_assets;
+  // Loaded evictable assets, least recently used first
+  std::list<CustomAsset*> m_lru_assets;
+  std::unordered_map<const CustomAsset*, std::list<CustomAsset*>::iterator> m_lru_lookup;
+
   // Use a recursive mutex to handle the scenario where an asset goes out of scope while
   // iterating over the assets to monitor which calls the lock above in 'LoadOrCreateAsset'
   std::recursive_mutex m_asset_load_lock;
-  Common::WorkQueueThread<std::weak_ptr<CustomAsset>> m_asset_load_thread;
+
+  // Assets can be queued more than once, when they are used while waiting to load
+  // Only the first copy to be taken off the queue is loaded
+  std::mutex m_load_queue_lock;
+  std::condition_variable m_load_queue_changed;
+  std::deque<std::weak_ptr<CustomAsset>> m_load_queue;
+  bool m_load_threads_shutdown = false;
+  std::vector<std::thread> m_asset_load_threads;
 };
 }  // namespace VideoCommon
@@ -0,0 +1,119 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/Assets/CustomTextureCache.h"
+
+#include <cstring>
+#include <mutex>
+#include <system_error>
+
+#include <zstd.h>
+
+#include "Common/Hash.h"
+#include "Common/Logging/Log.h"
+#include "Common/StringUtil.h"
+
+namespace VideoCommon
+{
+namespace
+{
+// Decompression speed matters much more than the size here
+constexpr int COMPRESSION_LEVEL = 1;
+}  // namespace
+
+CustomTextureCache::CustomTextureCache(const std::string& filename)
+{
+  const u32 num_entries = m_cache.Open(filename);
+  INFO_LOG_FMT(VIDEO, "Opened custom texture cache '{}' with {} entries", filename, num_entries);
+}
+
+bool CustomTextureCache::LoadPNGTexture(CustomTextureData::ArraySlice::Level* level,
+                                        const std::filesystem::path& path)
+{
+  const std::string filename = PathToString(path);
+
+  std::error_code ec;
+  const u64 file_size = std::filesystem::file_size(path, ec);
+  if (ec)
+    return VideoCommon::LoadPNGTexture(level, filename);
+  const s64 write_time = std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+  if (ec)
+    return VideoCommon::LoadPNGTexture(level, filename);
+
+  const u8* const filename_data = reinterpret_cast<const u8*>(filename.data());
+  const Key key{Common::HashXXH3(filename_data, filename.size()),
+                Common::HashXXH3(filename_data, filename.size(), filename.size())};
+  {
+    std::shared_lock lk(m_lock);
+    const auto entry = m_cache.Lookup(key);
+    if (entry && ReadEntry(*entry, write_time, file_size, level))
+      return true;
+  }
+
+  if (!VideoCommon::LoadPNGTexture(level, filename))
+    return false;
+
+  const std::vector<u8> entry = WriteEntry(*level, write_time, file_size);
+  if (!entry.empty())
+  {
+    std::lock_guard lk(m_lock);
+    m_cache.Append(key, entry.data(), static_cast<u32>(entry.size()));
+  }
+  return true;
+}
+
+bool CustomTextureCache::ReadEntry(std::span<const u8> entry, s64 write_time, u64 file_size,
+                                   CustomTextureData::ArraySlice::Level* level)
+{
+  EntryHeader header;
+  if (entry.size() < sizeof(header))
+    return false;
+  std::memcpy(&header, entry.data(), sizeof(header));
+  if (header.write_time != write_time || header.file_size != file_size)
+    return false;
+
+  level->data.resize(header.data_size);
+  const size_t result =
+      ZSTD_decompress(level->data.data(), level->data.size(), entry.data() + sizeof(header),
+                      entry.size() - sizeof(header));
+  if (ZSTD_isError(result) || result != header.data_size)
+  {
+    WARN_LOG_FMT(VIDEO, "Custom texture cache entry is corrupt: {}", ZSTD_getErrorName(result));
+    return false;
+  }
+
+  level->format = static_cast<AbstractTextureFormat>(header.format);
+  level->width = header.width;
+  level->height = header.height;
+  level->row_length = header.row_length;
+  return true;
+}
+
+std::vector<u8> CustomTextureCache::WriteEntry(const CustomTextureData::ArraySlice::Level& level,
+                                               s64 write_time, u64 file_size)
+{
+  EntryHeader header;
+  header.write_time = write_time;
+  header.file_size = file_size;
+  header.format = static_cast<u32>(level.format);
+  header.width = level.width;
+  header.height = level.height;
+  header.row_length = level.row_length;
+  header.data_size = level.data.size();
+
+  std::vector<u8> entry(sizeof(header) + ZSTD_compressBound(level.data.size()));
+  std::memcpy(entry.data(), &header, sizeof(header));
+  const size_t compressed_size =
+      ZSTD_compress(entry.data() + sizeof(header), entry.size() - sizeof(header),
+                    level.data.data(), level.data.size(), COMPRESSION_LEVEL);
+  if (ZSTD_isError(compressed_size))
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to compress custom texture: {}",
+                  ZSTD_getErrorName(compressed_size));
+    return {};
+  }
+
+  entry.resize(sizeof(header) + compressed_size);
+  return entry;
+}
+}  // namespace VideoCommon
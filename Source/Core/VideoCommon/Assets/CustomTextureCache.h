@@ -0,0 +1,60 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <filesystem>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/LinearDiskCache.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace VideoCommon
+{
+// Keeps the decoded data of PNG textures in a file, so each texture only has to be decoded once
+// The data is stored compressed, but decompressing it is many times faster than decoding the PNG
+// An entry is decoded again when the size or write time of its file changes
+class CustomTextureCache
+{
+public:
+  explicit CustomTextureCache(const std::string& filename);
+  CustomTextureCache(const CustomTextureCache&) = delete;
+  CustomTextureCache(CustomTextureCache&&) = delete;
+  CustomTextureCache& operator=(const CustomTextureCache&) = delete;
+  CustomTextureCache& operator=(CustomTextureCache&&) = delete;
+
+  // Can be called from multiple threads at once
+  bool LoadPNGTexture(CustomTextureData::ArraySlice::Level* level,
+                      const std::filesystem::path& path);
+
+private:
+  // Hashes of the file path
+  using Key = std::array<u64, 2>;
+
+  struct EntryHeader
+  {
+    s64 write_time;
+    u64 file_size;
+    u32 format;
+    u32 width;
+    u32 height;
+    u32 row_length;
+    u64 data_size;
+  };
+  static_assert(sizeof(EntryHeader) == 40);
+
+  static bool ReadEntry(std::span<const u8> entry, s64 write_time, u64 file_size,
+                        CustomTextureData::ArraySlice::Level* level);
+  static std::vector<u8> WriteEntry(const CustomTextureData::ArraySlice::Level& level,
+                                    s64 write_time, u64 file_size);
+
+  // Lookups only read from the cache, so they can run alongside each other
+  std::shared_mutex m_lock;
+  Common::LinearDiskCache<Key, u8> m_cache;
+};
+}  // namespace VideoCommon
@@ -413,11 +413,11 @@ CustomAssetLibrary::LoadInfo DirectFilesystemAssetLibrary::LoadTexture(const Ass
       data->m_texture.m_slices.push_back({});
 
     auto& slice = data->m_texture.m_slices[0];
-    // If we have no levels, create one to pass into LoadPNGTexture
+    // If we have no levels, create one to pass into LoadPNGLevel
     if (slice.m_levels.empty())
       slice.m_levels.push_back({});
 
-    if (!LoadPNGTexture(&slice.m_levels[0], PathToString(texture_path->second)))
+    if (!LoadPNGLevel(&slice.m_levels[0], texture_path->second))
     {
       ERROR_LOG_FMT(VIDEO, "Asset '{}' error - could not load png texture!", asset_id);
       return {};
@@ -440,6 +440,20 @@ void DirectFilesystemAssetLibrary::SetAssetIDMapData(const AssetID& asset_id,
   m_assetid_to_asset_map_path[asset_id] = std::move(asset_path_map);
 }
 
+void DirectFilesystemAssetLibrary::SetTextureCacheFile(const std::string& filename)
+{
+  if (!m_texture_cache)
+    m_texture_cache = std::make_unique<CustomTextureCache>(filename);
+}
+
+bool DirectFilesystemAssetLibrary::LoadPNGLevel(CustomTextureData::ArraySlice::Level* level,
+                                                const std::filesystem::path& path)
+{
+  if (m_texture_cache)
+    return m_texture_cache->LoadPNGTexture(level, path);
+  return LoadPNGTexture(level, PathToString(path));
+}
+
 bool DirectFilesystemAssetLibrary::LoadMips(const std::filesystem::path& asset_path,
                                             CustomTextureData::ArraySlice* data)
 {
@@ -474,7 +488,7 @@ bool DirectFilesystemAssetLibrary::LoadMips(const std::filesystem::path& asset_p
     }
     else if (extension_lower == ".png")
     {
-      if (!LoadPNGTexture(&level, full_path))
+      if (!LoadPNGLevel(&level, StringToPath(full_path)))
       {
         ERROR_LOG_FMT(VIDEO, "Custom mipmap '{}' failed to load", mip_level_filename);
         return false;
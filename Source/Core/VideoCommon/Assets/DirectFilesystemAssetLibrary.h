@@ -5,10 +5,12 @@
 #include <chrono>
 #include <filesystem>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 
 #include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/CustomTextureCache.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
 
 namespace VideoCommon
@@ -33,14 +35,24 @@ public:
   // file as the asset.  But a model file data might have its data spread across multiple files
   void SetAssetIDMapData(const AssetID& asset_id, AssetMap asset_path_map);
 
+  // Keeps decoded PNG textures in the given cache file, so later loads skip decoding them
+  // Expected to be called before any textures are loaded, later calls are ignored
+  void SetTextureCacheFile(const std::string& filename);
+
 private:
   // Loads additional mip levels into the texture structure until _mip<N> texture is not found
   bool LoadMips(const std::filesystem::path& asset_path, CustomTextureData::ArraySlice* data);
 
+  // Loads a PNG texture through the texture cache, if there is one
+  bool LoadPNGLevel(CustomTextureData::ArraySlice::Level* level,
+                    const std::filesystem::path& path);
+
   // Gets the asset map given an asset id
   AssetMap GetAssetMapForID(const AssetID& asset_id) const;
 
   mutable std::mutex m_lock;
   std::map<AssetID, std::map<std::string, std::filesystem::path>> m_assetid_to_asset_map_path;
+
+  std::unique_ptr<CustomTextureCache> m_texture_cache;
 };
 }  // namespace VideoCommon
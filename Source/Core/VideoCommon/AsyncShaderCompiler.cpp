@@ -3,6 +3,7 @@
 
 #include "VideoCommon/AsyncShaderCompiler.h"
 
+#include <algorithm>
 #include <thread>
 
 #include "Common/Assert.h"
@@ -31,19 +32,29 @@ void AsyncShaderCompiler::QueueWorkItem(WorkItemPtr item, u32 priority)
   if (!HasWorkerThreads())
   {
     item->Compile();
-    m_completed_work.push_back(std::move(item));
+    m_completed_work.push_back(QueuedWorkItem{std::move(item), Clock::now(), m_generation});
+    return;
   }
-  else
+
+  // The count is raised first, so workers never see more items than it says. They retry until the
+  // item shows up in the queue.
+  const u32 lane = std::min(priority, NUM_PRIORITIES - 1);
+  m_queued_work[lane]++;
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
-    m_pending_work.emplace(priority, std::move(item));
-    m_worker_thread_wake.notify_one();
+    WorkerQueue& queue = *m_worker_queues[m_next_queue];
+    m_next_queue = (m_next_queue + 1) % m_worker_queues.size();
+
+    std::lock_guard<std::mutex> guard(queue.lock);
+    queue.lanes[lane].push_back(QueuedWorkItem{std::move(item), Clock::now(), m_generation});
   }
+
+  std::lock_guard<std::mutex> guard(m_wake_lock);
+  m_worker_thread_wake.notify_one();
 }
 
 void AsyncShaderCompiler::RetrieveWorkItems()
 {
-  std::deque<WorkItemPtr> completed_work;
+  std::deque<QueuedWorkItem> completed_work;
   {
     std::lock_guard<std::mutex> guard(m_completed_work_lock);
     m_completed_work.swap(completed_work);
@@ -51,15 +62,18 @@ void AsyncShaderCompiler::RetrieveWorkItems()
 
   while (!completed_work.empty())
   {
-    completed_work.front()->Retrieve();
+    // Work items which were started before CancelPendingWork are only destroyed.
+    if (completed_work.front().generation == m_generation)
+      completed_work.front().item->Retrieve();
     completed_work.pop_front();
   }
 }
 
 bool AsyncShaderCompiler::HasPendingWork()
 {
-  std::lock_guard<std::mutex> guard(m_pending_work_lock);
-  return !m_pending_work.empty() || m_busy_workers.load() != 0;
+  // Workers count themselves as busy before taking an item from the queues, so there is no gap
+  // where a work item is in neither.
+  return GetQueuedWorkCount() != 0 || m_busy_workers.load() != 0;
 }
 
 bool AsyncShaderCompiler::HasCompletedWork()
@@ -68,6 +82,61 @@ bool AsyncShaderCompiler::HasCompletedWork()
   return !m_completed_work.empty();
 }
 
+void AsyncShaderCompiler::CancelPendingWork()
+{
+  // Bumping the generation first means any item finishing concurrently is either removed below,
+  // or skipped by RetrieveWorkItems.
+  m_generation++;
+
+  std::vector<QueuedWorkItem> cancelled_work;
+  for (const std::unique_ptr<WorkerQueue>& queue : m_worker_queues)
+  {
+    std::lock_guard<std::mutex> guard(queue->lock);
+    for (u32 lane = 0; lane < NUM_PRIORITIES; lane++)
+    {
+      m_queued_work[lane] -= queue->lanes[lane].size();
+      std::move(queue->lanes[lane].begin(), queue->lanes[lane].end(),
+                std::back_inserter(cancelled_work));
+      queue->lanes[lane].clear();
+    }
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_completed_work_lock);
+    std::move(m_completed_work.begin(), m_completed_work.end(),
+              std::back_inserter(cancelled_work));
+    m_completed_work.clear();
+  }
+
+  // The work items are destroyed here, outside of the locks, on the thread which queued them.
+  if (!cancelled_work.empty())
+    INFO_LOG_FMT(VIDEO, "Cancelled {} shader compiler work items", cancelled_work.size());
+}
+
+std::array<AsyncShaderCompiler::QueueStatistics, AsyncShaderCompiler::NUM_PRIORITIES>
+AsyncShaderCompiler::GetQueueStatistics() const
+{
+  std::array<QueueStatistics, NUM_PRIORITIES> statistics;
+  for (u32 lane = 0; lane < NUM_PRIORITIES; lane++)
+  {
+    statistics[lane].num_items = m_statistics[lane].num_items.load();
+    statistics[lane].total_wait =
+        std::chrono::microseconds(m_statistics[lane].total_wait_us.load());
+    statistics[lane].max_wait = std::chrono::microseconds(m_statistics[lane].max_wait_us.load());
+  }
+  return statistics;
+}
+
+void AsyncShaderCompiler::ResetQueueStatistics()
+{
+  for (LaneStatistics& statistics : m_statistics)
+  {
+    statistics.num_items.store(0);
+    statistics.total_wait_us.store(0);
+    statistics.max_wait_us.store(0);
+  }
+}
+
 bool AsyncShaderCompiler::WaitUntilCompletion(
     const std::function<void(size_t, size_t)>& progress_callback)
 {
@@ -88,10 +157,8 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
   // Grab the number of pending items. We use this to work out how many are left.
   size_t total_items;
   {
-    // Safe to hold both locks here, since nowhere else does.
-    std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
     std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-    total_items = m_completed_work.size() + m_pending_work.size() + m_busy_workers.load() + 1;
+    total_items = m_completed_work.size() + GetQueuedWorkCount() + m_busy_workers.load() + 1;
   }
 
   // Update progress while the compiles complete.
@@ -100,13 +167,9 @@ bool AsyncShaderCompiler::WaitUntilCompletion(
     if (Core::GetState(Core::System::GetInstance()) == Core::State::Stopping)
       return false;
 
-    size_t remaining_items;
-    {
-      std::lock_guard<std::mutex> pending_guard(m_pending_work_lock);
-      if (m_pending_work.empty() && !m_busy_workers.load())
-        break;
-      remaining_items = m_pending_work.size();
-    }
+    if (!HasPendingWork())
+      break;
+    const size_t remaining_items = std::min(GetQueuedWorkCount(), total_items);
 
     progress_callback(total_items - remaining_items, total_items);
     std::this_thread::sleep_for(CHECK_INTERVAL);
@@ -119,6 +182,24 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
   if (num_worker_threads == 0)
     return true;
 
+  // Spread the work left in the queues of the previous worker threads over the new ones.
+  std::vector<std::unique_ptr<WorkerQueue>> old_queues = std::move(m_worker_queues);
+  m_worker_queues.clear();
+  for (u32 i = 0; i < num_worker_threads; i++)
+    m_worker_queues.push_back(std::make_unique<WorkerQueue>());
+  m_next_queue = 0;
+  for (u32 lane = 0; lane < NUM_PRIORITIES; lane++)
+  {
+    for (const std::unique_ptr<WorkerQueue>& old_queue : old_queues)
+    {
+      for (QueuedWorkItem& item : old_queue->lanes[lane])
+      {
+        m_worker_queues[m_next_queue]->lanes[lane].push_back(std::move(item));
+        m_next_queue = (m_next_queue + 1) % m_worker_queues.size();
+      }
+    }
+  }
+
   for (u32 i = 0; i < num_worker_threads; i++)
   {
     void* thread_param = nullptr;
@@ -130,7 +211,8 @@ bool AsyncShaderCompiler::StartWorkerThreads(u32 num_worker_threads)
 
     m_worker_thread_start_result.store(false);
 
-    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param);
+    // Queues of threads which failed to start are emptied by the others.
+    std::thread thr(&AsyncShaderCompiler::WorkerThreadEntryPoint, this, thread_param, i);
     m_init_event.Wait();
 
     if (!m_worker_thread_start_result.load())
@@ -167,7 +249,7 @@ void AsyncShaderCompiler::StopWorkerThreads()
 
   // Signal worker threads to stop, and wake all of them.
   {
-    std::lock_guard<std::mutex> guard(m_pending_work_lock);
+    std::lock_guard<std::mutex> guard(m_wake_lock);
     m_exit_flag.Set();
     m_worker_thread_wake.notify_all();
   }
@@ -193,7 +275,7 @@ void AsyncShaderCompiler::WorkerThreadExit(void* param)
 {
 }
 
-void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
+void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param, size_t queue_index)
 {
   Common::SetCurrentThreadName("AsyncShaderCompiler Worker");
 
@@ -209,36 +291,89 @@ void AsyncShaderCompiler::WorkerThreadEntryPoint(void* param)
   m_worker_thread_start_result.store(true);
   m_init_event.Set();
 
-  WorkerThreadRun();
+  WorkerThreadRun(queue_index);
 
   WorkerThreadExit(param);
 }
 
-void AsyncShaderCompiler::WorkerThreadRun()
+void AsyncShaderCompiler::WorkerThreadRun(size_t queue_index)
 {
-  std::unique_lock<std::mutex> pending_lock(m_pending_work_lock);
   while (!m_exit_flag.IsSet())
   {
-    m_worker_thread_wake.wait(pending_lock);
+    m_busy_workers++;
+    std::optional<QueuedWorkItem> work = PopWorkItem(queue_index);
+    if (!work)
+    {
+      m_busy_workers--;
+
+      std::unique_lock<std::mutex> wake_lock(m_wake_lock);
+      m_worker_thread_wake.wait(
+          wake_lock, [this] { return m_exit_flag.IsSet() || GetQueuedWorkCount() != 0; });
+
+      // An item which is counted, but not in a queue yet, is about to be pushed.
+      if (!m_exit_flag.IsSet())
+        std::this_thread::yield();
+      continue;
+    }
 
-    while (!m_pending_work.empty() && !m_exit_flag.IsSet())
+    if (work->item->Compile())
     {
-      m_busy_workers++;
-      auto iter = m_pending_work.begin();
-      WorkItemPtr item(std::move(iter->second));
-      m_pending_work.erase(iter);
-      pending_lock.unlock();
+      std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
+      m_completed_work.push_back(std::move(*work));
+    }
+
+    m_busy_workers--;
+  }
+}
+
+std::optional<AsyncShaderCompiler::QueuedWorkItem>
+AsyncShaderCompiler::PopWorkItem(size_t queue_index)
+{
+  const size_t num_queues = m_worker_queues.size();
+  for (u32 lane = 0; lane < NUM_PRIORITIES; lane++)
+  {
+    if (m_queued_work[lane].load() == 0)
+      continue;
 
-      if (item->Compile())
+    // Start with this worker's own queue, then steal from the others.
+    for (size_t i = 0; i < num_queues; i++)
+    {
+      WorkerQueue& queue = *m_worker_queues[(queue_index + i) % num_queues];
+      std::unique_lock<std::mutex> guard(queue.lock);
+      std::deque<QueuedWorkItem>& items = queue.lanes[lane];
+      if (items.empty())
+        continue;
+
+      QueuedWorkItem work = std::move(items.front());
+      items.pop_front();
+      m_queued_work[lane]--;
+      guard.unlock();
+
+      const u64 wait_us = std::chrono::duration_cast<std::chrono::microseconds>(
+                              Clock::now() - work.queue_time)
+                              .count();
+      LaneStatistics& statistics = m_statistics[lane];
+      statistics.num_items++;
+      statistics.total_wait_us += wait_us;
+      u64 max_wait_us = statistics.max_wait_us.load();
+      while (wait_us > max_wait_us &&
+             !statistics.max_wait_us.compare_exchange_weak(max_wait_us, wait_us))
       {
-        std::lock_guard<std::mutex> completed_guard(m_completed_work_lock);
-        m_completed_work.push_back(std::move(item));
       }
 
-      pending_lock.lock();
-      m_busy_workers--;
+      return work;
     }
   }
+
+  return std::nullopt;
+}
+
+size_t AsyncShaderCompiler::GetQueuedWorkCount() const
+{
+  size_t count = 0;
+  for (const std::atomic_size_t& lane_count : m_queued_work)
+    count += lane_count.load();
+  return count;
 }
 
 }  // namespace VideoCommon
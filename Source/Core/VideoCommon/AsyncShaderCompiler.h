@@ -3,13 +3,15 @@
 
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <deque>
 #include <functional>
-#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <thread>
 #include <utility>
 #include <vector>
@@ -33,6 +35,17 @@ public:
 
   using WorkItemPtr = std::unique_ptr<WorkItem>;
 
+  // Number of priority lanes. Priorities at or above this use the last lane.
+  static constexpr u32 NUM_PRIORITIES = 3;
+
+  // Time work items of a priority lane spent queued before a worker thread started them.
+  struct QueueStatistics
+  {
+    u64 num_items = 0;
+    std::chrono::microseconds total_wait{};
+    std::chrono::microseconds max_wait{};
+  };
+
   AsyncShaderCompiler();
   virtual ~AsyncShaderCompiler();
 
@@ -43,12 +56,20 @@ public:
   }
 
   // Queues a new work item to the compiler threads. The lower the priority, the sooner
-  // this work item will be compiled, relative to the other work items.
+  // this work item will be compiled, relative to the other work items. Work items of the same
+  // priority are started in the order they were queued.
   void QueueWorkItem(WorkItemPtr item, u32 priority);
   void RetrieveWorkItems();
   bool HasPendingWork();
   bool HasCompletedWork();
 
+  // Drops all queued work items. Items which are already being compiled are finished, but are
+  // not retrieved.
+  void CancelPendingWork();
+
+  std::array<QueueStatistics, NUM_PRIORITIES> GetQueueStatistics() const;
+  void ResetQueueStatistics();
+
   // Calls progress_callback periodically, with completed_items, and total_items.
   // Returns false if interrupted.
   bool WaitUntilCompletion(const std::function<void(size_t, size_t)>& progress_callback);
@@ -65,8 +86,35 @@ protected:
   virtual void WorkerThreadExit(void* param);
 
 private:
-  void WorkerThreadEntryPoint(void* param);
-  void WorkerThreadRun();
+  using Clock = std::chrono::steady_clock;
+
+  struct QueuedWorkItem
+  {
+    WorkItemPtr item;
+    Clock::time_point queue_time;
+    u64 generation;
+  };
+
+  // Each worker thread has its own queue, so queueing and starting work items rarely contend.
+  // Idle workers steal from the other queues, and take higher priority work from them before
+  // starting lower priority work of their own.
+  struct WorkerQueue
+  {
+    std::mutex lock;
+    std::array<std::deque<QueuedWorkItem>, NUM_PRIORITIES> lanes;
+  };
+
+  struct LaneStatistics
+  {
+    std::atomic<u64> num_items{0};
+    std::atomic<u64> total_wait_us{0};
+    std::atomic<u64> max_wait_us{0};
+  };
+
+  void WorkerThreadEntryPoint(void* param, size_t queue_index);
+  void WorkerThreadRun(size_t queue_index);
+  std::optional<QueuedWorkItem> PopWorkItem(size_t queue_index);
+  size_t GetQueuedWorkCount() const;
 
   Common::Flag m_exit_flag;
   Common::Event m_init_event;
@@ -74,14 +122,18 @@ private:
   std::vector<std::thread> m_worker_threads;
   std::atomic_bool m_worker_thread_start_result{false};
 
-  // A multimap is used to store the work items. We can't use a priority_queue here, because
-  // there's no way to obtain a non-const reference, which we need for the unique_ptr.
-  std::multimap<u32, WorkItemPtr> m_pending_work;
-  std::mutex m_pending_work_lock;
-  std::condition_variable m_worker_thread_wake;
+  // The queues are only resized while the worker threads are stopped.
+  std::vector<std::unique_ptr<WorkerQueue>> m_worker_queues;
+  size_t m_next_queue = 0;
+  std::array<std::atomic_size_t, NUM_PRIORITIES> m_queued_work{};
   std::atomic_size_t m_busy_workers{0};
+  std::atomic<u64> m_generation{0};
+  std::array<LaneStatistics, NUM_PRIORITIES> m_statistics;
+
+  std::mutex m_wake_lock;
+  std::condition_variable m_worker_thread_wake;
 
-  std::deque<WorkItemPtr> m_completed_work;
+  std::deque<QueuedWorkItem> m_completed_work;
   std::mutex m_completed_work_lock;
 };
 
@@ -4,6 +4,7 @@
 #pragma once
 
 #include <array>
+#include <span>
 #include <string>
 #include <utility>
 
@@ -2532,7 +2533,16 @@ struct BPMemory
 
 extern BPMemory bpmem;
 
+struct BPWrite
+{
+  u8 reg;
+  u32 value;
+  int cycles_into_future;
+};
+
 void LoadBPReg(u8 reg, u32 value, int cycles_into_future);
+// Same as calling LoadBPReg for each write in order, without looking up the managers each time.
+void LoadBPRegs(std::span<const BPWrite> writes);
 void LoadBPRegPreprocess(u8 reg, u32 value, int cycles_into_future);
 
 std::pair<std::string, std::string> GetBPRegInfo(u8 cmd, u32 cmddata);
@@ -784,10 +784,10 @@ static void BPWritten(PixelShaderManager& pixel_shader_manager, XFStateManager&
 }
 
 // Call browser: OpcodeDecoding.cpp RunCallback::OnBP()
-void LoadBPReg(u8 reg, u32 value, int cycles_into_future)
+static void LoadBPReg(PixelShaderManager& pixel_shader_manager, XFStateManager& xf_state_manager,
+                      GeometryShaderManager& geometry_shader_manager, u8 reg, u32 value,
+                      int cycles_into_future)
 {
-  auto& system = Core::System::GetInstance();
-
   int oldval = ((u32*)&bpmem)[reg];
   int newval = (oldval & ~bpmem.bpMask) | (value & bpmem.bpMask);
   int changes = (oldval ^ newval) & 0xFFFFFF;
@@ -798,8 +798,29 @@ void LoadBPReg(u8 reg, u32 value, int cycles_into_future)
   if (reg != BPMEM_BP_MASK)
     bpmem.bpMask = 0xFFFFFF;
 
-  BPWritten(system.GetPixelShaderManager(), system.GetXFStateManager(),
-            system.GetGeometryShaderManager(), bp, cycles_into_future);
+  BPWritten(pixel_shader_manager, xf_state_manager, geometry_shader_manager, bp,
+            cycles_into_future);
+}
+
+void LoadBPReg(u8 reg, u32 value, int cycles_into_future)
+{
+  auto& system = Core::System::GetInstance();
+  LoadBPReg(system.GetPixelShaderManager(), system.GetXFStateManager(),
+            system.GetGeometryShaderManager(), reg, value, cycles_into_future);
+}
+
+void LoadBPRegs(std::span<const BPWrite> writes)
+{
+  auto& system = Core::System::GetInstance();
+  auto& pixel_shader_manager = system.GetPixelShaderManager();
+  auto& xf_state_manager = system.GetXFStateManager();
+  auto& geometry_shader_manager = system.GetGeometryShaderManager();
+
+  for (const BPWrite& write : writes)
+  {
+    LoadBPReg(pixel_shader_manager, xf_state_manager, geometry_shader_manager, write.reg,
+              write.value, write.cycles_into_future);
+  }
 }
 
 void LoadBPRegPreprocess(u8 reg, u32 value, int cycles_into_future)
@@ -3,10 +3,13 @@
 
 #include "VideoCommon/CPUCull.h"
 
+#include <algorithm>
+#include <atomic>
+
 #include "Common/Assert.h"
 #include "Common/CPUDetect.h"
-#include "Common/MathUtil.h"
 #include "Common/MemoryUtil.h"
+#include "Common/WorkerPool.h"
 #include "Core/System.h"
 
 #include "VideoCommon/CPMemory.h"
@@ -70,6 +73,18 @@ static constexpr int MIN_SSE = 0;
 #endif
 #endif
 
+// Draws are transformed and culled in chunks of this many vertices, so that visible draws can stop
+// early. It is a multiple of 12, so every chunk starts on a whole triangle or quad, and on an even
+// vertex of a strip.
+static constexpr u32 CHUNK_SIZE = 1536;
+
+// Each thread's buffer holds a chunk, the two vertices before it for strips and fans, and the first
+// vertex of a fan. The chunk itself is kept 32-byte aligned for the AVX transform.
+static constexpr u32 TRANSFORM_BUFFER_SIZE = CHUNK_SIZE + 4;
+
+// Culling fewer remaining vertices is faster than waking up the workers.
+static constexpr u32 MIN_PARALLEL_VERTICES = 4 * CHUNK_SIZE;
+
 template <bool PositionHas3Elems, bool PerVertexPosMtx>
 static CPUCull::TransformFunction GetTransformFunction()
 {
@@ -123,8 +138,9 @@ static Common::EnumMap<CPUCull::CullFunction, CullMode::All> GetCullFunction1()
 
 CPUCull::~CPUCull() = default;
 
-void CPUCull::Init()
+void CPUCull::Init(Common::WorkerPool* workers)
 {
+  m_workers = workers;
   m_transform_table[false][false] = GetTransformFunction<false, false>();
   m_transform_table[false][true] = GetTransformFunction<false, true>();
   m_transform_table[true][false] = GetTransformFunction<true, false>();
@@ -145,13 +161,6 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   const u32 stride = loader->m_native_vtx_decl.stride;
   const bool posHas3Elems = loader->m_native_vtx_decl.position.components >= 3;
   const bool perVertexPosMtx = loader->m_native_vtx_decl.posmtx.enable;
-  if (m_transform_buffer_size < count) [[unlikely]]
-  {
-    u32 new_size = MathUtil::NextPowerOf2(count);
-    m_transform_buffer_size = new_size;
-    m_transform_buffer.reset(static_cast<TransformedVertex*>(
-        Common::AllocateAlignedMemory(new_size * sizeof(TransformedVertex), 32)));
-  }
 
   // transform functions need the projection matrix to tranform to clip space
   auto& system = Core::System::GetInstance();
@@ -163,10 +172,79 @@ bool CPUCull::AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Prim
   CullMode cullmode = bpmem.genMode.cullmode;
   if (xfmem.viewport.ht > 0)  // See videosoftware Clipper.cpp:IsBackface
     cullmode = cullmode_invert[cullmode];
-  const TransformFunction transform = m_transform_table[posHas3Elems][perVertexPosMtx];
-  transform(m_transform_buffer.get(), src, stride, count);
-  const CullFunction cull = m_cull_table[primitive][cullmode];
-  return cull(m_transform_buffer.get(), count);
+  const Draw draw{m_transform_table[posHas3Elems][perVertexPosMtx],
+                  m_cull_table[primitive][cullmode], primitive, src, stride, count};
+
+  // Most draws are visible, which usually shows in the first chunk already. So only draws which
+  // are culled at least that far are split between the workers.
+  if (!IsChunkCulled(draw, GetTransformBuffer(0), 0))
+    return false;
+  if (count <= CHUNK_SIZE)
+    return true;
+
+  if (!m_workers || m_workers->GetWorkerCount() == 0 || count - CHUNK_SIZE < MIN_PARALLEL_VERTICES)
+  {
+    for (u32 start = CHUNK_SIZE; start < count; start += CHUNK_SIZE)
+    {
+      if (!IsChunkCulled(draw, GetTransformBuffer(0), start))
+        return false;
+    }
+    return true;
+  }
+
+  const u32 num_chunks = (count + CHUNK_SIZE - 1) / CHUNK_SIZE;
+  std::atomic<u32> next_chunk = 1;
+  std::atomic<bool> visible = false;
+  // Allocates the buffers of all threads before the workers start using them.
+  GetTransformBuffer(m_workers->GetWorkerCount());
+  m_workers->Run([&](u32 thread) {
+    TransformedVertex* buffer = GetTransformBuffer(thread);
+    while (!visible.load(std::memory_order_relaxed))
+    {
+      const u32 chunk = next_chunk++;
+      if (chunk >= num_chunks)
+        break;
+      if (!IsChunkCulled(draw, buffer, chunk * CHUNK_SIZE))
+        visible.store(true, std::memory_order_relaxed);
+    }
+  });
+  return !visible.load(std::memory_order_relaxed);
+}
+
+bool CPUCull::IsChunkCulled(const Draw& draw, TransformedVertex* buffer, u32 start)
+{
+  using OpcodeDecoder::Primitive;
+  const u32 end = std::min(start + CHUNK_SIZE, draw.count);
+
+  // The first triangles of later strip and fan chunks need the vertices before the chunk, and fans
+  // also need their first vertex.
+  u32 first = start;
+  TransformedVertex* cull_start = buffer + 2;
+  if (start != 0 && draw.primitive == Primitive::GX_DRAW_TRIANGLE_STRIP)
+  {
+    first = start - 2;
+  }
+  else if (start != 0 && draw.primitive == Primitive::GX_DRAW_TRIANGLE_FAN)
+  {
+    first = start - 1;
+    cull_start = buffer + 1;
+    draw.transform(cull_start, draw.src, draw.stride, 1);
+  }
+
+  draw.transform(buffer + 2, draw.src + first * draw.stride, draw.stride, end - first);
+  return draw.cull(cull_start, static_cast<int>(buffer + 2 - cull_start + end - first));
+}
+
+CPUCull::TransformedVertex* CPUCull::GetTransformBuffer(u32 thread)
+{
+  const u32 size = (thread + 1) * TRANSFORM_BUFFER_SIZE;
+  if (m_transform_buffer_size < size) [[unlikely]]
+  {
+    m_transform_buffer_size = size;
+    m_transform_buffer.reset(static_cast<TransformedVertex*>(
+        Common::AllocateAlignedMemory(size * sizeof(TransformedVertex), 32)));
+  }
+  return m_transform_buffer.get() + thread * TRANSFORM_BUFFER_SIZE;
 }
 
 template <typename T>
@@ -7,11 +7,17 @@
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/OpcodeDecoding.h"
 
+namespace Common
+{
+class WorkerPool;
+}
+
 class CPUCull
 {
 public:
   ~CPUCull();
-  void Init();
+  // Large draws which aren't visible early on are culled by the workers (if any) as well.
+  void Init(Common::WorkerPool* workers);
   bool AreAllVerticesCulled(VertexLoaderBase* loader, OpcodeDecoder::Primitive primitive,
                             const u8* src, u32 count);
 
@@ -24,13 +30,28 @@ public:
   using CullFunction = bool (*)(const CPUCull::TransformedVertex*, int);
 
 private:
+  struct Draw
+  {
+    TransformFunction transform;
+    CullFunction cull;
+    OpcodeDecoder::Primitive primitive;
+    const u8* src;
+    u32 stride;
+    u32 count;
+  };
+
+  static bool IsChunkCulled(const Draw& draw, TransformedVertex* buffer, u32 start);
+  TransformedVertex* GetTransformBuffer(u32 thread);
+
   template <typename T>
   struct BufferDeleter
   {
     void operator()(T* ptr);
   };
+  // One buffer for each thread.
   std::unique_ptr<TransformedVertex[], BufferDeleter<TransformedVertex>> m_transform_buffer{};
   u32 m_transform_buffer_size = 0;
+  Common::WorkerPool* m_workers = nullptr;
   std::array<std::array<TransformFunction, 2>, 2> m_transform_table{};
   Common::EnumMap<Common::EnumMap<CullFunction, CullMode::All>,
                   OpcodeDecoder::Primitive::GX_DRAW_TRIANGLE_FAN>
@@ -4,6 +4,7 @@
 #include "VideoCommon/Fifo.h"
 
 #include <atomic>
+#include <chrono>
 #include <cstring>
 
 #include "Common/Assert.h"
@@ -36,6 +37,10 @@ namespace Fifo
 {
 static constexpr int GPU_TIME_SLOT_SIZE = 1000;
 
+// In deterministic GPU thread mode, preprocessed commands are handed to the GPU thread once this
+// many bytes are ready, and at the end of each time slot.
+static constexpr size_t VIDEO_BUFFER_SEGMENT_SIZE = 16 * 1024;
+
 FifoManager::FifoManager(Core::System& system) : m_system{system}
 {
 }
@@ -60,7 +65,7 @@ void FifoManager::DoState(PointerWrap& p)
   if (p.IsReadMode() && m_use_deterministic_gpu_thread)
   {
     // We're good and paused, right?
-    m_video_buffer_seen_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
+    m_video_buffer_publish_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
   }
 
   p.Do(m_sync_ticks);
@@ -110,10 +115,15 @@ void FifoManager::Shutdown()
   m_video_buffer_write_ptr = nullptr;
   m_video_buffer_pp_read_ptr = nullptr;
   m_video_buffer_read_ptr = nullptr;
-  m_video_buffer_seen_ptr = nullptr;
+  m_video_buffer_publish_ptr = nullptr;
   m_fifo_aux_write_ptr = nullptr;
   m_fifo_aux_read_ptr = nullptr;
 
+  m_gpu_segments.Clear();
+  m_pending_segments.Clear();
+  m_preprocessed_cycles = 0;
+  m_gpu_cycles_executed.store(0);
+
   if (m_config_callback_id)
   {
     Config::RemoveConfigChangedCallback(*m_config_callback_id);
@@ -150,6 +160,9 @@ void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
 {
   if (m_use_deterministic_gpu_thread)
   {
+    // Hand over everything that was preprocessed, so it is included in the wait.
+    PublishVideoBufferSegment();
+
     m_gpu_mainloop.Wait();
     if (!m_gpu_mainloop.IsRunning())
       return;
@@ -173,13 +186,10 @@ void FifoManager::SyncGPU(SyncGPUReason reason, bool may_move_read_ptr)
       size_t size = write_ptr - m_video_buffer_pp_read_ptr;
 
       memmove(m_video_buffer, m_video_buffer_pp_read_ptr, size);
-      // This change always decreases the pointers.  We write seen_ptr
-      // after write_ptr here, and read it before in RunGpuLoop, so
-      // 'write_ptr > seen_ptr' there cannot become spuriously true.
-      m_video_buffer_write_ptr = write_ptr = m_video_buffer + size;
+      m_video_buffer_write_ptr = m_video_buffer + size;
       m_video_buffer_pp_read_ptr = m_video_buffer;
+      m_video_buffer_publish_ptr = m_video_buffer;
       m_video_buffer_read_ptr = m_video_buffer;
-      m_video_buffer_seen_ptr = write_ptr;
     }
   }
 }
@@ -242,21 +252,8 @@ void FifoManager::ReadDataFromFifoOnCPU(u32 read_ptr)
   u8* write_ptr = m_video_buffer_write_ptr;
   if (GPFifo::GATHER_PIPE_SIZE > static_cast<size_t>(m_video_buffer + FIFO_SIZE - write_ptr))
   {
-    // We can't wrap around while the GPU is working on the data.
-    // This should be very rare due to the reset in SyncGPU.
-    SyncGPU(SyncGPUReason::Wraparound);
-    if (!m_gpu_mainloop.IsRunning())
-    {
-      // GPU is shutting down, so the next asserts may fail
-      return;
-    }
-
-    if (m_video_buffer_pp_read_ptr != m_video_buffer_read_ptr)
-    {
-      PanicAlertFmt("Desynced read pointers");
-      return;
-    }
-    write_ptr = m_video_buffer_write_ptr;
+    // Commands have to be contiguous, so the incomplete command at the end is moved to the start
+    // of the buffer, once the GPU thread is done with the segments there.
     const size_t existing_len = write_ptr - m_video_buffer_pp_read_ptr;
     if (GPFifo::GATHER_PIPE_SIZE > static_cast<size_t>(FIFO_SIZE - existing_len))
     {
@@ -264,23 +261,99 @@ void FifoManager::ReadDataFromFifoOnCPU(u32 read_ptr)
                     GPFifo::GATHER_PIPE_SIZE, FIFO_SIZE);
       return;
     }
+
+    PublishVideoBufferSegment();
+    if (!WaitForGpuToLeave(m_video_buffer,
+                           m_video_buffer + existing_len + GPFifo::GATHER_PIPE_SIZE))
+    {
+      // GPU is shutting down
+      return;
+    }
+
+    memmove(m_video_buffer, m_video_buffer_pp_read_ptr, existing_len);
+    write_ptr = m_video_buffer + existing_len;
+    m_video_buffer_pp_read_ptr = m_video_buffer;
+    m_video_buffer_publish_ptr = m_video_buffer;
   }
+  else if (!WaitForGpuToLeave(write_ptr, write_ptr + GPFifo::GATHER_PIPE_SIZE))
+  {
+    // GPU is shutting down
+    return;
+  }
+
   auto& memory = m_system.GetMemory();
-  memory.CopyFromEmu(m_video_buffer_write_ptr, read_ptr, GPFifo::GATHER_PIPE_SIZE);
+  memory.CopyFromEmu(write_ptr, read_ptr, GPFifo::GATHER_PIPE_SIZE);
+  u32 cycles = 0;
   m_video_buffer_pp_read_ptr = OpcodeDecoder::RunFifo<true>(
-      DataReader(m_video_buffer_pp_read_ptr, write_ptr + GPFifo::GATHER_PIPE_SIZE), nullptr);
-  // This would have to be locked if the GPU thread didn't spin.
+      DataReader(m_video_buffer_pp_read_ptr, write_ptr + GPFifo::GATHER_PIPE_SIZE), &cycles);
+  m_preprocessed_cycles += cycles;
   m_video_buffer_write_ptr = write_ptr + GPFifo::GATHER_PIPE_SIZE;
 }
 
+void FifoManager::PublishVideoBufferSegment()
+{
+  if (m_video_buffer_publish_ptr == m_video_buffer_pp_read_ptr)
+    return;
+
+  // Every command takes at least one cycle, so the stamp is unique.
+  const VideoBufferSegment segment{m_video_buffer_publish_ptr, m_video_buffer_pp_read_ptr,
+                                   m_preprocessed_cycles};
+  m_pending_segments.Add(segment);
+  m_gpu_segments.Push(segment);
+  m_video_buffer_publish_ptr = m_video_buffer_pp_read_ptr;
+  m_gpu_mainloop.Wakeup();
+}
+
+void PendingVideoBufferSegments::Retire(u64 cycles_executed)
+{
+  while (!m_segments.empty() && m_segments.front().cycles <= cycles_executed)
+    m_segments.pop_front();
+}
+
+bool PendingVideoBufferSegments::Overlaps(const u8* begin, const u8* end) const
+{
+  if (m_segments.empty())
+    return false;
+
+  // If the newest segment ends where the oldest one begins, they cover the whole buffer.
+  const u8* const oldest = m_segments.front().begin;
+  const u8* const newest = m_segments.back().end;
+  if (oldest < newest)
+    return begin < newest && oldest < end;
+  return oldest < end || begin < newest;
+}
+
+// Waits until the GPU thread has run the segments overlapping [begin, end), so the CPU thread can
+// write there. Returns false if the GPU thread is shutting down.
+bool FifoManager::WaitForGpuToLeave(const u8* begin, const u8* end)
+{
+  for (;;)
+  {
+    m_pending_segments.Retire(m_gpu_cycles_executed.load(std::memory_order_acquire));
+    if (!m_pending_segments.Overlaps(begin, end))
+      return true;
+
+    if (!m_gpu_mainloop.IsRunning())
+      return false;
+    m_gpu_mainloop.Wakeup();
+    m_gpu_progress_event.WaitFor(std::chrono::milliseconds(1));
+  }
+}
+
 void FifoManager::ResetVideoBuffer()
 {
   m_video_buffer_read_ptr = m_video_buffer;
   m_video_buffer_write_ptr = m_video_buffer;
-  m_video_buffer_seen_ptr = m_video_buffer;
   m_video_buffer_pp_read_ptr = m_video_buffer;
+  m_video_buffer_publish_ptr = m_video_buffer;
   m_fifo_aux_write_ptr = m_fifo_aux_data;
   m_fifo_aux_read_ptr = m_fifo_aux_data;
+
+  // Segments which weren't run yet point to data which was dropped. Only the GPU thread may take
+  // them from the queue, the CPU thread retires them once it sees the stamp.
+  VideoBufferSegment segment;
+  while (m_gpu_segments.Pop(segment))
+    m_gpu_cycles_executed.store(segment.cycles, std::memory_order_release);
 }
 
 // Description: Main FIFO update loop
@@ -302,14 +375,13 @@ void FifoManager::RunGpuLoop()
         if (m_use_deterministic_gpu_thread)
         {
           // All the fifo/CP stuff is on the CPU.  We just need to run the opcode decoder.
-          u8* seen_ptr = m_video_buffer_seen_ptr;
-          u8* write_ptr = m_video_buffer_write_ptr;
-          // See comment in SyncGPU
-          if (write_ptr > seen_ptr)
+          VideoBufferSegment segment;
+          while (m_gpu_segments.Pop(segment))
           {
             m_video_buffer_read_ptr =
-                OpcodeDecoder::RunFifo(DataReader(m_video_buffer_read_ptr, write_ptr), nullptr);
-            m_video_buffer_seen_ptr = write_ptr;
+                OpcodeDecoder::RunFifo(DataReader(segment.begin, segment.end), nullptr);
+            m_gpu_cycles_executed.store(segment.cycles, std::memory_order_release);
+            m_gpu_progress_event.Set();
           }
         }
         else
@@ -453,7 +525,11 @@ int FifoManager::RunGpuOnCpu(int ticks)
     if (m_use_deterministic_gpu_thread)
     {
       ReadDataFromFifoOnCPU(fifo.CPReadPointer.load(std::memory_order_relaxed));
-      m_gpu_mainloop.Wakeup();
+      if (static_cast<size_t>(m_video_buffer_pp_read_ptr - m_video_buffer_publish_ptr) >=
+          VIDEO_BUFFER_SEGMENT_SIZE)
+      {
+        PublishVideoBufferSegment();
+      }
     }
     else
     {
@@ -484,6 +560,9 @@ int FifoManager::RunGpuOnCpu(int ticks)
     fifo.CPReadWriteDistance.fetch_sub(GPFifo::GATHER_PIPE_SIZE, std::memory_order_relaxed);
   }
 
+  if (m_use_deterministic_gpu_thread)
+    PublishVideoBufferSegment();
+
   command_processor.SetCPStatusFromGPU();
 
   if (reset_simd_state)
@@ -528,7 +607,7 @@ void FifoManager::UpdateWantDeterminism(bool want)
     if (gpu_thread)
     {
       // These haven't been updated in non-deterministic mode.
-      m_video_buffer_seen_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
+      m_video_buffer_publish_ptr = m_video_buffer_pp_read_ptr = m_video_buffer_read_ptr;
       CopyPreprocessCPStateFromMain();
       VertexLoaderManager::MarkAllDirty();
     }
@@ -5,6 +5,7 @@
 
 #include <atomic>
 #include <cstddef>
+#include <deque>
 #include <optional>
 
 #include "Common/BlockingLoop.h"
@@ -12,6 +13,7 @@
 #include "Common/Config/Config.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
+#include "Common/SPSCQueue.h"
 
 class PointerWrap;
 
@@ -38,6 +40,38 @@ enum class SyncGPUReason
   AuxSpace,
 };
 
+// A run of preprocessed commands in the video buffer, handed to the GPU thread in deterministic
+// GPU thread mode. Only whole commands are included, so the GPU thread never has to wait for the
+// rest of a command. cycles is the total of the preprocessed cycles up to the end of the segment,
+// which always increases, so it also identifies the segment.
+struct VideoBufferSegment
+{
+  u8* begin = nullptr;
+  u8* end = nullptr;
+  u64 cycles = 0;
+};
+
+// The CPU thread's copy of the segments it handed to the GPU thread, which the GPU thread may not
+// have run yet. They follow each other through the video buffer in the order they were added, and
+// wrap around to the start of the buffer at most once.
+class PendingVideoBufferSegments
+{
+public:
+  bool IsEmpty() const { return m_segments.empty(); }
+  void Add(const VideoBufferSegment& segment) { m_segments.push_back(segment); }
+  void Clear() { m_segments.clear(); }
+
+  // Drops the segments up to the one the GPU thread reported as its last, by its stamp.
+  void Retire(u64 cycles_executed);
+
+  // Whether [begin, end) overlaps the part of the buffer from the start of the oldest segment to
+  // the end of the newest one. After wrapping around, this includes the end of the buffer.
+  bool Overlaps(const u8* begin, const u8* end) const;
+
+private:
+  std::deque<VideoBufferSegment> m_segments;
+};
+
 class FifoManager final
 {
 public:
@@ -79,6 +113,8 @@ private:
   void RefreshConfig();
   void ReadDataFromFifo(u32 read_ptr);
   void ReadDataFromFifoOnCPU(u32 read_ptr);
+  void PublishVideoBufferSegment();
+  bool WaitForGpuToLeave(const u8* begin, const u8* end);
   int RunGpuOnCpu(int ticks);
   int WaitForGpuThread(int ticks);
   static void SyncGPUCallback(Core::System& system, u64 ticks, s64 cyclesLate);
@@ -104,19 +140,26 @@ private:
   u8* m_video_buffer = nullptr;
   u8* m_video_buffer_read_ptr = nullptr;
   std::atomic<u8*> m_video_buffer_write_ptr = nullptr;
-  std::atomic<u8*> m_video_buffer_seen_ptr = nullptr;
   u8* m_video_buffer_pp_read_ptr = nullptr;
   // The read_ptr is always owned by the GPU thread.  In normal mode, so is the
-  // write_ptr, despite it being atomic.  In deterministic GPU thread mode,
-  // things get a bit more complicated:
-  // - The seen_ptr is written by the GPU thread, and points to what it's already
-  // processed as much of as possible - in the case of a partial command which
-  // caused it to stop, not the same as the read ptr.  It's written by the GPU,
-  // under the lock, and updating the cond.
-  // - The write_ptr is written by the CPU thread after it copies data from the
-  // FIFO.  Maybe someday it will be under the lock.  For now, because RunGpuLoop
-  // polls, it's just atomic.
-  // - The pp_read_ptr is the CPU preprocessing version of the read_ptr.
+  // write_ptr, despite it being atomic.  In deterministic GPU thread mode, the
+  // video buffer is used as a ring instead:
+  // - The write_ptr and pp_read_ptr are owned by the CPU thread. The data between
+  // them is the incomplete command the CPU is still waiting for the rest of.
+  // - Whole commands up to the pp_read_ptr are handed to the GPU thread as
+  // segments, through m_gpu_segments. The CPU only waits for the GPU thread
+  // when it would overwrite a segment the GPU thread has not run yet.
+  // - When the end of the buffer is reached, the incomplete command is moved to
+  // the start of the buffer, and segments continue from there.
+
+  // Deterministic GPU thread mode state. m_pending_segments and the counters are only used by the
+  // CPU thread, the GPU thread reports its progress through m_gpu_cycles_executed.
+  Common::SPSCQueue<VideoBufferSegment, false> m_gpu_segments;
+  PendingVideoBufferSegments m_pending_segments;
+  u8* m_video_buffer_publish_ptr = nullptr;
+  u64 m_preprocessed_cycles = 0;
+  std::atomic<u64> m_gpu_cycles_executed = 0;
+  Common::Event m_gpu_progress_event;
 
   std::atomic<int> m_sync_ticks = 0;
   bool m_syncing_suspended = false;
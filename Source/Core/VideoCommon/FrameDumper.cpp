@@ -3,6 +3,8 @@
 
 #include "VideoCommon/FrameDumper.h"
 
+#include <algorithm>
+
 #include "Common/Assert.h"
 #include "Common/FileUtil.h"
 #include "Common/Image.h"
@@ -49,6 +51,13 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
   int target_width = target_rect.GetWidth();
   int target_height = target_rect.GetHeight();
 
+  const u32 index = m_next_frame_dump_buffer;
+  if (!ReleaseFrameDumpBuffer(index, true))
+  {
+    m_frame_dump_dropped_frames++;
+    return;
+  }
+
   // We only need to render a copy if we need to stretch/scale the XFB copy.
   MathUtil::Rectangle<int> copy_rect = src_rect;
   if (source_width != target_width || source_height != target_height)
@@ -62,13 +71,16 @@ void FrameDumper::DumpCurrentFrame(const AbstractTexture* src_texture,
     copy_rect = src_texture->GetRect();
   }
 
-  if (!CheckFrameDumpReadbackTexture(target_width, target_height))
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[index];
+  if (!CheckFrameDumpReadbackTexture(buffer, target_width, target_height))
     return;
 
-  m_frame_dump_readback_texture->CopyFromTexture(src_texture, copy_rect, 0, 0,
-                                                 m_frame_dump_readback_texture->GetRect());
-  m_last_frame_state = m_ffmpeg_dump.FetchState(ticks, frame_number);
-  m_frame_dump_needs_flush = true;
+  // The copy is only read back a frame later, by which time the GPU should have executed it.
+  buffer.texture->CopyFromTexture(src_texture, copy_rect, 0, 0, buffer.texture->GetRect());
+  buffer.frame.state = m_ffmpeg_dump.FetchState(ticks, frame_number);
+  buffer.copy_frame = m_frame_dump_frame_counter;
+  buffer.state = FrameDumpBuffer::State::Readback;
+  m_next_frame_dump_buffer = (index + 1) % NUM_FRAME_DUMP_BUFFERS;
 }
 
 bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_height)
@@ -99,9 +111,10 @@ bool FrameDumper::CheckFrameDumpRenderTexture(u32 target_width, u32 target_heigh
   return true;
 }
 
-bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height)
+bool FrameDumper::CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                                u32 target_height)
 {
-  std::unique_ptr<AbstractStagingTexture>& rbtex = m_frame_dump_readback_texture;
+  std::unique_ptr<AbstractStagingTexture>& rbtex = buffer.texture;
   if (rbtex && rbtex->GetWidth() == target_width && rbtex->GetHeight() == target_height)
     return true;
 
@@ -118,155 +131,204 @@ bool FrameDumper::CheckFrameDumpReadbackTexture(u32 target_width, u32 target_hei
 
 void FrameDumper::FlushFrameDump()
 {
-  if (!m_frame_dump_needs_flush)
+  if (!HasFrameDumpBuffersInUse())
     return;
 
-  // Ensure dumping thread is done with output texture before swapping.
-  FinishFrameData();
-
-  std::swap(m_frame_dump_output_texture, m_frame_dump_readback_texture);
-
-  // Queue encoding of the last frame dumped.
-  auto& output = m_frame_dump_output_texture;
-  output->Flush();
-  if (output->Map())
-  {
-    DumpFrameData(reinterpret_cast<u8*>(output->GetMappedPointer()), output->GetConfig().width,
-                  output->GetConfig().height, static_cast<int>(output->GetMappedStride()));
-  }
-  else
-  {
-    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
-  }
-
-  m_frame_dump_needs_flush = false;
+  // A screenshot is read back right away, so it is saved from the frame it was requested on.
+  SubmitFrameDumpBuffers(m_screenshot_request.IsSet() ? 0 : FRAME_DUMP_READBACK_LATENCY);
+  m_frame_dump_frame_counter++;
 
   // Shutdown frame dumping if it is no longer active.
   if (!IsFrameDumping())
     ShutdownFrameDumping();
 }
 
-void FrameDumper::ShutdownFrameDumping()
+void FrameDumper::SubmitFrameDumpBuffers(u64 min_age)
 {
-  // Ensure the last queued readback has been sent to the encoder.
-  FlushFrameDump();
+  // Starting at the next buffer to be reused goes through them from oldest to newest, so frames
+  // are encoded in order.
+  for (u32 i = 0; i < NUM_FRAME_DUMP_BUFFERS; i++)
+  {
+    const u32 index = (m_next_frame_dump_buffer + i) % NUM_FRAME_DUMP_BUFFERS;
+    FrameDumpBuffer& buffer = m_frame_dump_buffers[index];
+    if (buffer.state == FrameDumpBuffer::State::Encoding && buffer.encoded.load())
+    {
+      ReleaseFrameDumpBuffer(index, false);
+    }
+    else if (buffer.state == FrameDumpBuffer::State::Readback &&
+             buffer.copy_frame + min_age <= m_frame_dump_frame_counter)
+    {
+      SubmitFrameDumpBuffer(index);
+    }
+  }
+}
 
-  if (!m_frame_dump_thread_running.IsSet())
+void FrameDumper::SubmitFrameDumpBuffer(u32 index)
+{
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[index];
+  AbstractStagingTexture* const texture = buffer.texture.get();
+  texture->Flush();
+  if (!texture->Map())
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to map texture for dumping.");
+    buffer.state = FrameDumpBuffer::State::Free;
     return;
+  }
 
-  // Ensure previous frame has been encoded.
-  FinishFrameData();
+  buffer.frame.data = reinterpret_cast<const u8*>(texture->GetMappedPointer());
+  buffer.frame.width = texture->GetConfig().width;
+  buffer.frame.height = texture->GetConfig().height;
+  buffer.frame.stride = static_cast<int>(texture->GetMappedStride());
+  buffer.encoded.store(false);
+  buffer.state = FrameDumpBuffer::State::Encoding;
 
-  // Wake thread up, and wait for it to exit.
-  m_frame_dump_thread_running.Clear();
-  m_frame_dump_start.Set();
-  if (m_frame_dump_thread.joinable())
-    m_frame_dump_thread.join();
-  m_frame_dump_render_framebuffer.reset();
-  m_frame_dump_render_texture.reset();
+  if (!m_frame_dump_thread_running)
+  {
+    m_dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
+    m_frame_dump_started = false;
 
-  m_frame_dump_readback_texture.reset();
-  m_frame_dump_output_texture.reset();
+// If Dolphin was compiled without ffmpeg, we only support dumping to images.
+#if !defined(HAVE_FFMPEG)
+    if (m_dump_to_ffmpeg)
+    {
+      WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
+                          "Frames will be saved as PNG images instead.");
+      m_dump_to_ffmpeg = false;
+    }
+#endif
+
+    m_frame_dump_dropped_frames = 0;
+    m_frame_dump_thread.Reset("FrameDumping", [this](u32 frame) { DumpFrameBuffer(frame); });
+    m_frame_dump_thread_running = true;
+  }
+
+  m_frame_dump_thread.Push(index);
 }
 
-void FrameDumper::DumpFrameData(const u8* data, int w, int h, int stride)
+bool FrameDumper::ReleaseFrameDumpBuffer(u32 index, bool can_drop)
 {
-  m_frame_dump_data = FrameData{data, w, h, stride, m_last_frame_state};
-
-  if (!m_frame_dump_thread_running.IsSet())
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[index];
+  switch (buffer.state)
   {
-    if (m_frame_dump_thread.joinable())
-      m_frame_dump_thread.join();
-    m_frame_dump_thread_running.Set();
-    m_frame_dump_thread = std::thread(&FrameDumper::FrameDumpThreadFunc, this);
+  case FrameDumpBuffer::State::Free:
+    return true;
+
+  case FrameDumpBuffer::State::Readback:
+    // Every buffer holds a frame waiting for readback, so the oldest one has to be read now.
+    SubmitFrameDumpBuffer(index);
+    if (buffer.state != FrameDumpBuffer::State::Encoding)
+      return true;
+    [[fallthrough]];
+
+  case FrameDumpBuffer::State::Encoding:
+    if (!buffer.encoded.load())
+    {
+      // Screenshots are never dropped.
+      if (can_drop && g_ActiveConfig.bDumpFramesDropWhenBehind &&
+          !m_screenshot_request.IsSet())
+      {
+        return false;
+      }
+
+      while (!buffer.encoded.load())
+        m_frame_dump_done.Wait();
+    }
+
+    buffer.texture->Unmap();
+    buffer.state = FrameDumpBuffer::State::Free;
+    return true;
   }
 
-  // Wake worker thread up.
-  m_frame_dump_start.Set();
-  m_frame_dump_frame_running = true;
+  return true;
 }
 
-void FrameDumper::FinishFrameData()
+bool FrameDumper::HasFrameDumpBuffersInUse() const
 {
-  if (!m_frame_dump_frame_running)
-    return;
-
-  m_frame_dump_done.Wait();
-  m_frame_dump_frame_running = false;
-
-  m_frame_dump_output_texture->Unmap();
+  return std::any_of(m_frame_dump_buffers.begin(), m_frame_dump_buffers.end(),
+                     [](const FrameDumpBuffer& buffer) {
+                       return buffer.state != FrameDumpBuffer::State::Free;
+                     });
 }
 
-void FrameDumper::FrameDumpThreadFunc()
+void FrameDumper::ShutdownFrameDumping()
 {
-  Common::SetCurrentThreadName("FrameDumping");
+  // Ensure all copied frames have been sent to the encoder, and the encoder is done with them.
+  SubmitFrameDumpBuffers(0);
+  for (u32 i = 0; i < NUM_FRAME_DUMP_BUFFERS; i++)
+    ReleaseFrameDumpBuffer(i, false);
 
-  bool dump_to_ffmpeg = !g_ActiveConfig.bDumpFramesAsImages;
-  bool frame_dump_started = false;
+  if (!m_frame_dump_thread_running)
+    return;
 
-// If Dolphin was compiled without ffmpeg, we only support dumping to images.
-#if !defined(HAVE_FFMPEG)
-  if (dump_to_ffmpeg)
+  m_frame_dump_thread.Shutdown();
+  m_frame_dump_thread_running = false;
+
+  if (m_frame_dump_started)
   {
-    WARN_LOG_FMT(VIDEO, "FrameDump: Dolphin was not compiled with FFmpeg, using fallback option. "
-                        "Frames will be saved as PNG images instead.");
-    dump_to_ffmpeg = false;
+    // No additional cleanup is needed when dumping to images.
+    if (m_dump_to_ffmpeg)
+      StopFrameDumpToFFMPEG();
+    m_frame_dump_started = false;
   }
-#endif
 
-  while (true)
+  if (m_frame_dump_dropped_frames != 0)
   {
-    m_frame_dump_start.Wait();
-    if (!m_frame_dump_thread_running.IsSet())
-      break;
-
-    auto frame = m_frame_dump_data;
+    WARN_LOG_FMT(VIDEO, "FrameDump: Dropped {} frames because the encoder fell behind.",
+                 m_frame_dump_dropped_frames);
+  }
 
-    // Save screenshot
-    if (m_screenshot_request.TestAndClear())
-    {
-      std::lock_guard<std::mutex> lk(m_screenshot_lock);
+  m_frame_dump_render_framebuffer.reset();
+  m_frame_dump_render_texture.reset();
 
-      if (DumpFrameToPNG(frame, m_screenshot_name))
-        OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
+  for (FrameDumpBuffer& buffer : m_frame_dump_buffers)
+    buffer.texture.reset();
+}
 
-      // Reset settings
-      m_screenshot_name.clear();
-      m_screenshot_completed.Set();
-    }
+void FrameDumper::DumpFrameBuffer(u32 index)
+{
+  FrameDumpBuffer& buffer = m_frame_dump_buffers[index];
+  DumpFrame(buffer.frame);
+  buffer.encoded.store(true);
+  m_frame_dump_done.Set();
+}
 
-    if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
-    {
-      if (!frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          frame_dump_started = StartFrameDumpToFFMPEG(frame);
-        else
-          frame_dump_started = StartFrameDumpToImage(frame);
-
-        // Stop frame dumping if we fail to start.
-        if (!frame_dump_started)
-          Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
-      }
+void FrameDumper::DumpFrame(const FrameData& frame)
+{
+  // Save screenshot
+  if (m_screenshot_request.TestAndClear())
+  {
+    std::lock_guard<std::mutex> lk(m_screenshot_lock);
 
-      // If we failed to start frame dumping, don't write a frame.
-      if (frame_dump_started)
-      {
-        if (dump_to_ffmpeg)
-          DumpFrameToFFMPEG(frame);
-        else
-          DumpFrameToImage(frame);
-      }
-    }
+    if (DumpFrameToPNG(frame, m_screenshot_name))
+      OSD::AddMessage("Screenshot saved to " + m_screenshot_name);
 
-    m_frame_dump_done.Set();
+    // Reset settings
+    m_screenshot_name.clear();
+    m_screenshot_completed.Set();
   }
 
-  if (frame_dump_started)
+  if (Config::Get(Config::MAIN_MOVIE_DUMP_FRAMES))
   {
-    // No additional cleanup is needed when dumping to images.
-    if (dump_to_ffmpeg)
-      StopFrameDumpToFFMPEG();
+    if (!m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        m_frame_dump_started = StartFrameDumpToFFMPEG(frame);
+      else
+        m_frame_dump_started = StartFrameDumpToImage(frame);
+
+      // Stop frame dumping if we fail to start.
+      if (!m_frame_dump_started)
+        Config::SetCurrent(Config::MAIN_MOVIE_DUMP_FRAMES, false);
+    }
+
+    // If we failed to start frame dumping, don't write a frame.
+    if (m_frame_dump_started)
+    {
+      if (m_dump_to_ffmpeg)
+        DumpFrameToFFMPEG(frame);
+      else
+        DumpFrameToImage(frame);
+    }
   }
 }
 
@@ -3,11 +3,18 @@
 
 #pragma once
 
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
 #include "Common/CommonTypes.h"
 #include "Common/Event.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
 #include "Common/Thread.h"
+#include "Common/WorkQueueThread.h"
 
 #include "VideoCommon/FrameDumpFFMpeg.h"
 #include "VideoCommon/VideoEvents.h"
@@ -22,10 +29,10 @@ public:
   FrameDumper();
   ~FrameDumper();
 
-  // Ensures all rendered frames are queued for encoding.
+  // Queues the frames which the GPU has finished copying for encoding.
   void FlushFrameDump();
 
-  // Fills the frame dump staging texture with the current XFB texture.
+  // Copies the current XFB texture to the next frame dump staging texture.
   void DumpCurrentFrame(const AbstractTexture* src_texture,
                         const MathUtil::Rectangle<int>& src_rect,
                         const MathUtil::Rectangle<int>& target_rect, u64 ticks, int frame_number);
@@ -38,8 +45,35 @@ public:
   void DoState(PointerWrap& p);
 
 private:
+  // Number of frames which can be in flight between the GPU copy and the encoder. When all of them
+  // are in use, the video thread waits for the encoder, or drops the frame if allowed to.
+  static constexpr u32 NUM_FRAME_DUMP_BUFFERS = 4;
+
+  // Frames are read back this many frames after they were copied, so the GPU has finished the copy
+  // by then and mapping the staging texture doesn't stall. Screenshots are read back immediately.
+  static constexpr u64 FRAME_DUMP_READBACK_LATENCY = 1;
+
+  struct FrameDumpBuffer
+  {
+    enum class State
+    {
+      Free,
+      Readback,
+      Encoding,
+    };
+
+    std::unique_ptr<AbstractStagingTexture> texture;
+    FrameData frame;
+    u64 copy_frame = 0;
+    State state = State::Free;
+
+    // Set by the frame dump thread once it is done with the mapped texture.
+    std::atomic_bool encoded{false};
+  };
+
   // NOTE: The methods below are called on the framedumping thread.
-  void FrameDumpThreadFunc();
+  void DumpFrameBuffer(u32 index);
+  void DumpFrame(const FrameData& frame);
   bool StartFrameDumpToFFMPEG(const FrameData&);
   void DumpFrameToFFMPEG(const FrameData&);
   void StopFrameDumpToFFMPEG();
@@ -52,41 +86,42 @@ private:
   // Checks that the frame dump render texture exists and is the correct size.
   bool CheckFrameDumpRenderTexture(u32 target_width, u32 target_height);
 
-  // Checks that the frame dump readback texture exists and is the correct size.
-  bool CheckFrameDumpReadbackTexture(u32 target_width, u32 target_height);
+  // Checks that the readback texture of the buffer exists and is the correct size.
+  bool CheckFrameDumpReadbackTexture(FrameDumpBuffer& buffer, u32 target_width,
+                                     u32 target_height);
 
-  // Asynchronously encodes the specified pointer of frame data to the frame dump.
-  void DumpFrameData(const u8* data, int w, int h, int stride);
+  // Reads back the frames which have been copied at least min_age frames ago, and queues them for
+  // encoding. Buffers which the encoder is done with are released.
+  void SubmitFrameDumpBuffers(u64 min_age);
 
-  // Ensures all encoded frames have been written to the output file.
-  void FinishFrameData();
+  // Maps the buffer and queues it for encoding.
+  void SubmitFrameDumpBuffer(u32 index);
 
-  std::thread m_frame_dump_thread;
-  Common::Flag m_frame_dump_thread_running;
+  // Makes the buffer available for the next copy. Returns false if the frame should be dropped
+  // instead of waiting for the encoder.
+  bool ReleaseFrameDumpBuffer(u32 index, bool can_drop);
 
-  // Used to kick frame dump thread.
-  Common::Event m_frame_dump_start;
+  bool HasFrameDumpBuffersInUse() const;
+
+  Common::WorkQueueThread<u32> m_frame_dump_thread;
+  bool m_frame_dump_thread_running = false;
 
   // Set by frame dump thread on frame completion.
   Common::Event m_frame_dump_done;
 
-  // Holds emulation state during the last swap when dumping.
-  FrameState m_last_frame_state;
-
-  // Communication of frame between video and dump threads.
-  FrameData m_frame_dump_data;
+  // Ring of buffers, used in order.
+  std::array<FrameDumpBuffer, NUM_FRAME_DUMP_BUFFERS> m_frame_dump_buffers;
+  u32 m_next_frame_dump_buffer = 0;
+  u64 m_frame_dump_frame_counter = 0;
+  u32 m_frame_dump_dropped_frames = 0;
 
   // Texture used for screenshot/frame dumping
   std::unique_ptr<AbstractTexture> m_frame_dump_render_texture;
   std::unique_ptr<AbstractFramebuffer> m_frame_dump_render_framebuffer;
 
-  // Double buffer:
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_readback_texture;
-  std::unique_ptr<AbstractStagingTexture> m_frame_dump_output_texture;
-  // Set when readback texture holds a frame that needs to be dumped.
-  bool m_frame_dump_needs_flush = false;
-  // Set when thread is processing output texture.
-  bool m_frame_dump_frame_running = false;
+  // State of the frame dump thread.
+  bool m_dump_to_ffmpeg = false;
+  bool m_frame_dump_started = false;
 
   // Used to generate screenshot names.
   u32 m_frame_dump_image_counter = 0;
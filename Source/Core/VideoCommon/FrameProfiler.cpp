@@ -0,0 +1,290 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/FrameProfiler.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include <fmt/format.h>
+
+#include "Common/HookableEvent.h"
+#include "Common/IOFile.h"
+#include "Common/Logging/Log.h"
+#include "VideoCommon/VideoEvents.h"
+
+namespace VideoCommon
+{
+FrameProfiler g_frame_profiler;
+
+thread_local FrameProfilerScope* FrameProfilerScope::s_current = nullptr;
+thread_local FrameProfiler* FrameProfiler::s_trace_buffer_owner = nullptr;
+thread_local FrameProfiler::TraceEventBuffer* FrameProfiler::s_trace_buffer = nullptr;
+
+static std::atomic<u32> s_next_thread_id = 1;
+static thread_local u32 s_thread_id = 0;
+
+// Frames go on their own track in the trace, above the threads
+constexpr u32 TRACE_FRAME_THREAD_ID = 0;
+
+static Common::EventHook s_after_frame_event = AfterFrameEvent::Register(
+    [](Core::System&) {
+      if (g_frame_profiler.IsEnabled())
+        g_frame_profiler.EndFrame();
+    },
+    "FrameProfiler");
+
+const char* GetFrameProfilerPhaseName(FrameProfilerPhase phase)
+{
+  switch (phase)
+  {
+  case FrameProfilerPhase::OpcodeDecoding:
+    return "Opcode decoding";
+  case FrameProfilerPhase::VertexLoading:
+    return "Vertex loading";
+  case FrameProfilerPhase::CPUCulling:
+    return "CPU culling";
+  case FrameProfilerPhase::IndexGeneration:
+    return "Index generation";
+  case FrameProfilerPhase::TextureCache:
+    return "Texture cache";
+  case FrameProfilerPhase::BackendSubmission:
+    return "Backend submission";
+  case FrameProfilerPhase::ShaderCompileWait:
+    return "Shader compile wait";
+  case FrameProfilerPhase::Present:
+    return "Present";
+  default:
+    return "Unknown";
+  }
+}
+
+void FrameProfiler::SetEnabled(bool enabled)
+{
+  std::lock_guard lk(m_frames_lock);
+  if (enabled && !IsEnabled())
+  {
+    for (std::atomic<u64>& ns : m_current_ns)
+      ns.store(0, std::memory_order_relaxed);
+    m_last_frame_end = Clock::now();
+    m_frame_number = 0;
+  }
+  m_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void FrameProfiler::SetTracingEnabled(bool enabled, size_t capacity)
+{
+  std::lock_guard lk(m_trace_buffers_lock);
+  if (enabled && !IsTracingEnabled())
+  {
+    {
+      std::lock_guard frames_lk(m_trace_frames_lock);
+      m_trace_frames.clear();
+    }
+
+    // The buffers of threads which have exited stay around, but don't keep their events.
+    m_trace_capacity = std::max<size_t>(capacity, 1);
+    for (const auto& buffer : m_trace_buffers)
+    {
+      std::lock_guard buffer_lk(buffer->lock);
+      buffer->events = {};
+      buffer->capacity = m_trace_capacity;
+      buffer->count = 0;
+    }
+  }
+  m_tracing_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+void FrameProfiler::AddTime(FrameProfilerPhase phase, u64 ns)
+{
+  m_current_ns[static_cast<u32>(phase)].fetch_add(ns, std::memory_order_relaxed);
+}
+
+void FrameProfiler::AddTraceEvent(FrameProfilerPhase phase, Clock::time_point start,
+                                  u64 duration_ns)
+{
+  if (s_thread_id == 0) [[unlikely]]
+    s_thread_id = s_next_thread_id.fetch_add(1, std::memory_order_relaxed);
+
+  TraceEventBuffer* const buffer = GetThreadTraceEventBuffer();
+  std::lock_guard lk(buffer->lock);
+  if (!IsTracingEnabled())
+    return;
+
+  const FrameProfilerEvent event{GetTimestamp(start), duration_ns, s_thread_id, phase};
+  if (buffer->events.size() < buffer->capacity)
+    buffer->events.push_back(event);
+  else
+    buffer->events[buffer->count % buffer->capacity] = event;
+  buffer->count++;
+}
+
+FrameProfiler::TraceEventBuffer* FrameProfiler::GetThreadTraceEventBuffer()
+{
+  if (s_trace_buffer_owner == this) [[likely]]
+    return s_trace_buffer;
+
+  std::lock_guard lk(m_trace_buffers_lock);
+  TraceEventBuffer* const buffer =
+      m_trace_buffers.emplace_back(std::make_unique<TraceEventBuffer>()).get();
+  buffer->capacity = m_trace_capacity;
+  s_trace_buffer_owner = this;
+  s_trace_buffer = buffer;
+  return buffer;
+}
+
+void FrameProfiler::EndFrame()
+{
+  const Clock::time_point now = Clock::now();
+
+  FrameProfile profile;
+  for (u32 i = 0; i < FRAME_PROFILER_PHASE_COUNT; ++i)
+    profile.phase_ns[i] = m_current_ns[i].exchange(0, std::memory_order_relaxed);
+
+  profile.end_timestamp = GetTimestamp(now);
+
+  {
+    std::lock_guard lk(m_frames_lock);
+    profile.frame_ns =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(now - m_last_frame_end).count();
+    profile.frame_number = m_frame_number++;
+    m_last_frame_end = now;
+
+    if (m_frames.size() == MAX_STORED_FRAMES)
+      m_frames.pop_front();
+    m_frames.push_back(profile);
+  }
+
+  if (IsTracingEnabled())
+  {
+    std::lock_guard lk(m_trace_frames_lock);
+    if (m_trace_frames.size() == MAX_STORED_FRAMES)
+      m_trace_frames.pop_front();
+    m_trace_frames.push_back(profile);
+  }
+}
+
+std::vector<FrameProfile> FrameProfiler::TakeFrames()
+{
+  std::lock_guard lk(m_frames_lock);
+  std::vector<FrameProfile> frames(m_frames.begin(), m_frames.end());
+  m_frames.clear();
+  return frames;
+}
+
+std::vector<FrameProfile> FrameProfiler::GetTraceFrames() const
+{
+  std::lock_guard lk(m_trace_frames_lock);
+  return std::vector<FrameProfile>(m_trace_frames.begin(), m_trace_frames.end());
+}
+
+std::vector<FrameProfilerEvent> FrameProfiler::GetTraceEvents() const
+{
+  std::vector<FrameProfilerEvent> events;
+  {
+    std::lock_guard lk(m_trace_buffers_lock);
+    for (const auto& buffer : m_trace_buffers)
+    {
+      std::lock_guard buffer_lk(buffer->lock);
+      if (buffer->events.empty())
+        continue;
+
+      // Once the buffer has wrapped around, the oldest event is the one which is overwritten next
+      const auto oldest = buffer->events.begin() + buffer->count % buffer->events.size();
+      events.insert(events.end(), oldest, buffer->events.end());
+      events.insert(events.end(), buffer->events.begin(), oldest);
+    }
+  }
+
+  // Each thread records its events as they end, so this keeps their order within a thread.
+  std::stable_sort(events.begin(), events.end(),
+                   [](const FrameProfilerEvent& a, const FrameProfilerEvent& b) {
+                     return a.start_timestamp + a.duration_ns < b.start_timestamp + b.duration_ns;
+                   });
+  return events;
+}
+
+bool FrameProfiler::WriteChromeTrace(const std::string& filename) const
+{
+  const std::vector<FrameProfile> frames = GetTraceFrames();
+  const std::vector<FrameProfilerEvent> events = GetTraceEvents();
+
+  File::IOFile file(filename, "wb");
+  if (!file)
+  {
+    ERROR_LOG_FMT(VIDEO, "Failed to open {} for writing the frame trace", filename);
+    return false;
+  }
+
+  // Timestamps are in microseconds. Phase names don't need escaping.
+  fmt::memory_buffer buffer;
+  const auto flush = [&] {
+    const bool result = file.WriteBytes(buffer.data(), buffer.size());
+    buffer.clear();
+    return result;
+  };
+
+  fmt::format_to(std::back_inserter(buffer),
+                 "{{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+                 "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{},"
+                 "\"args\":{{\"name\":\"Frames\"}}}}",
+                 TRACE_FRAME_THREAD_ID);
+
+  for (const FrameProfile& frame : frames)
+  {
+    const u64 start = frame.end_timestamp - std::min(frame.frame_ns, frame.end_timestamp);
+    fmt::format_to(std::back_inserter(buffer),
+                   ",\n{{\"name\":\"Frame {}\",\"cat\":\"frame\",\"ph\":\"X\",\"ts\":{:.3f},"
+                   "\"dur\":{:.3f},\"pid\":1,\"tid\":{},\"args\":{{",
+                   frame.frame_number, start / 1000.0, frame.frame_ns / 1000.0,
+                   TRACE_FRAME_THREAD_ID);
+    for (u32 i = 0; i < FRAME_PROFILER_PHASE_COUNT; ++i)
+    {
+      fmt::format_to(std::back_inserter(buffer), "{}\"{} (ms)\":{:.3f}", i == 0 ? "" : ",",
+                     GetFrameProfilerPhaseName(static_cast<FrameProfilerPhase>(i)),
+                     frame.phase_ns[i] / 1000000.0);
+    }
+    fmt::format_to(std::back_inserter(buffer), "}}}}");
+    if (buffer.size() >= 1024 * 1024 && !flush())
+      return false;
+  }
+
+  for (const FrameProfilerEvent& event : events)
+  {
+    fmt::format_to(std::back_inserter(buffer),
+                   ",\n{{\"name\":\"{}\",\"cat\":\"video\",\"ph\":\"X\",\"ts\":{:.3f},"
+                   "\"dur\":{:.3f},\"pid\":1,\"tid\":{}}}",
+                   GetFrameProfilerPhaseName(event.phase), event.start_timestamp / 1000.0,
+                   event.duration_ns / 1000.0, event.thread_id);
+    if (buffer.size() >= 1024 * 1024 && !flush())
+      return false;
+  }
+
+  fmt::format_to(std::back_inserter(buffer), "\n]}}\n");
+  if (!flush())
+    return false;
+
+  INFO_LOG_FMT(VIDEO, "Wrote {} frames and {} events to {}", frames.size(), events.size(),
+               filename);
+  return true;
+}
+
+u64 FrameProfiler::GetTimestamp(Clock::time_point time) const
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time - m_epoch).count();
+}
+
+void FrameProfilerScope::Stop()
+{
+  const u64 elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             FrameProfiler::Clock::now() - m_start)
+                             .count();
+
+  g_frame_profiler.AddTime(m_phase, elapsed_ns - std::min(m_child_ns, elapsed_ns));
+  if (g_frame_profiler.IsTracingEnabled())
+    g_frame_profiler.AddTraceEvent(m_phase, m_start, elapsed_ns);
+  if (m_parent)
+    m_parent->m_child_ns += elapsed_ns;
+  s_current = m_parent;
+}
+}  // namespace VideoCommon
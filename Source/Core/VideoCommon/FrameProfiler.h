@@ -0,0 +1,184 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+// Measures how much host CPU time each part of the video front-end spends per emulated frame.
+//
+// Code is attributed to a phase with a FrameProfilerScope. Scopes nest: time spent in an inner
+// scope is only counted for the inner phase, so the phases of a frame add up to the time spent
+// inside any scope. A frame ends whenever AfterFrameEvent is triggered.
+//
+// Profiling is disabled by default, in which case a scope costs a single relaxed atomic load.
+//
+// Tracing additionally records every scope as an event in a ring buffer of the thread it ran on,
+// along with the frames, so a stutter can be looked at after the fact. The buffers can be exported
+// as a Chrome trace, which can be opened in chrome://tracing or Perfetto.
+
+namespace VideoCommon
+{
+enum class FrameProfilerPhase : u32
+{
+  OpcodeDecoding,
+  VertexLoading,
+  CPUCulling,
+  IndexGeneration,
+  TextureCache,
+  BackendSubmission,
+  ShaderCompileWait,
+  Present,
+  Count
+};
+
+constexpr u32 FRAME_PROFILER_PHASE_COUNT = static_cast<u32>(FrameProfilerPhase::Count);
+
+const char* GetFrameProfilerPhaseName(FrameProfilerPhase phase);
+
+// All timestamps are in nanoseconds since the profiler was created.
+
+struct FrameProfile
+{
+  // Exclusive time spent in each phase, in nanoseconds
+  std::array<u64, FRAME_PROFILER_PHASE_COUNT> phase_ns{};
+  // Time since the end of the previous frame, in nanoseconds
+  u64 frame_ns = 0;
+  u64 end_timestamp = 0;
+  // Counts the frames since profiling was last enabled
+  u64 frame_number = 0;
+};
+
+struct FrameProfilerEvent
+{
+  u64 start_timestamp = 0;
+  // Including the time spent in nested scopes
+  u64 duration_ns = 0;
+  // Small numbers assigned to threads in the order they first recorded an event
+  u32 thread_id = 0;
+  FrameProfilerPhase phase{};
+};
+
+class FrameProfiler
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  // Frames which are never taken are dropped once this many have accumulated.
+  static constexpr size_t MAX_STORED_FRAMES = 1 << 16;
+  // Events kept per thread. Enough for several seconds of a game with a few thousand draws per
+  // frame.
+  static constexpr size_t DEFAULT_TRACE_CAPACITY = 1 << 20;
+
+  void SetEnabled(bool enabled);
+  bool IsEnabled() const { return m_enabled.load(std::memory_order_relaxed); }
+
+  // Only has an effect while profiling is enabled. Enabling tracing clears the previous trace,
+  // disabling it keeps the trace around for the Get/Write functions below. The capacity is the
+  // number of events kept for each thread.
+  void SetTracingEnabled(bool enabled, size_t capacity = DEFAULT_TRACE_CAPACITY);
+  bool IsTracingEnabled() const { return m_tracing_enabled.load(std::memory_order_relaxed); }
+
+  // May be called from any thread.
+  void AddTime(FrameProfilerPhase phase, u64 ns);
+  void AddTraceEvent(FrameProfilerPhase phase, Clock::time_point start, u64 duration_ns);
+
+  void EndFrame();
+
+  // Returns the profiles of all frames which ended since the last call, oldest first.
+  std::vector<FrameProfile> TakeFrames();
+
+  // Return what is left of the trace in the ring buffers, oldest first. Events are ordered by
+  // the time they ended. These don't consume anything, so they can be called any number of
+  // times.
+  std::vector<FrameProfile> GetTraceFrames() const;
+  std::vector<FrameProfilerEvent> GetTraceEvents() const;
+
+  bool WriteChromeTrace(const std::string& filename) const;
+
+  u64 GetTimestamp(Clock::time_point time) const;
+
+private:
+  // Only the thread an event buffer belongs to adds events to it, so its lock is uncontended
+  // unless the trace is being read or reset at the same time.
+  struct TraceEventBuffer
+  {
+    std::mutex lock;
+    // Grows up to the capacity, and is used as a ring buffer from then on
+    std::vector<FrameProfilerEvent> events;
+    size_t capacity = 0;
+    // Total number of events recorded, the next one goes to this modulo the capacity
+    u64 count = 0;
+  };
+
+  TraceEventBuffer* GetThreadTraceEventBuffer();
+
+  static thread_local FrameProfiler* s_trace_buffer_owner;
+  static thread_local TraceEventBuffer* s_trace_buffer;
+
+  const Clock::time_point m_epoch = Clock::now();
+
+  std::atomic<bool> m_enabled = false;
+  std::array<std::atomic<u64>, FRAME_PROFILER_PHASE_COUNT> m_current_ns{};
+
+  std::mutex m_frames_lock;
+  std::deque<FrameProfile> m_frames;
+  Clock::time_point m_last_frame_end{};
+  u64 m_frame_number = 0;
+
+  std::atomic<bool> m_tracing_enabled = false;
+  mutable std::mutex m_trace_frames_lock;
+  std::deque<FrameProfile> m_trace_frames;
+  // Guards the list of buffers and the capacity, not the contents of the buffers
+  mutable std::mutex m_trace_buffers_lock;
+  std::vector<std::unique_ptr<TraceEventBuffer>> m_trace_buffers;
+  size_t m_trace_capacity = DEFAULT_TRACE_CAPACITY;
+};
+
+extern FrameProfiler g_frame_profiler;
+
+class FrameProfilerScope
+{
+public:
+  explicit FrameProfilerScope(FrameProfilerPhase phase)
+  {
+    if (!g_frame_profiler.IsEnabled()) [[likely]]
+      return;
+
+    m_phase = phase;
+    m_active = true;
+    m_parent = s_current;
+    s_current = this;
+    m_start = FrameProfiler::Clock::now();
+  }
+
+  ~FrameProfilerScope()
+  {
+    if (m_active) [[unlikely]]
+      Stop();
+  }
+
+  FrameProfilerScope(const FrameProfilerScope&) = delete;
+  FrameProfilerScope& operator=(const FrameProfilerScope&) = delete;
+
+private:
+  void Stop();
+
+  static thread_local FrameProfilerScope* s_current;
+
+  FrameProfilerScope* m_parent = nullptr;
+  FrameProfiler::Clock::time_point m_start{};
+  u64 m_child_ns = 0;
+  FrameProfilerPhase m_phase{};
+  bool m_active = false;
+};
+}  // namespace VideoCommon
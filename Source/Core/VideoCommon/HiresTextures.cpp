@@ -102,6 +102,12 @@ void HiresTexture::Update()
 
   auto& system = Core::System::GetInstance();
 
+  if (g_ActiveConfig.bHiresTexturesDiskCache && !game_id.empty())
+  {
+    s_file_library->SetTextureCacheFile(File::GetUserPath(D_CACHE_IDX) + game_id +
+                                        ".texcache");
+  }
+
   for (const auto& texture_directory : texture_directories)
   {
     const auto texture_paths =
@@ -176,13 +182,15 @@ std::shared_ptr<HiresTexture> HiresTexture::Search(const TextureInfo& texture_in
   if (base_filename == "")
     return nullptr;
 
+  auto& system = Core::System::GetInstance();
   if (auto iter = s_hires_texture_cache.find(base_filename); iter != s_hires_texture_cache.end())
   {
+    // Brings the texture back if it was evicted from memory since it was last used
+    system.GetCustomAssetLoader().UseAsset(iter->second->GetAsset());
     return iter->second;
   }
   else
   {
-    auto& system = Core::System::GetInstance();
     auto hires_texture = std::make_shared<HiresTexture>(
         has_arb_mipmaps,
         system.GetCustomAssetLoader().LoadGameTexture(base_filename, s_file_library));
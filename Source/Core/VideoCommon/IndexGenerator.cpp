@@ -3,12 +3,15 @@
 
 #include "VideoCommon/IndexGenerator.h"
 
+#include <algorithm>
 #include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstring>
 
 #include "Common/CommonTypes.h"
 #include "Common/Logging/Log.h"
+#include "Common/WorkerPool.h"
 #include "VideoCommon/OpcodeDecoding.h"
 #include "VideoCommon/VideoConfig.h"
 
@@ -16,6 +19,14 @@ namespace
 {
 constexpr u16 s_primitive_restart = UINT16_MAX;
 
+// Large draws are split into chunks of this many vertices (or triangles for fans). It is a multiple
+// of 12, so every chunk starts on a whole triangle or quad, on an even vertex of a strip, and on a
+// primitive restart group of a fan.
+constexpr u32 PARALLEL_CHUNK_SIZE = 6144;
+
+// Generating the indices for smaller draws is faster than waking up the workers.
+constexpr u32 MIN_PARALLEL_VERTICES = 2 * PARALLEL_CHUNK_SIZE;
+
 template <bool pr>
 u16* WriteTriangle(u16* index_ptr, u32 index1, u32 index2, u32 index3)
 {
@@ -50,13 +61,15 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
   }
   else
   {
-    bool wind = false;
-    for (u32 i = 2; i < num_verts; ++i)
+    // Every other triangle is flipped to keep the winding, so two are added at a time.
+    u32 i = 2;
+    for (; i + 1 < num_verts; i += 2)
     {
-      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - !wind, index + i - wind);
-
-      wind ^= true;
+      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
+      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 1, index + i + 1, index + i);
     }
+    if (i < num_verts)
+      index_ptr = WriteTriangle<pr>(index_ptr, index + i - 2, index + i - 1, index + i);
   }
   return index_ptr;
 }
@@ -80,10 +93,12 @@ u16* AddStrip(u16* index_ptr, u32 num_verts, u32 index)
  * so we use 6 indices for 3 triangles
  */
 
+// Adds the triangles which end at the vertices first to num_verts - 1. first must be 2 plus a
+// multiple of 3, so that the triangles are grouped the same way as when starting at 2.
 template <bool pr>
-u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
+u16* AddFanTriangles(u16* index_ptr, u32 first, u32 num_verts, u32 index)
 {
-  u32 i = 2;
+  u32 i = first;
 
   if constexpr (pr)
   {
@@ -114,6 +129,12 @@ u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+template <bool pr>
+u16* AddFan(u16* index_ptr, u32 num_verts, u32 index)
+{
+  return AddFanTriangles<pr>(index_ptr, 2, num_verts, index);
+}
+
 /*
  * QUAD simulator
  *
@@ -232,6 +253,48 @@ u16* AddPoints(u16* index_ptr, u32 num_verts, u32 index)
   return index_ptr;
 }
 
+bool CanAddInParallel(OpcodeDecoder::Primitive primitive)
+{
+  using OpcodeDecoder::Primitive;
+  return primitive == Primitive::GX_DRAW_QUADS || primitive == Primitive::GX_DRAW_TRIANGLES ||
+         primitive == Primitive::GX_DRAW_TRIANGLE_STRIP ||
+         primitive == Primitive::GX_DRAW_TRIANGLE_FAN;
+}
+
+// Adds the indices for one chunk of a large draw, from the vertex start to end (exclusive). For
+// strips without primitive restart, start and end are the first vertices of the triangles, and for
+// fans they are the last ones. Every chunk writes to the same place as it would when the whole draw
+// is added at once.
+template <bool pr>
+u16* AddChunk(OpcodeDecoder::Primitive primitive, u16* index_ptr, u32 num_verts, u32 index,
+              u32 start, u32 end)
+{
+  using OpcodeDecoder::Primitive;
+  switch (primitive)
+  {
+  case Primitive::GX_DRAW_QUADS:
+    return AddQuads<pr>(index_ptr + start / 4 * (pr ? 5 : 6), end - start, index + start);
+  case Primitive::GX_DRAW_TRIANGLES:
+    return AddList<pr>(index_ptr + start / 3 * (pr ? 4 : 3), end - start, index + start);
+  case Primitive::GX_DRAW_TRIANGLE_STRIP:
+    if constexpr (pr)
+    {
+      // The whole strip is a list of its vertices, followed by a single primitive restart.
+      if (end != num_verts)
+        return AddPoints(index_ptr + start, end - start, index + start);
+      return AddStrip<pr>(index_ptr + start, end - start, index + start);
+    }
+    else
+    {
+      return AddStrip<pr>(index_ptr + start * 3, end + 2 - start, index + start);
+    }
+  case Primitive::GX_DRAW_TRIANGLE_FAN:
+    return AddFanTriangles<pr>(index_ptr + (start - 2) * (pr ? 2 : 3), start, end, index);
+  default:
+    return index_ptr;
+  }
+}
+
 template <bool pr>
 u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 {
@@ -262,11 +325,13 @@ u16* AddPoints_VSExpand(u16* index_ptr, u32 num_verts, u32 index)
 }
 }  // Anonymous namespace
 
-void IndexGenerator::Init()
+void IndexGenerator::Init(Common::WorkerPool* workers)
 {
   using OpcodeDecoder::Primitive;
 
-  if (g_Config.backend_info.bSupportsPrimitiveRestart)
+  m_workers = workers;
+  m_primitive_restart = g_Config.backend_info.bSupportsPrimitiveRestart;
+  if (m_primitive_restart)
   {
     m_primitive_table[Primitive::GX_DRAW_QUADS] = AddQuads<true>;
     m_primitive_table[Primitive::GX_DRAW_QUADS_2] = AddQuads_nonstandard<true>;
@@ -314,11 +379,46 @@ void IndexGenerator::Start(u16* index_ptr)
 
 void IndexGenerator::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
 {
+  if (num_vertices >= MIN_PARALLEL_VERTICES && m_workers && m_workers->GetWorkerCount() != 0 &&
+      CanAddInParallel(primitive)) [[unlikely]]
+  {
+    AddIndicesInParallel(primitive, num_vertices);
+    return;
+  }
+
   m_index_buffer_current =
       m_primitive_table[primitive](m_index_buffer_current, num_vertices, m_base_index);
   m_base_index += num_vertices;
 }
 
+void IndexGenerator::AddIndicesInParallel(OpcodeDecoder::Primitive primitive, u32 num_vertices)
+{
+  using OpcodeDecoder::Primitive;
+  const u32 first = primitive == Primitive::GX_DRAW_TRIANGLE_FAN ? 2 : 0;
+  const u32 last = primitive == Primitive::GX_DRAW_TRIANGLE_STRIP && !m_primitive_restart ?
+                       num_vertices - 2 :
+                       num_vertices;
+  const u32 num_chunks = (last - first + PARALLEL_CHUNK_SIZE - 1) / PARALLEL_CHUNK_SIZE;
+  const auto add_chunk = m_primitive_restart ? AddChunk<true> : AddChunk<false>;
+  std::atomic<u32> next_chunk = 0;
+  u16* end_ptr = m_index_buffer_current;
+
+  m_workers->Run([&](u32) {
+    for (u32 chunk = next_chunk++; chunk < num_chunks; chunk = next_chunk++)
+    {
+      const u32 start = first + chunk * PARALLEL_CHUNK_SIZE;
+      const u32 end = std::min(start + PARALLEL_CHUNK_SIZE, last);
+      u16* const chunk_end_ptr = add_chunk(primitive, m_index_buffer_current, num_vertices,
+                                           m_base_index, start, end);
+      if (chunk == num_chunks - 1)
+        end_ptr = chunk_end_ptr;
+    }
+  });
+
+  m_index_buffer_current = end_ptr;
+  m_base_index += num_vertices;
+}
+
 void IndexGenerator::AddExternalIndices(const u16* indices, u32 num_indices, u32 num_vertices)
 {
   std::memcpy(m_index_buffer_current, indices, sizeof(u16) * num_indices);
@@ -10,10 +10,16 @@
 #include "Common/EnumMap.h"
 #include "VideoCommon/OpcodeDecoding.h"
 
+namespace Common
+{
+class WorkerPool;
+}
+
 class IndexGenerator
 {
 public:
-  void Init();
+  // Indices for large triangle draws are generated by the workers (if any) as well.
+  void Init(Common::WorkerPool* workers);
   void Start(u16* index_ptr);
 
   void AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices);
@@ -26,10 +32,15 @@ public:
   u32 GetRemainingIndices(OpcodeDecoder::Primitive primitive) const;
 
 private:
+  void AddIndicesInParallel(OpcodeDecoder::Primitive primitive, u32 num_vertices);
+
   u16* m_index_buffer_current = nullptr;
   u16* m_base_index_ptr = nullptr;
   u32 m_base_index = 0;
 
   using PrimitiveFunction = u16* (*)(u16*, u32, u32);
   Common::EnumMap<PrimitiveFunction, OpcodeDecoder::Primitive::GX_DRAW_POINTS> m_primitive_table{};
+
+  Common::WorkerPool* m_workers = nullptr;
+  bool m_primitive_restart = false;
 };
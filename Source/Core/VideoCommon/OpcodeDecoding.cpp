@@ -14,8 +14,12 @@
 
 #include "VideoCommon/OpcodeDecoding.h"
 
+#include <array>
+#include <optional>
+
 #include "Common/Assert.h"
 #include "Common/Logging/Log.h"
+#include "Common/Swap.h"
 #include "Core/FifoPlayer/FifoRecorder.h"
 #include "Core/HW/Memmap.h"
 #include "Core/System.h"
@@ -24,6 +28,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/DataReader.h"
 #include "VideoCommon/Fifo.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
@@ -39,6 +44,41 @@ template <bool is_preprocess>
 class RunCallback final : public Callback
 {
 public:
+  // Runs the commands like Run does, but passes on runs of draws with the same vertex format and
+  // runs of BP writes together, so the work shared between them is only done once per run.
+  u32 RunBatched(const u8* data, u32 available)
+  {
+    if (!m_batched)
+      return Run(data, available, *this);
+
+    // The FIFO recorder has to see every command on its own.
+    if constexpr (!is_preprocess)
+    {
+      if (g_record_fifo_data)
+        return Run(data, available, *this);
+    }
+
+    u32 size = 0;
+    while (size < available)
+    {
+      const Opcode cmd = static_cast<Opcode>(data[size]);
+
+      u32 command_size = 0;
+      if (cmd >= Opcode::GX_PRIMITIVE_START && cmd <= Opcode::GX_PRIMITIVE_END)
+        command_size = RunPrimitives(&data[size], available - size);
+      else if (cmd == Opcode::GX_LOAD_BP_REG)
+        command_size = RunBPWrites(&data[size], available - size);
+
+      // Also handles incomplete draws and BP writes, which end the run.
+      if (command_size == 0)
+        command_size = RunCommand(&data[size], available - size, *this);
+      if (command_size == 0)
+        break;
+      size += command_size;
+    }
+    return size;
+  }
+
   OPCODE_CALLBACK(void OnXF(u16 address, u8 count, const u8* data))
   {
     m_cycles += 18 + 6 * count;
@@ -138,9 +178,9 @@ public:
     // 4 GPU ticks per vertex, 3 CPU ticks per GPU tick
     m_cycles += num_vertices * 4 * 3 + 6;
   }
-  // This can't be inlined since it calls Run, which makes it recursive
+  // This can't be inlined since it calls RunBatched, which makes it recursive
   // m_in_display_list prevents it from actually recursing infinitely, but there's no real benefit
-  // to inlining Run for the display list directly.
+  // to inlining RunBatched for the display list directly.
   OPCODE_CALLBACK_NOINLINE(void OnDisplayList(u32 address, u32 size))
   {
     m_cycles += 6;
@@ -164,7 +204,7 @@ public:
 
         if (start_address != nullptr)
         {
-          Run(start_address, size, *this);
+          RunBatched(start_address, size);
         }
       }
       else
@@ -188,7 +228,7 @@ public:
           // temporarily swap dl and non-dl (small "hack" for the stats)
           g_stats.SwapDL();
 
-          Run(start_address, size, *this);
+          RunBatched(start_address, size);
           INCSTAT(g_stats.this_frame.num_dlists_called);
 
           // un-swap
@@ -255,14 +295,94 @@ public:
 
   u32 m_cycles = 0;
   bool m_in_display_list = false;
+  bool m_batched = true;
+
+private:
+  static constexpr size_t MAX_BATCH_SIZE = 64;
+
+  // Returns the size of the draws which were run, which is 0 if the first one is incomplete.
+  u32 RunPrimitives(const u8* data, u32 available)
+  {
+    const u8 vat = data[0] & GX_VAT_MASK;
+    const u32 vertex_size = GetVertexSize(vat);
+
+    std::array<VertexLoaderManager::PrimitiveCommand, MAX_BATCH_SIZE> commands;
+    size_t num_commands = 0;
+    u32 size = 0;
+    while (num_commands < commands.size() && available - size >= 3)
+    {
+      const u8* command = &data[size];
+      const Opcode cmd = static_cast<Opcode>(command[0]);
+      if (cmd < Opcode::GX_PRIMITIVE_START || cmd > Opcode::GX_PRIMITIVE_END ||
+          (command[0] & GX_VAT_MASK) != vat)
+      {
+        break;
+      }
+
+      const u16 num_vertices = Common::swap16(&command[1]);
+      const u32 command_size = 3 + num_vertices * vertex_size;
+      if (available - size < command_size)
+        break;
+
+      // Empty draws are skipped, like RunVertices does.
+      if (num_vertices != 0)
+      {
+        const Primitive primitive =
+            static_cast<Primitive>((command[0] & GX_PRIMITIVE_MASK) >> GX_PRIMITIVE_SHIFT);
+        commands[num_commands++] = {primitive, num_vertices, &command[3]};
+      }
+      size += command_size;
+
+      // 4 GPU ticks per vertex, 3 CPU ticks per GPU tick
+      m_cycles += num_vertices * 4 * 3 + 6;
+    }
+
+    if (num_commands != 0)
+      VertexLoaderManager::RunVertexBatch<is_preprocess>(vat, {commands.data(), num_commands});
+    return size;
+  }
+
+  // Returns the size of the BP writes which were run, which is 0 if the first one is incomplete.
+  u32 RunBPWrites(const u8* data, u32 available)
+  {
+    std::array<BPWrite, MAX_BATCH_SIZE> writes;
+    size_t num_writes = 0;
+    u32 size = 0;
+    while (num_writes < writes.size() && available - size >= 5 &&
+           static_cast<Opcode>(data[size]) == Opcode::GX_LOAD_BP_REG)
+    {
+      m_cycles += 12;
+      writes[num_writes++] = {data[size + 1], Common::swap24(&data[size + 2]),
+                              static_cast<int>(m_cycles)};
+      size += 5;
+    }
+
+    if constexpr (is_preprocess)
+    {
+      for (size_t i = 0; i < num_writes; i++)
+        LoadBPRegPreprocess(writes[i].reg, writes[i].value, writes[i].cycles_into_future);
+    }
+    else
+    {
+      LoadBPRegs({writes.data(), num_writes});
+      ADDSTAT(g_stats.this_frame.num_bp_loads, static_cast<int>(num_writes));
+    }
+    return size;
+  }
 };
 
 template <bool is_preprocess>
-u8* RunFifo(DataReader src, u32* cycles)
+static u8* RunFifoImpl(DataReader src, u32* cycles, bool batched)
 {
+  // Preprocessing runs on the CPU thread and isn't part of the video front-end's own time.
+  std::optional<VideoCommon::FrameProfilerScope> profiler_scope;
+  if constexpr (!is_preprocess)
+    profiler_scope.emplace(VideoCommon::FrameProfilerPhase::OpcodeDecoding);
+
   using CallbackT = RunCallback<is_preprocess>;
   auto callback = CallbackT{};
-  u32 size = Run(src.GetPointer(), static_cast<u32>(src.size()), callback);
+  callback.m_batched = batched;
+  u32 size = callback.RunBatched(src.GetPointer(), static_cast<u32>(src.size()));
 
   if (cycles != nullptr)
     *cycles = callback.m_cycles;
@@ -271,7 +391,21 @@ u8* RunFifo(DataReader src, u32* cycles)
   return src.GetPointer();
 }
 
+template <bool is_preprocess>
+u8* RunFifo(DataReader src, u32* cycles)
+{
+  return RunFifoImpl<is_preprocess>(src, cycles, true);
+}
+
+template <bool is_preprocess>
+u8* RunFifoUnbatched(DataReader src, u32* cycles)
+{
+  return RunFifoImpl<is_preprocess>(src, cycles, false);
+}
+
 template u8* RunFifo<true>(DataReader src, u32* cycles);
 template u8* RunFifo<false>(DataReader src, u32* cycles);
+template u8* RunFifoUnbatched<true>(DataReader src, u32* cycles);
+template u8* RunFifoUnbatched<false>(DataReader src, u32* cycles);
 
 }  // namespace OpcodeDecoder
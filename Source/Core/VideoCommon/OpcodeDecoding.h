@@ -277,6 +277,11 @@ DOLPHIN_FORCE_INLINE u32 Run(const u8* data, u32 available, T& callback)
 template <bool is_preprocess = false>
 u8* RunFifo(DataReader src, u32* cycles);
 
+// Runs every command on its own, like Run does, instead of batching draws and BP writes.
+// RunFifo has to have the same effects, which is what this is used to check.
+template <bool is_preprocess = false>
+u8* RunFifoUnbatched(DataReader src, u32* cycles);
+
 }  // namespace OpcodeDecoder
 
 template <>
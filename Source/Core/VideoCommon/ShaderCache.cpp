@@ -13,9 +13,12 @@
 #include "VideoCommon/AbstractGfx.h"
 #include "VideoCommon/ConstantManager.h"
 #include "VideoCommon/DriverDetails.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/FramebufferShaderGen.h"
+#include "VideoCommon/OnScreenDisplay.h"
 #include "VideoCommon/Present.h"
+#include "VideoCommon/ShaderCachePack.h"
 #include "VideoCommon/Statistics.h"
 #include "VideoCommon/VertexLoaderManager.h"
 #include "VideoCommon/VertexManagerBase.h"
@@ -60,6 +63,7 @@ void ShaderCache::InitializeShaderCache()
   {
     LoadCaches();
     LoadPipelineUIDCache();
+    LoadShaderCachePack();
   }
 
   // Queue ubershader precompiling if required.
@@ -69,7 +73,10 @@ void ShaderCache::InitializeShaderCache()
   // Compile all known UIDs.
   CompileMissingPipelines();
   if (g_ActiveConfig.bWaitForShadersBeforeStarting)
+  {
     WaitForAsyncCompiler();
+    LogCompilerQueueStatistics();
+  }
 
   // Switch to the runtime shader compiler thread configuration.
   m_async_shader_compiler->ResizeWorkerThreads(g_ActiveConfig.GetShaderCompilerThreads());
@@ -77,6 +84,9 @@ void ShaderCache::InitializeShaderCache()
 
 void ShaderCache::Reload()
 {
+  // Everything compiled for the old configuration is thrown away, so only wait for the work items
+  // which were already started.
+  m_async_shader_compiler->CancelPendingWork();
   WaitForAsyncCompiler();
   ClosePipelineUIDCache();
   ClearCaches();
@@ -102,6 +112,9 @@ void ShaderCache::Reload()
 void ShaderCache::RetrieveAsyncShaders()
 {
   m_async_shader_compiler->RetrieveWorkItems();
+
+  if (!m_shader_cache_pack_pending.empty())
+    UpdateShaderCachePackProgress();
 }
 
 void ShaderCache::Shutdown()
@@ -109,17 +122,42 @@ void ShaderCache::Shutdown()
   // This may leave shaders uncommitted to the cache, but it's better than blocking shutdown
   // until everything has finished compiling.
   if (m_async_shader_compiler)
+  {
+    // Don't let precompiling for a game which is being switched away from hold up the next one.
+    m_async_shader_compiler->CancelPendingWork();
     m_async_shader_compiler->StopWorkerThreads();
+    LogCompilerQueueStatistics();
+  }
 
   ClosePipelineUIDCache();
 }
 
+void ShaderCache::LogCompilerQueueStatistics() const
+{
+  static constexpr std::array<const char*, AsyncShaderCompiler::NUM_PRIORITIES> lane_names = {
+      "on demand", "ubershader", "shader cache"};
+
+  const auto statistics = m_async_shader_compiler->GetQueueStatistics();
+  for (u32 lane = 0; lane < AsyncShaderCompiler::NUM_PRIORITIES; lane++)
+  {
+    if (statistics[lane].num_items == 0)
+      continue;
+
+    INFO_LOG_FMT(VIDEO, "Shader compiler {} queue: {} items, {} us average wait, {} us max wait",
+                 lane_names[lane], statistics[lane].num_items,
+                 statistics[lane].total_wait.count() / statistics[lane].num_items,
+                 statistics[lane].max_wait.count());
+  }
+}
+
 const AbstractPipeline* ShaderCache::GetPipelineForUid(const GXPipelineUid& uid)
 {
   auto it = m_gx_pipeline_cache.find(uid);
   if (it != m_gx_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  // The GPU thread has to wait for the pipeline to be compiled here.
+  FrameProfilerScope profiler_scope(FrameProfilerPhase::ShaderCompileWait);
   const bool exists_in_cache = it != m_gx_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
@@ -153,15 +191,20 @@ const AbstractPipeline* ShaderCache::GetUberPipelineForUid(const GXUberPipelineU
   if (it != m_gx_uber_pipeline_cache.end() && !it->second.second)
     return it->second.first.get();
 
+  FrameProfilerScope profiler_scope(FrameProfilerPhase::ShaderCompileWait);
+  const bool exists_in_cache = it != m_gx_uber_pipeline_cache.end();
   std::unique_ptr<AbstractPipeline> pipeline;
   std::optional<AbstractPipelineConfig> pipeline_config = GetGXPipelineConfig(uid);
   if (pipeline_config)
     pipeline = g_gfx->CreatePipeline(*pipeline_config);
+  if (g_ActiveConfig.bShaderCache && !exists_in_cache)
+    AppendGXUberPipelineUID(uid);
   return InsertGXUberPipeline(uid, std::move(pipeline));
 }
 
 void ShaderCache::WaitForAsyncCompiler()
 {
+  FrameProfilerScope profiler_scope(FrameProfilerPhase::ShaderCompileWait);
   bool running = true;
 
   constexpr auto update_ui_progress = [](size_t completed, size_t total) {
@@ -195,6 +238,10 @@ void ShaderCache::WaitForAsyncCompiler()
     m_async_shader_compiler->RetrieveWorkItems();
   }
 
+  // The emulator is stopping, so there is no point in compiling the rest.
+  if (!running)
+    m_async_shader_compiler->CancelPendingWork();
+
   // An extra Present to clear the screen
   g_presenter->Present();
 }
@@ -383,6 +430,7 @@ void ShaderCache::LoadCaches()
 
 void ShaderCache::ClearCaches()
 {
+  m_shader_cache_pack_pending.clear();
   ClearPipelineCache(m_gx_pipeline_cache, m_gx_pipeline_disk_cache);
   ClearShaderCache(m_vs_cache);
   ClearShaderCache(m_gs_cache);
@@ -423,6 +471,11 @@ void ShaderCache::CompileMissingPipelines()
     if (!it.second.first)
       QueuePipelineCompile(it.first, COMPILE_PRIORITY_SHADERCACHE_PIPELINE);
   }
+
+  // Ubershader pipelines are never used without ubershaders, so don't spend time on them.
+  if (!g_ActiveConfig.UsingUberShaders())
+    return;
+
   for (auto& it : m_gx_uber_pipeline_cache)
   {
     if (!it.second.first)
@@ -920,39 +973,41 @@ ShaderCache::InsertGXUberPipeline(const GXUberPipelineUid& config,
   return entry.first.get();
 }
 
-void ShaderCache::LoadPipelineUIDCache()
+// Opens a UID cache file for appending, and passes the UIDs which are already in it to add_uid.
+// Returns false if the file was missing or invalid, in which case it is recreated empty.
+template <typename SerializedUidType, typename AddFunction>
+static bool OpenPipelineUIDCache(File::IOFile& file, const std::string& filename,
+                                 AddFunction add_uid)
 {
-  constexpr u32 CACHE_FILE_MAGIC = 0x44495550;  // PUID
   constexpr size_t CACHE_HEADER_SIZE = sizeof(u32) + sizeof(u32);
-  std::string filename =
-      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID() + ".uidcache";
-  if (m_gx_pipeline_uid_cache_file.Open(filename, "rb+"))
+  bool uid_file_valid = false;
+  if (file.Open(filename, "rb+"))
   {
     // If an existing case exists, validate the version before reading entries.
     u32 existing_magic;
     u32 existing_version;
-    bool uid_file_valid = false;
-    if (m_gx_pipeline_uid_cache_file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
-        m_gx_pipeline_uid_cache_file.ReadBytes(&existing_version, sizeof(existing_version)) &&
-        existing_magic == CACHE_FILE_MAGIC && existing_version == GX_PIPELINE_UID_VERSION)
+    if (file.ReadBytes(&existing_magic, sizeof(existing_magic)) &&
+        file.ReadBytes(&existing_version, sizeof(existing_version)) &&
+        existing_magic == GX_PIPELINE_UID_CACHE_MAGIC &&
+        existing_version == GX_PIPELINE_UID_VERSION)
     {
       // Ensure the expected size matches the actual size of the file. If it doesn't, it means
       // the cache file may be corrupted, and we should not proceed with loading potentially
       // garbage or invalid UIDs.
-      const u64 file_size = m_gx_pipeline_uid_cache_file.GetSize();
+      const u64 file_size = file.GetSize();
       const size_t uid_count =
-          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedGXPipelineUid);
-      const size_t expected_size = uid_count * sizeof(SerializedGXPipelineUid) + CACHE_HEADER_SIZE;
+          static_cast<size_t>(file_size - CACHE_HEADER_SIZE) / sizeof(SerializedUidType);
+      const size_t expected_size = uid_count * sizeof(SerializedUidType) + CACHE_HEADER_SIZE;
       uid_file_valid = file_size == expected_size;
       if (uid_file_valid)
       {
         for (size_t i = 0; i < uid_count; i++)
         {
-          SerializedGXPipelineUid serialized_uid;
-          if (m_gx_pipeline_uid_cache_file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
+          SerializedUidType serialized_uid;
+          if (file.ReadBytes(&serialized_uid, sizeof(serialized_uid)))
           {
             // This just adds the pipeline to the map, it is compiled later.
-            AddSerializedGXPipelineUID(serialized_uid);
+            add_uid(serialized_uid);
           }
           else
           {
@@ -964,39 +1019,58 @@ void ShaderCache::LoadPipelineUIDCache()
 
       // We open the file for reading and writing, so we must seek to the end before writing.
       if (uid_file_valid)
-        uid_file_valid = m_gx_pipeline_uid_cache_file.Seek(expected_size, File::SeekOrigin::Begin);
+        uid_file_valid = file.Seek(expected_size, File::SeekOrigin::Begin);
     }
 
     // If the file is invalid, close it. We re-open and truncate it below.
     if (!uid_file_valid)
-      m_gx_pipeline_uid_cache_file.Close();
+      file.Close();
   }
 
   // If the file is not open, it means it was either corrupted or didn't exist.
-  if (!m_gx_pipeline_uid_cache_file.IsOpen())
+  if (!file.IsOpen() && file.Open(filename, "wb"))
   {
-    if (m_gx_pipeline_uid_cache_file.Open(filename, "wb"))
-    {
-      // Write the version identifier.
-      m_gx_pipeline_uid_cache_file.WriteBytes(&CACHE_FILE_MAGIC, sizeof(GX_PIPELINE_UID_VERSION));
-      m_gx_pipeline_uid_cache_file.WriteBytes(&GX_PIPELINE_UID_VERSION,
-                                              sizeof(GX_PIPELINE_UID_VERSION));
-
-      // Write any current UIDs out to the file.
-      // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
-      // we don't lose the existing UIDs which were previously at the beginning.
-      for (const auto& it : m_gx_pipeline_cache)
-        AppendGXPipelineUID(it.first);
-    }
+    // Write the version identifier.
+    file.WriteBytes(&GX_PIPELINE_UID_CACHE_MAGIC, sizeof(GX_PIPELINE_UID_CACHE_MAGIC));
+    file.WriteBytes(&GX_PIPELINE_UID_VERSION, sizeof(GX_PIPELINE_UID_VERSION));
   }
 
+  return uid_file_valid;
+}
+
+void ShaderCache::LoadPipelineUIDCache()
+{
+  const std::string base_filename =
+      File::GetUserPath(D_CACHE_IDX) + SConfig::GetInstance().GetGameID();
+  const std::string filename = base_filename + ".uidcache";
+  if (!OpenPipelineUIDCache<SerializedGXPipelineUid>(
+          m_gx_pipeline_uid_cache_file, filename,
+          [this](const SerializedGXPipelineUid& uid) { AddSerializedGXPipelineUID(uid); }))
+  {
+    // Write any current UIDs out to the file.
+    // This way, if we load a UID cache where the data was incomplete (e.g. Dolphin crashed),
+    // we don't lose the existing UIDs which were previously at the beginning.
+    for (const auto& it : m_gx_pipeline_cache)
+      AppendGXPipelineUID(it.first);
+  }
   INFO_LOG_FMT(VIDEO, "Read {} pipeline UIDs from {}", m_gx_pipeline_cache.size(), filename);
+
+  if (!g_ActiveConfig.UsingUberShaders())
+    return;
+
+  // Only ubershader pipelines which were requested while drawing are recorded here, so the
+  // existing entries are not written back: most of them are queued by QueueUberShaderPipelines.
+  const std::string uber_filename = base_filename + ".uberuidcache";
+  OpenPipelineUIDCache<SerializedGXUberPipelineUid>(
+      m_gx_uber_pipeline_uid_cache_file, uber_filename,
+      [this](const SerializedGXUberPipelineUid& uid) { AddSerializedGXUberPipelineUID(uid); });
 }
 
 void ShaderCache::ClosePipelineUIDCache()
 {
   // This is left as a method in case we need to append extra data to the file in the future.
   m_gx_pipeline_uid_cache_file.Close();
+  m_gx_uber_pipeline_uid_cache_file.Close();
 }
 
 void ShaderCache::AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid)
@@ -1027,6 +1101,103 @@ void ShaderCache::AppendGXPipelineUID(const GXPipelineUid& config)
   }
 }
 
+void ShaderCache::AddSerializedGXUberPipelineUID(const SerializedGXUberPipelineUid& uid)
+{
+  GXUberPipelineUid real_uid;
+  UnserializePipelineUid(uid, real_uid);
+
+  // Flag it as empty with a null pipeline object, for later compilation.
+  m_gx_uber_pipeline_cache.try_emplace(real_uid);
+}
+
+void ShaderCache::AppendGXUberPipelineUID(const GXUberPipelineUid& config)
+{
+  if (!m_gx_uber_pipeline_uid_cache_file.IsOpen())
+    return;
+
+  SerializedGXUberPipelineUid disk_uid;
+  SerializePipelineUid(config, disk_uid);
+  if (!m_gx_uber_pipeline_uid_cache_file.WriteBytes(&disk_uid, sizeof(disk_uid)))
+  {
+    WARN_LOG_FMT(VIDEO, "Writing ubershader pipeline UID to cache failed, closing file.");
+    m_gx_uber_pipeline_uid_cache_file.Close();
+  }
+}
+
+void ShaderCache::LoadShaderCachePack()
+{
+  const std::string& game_id = SConfig::GetInstance().GetGameID();
+  const std::string filename = ShaderCachePack::GetPathForGame(game_id);
+  if (!File::Exists(filename))
+    return;
+
+  const ShaderCachePack::Result pack = ShaderCachePack::Load(filename);
+  if (!pack)
+  {
+    WARN_LOG_FMT(VIDEO, "Failed to load shader cache pack {}: {}", filename,
+                 ShaderCachePack::GetErrorString(pack.Error()));
+    return;
+  }
+  if (pack->GetGameID() != game_id)
+  {
+    WARN_LOG_FMT(VIDEO, "Shader cache pack {} is for {}, not {}", filename, pack->GetGameID(),
+                 game_id);
+    return;
+  }
+
+  // The pipelines are queued with the rest of the missing pipelines in CompileMissingPipelines.
+  m_shader_cache_pack_pending.clear();
+  for (const SerializedGXPipelineUid& serialized_uid : pack->GetPipelineUIDs())
+  {
+    GXPipelineUid uid;
+    UnserializePipelineUid(serialized_uid, uid);
+    const auto [iter, inserted] = m_gx_pipeline_cache.try_emplace(uid);
+    if (inserted)
+      m_shader_cache_pack_pending.push_back(&iter->second.second);
+  }
+  // The ubershader pipelines would never be compiled without ubershaders.
+  const bool using_uber_shaders = g_ActiveConfig.UsingUberShaders();
+  if (using_uber_shaders)
+  {
+    for (const SerializedGXUberPipelineUid& serialized_uid : pack->GetUberPipelineUIDs())
+    {
+      GXUberPipelineUid uid;
+      UnserializePipelineUid(serialized_uid, uid);
+      const auto [iter, inserted] = m_gx_uber_pipeline_cache.try_emplace(uid);
+      if (inserted)
+        m_shader_cache_pack_pending.push_back(&iter->second.second);
+    }
+  }
+  m_shader_cache_pack_size = m_shader_cache_pack_pending.size();
+
+  INFO_LOG_FMT(VIDEO, "Added {} of {} pipeline UIDs from shader cache pack {}",
+               m_shader_cache_pack_size,
+               pack->GetPipelineUIDs().size() +
+                   (using_uber_shaders ? pack->GetUberPipelineUIDs().size() : 0),
+               filename);
+}
+
+void ShaderCache::UpdateShaderCachePackProgress()
+{
+  // Entries are flagged as pending when they are queued, and the flag is cleared once the
+  // compiled pipeline has been inserted, whether or not compiling it succeeded.
+  std::erase_if(m_shader_cache_pack_pending, [](const bool* pending) { return !*pending; });
+
+  if (m_shader_cache_pack_pending.empty())
+  {
+    OSD::AddTypedMessage(OSD::MessageType::ShaderCachePack,
+                         fmt::format("Compiled {} pipelines from the shader cache pack",
+                                     m_shader_cache_pack_size),
+                         OSD::Duration::NORMAL);
+    return;
+  }
+
+  OSD::AddTypedMessage(OSD::MessageType::ShaderCachePack,
+                       fmt::format("Compiling shader cache pack: {}/{}",
+                                   m_shader_cache_pack_size - m_shader_cache_pack_pending.size(),
+                                   m_shader_cache_pack_size));
+}
+
 void ShaderCache::QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority)
 {
   class VertexShaderWorkItem final : public AsyncShaderCompiler::WorkItem
@@ -12,6 +12,7 @@
 #include <string>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "Common/CommonTypes.h"
 #include "Common/IOFile.h"
@@ -161,6 +162,12 @@ private:
                                                std::unique_ptr<AbstractPipeline> pipeline);
   void AddSerializedGXPipelineUID(const SerializedGXPipelineUid& uid);
   void AppendGXPipelineUID(const GXPipelineUid& config);
+  void AddSerializedGXUberPipelineUID(const SerializedGXUberPipelineUid& uid);
+  void AppendGXUberPipelineUID(const GXUberPipelineUid& config);
+
+  // Adds the pipelines from the game's shader cache pack, if there is one.
+  void LoadShaderCachePack();
+  void UpdateShaderCachePackProgress();
 
   // ASync Compiler Methods
   void QueueVertexShaderCompile(const VertexShaderUid& uid, u32 priority);
@@ -181,16 +188,20 @@ private:
   template <typename T, typename Y>
   void ClearPipelineCache(T& cache, Y& disk_cache);
 
-  // Priorities for compiling. The lower the value, the sooner the pipeline is compiled.
-  // The shader cache is compiled last, as it is the least likely to be required. On demand
-  // shaders are always compiled before pending ubershaders, as we want to use the ubershader
-  // for as few frames as possible, otherwise we risk framerate drops.
+  // Priorities for compiling, each of which is a separate lane in the async compiler. The lower
+  // the value, the sooner the pipeline is compiled. The shader cache is compiled last, as it is the
+  // least likely to be required. On demand shaders are always compiled before pending ubershaders,
+  // as we want to use the ubershader for as few frames as possible, otherwise we risk framerate
+  // drops.
   enum : u32
   {
-    COMPILE_PRIORITY_ONDEMAND_PIPELINE = 100,
-    COMPILE_PRIORITY_UBERSHADER_PIPELINE = 200,
-    COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 300
+    COMPILE_PRIORITY_ONDEMAND_PIPELINE = 0,
+    COMPILE_PRIORITY_UBERSHADER_PIPELINE = 1,
+    COMPILE_PRIORITY_SHADERCACHE_PIPELINE = 2
   };
+  static_assert(COMPILE_PRIORITY_SHADERCACHE_PIPELINE < AsyncShaderCompiler::NUM_PRIORITIES);
+
+  void LogCompilerQueueStatistics() const;
 
   // Configuration bits.
   APIType m_api_type;
@@ -229,9 +240,15 @@ private:
   std::map<GXUberPipelineUid, std::pair<std::unique_ptr<AbstractPipeline>, bool>>
       m_gx_uber_pipeline_cache;
   File::IOFile m_gx_pipeline_uid_cache_file;
+  File::IOFile m_gx_uber_pipeline_uid_cache_file;
   Common::LinearDiskCache<SerializedGXPipelineUid, u8> m_gx_pipeline_disk_cache;
   Common::LinearDiskCache<SerializedGXUberPipelineUid, u8> m_gx_uber_pipeline_disk_cache;
 
+  // Pending flags of the cache entries added from the shader cache pack which are still being
+  // compiled, for progress reporting.
+  std::vector<const bool*> m_shader_cache_pack_pending;
+  size_t m_shader_cache_pack_size = 0;
+
   // EFB copy to VRAM/RAM pipelines
   std::map<TextureConversionShaderGen::TCShaderUid, std::unique_ptr<AbstractPipeline>>
       m_efb_copy_to_vram_pipelines;
@@ -0,0 +1,248 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "VideoCommon/ShaderCachePack.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "Common/FileUtil.h"
+#include "Common/Hash.h"
+#include "Common/IOFile.h"
+#include "Common/StringUtil.h"
+
+namespace VideoCommon
+{
+namespace
+{
+constexpr u32 PACK_MAGIC = 0x50435344;  // DSCP
+constexpr const char* PACK_EXTENSION = ".dsp";
+constexpr const char* UID_CACHE_EXTENSION = ".uidcache";
+constexpr const char* UBER_UID_CACHE_EXTENSION = ".uberuidcache";
+
+struct Header
+{
+  u32 magic;
+  u32 version;
+  u32 uid_version;
+  u16 pipeline_uid_size;
+  u16 uber_pipeline_uid_size;
+  u32 num_pipeline_uids;
+  u32 num_uber_pipeline_uids;
+  u64 checksum;
+  // Not null-terminated if the game ID fills the whole array.
+  char game_id[32];
+};
+static_assert(sizeof(Header) == 64);
+static_assert(std::is_trivially_copyable_v<SerializedGXPipelineUid> &&
+              std::is_trivially_copyable_v<SerializedGXUberPipelineUid>);
+
+// The serialized UIDs have no padding, so their bytes can be compared directly.
+template <typename T>
+bool IsLess(const T& lhs, const T& rhs)
+{
+  return std::memcmp(&lhs, &rhs, sizeof(T)) < 0;
+}
+
+template <typename T>
+bool IsEqual(const T& lhs, const T& rhs)
+{
+  return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+}
+
+template <typename T>
+void SortAndDeduplicate(std::vector<T>& uids)
+{
+  std::sort(uids.begin(), uids.end(), IsLess<T>);
+  uids.erase(std::unique(uids.begin(), uids.end(), IsEqual<T>), uids.end());
+}
+
+template <typename T>
+bool IsSortedAndUnique(const std::vector<T>& uids)
+{
+  return std::adjacent_find(uids.begin(), uids.end(), [](const T& lhs, const T& rhs) {
+           return !IsLess(lhs, rhs);
+         }) == uids.end();
+}
+
+template <typename T>
+size_t MergeUIDs(std::vector<T>& uids, const std::vector<T>& other)
+{
+  std::vector<T> merged;
+  merged.reserve(uids.size() + other.size());
+  std::set_union(uids.begin(), uids.end(), other.begin(), other.end(),
+                 std::back_inserter(merged), IsLess<T>);
+
+  const size_t added = merged.size() - uids.size();
+  uids = std::move(merged);
+  return added;
+}
+
+u64 ComputeChecksum(const std::vector<SerializedGXPipelineUid>& pipeline_uids,
+                    const std::vector<SerializedGXUberPipelineUid>& uber_pipeline_uids)
+{
+  const u64 hash = Common::HashXXH3(reinterpret_cast<const u8*>(pipeline_uids.data()),
+                                    pipeline_uids.size() * sizeof(SerializedGXPipelineUid));
+  return Common::HashXXH3(reinterpret_cast<const u8*>(uber_pipeline_uids.data()),
+                          uber_pipeline_uids.size() * sizeof(SerializedGXUberPipelineUid), hash);
+}
+
+template <typename T>
+std::optional<ShaderCachePackError> ReadUIDCache(File::IOFile& file, std::vector<T>& uids)
+{
+  constexpr size_t header_size = sizeof(u32) + sizeof(u32);
+  const u64 file_size = file.GetSize();
+  if ((file_size - header_size) % sizeof(T) != 0)
+    return ShaderCachePackError::SizeMismatch;
+
+  uids.resize(static_cast<size_t>((file_size - header_size) / sizeof(T)));
+  if (!file.ReadArray(uids.data(), uids.size()))
+    return ShaderCachePackError::FileError;
+
+  SortAndDeduplicate(uids);
+  return std::nullopt;
+}
+}  // namespace
+
+ShaderCachePack::ShaderCachePack(std::string game_id) : m_game_id(std::move(game_id))
+{
+}
+
+ShaderCachePack::Result ShaderCachePack::Load(const std::string& path)
+{
+  File::IOFile file(path, "rb");
+  if (!file.IsOpen())
+    return ShaderCachePackError::FileError;
+
+  Header header;
+  if (!file.ReadArray(&header, 1) || header.magic != PACK_MAGIC)
+    return ShaderCachePackError::InvalidHeader;
+  if (header.version != VERSION)
+    return ShaderCachePackError::UnsupportedVersion;
+  if (header.uid_version != GX_PIPELINE_UID_VERSION)
+    return ShaderCachePackError::UIDVersionMismatch;
+
+  const u64 expected_size =
+      sizeof(Header) + u64{header.num_pipeline_uids} * sizeof(SerializedGXPipelineUid) +
+      u64{header.num_uber_pipeline_uids} * sizeof(SerializedGXUberPipelineUid);
+  if (header.pipeline_uid_size != sizeof(SerializedGXPipelineUid) ||
+      header.uber_pipeline_uid_size != sizeof(SerializedGXUberPipelineUid) ||
+      file.GetSize() != expected_size)
+  {
+    return ShaderCachePackError::SizeMismatch;
+  }
+
+  ShaderCachePack pack(
+      std::string(header.game_id, strnlen(header.game_id, sizeof(header.game_id))));
+  pack.m_pipeline_uids.resize(header.num_pipeline_uids);
+  pack.m_uber_pipeline_uids.resize(header.num_uber_pipeline_uids);
+  if (!file.ReadArray(pack.m_pipeline_uids.data(), pack.m_pipeline_uids.size()) ||
+      !file.ReadArray(pack.m_uber_pipeline_uids.data(), pack.m_uber_pipeline_uids.size()))
+  {
+    return ShaderCachePackError::FileError;
+  }
+
+  if (ComputeChecksum(pack.m_pipeline_uids, pack.m_uber_pipeline_uids) != header.checksum)
+    return ShaderCachePackError::ChecksumMismatch;
+
+  // Merging relies on the UIDs being sorted, and Save always writes them this way.
+  if (!IsSortedAndUnique(pack.m_pipeline_uids) || !IsSortedAndUnique(pack.m_uber_pipeline_uids))
+    return ShaderCachePackError::UnsortedUIDs;
+
+  return pack;
+}
+
+ShaderCachePack::Result ShaderCachePack::ImportUIDCache(const std::string& path)
+{
+  std::string game_id;
+  std::string extension;
+  SplitPath(path, nullptr, &game_id, &extension);
+  Common::ToLower(&extension);
+
+  File::IOFile file(path, "rb");
+  if (!file.IsOpen())
+    return ShaderCachePackError::FileError;
+
+  u32 magic;
+  u32 uid_version;
+  if (!file.ReadArray(&magic, 1) || !file.ReadArray(&uid_version, 1) ||
+      magic != GX_PIPELINE_UID_CACHE_MAGIC)
+  {
+    return ShaderCachePackError::InvalidHeader;
+  }
+  if (uid_version != GX_PIPELINE_UID_VERSION)
+    return ShaderCachePackError::UIDVersionMismatch;
+
+  ShaderCachePack pack(std::move(game_id));
+  std::optional<ShaderCachePackError> error;
+  if (extension == UID_CACHE_EXTENSION)
+    error = ReadUIDCache(file, pack.m_pipeline_uids);
+  else if (extension == UBER_UID_CACHE_EXTENSION)
+    error = ReadUIDCache(file, pack.m_uber_pipeline_uids);
+  else
+    error = ShaderCachePackError::InvalidHeader;
+
+  if (error)
+    return *error;
+  return pack;
+}
+
+bool ShaderCachePack::Save(const std::string& path) const
+{
+  Header header{};
+  header.magic = PACK_MAGIC;
+  header.version = VERSION;
+  header.uid_version = GX_PIPELINE_UID_VERSION;
+  header.pipeline_uid_size = sizeof(SerializedGXPipelineUid);
+  header.uber_pipeline_uid_size = sizeof(SerializedGXUberPipelineUid);
+  header.num_pipeline_uids = static_cast<u32>(m_pipeline_uids.size());
+  header.num_uber_pipeline_uids = static_cast<u32>(m_uber_pipeline_uids.size());
+  header.checksum = ComputeChecksum(m_pipeline_uids, m_uber_pipeline_uids);
+  std::memcpy(header.game_id, m_game_id.data(),
+              std::min(m_game_id.size(), sizeof(header.game_id)));
+
+  File::IOFile file(path, "wb");
+  return file.WriteArray(&header, 1) &&
+         file.WriteArray(m_pipeline_uids.data(), m_pipeline_uids.size()) &&
+         file.WriteArray(m_uber_pipeline_uids.data(), m_uber_pipeline_uids.size());
+}
+
+size_t ShaderCachePack::Merge(const ShaderCachePack& other)
+{
+  return MergeUIDs(m_pipeline_uids, other.m_pipeline_uids) +
+         MergeUIDs(m_uber_pipeline_uids, other.m_uber_pipeline_uids);
+}
+
+std::string ShaderCachePack::GetPathForGame(std::string_view game_id)
+{
+  return fmt::format("{}{}{}", File::GetUserPath(D_SHADERPACKS_IDX), game_id, PACK_EXTENSION);
+}
+
+std::string_view ShaderCachePack::GetErrorString(ShaderCachePackError error)
+{
+  switch (error)
+  {
+  case ShaderCachePackError::FileError:
+    return "The file could not be read.";
+  case ShaderCachePackError::InvalidHeader:
+    return "The file is not a shader cache pack or UID cache.";
+  case ShaderCachePackError::UnsupportedVersion:
+    return "The pack was created by an unsupported version of Dolphin.";
+  case ShaderCachePackError::UIDVersionMismatch:
+    return "The UIDs were created for a different shader UID version.";
+  case ShaderCachePackError::SizeMismatch:
+    return "The file size does not match its contents. The file may be truncated.";
+  case ShaderCachePackError::ChecksumMismatch:
+    return "The checksum does not match. The file is corrupted.";
+  case ShaderCachePackError::UnsortedUIDs:
+    return "The UIDs are not sorted or contain duplicates.";
+  }
+  return "Unknown error.";
+}
+}  // namespace VideoCommon
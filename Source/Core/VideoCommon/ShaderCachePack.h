@@ -0,0 +1,73 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/Result.h"
+#include "VideoCommon/GXPipelineTypes.h"
+
+namespace VideoCommon
+{
+// Shader cache packs hold the pipeline UIDs a game is known to use, so they can be compiled
+// before they are first needed. Unlike the UID caches in the cache directory, packs are meant to
+// be shared: they are built by merging the UID caches of many users with dolphin-tool.
+//
+// On disk format:
+// Header
+// SerializedGXPipelineUid[num_pipeline_uids]
+// SerializedGXUberPipelineUid[num_uber_pipeline_uids]
+//
+// Both UID arrays are sorted by their bytes and contain no duplicates.
+enum class ShaderCachePackError
+{
+  FileError,
+  InvalidHeader,
+  UnsupportedVersion,
+  UIDVersionMismatch,
+  SizeMismatch,
+  ChecksumMismatch,
+  UnsortedUIDs,
+};
+
+class ShaderCachePack
+{
+public:
+  using Result = Common::Result<ShaderCachePackError, ShaderCachePack>;
+
+  // Increment this when the layout of the file changes. Changes to the UID structures are covered
+  // by GX_PIPELINE_UID_VERSION instead.
+  static constexpr u32 VERSION = 1;
+
+  explicit ShaderCachePack(std::string game_id);
+
+  static Result Load(const std::string& path);
+  // Reads a .uidcache or .uberuidcache file written by the shader cache.
+  // The game ID is taken from the file name.
+  static Result ImportUIDCache(const std::string& path);
+  bool Save(const std::string& path) const;
+
+  // Adds the UIDs of other which are not in this pack yet, and returns how many were added.
+  size_t Merge(const ShaderCachePack& other);
+
+  const std::string& GetGameID() const { return m_game_id; }
+  const std::vector<SerializedGXPipelineUid>& GetPipelineUIDs() const { return m_pipeline_uids; }
+  const std::vector<SerializedGXUberPipelineUid>& GetUberPipelineUIDs() const
+  {
+    return m_uber_pipeline_uids;
+  }
+
+  // Packs are looked up in Load/ShaderPacks/<game ID>.dsp.
+  static std::string GetPathForGame(std::string_view game_id);
+  static std::string_view GetErrorString(ShaderCachePackError error);
+
+private:
+  std::string m_game_id;
+  std::vector<SerializedGXPipelineUid> m_pipeline_uids;
+  std::vector<SerializedGXUberPipelineUid> m_uber_pipeline_uids;
+};
+}  // namespace VideoCommon
@@ -38,6 +38,7 @@
 #include "VideoCommon/AbstractStagingTexture.h"
 #include "VideoCommon/Assets/CustomTextureData.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/FBInfo.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModActionData.h"
@@ -60,11 +61,72 @@ static const u64 TEXHASH_INVALID = 0;
 // Sonic the Fighters (inside Sonic Gems Collection) loops a 64 frames animation
 static const int TEXTURE_KILL_THRESHOLD = 64;
 static const int TEXTURE_POOL_KILL_THRESHOLD = 3;
+// Textures which are hashed with XXH3 are hashed in parts, and the hashes of the parts are chained
+// together. A part is a row of blocks for EFB copies with a custom stride, and a chunk of this size
+// for everything else. This lets a partial update of an XFB copy only rehash what it touched.
+static const u32 TEXTURE_HASH_CHUNK_SIZE = 16 * 1024;
 
 static int xfb_count = 0;
 
 std::unique_ptr<TextureCacheBase> g_texture_cache;
 
+namespace
+{
+struct TextureHashParts
+{
+  u32 count;
+  u32 size;
+  u32 stride;
+  u32 last_size;
+
+  static TextureHashParts Contiguous(u32 total_size)
+  {
+    const u32 count =
+        std::max((total_size + TEXTURE_HASH_CHUNK_SIZE - 1) / TEXTURE_HASH_CHUNK_SIZE, 1u);
+    return {count, TEXTURE_HASH_CHUNK_SIZE, TEXTURE_HASH_CHUNK_SIZE,
+            total_size - (count - 1) * TEXTURE_HASH_CHUNK_SIZE};
+  }
+
+  u64 HashPart(const u8* ptr, u32 index) const
+  {
+    return Common::HashXXH3(ptr + index * stride, index == count - 1 ? last_size : size);
+  }
+};
+}  // namespace
+
+static bool UseXXH3TextureHash(u32 samples)
+{
+  // XXH3 can't sample the data, so it only replaces hashing everything.
+  return samples == 0 && !g_ActiveConfig.bLegacyTextureHash;
+}
+
+// XFB copies are always hashed with XXH3, since their hashes are updated in parts after
+// overlapping copies. They are never looked up by a hash from HashTextureMemory(), so they don't
+// have to follow the setting.
+static bool UseXXH3TextureHash(const TCacheEntry& entry)
+{
+  const u32 samples = entry.HashSampleSize();
+  return entry.is_xfb_copy ? samples == 0 : UseXXH3TextureHash(samples);
+}
+
+static u64 ChainTextureHash(u64 hash, u64 part_hash)
+{
+  return Common::HashXXH3(reinterpret_cast<const u8*>(&part_hash), sizeof(part_hash), hash);
+}
+
+// Hashes a texture or TLUT which is stored contiguously in memory.
+static u64 HashTextureMemory(const u8* ptr, u32 size, u32 samples)
+{
+  if (!UseXXH3TextureHash(samples))
+    return Common::GetHash64(ptr, size, samples);
+
+  const TextureHashParts parts = TextureHashParts::Contiguous(size);
+  u64 hash = size;
+  for (u32 i = 0; i < parts.count; i++)
+    hash = ChainTextureHash(hash, parts.HashPart(ptr, i));
+  return hash;
+}
+
 TCacheEntry::TCacheEntry(std::unique_ptr<AbstractTexture> tex,
                          std::unique_ptr<AbstractFramebuffer> fb)
     : texture(std::move(tex)), framebuffer(std::move(fb))
@@ -99,6 +161,8 @@ TextureCacheBase::TextureCacheBase()
   TexDecoder_SetTexFmtOverlayOptions(m_backup_config.texfmt_overlay,
                                      m_backup_config.texfmt_overlay_center);
 
+  m_decoding_workers.Reset("Texture Decoding", g_ActiveConfig.GetTextureDecodingThreads());
+
   HiresTexture::Init();
 
   TMEM::InvalidateAll();
@@ -111,6 +175,8 @@ void TextureCacheBase::Shutdown()
 
   HiresTexture::Shutdown();
 
+  m_decoding_workers.Shutdown();
+
   // For correctness, we need to invalidate textures before the gpu context starts shutting down.
   Invalidate();
 }
@@ -158,6 +224,7 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
 
   // TODO: Invalidating texcache is really stupid in some of these cases
   if (config.iSafeTextureCache_ColorSamples != m_backup_config.color_samples ||
+      config.bLegacyTextureHash != m_backup_config.legacy_texture_hash ||
       config.bTexFmtOverlayEnable != m_backup_config.texfmt_overlay ||
       config.bTexFmtOverlayCenter != m_backup_config.texfmt_overlay_center ||
       config.bHiresTextures != m_backup_config.hires_textures ||
@@ -171,6 +238,9 @@ void TextureCacheBase::OnConfigChanged(const VideoConfig& config)
     TexDecoder_SetTexFmtOverlayOptions(config.bTexFmtOverlayEnable, config.bTexFmtOverlayCenter);
   }
 
+  if (config.GetTextureDecodingThreads() != m_decoding_workers.GetWorkerCount())
+    m_decoding_workers.Reset("Texture Decoding", config.GetTextureDecodingThreads());
+
   SetBackupConfig(config);
 }
 
@@ -247,6 +317,7 @@ bool TCacheEntry::OverlapsMemoryRange(u32 range_address, u32 range_size) const
 void TextureCacheBase::SetBackupConfig(const VideoConfig& config)
 {
   m_backup_config.color_samples = config.iSafeTextureCache_ColorSamples;
+  m_backup_config.legacy_texture_hash = config.bLegacyTextureHash;
   m_backup_config.texfmt_overlay = config.bTexFmtOverlayEnable;
   m_backup_config.texfmt_overlay_center = config.bTexFmtOverlayCenter;
   m_backup_config.hires_textures = config.bHiresTextures;
@@ -715,8 +786,9 @@ void TextureCacheBase::DoLoadState(PointerWrap& p)
     // Even if the texture isn't valid, we still need to create the cache entry object
     // to update the point in the state state. We'll just throw it away if it's invalid.
     auto tex = DeserializeTexture(p);
-    auto entry =
-        std::make_shared<TCacheEntry>(std::move(tex->texture), std::move(tex->framebuffer));
+    auto entry = std::allocate_shared<TCacheEntry>(
+        VideoCommon::TextureCacheEntryAllocator<TCacheEntry>(&m_entry_pool),
+        std::move(tex->texture), std::move(tex->framebuffer));
     entry->textures_by_hash_iter = m_textures_by_hash.end();
     entry->DoState(p);
     if (entry->texture && commit_state)
@@ -1245,6 +1317,8 @@ private:
 
 TCacheEntry* TextureCacheBase::Load(const TextureInfo& texture_info)
 {
+  VideoCommon::FrameProfilerScope profiler_scope(VideoCommon::FrameProfilerPhase::TextureCache);
+
   if (auto entry = LoadImpl(texture_info, false))
   {
     if (!DidLinkedAssetsChange(*entry))
@@ -1351,14 +1425,14 @@ RcTcacheEntry TextureCacheBase::GetTexture(const int textureCacheSafetyColorSamp
 
   // TODO: This doesn't hash GB tiles for preloaded RGBA8 textures (instead, it's hashing more data
   // from the low tmem bank than it should)
-  base_hash = Common::GetHash64(texture_info.GetData(), texture_info.GetTextureSize(),
-                                textureCacheSafetyColorSampleSize);
+  base_hash = HashTextureMemory(texture_info.GetData(), texture_info.GetTextureSize(),
+                               textureCacheSafetyColorSampleSize);
   u32 palette_size = 0;
   if (texture_info.GetPaletteSize())
   {
     palette_size = *texture_info.GetPaletteSize();
     full_hash =
-        base_hash ^ Common::GetHash64(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
+        base_hash ^ HashTextureMemory(texture_info.GetTlutAddress(), *texture_info.GetPaletteSize(),
                                       textureCacheSafetyColorSampleSize);
   }
   else
@@ -1757,9 +1831,9 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
       dst_buffer = m_temp;
       if (!(texture_info.GetTextureFormat() == TextureFormat::RGBA8 && texture_info.IsFromTmem()))
       {
-        TexDecoder_Decode(dst_buffer, texture_info.GetData(), expanded_width, expanded_height,
-                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
-                          texture_info.GetTlutFormat());
+        TexDecoder_Decode(m_decoding_workers, dst_buffer, texture_info.GetData(), expanded_width,
+                          expanded_height, texture_info.GetTextureFormat(),
+                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
       }
       else
       {
@@ -1793,9 +1867,10 @@ RcTcacheEntry TextureCacheBase::CreateTextureEntry(
         // No need to call CheckTempSize here, as the whole buffer is preallocated at the beginning
         const u32 decoded_mip_size =
             mip_level->GetExpandedWidth() * sizeof(u32) * mip_level->GetExpandedHeight();
-        TexDecoder_Decode(dst_buffer, mip_level->GetData(), mip_level->GetExpandedWidth(),
-                          mip_level->GetExpandedHeight(), texture_info.GetTextureFormat(),
-                          texture_info.GetTlutAddress(), texture_info.GetTlutFormat());
+        TexDecoder_Decode(m_decoding_workers, dst_buffer, mip_level->GetData(),
+                          mip_level->GetExpandedWidth(), mip_level->GetExpandedHeight(),
+                          texture_info.GetTextureFormat(), texture_info.GetTlutAddress(),
+                          texture_info.GetTlutFormat());
         entry->texture->Load(level, mip_level->GetRawWidth(), mip_level->GetRawHeight(),
                              mip_level->GetExpandedWidth(), dst_buffer, decoded_mip_size);
 
@@ -2508,7 +2583,8 @@ void TextureCacheBase::CopyRenderTargetToTexture(
       // to mitigate this
       if (overlapping_entry->is_xfb_copy && copy_to_ram)
       {
-        overlapping_entry->hash = overlapping_entry->CalculateHash();
+        overlapping_entry->hash =
+            overlapping_entry->CalculateHashAfterWrite(dstAddr, covered_range);
       }
 
       // Do not load textures by hash, if they were at least partly overwritten by an efb copy.
@@ -2603,7 +2679,8 @@ void TextureCacheBase::FlushEFBCopy(TCacheEntry* entry)
       if (overlapping_entry->may_have_overlapping_textures && overlapping_entry->is_xfb_copy &&
           overlapping_entry->OverlapsMemoryRange(entry->addr, covered_range))
       {
-        const u64 overlapping_hash = overlapping_entry->CalculateHash();
+        const u64 overlapping_hash =
+            overlapping_entry->CalculateHashAfterWrite(entry->addr, covered_range);
         entry->SetHashes(overlapping_hash, overlapping_hash);
       }
     }
@@ -2695,8 +2772,9 @@ RcTcacheEntry TextureCacheBase::AllocateCacheEntry(const TextureConfig& config)
   if (!alloc)
     return {};
 
-  auto cacheEntry =
-      std::make_shared<TCacheEntry>(std::move(alloc->texture), std::move(alloc->framebuffer));
+  auto cacheEntry = std::allocate_shared<TCacheEntry>(
+      VideoCommon::TextureCacheEntryAllocator<TCacheEntry>(&m_entry_pool),
+      std::move(alloc->texture), std::move(alloc->framebuffer));
   cacheEntry->textures_by_hash_iter = m_textures_by_hash.end();
   cacheEntry->id = m_last_entry_id++;
   return cacheEntry;
@@ -3154,6 +3232,15 @@ int TCacheEntry::HashSampleSize() const
   return g_ActiveConfig.iSafeTextureCache_ColorSamples;
 }
 
+static TextureHashParts GetHashParts(const TCacheEntry& entry)
+{
+  const u32 bytes_per_row = entry.BytesPerRow();
+  if (entry.memory_stride == bytes_per_row)
+    return TextureHashParts::Contiguous(entry.size_in_bytes);
+
+  return {entry.NumBlocksY(), bytes_per_row, entry.memory_stride, bytes_per_row};
+}
+
 u64 TCacheEntry::CalculateHash() const
 {
   const u32 bytes_per_row = BytesPerRow();
@@ -3163,7 +3250,15 @@ u64 TCacheEntry::CalculateHash() const
   auto& system = Core::System::GetInstance();
   auto& memory = system.GetMemory();
   u8* ptr = memory.GetPointerForRange(addr, size_in_bytes);
-  if (memory_stride == bytes_per_row)
+  if (UseXXH3TextureHash(*this))
+  {
+    const TextureHashParts parts = GetHashParts(*this);
+    u64 hash = size_in_bytes;
+    for (u32 i = 0; i < parts.count; i++)
+      hash = ChainTextureHash(hash, parts.HashPart(ptr, i));
+    return hash;
+  }
+  else if (memory_stride == bytes_per_row)
   {
     return Common::GetHash64(ptr, size_in_bytes, hash_sample_size);
   }
@@ -3191,6 +3286,45 @@ u64 TCacheEntry::CalculateHash() const
   }
 }
 
+u64 TCacheEntry::CalculateHashAfterWrite(u32 range_address, u32 range_size)
+{
+  if (!UseXXH3TextureHash(*this))
+    return CalculateHash();
+
+  auto& system = Core::System::GetInstance();
+  auto& memory = system.GetMemory();
+  const u8* ptr = memory.GetPointerForRange(addr, size_in_bytes);
+  const TextureHashParts parts = GetHashParts(*this);
+
+  // The part hashes can only be reused if nothing has replaced the hash they were chained into.
+  u32 first = 0;
+  u32 last = parts.count;
+  if (partial_hashes.size() == parts.count && hash == partial_hashes_chain)
+  {
+    // Only the parts which overlap the written range can have changed since the last call.
+    first = last = 0;
+    if (OverlapsMemoryRange(range_address, range_size))
+    {
+      const u32 start = std::max(range_address, addr) - addr;
+      const u32 end = std::min(range_address + range_size, addr + size_in_bytes) - addr;
+      first = start / parts.stride;
+      last = std::min((end + parts.stride - 1) / parts.stride, parts.count);
+    }
+  }
+  else
+  {
+    partial_hashes.resize(parts.count);
+  }
+
+  for (u32 i = first; i < last; i++)
+    partial_hashes[i] = parts.HashPart(ptr, i);
+
+  partial_hashes_chain = size_in_bytes;
+  for (const u64 part_hash : partial_hashes)
+    partial_hashes_chain = ChainTextureHash(partial_hashes_chain, part_hash);
+  return partial_hashes_chain;
+}
+
 TextureCacheBase::TexPoolEntry::TexPoolEntry(std::unique_ptr<AbstractTexture> tex,
                                              std::unique_ptr<AbstractFramebuffer> fb)
     : texture(std::move(tex)), framebuffer(std::move(fb))
@@ -20,10 +20,12 @@
 #include "Common/CommonTypes.h"
 #include "Common/Flag.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkerPool.h"
 
 #include "VideoCommon/AbstractTexture.h"
 #include "VideoCommon/Assets/CustomAsset.h"
 #include "VideoCommon/BPMemory.h"
+#include "VideoCommon/TextureCacheIndex.h"
 #include "VideoCommon/TextureConfig.h"
 #include "VideoCommon/TextureDecoder.h"
 #include "VideoCommon/TextureInfo.h"
@@ -154,7 +156,7 @@ struct TCacheEntry
 
   // Keep an iterator to the entry in m_textures_by_hash, so it does not need to be searched when
   // removing the cache entry
-  std::multimap<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
+  VideoCommon::TextureCacheIndex<u64, std::shared_ptr<TCacheEntry>>::iterator textures_by_hash_iter;
 
   // This is used to keep track of both:
   //   * efb copies used by this partially updated texture
@@ -168,6 +170,11 @@ struct TCacheEntry
 
   std::string texture_info_name = "";
 
+  // Hashes of the parts of an XFB copy from the last call of CalculateHashAfterWrite(), and the
+  // hash they were chained into. They are only reused while the entry still has that hash.
+  std::vector<u64> partial_hashes;
+  u64 partial_hashes_chain = 0;
+
   std::vector<VideoCommon::CachedAsset<VideoCommon::GameTextureAsset>> linked_game_texture_assets;
   std::vector<VideoCommon::CachedAsset<VideoCommon::CustomAsset>> linked_asset_dependencies;
 
@@ -229,6 +236,10 @@ struct TCacheEntry
   u32 BytesPerRow() const;
 
   u64 CalculateHash() const;
+  // Same as CalculateHash(), but after a write to the given range of memory. For XFB copies, this
+  // only rehashes the parts which overlap that range, and reuses the hashes of the other parts from
+  // the last call if the entry's hash is still the one that call returned.
+  u64 CalculateHashAfterWrite(u32 range_address, u32 range_size);
 
   int HashSampleSize() const;
   u32 GetWidth() const { return texture->GetConfig().width; }
@@ -339,8 +350,8 @@ protected:
   size_t m_temp_size = 0;
 
 private:
-  using TexAddrCache = std::multimap<u32, RcTcacheEntry>;
-  using TexHashCache = std::multimap<u64, RcTcacheEntry>;
+  using TexAddrCache = VideoCommon::TextureCacheIndex<u32, RcTcacheEntry>;
+  using TexHashCache = VideoCommon::TextureCacheIndex<u64, RcTcacheEntry>;
 
   using TexPool = std::unordered_multimap<TextureConfig, TexPoolEntry>;
 
@@ -408,6 +419,9 @@ private:
   void DoSaveState(PointerWrap& p);
   void DoLoadState(PointerWrap& p);
 
+  // Backs the memory of all cache entries, so it has to outlive every RcTcacheEntry below.
+  VideoCommon::TextureCacheEntryPool m_entry_pool;
+
   // m_textures_by_address is the authoritive version of what's actually "in" the texture cache
   // but it's possible for invalidated TCache entries to live on elsewhere
   TexAddrCache m_textures_by_address;
@@ -423,10 +437,14 @@ private:
   TexPool m_texture_pool;
   u64 m_last_entry_id = 0;
 
+  // Helps the GPU thread decode large textures on the CPU.
+  Common::WorkerPool m_decoding_workers;
+
   // Backup configuration values
   struct BackupConfig
   {
     int color_samples;
+    bool legacy_texture_hash;
     bool texfmt_overlay;
     bool texfmt_overlay_center;
     bool hires_textures;
@@ -0,0 +1,452 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+
+namespace VideoCommon
+{
+// An ordered multimap which implements the subset of the std::multimap interface used by the
+// texture cache, without walking a tree on every lookup.
+//
+// All elements are linked into a single intrusive list in key order, with elements of equal keys
+// in insertion order. An open-addressing hash table maps each key to the first and last element
+// with that key, so equal_range is a single probe. A flat sorted array of the distinct keys is
+// only needed to find where a new key goes and to answer lower_bound/upper_bound. Nodes are
+// recycled through a free list owned by the index instead of being allocated one at a time.
+//
+// As with std::multimap, inserting or erasing elements does not invalidate iterators to other
+// elements. The index must not be moved, as end() points into it.
+template <typename Key, typename Value>
+class TextureCacheIndex
+{
+  static_assert(std::is_integral_v<Key>);
+
+  struct Link
+  {
+    Link* prev;
+    Link* next;
+  };
+
+  struct Node : Link
+  {
+    Node(const Key& key, Value&& v) : value(key, std::move(v)) {}
+
+    std::pair<const Key, Value> value;
+  };
+
+  union NodeStorage
+  {
+    NodeStorage() {}
+    ~NodeStorage() {}
+
+    NodeStorage* next_free;
+    Node node;
+  };
+
+  struct Slot
+  {
+    Key key{};
+    // nullptr if the slot is empty
+    Node* first = nullptr;
+    Node* last = nullptr;
+  };
+
+  static constexpr size_t NODES_PER_CHUNK = 256;
+  static constexpr size_t MIN_SLOTS = 64;
+
+public:
+  using key_type = Key;
+  using mapped_type = Value;
+  using value_type = std::pair<const Key, Value>;
+
+  template <bool IsConst>
+  class Iterator
+  {
+  public:
+    using iterator_category = std::bidirectional_iterator_tag;
+    using value_type = TextureCacheIndex::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<IsConst, const value_type*, value_type*>;
+    using reference = std::conditional_t<IsConst, const value_type&, value_type&>;
+
+    Iterator() = default;
+    template <bool OtherIsConst>
+      requires(IsConst && !OtherIsConst)
+    Iterator(const Iterator<OtherIsConst>& other) : m_link(other.m_link)
+    {
+    }
+
+    reference operator*() const { return static_cast<Node*>(m_link)->value; }
+    pointer operator->() const { return &static_cast<Node*>(m_link)->value; }
+
+    Iterator& operator++()
+    {
+      m_link = m_link->next;
+      return *this;
+    }
+    Iterator operator++(int)
+    {
+      Iterator old = *this;
+      m_link = m_link->next;
+      return old;
+    }
+    Iterator& operator--()
+    {
+      m_link = m_link->prev;
+      return *this;
+    }
+    Iterator operator--(int)
+    {
+      Iterator old = *this;
+      m_link = m_link->prev;
+      return old;
+    }
+
+    bool operator==(const Iterator& other) const = default;
+
+  private:
+    friend class TextureCacheIndex;
+    friend class Iterator<!IsConst>;
+
+    explicit Iterator(Link* link) : m_link(link) {}
+
+    Link* m_link = nullptr;
+  };
+
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  TextureCacheIndex() { m_end.prev = m_end.next = &m_end; }
+  ~TextureCacheIndex() { clear(); }
+
+  TextureCacheIndex(const TextureCacheIndex&) = delete;
+  TextureCacheIndex(TextureCacheIndex&&) = delete;
+  TextureCacheIndex& operator=(const TextureCacheIndex&) = delete;
+  TextureCacheIndex& operator=(TextureCacheIndex&&) = delete;
+
+  iterator begin() { return iterator(m_end.next); }
+  iterator end() { return iterator(&m_end); }
+  const_iterator begin() const { return const_iterator(m_end.next); }
+  const_iterator end() const { return const_iterator(const_cast<Link*>(&m_end)); }
+
+  size_t size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+
+  // Inserts after all existing elements with the same key.
+  iterator emplace(const Key& key, Value value)
+  {
+    Node* node = AllocateNode(key, std::move(value));
+
+    if (Slot* slot = FindSlot(key))
+    {
+      LinkBefore(node, slot->last->next);
+      slot->last = node;
+    }
+    else
+    {
+      const auto pos = std::upper_bound(m_sorted_keys.begin(), m_sorted_keys.end(), key);
+      LinkBefore(node, pos != m_sorted_keys.end() ? FindSlot(*pos)->first : &m_end);
+      m_sorted_keys.insert(pos, key);
+
+      Slot& new_slot = InsertSlot(key);
+      new_slot.first = node;
+      new_slot.last = node;
+    }
+
+    m_size++;
+    return iterator(node);
+  }
+
+  iterator erase(iterator it)
+  {
+    Node* node = static_cast<Node*>(it.m_link);
+    Link* next = node->next;
+
+    Slot* slot = FindSlot(node->value.first);
+    if (slot->first == node && slot->last == node)
+    {
+      m_sorted_keys.erase(
+          std::lower_bound(m_sorted_keys.begin(), m_sorted_keys.end(), node->value.first));
+      EraseSlot(slot);
+    }
+    else if (slot->first == node)
+    {
+      slot->first = static_cast<Node*>(next);
+    }
+    else if (slot->last == node)
+    {
+      slot->last = static_cast<Node*>(node->prev);
+    }
+
+    node->prev->next = next;
+    next->prev = node->prev;
+    m_size--;
+
+    // Destroying the value may run arbitrary code, so only do it once the index is consistent.
+    FreeNode(node);
+    return iterator(next);
+  }
+
+  void clear()
+  {
+    Link* link = m_end.next;
+    m_end.prev = m_end.next = &m_end;
+    m_sorted_keys.clear();
+    std::fill(m_slots.begin(), m_slots.end(), Slot{});
+    m_num_keys = 0;
+    m_size = 0;
+
+    while (link != &m_end)
+    {
+      Link* next = link->next;
+      FreeNode(static_cast<Node*>(link));
+      link = next;
+    }
+  }
+
+  std::pair<iterator, iterator> equal_range(const Key& key)
+  {
+    if (const Slot* slot = FindSlot(key))
+      return {iterator(slot->first), iterator(slot->last->next)};
+    return {end(), end()};
+  }
+
+  iterator lower_bound(const Key& key)
+  {
+    return FirstOfKey(std::lower_bound(m_sorted_keys.begin(), m_sorted_keys.end(), key));
+  }
+
+  iterator upper_bound(const Key& key)
+  {
+    return FirstOfKey(std::upper_bound(m_sorted_keys.begin(), m_sorted_keys.end(), key));
+  }
+
+private:
+  size_t GetHomeSlot(Key key) const
+  {
+    // Fibonacci hashing spreads out the sequential, aligned addresses textures tend to live at.
+    return static_cast<size_t>((static_cast<u64>(key) * 0x9E3779B97F4A7C15ULL) >> m_hash_shift);
+  }
+
+  Slot* FindSlot(Key key)
+  {
+    if (m_slots.empty())
+      return nullptr;
+
+    const size_t mask = m_slots.size() - 1;
+    for (size_t i = GetHomeSlot(key);; i = (i + 1) & mask)
+    {
+      Slot& slot = m_slots[i];
+      if (!slot.first)
+        return nullptr;
+      if (slot.key == key)
+        return &slot;
+    }
+  }
+
+  // The key must not be in the table yet. Invalidates pointers to other slots.
+  Slot& InsertSlot(Key key)
+  {
+    // Keep the load factor at or below 1/2, so probe sequences stay short.
+    if ((m_num_keys + 1) * 2 > m_slots.size())
+      Rehash(std::max(m_slots.size() * 2, MIN_SLOTS));
+
+    const size_t mask = m_slots.size() - 1;
+    size_t i = GetHomeSlot(key);
+    while (m_slots[i].first)
+      i = (i + 1) & mask;
+
+    m_num_keys++;
+    m_slots[i].key = key;
+    return m_slots[i];
+  }
+
+  void EraseSlot(Slot* slot)
+  {
+    // Backward shift deletion: move later elements of the probe sequence into the hole, unless
+    // that would put them before their home slot. This avoids the need for tombstones.
+    const size_t mask = m_slots.size() - 1;
+    size_t hole = slot - m_slots.data();
+    for (size_t i = (hole + 1) & mask; m_slots[i].first; i = (i + 1) & mask)
+    {
+      const size_t home = GetHomeSlot(m_slots[i].key);
+      if (((i - home) & mask) >= ((i - hole) & mask))
+      {
+        m_slots[hole] = m_slots[i];
+        hole = i;
+      }
+    }
+
+    m_slots[hole] = Slot{};
+    m_num_keys--;
+  }
+
+  void Rehash(size_t num_slots)
+  {
+    std::vector<Slot> old_slots(num_slots);
+    std::swap(old_slots, m_slots);
+    m_hash_shift = 64 - std::countr_zero(num_slots);
+
+    const size_t mask = num_slots - 1;
+    for (const Slot& slot : old_slots)
+    {
+      if (!slot.first)
+        continue;
+
+      size_t i = GetHomeSlot(slot.key);
+      while (m_slots[i].first)
+        i = (i + 1) & mask;
+      m_slots[i] = slot;
+    }
+  }
+
+  iterator FirstOfKey(typename std::vector<Key>::const_iterator pos)
+  {
+    return pos != m_sorted_keys.end() ? iterator(FindSlot(*pos)->first) : end();
+  }
+
+  static void LinkBefore(Node* node, Link* next)
+  {
+    node->prev = next->prev;
+    node->next = next;
+    next->prev->next = node;
+    next->prev = node;
+  }
+
+  Node* AllocateNode(const Key& key, Value&& value)
+  {
+    if (!m_free_nodes)
+    {
+      auto& chunk = m_chunks.emplace_back(std::make_unique<NodeStorage[]>(NODES_PER_CHUNK));
+      for (size_t i = 0; i < NODES_PER_CHUNK; i++)
+      {
+        chunk[i].next_free = m_free_nodes;
+        m_free_nodes = &chunk[i];
+      }
+    }
+
+    NodeStorage* storage = m_free_nodes;
+    m_free_nodes = storage->next_free;
+    return new (&storage->node) Node(key, std::move(value));
+  }
+
+  void FreeNode(Node* node)
+  {
+    NodeStorage* storage = reinterpret_cast<NodeStorage*>(node);
+    node->~Node();
+    storage->next_free = m_free_nodes;
+    m_free_nodes = storage;
+  }
+
+  Link m_end;
+  size_t m_size = 0;
+
+  std::vector<Key> m_sorted_keys;
+
+  std::vector<Slot> m_slots;
+  size_t m_num_keys = 0;
+  int m_hash_shift = 64;
+
+  std::vector<std::unique_ptr<NodeStorage[]>> m_chunks;
+  NodeStorage* m_free_nodes = nullptr;
+};
+
+// Recycles the memory of destroyed texture cache entries, including their shared_ptr control
+// blocks. Like the rest of the texture cache, it must only be used from the GPU thread.
+class TextureCacheEntryPool
+{
+public:
+  TextureCacheEntryPool() = default;
+  ~TextureCacheEntryPool()
+  {
+    while (m_free_blocks)
+    {
+      FreeBlock* next = m_free_blocks->next;
+      ::operator delete(m_free_blocks);
+      m_free_blocks = next;
+    }
+  }
+
+  TextureCacheEntryPool(const TextureCacheEntryPool&) = delete;
+  TextureCacheEntryPool& operator=(const TextureCacheEntryPool&) = delete;
+
+  void* Allocate(size_t size)
+  {
+    // std::allocate_shared only ever asks for a single block size.
+    if (m_block_size == 0)
+      m_block_size = std::max(size, sizeof(FreeBlock));
+    if (size > m_block_size || !m_free_blocks)
+      return ::operator new(std::max(size, m_block_size));
+
+    FreeBlock* block = m_free_blocks;
+    m_free_blocks = block->next;
+    return block;
+  }
+
+  void Deallocate(void* ptr, size_t size)
+  {
+    if (size > m_block_size)
+    {
+      ::operator delete(ptr);
+      return;
+    }
+
+    FreeBlock* block = static_cast<FreeBlock*>(ptr);
+    block->next = m_free_blocks;
+    m_free_blocks = block;
+  }
+
+private:
+  struct FreeBlock
+  {
+    FreeBlock* next;
+  };
+
+  size_t m_block_size = 0;
+  FreeBlock* m_free_blocks = nullptr;
+};
+
+template <typename T>
+class TextureCacheEntryAllocator
+{
+public:
+  using value_type = T;
+
+  explicit TextureCacheEntryAllocator(TextureCacheEntryPool* pool) : m_pool(pool) {}
+  template <typename U>
+  TextureCacheEntryAllocator(const TextureCacheEntryAllocator<U>& other) : m_pool(other.m_pool)
+  {
+  }
+
+  T* allocate(size_t n)
+  {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+    return static_cast<T*>(m_pool->Allocate(n * sizeof(T)));
+  }
+  void deallocate(T* ptr, size_t n) { m_pool->Deallocate(ptr, n * sizeof(T)); }
+
+  template <typename U>
+  bool operator==(const TextureCacheEntryAllocator<U>& other) const
+  {
+    return m_pool == other.m_pool;
+  }
+
+private:
+  template <typename U>
+  friend class TextureCacheEntryAllocator;
+
+  TextureCacheEntryPool* m_pool;
+};
+}  // namespace VideoCommon
@@ -11,6 +11,11 @@
 #include "Common/EnumFormatter.h"
 #include "Common/SpanUtils.h"
 
+namespace Common
+{
+class WorkerPool;
+}
+
 enum
 {
   TMEM_SIZE = 1024 * 1024,
@@ -191,6 +196,10 @@ TextureFormat TexDecoder_GetEFBCopyBaseFormat(EFBCopyFormat format);
 
 void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFormat texformat,
                        const u8* tlut, TLUTFormat tlutfmt);
+// Splits large textures into bands of block rows, which are decoded by the workers and the calling
+// thread together. Small textures are decoded on the calling thread only.
+void TexDecoder_Decode(Common::WorkerPool& workers, u8* dst, const u8* src, int width, int height,
+                       TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt);
 void TexDecoder_DecodeRGBA8FromTmem(u8* dst, const u8* src_ar, const u8* src_gb, int width,
                                     int height);
 void TexDecoder_DecodeTexel(u8* dst, std::span<const u8> src, int s, int t, int imageWidth,
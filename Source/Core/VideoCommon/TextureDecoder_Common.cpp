@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <cmath>
 #include <cstddef>
 #include <span>
@@ -11,6 +12,7 @@
 #include "Common/MsgHandler.h"
 #include "Common/SpanUtils.h"
 #include "Common/Swap.h"
+#include "Common/WorkerPool.h"
 
 #include "VideoCommon/LookUpTables.h"
 #include "VideoCommon/TextureDecoder.h"
@@ -307,6 +309,37 @@ void TexDecoder_Decode(u8* dst, const u8* src, int width, int height, TextureFor
     TexDecoder_DrawOverlay(dst, width, height, texformat);
 }
 
+void TexDecoder_Decode(Common::WorkerPool& workers, u8* dst, const u8* src, int width, int height,
+                       TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt)
+{
+  // Waking up the workers costs more than decoding bands smaller than this saves.
+  constexpr int MIN_TEXELS_PER_BAND = 64 * 1024;
+
+  // Bands consist of whole block rows, so each of them also starts at a block row in the source.
+  const int block_height = TexDecoder_GetBlockHeightInTexels(texformat);
+  const int band_height = std::max(MIN_TEXELS_PER_BAND / (width * block_height), 1) * block_height;
+  const int num_bands = (height + band_height - 1) / band_height;
+  if (workers.GetWorkerCount() == 0 || num_bands < 2)
+  {
+    TexDecoder_Decode(dst, src, width, height, texformat, tlut, tlutfmt);
+    return;
+  }
+
+  std::atomic<int> next_band = 0;
+  workers.Run([&](u32) {
+    for (int band = next_band++; band < num_bands; band = next_band++)
+    {
+      const int y = band * band_height;
+      _TexDecoder_DecodeImpl((u32*)dst + y * width,
+                             src + TexDecoder_GetTextureSizeInBytes(width, y, texformat), width,
+                             std::min(band_height, height - y), texformat, tlut, tlutfmt);
+    }
+  });
+
+  if (TexFmt_Overlay_Enable)
+    TexDecoder_DrawOverlay(dst, width, height, texformat);
+}
+
 static inline u32 DecodePixel_IA8(u16 val)
 {
   int a = val & 0xFF;
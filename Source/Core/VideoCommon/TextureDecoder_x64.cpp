@@ -13,6 +13,7 @@
 
 #include "Common/CPUDetect.h"
 #include "Common/CommonTypes.h"
+#include "Common/Inline.h"
 #include "Common/Intrinsics.h"
 #include "Common/MsgHandler.h"
 #include "Common/Swap.h"
@@ -1157,6 +1158,170 @@ static void TexDecoder_DecodeImpl_RGBA8(u32* dst, const u8* src, int width, int
   }
 }
 
+// Calculates the colors of two consecutive DXT blocks, and copies out their 2-bit color indices.
+// This is force inlined, so that the AVX2 decoder gets a VEX encoded copy of it.
+static DOLPHIN_FORCE_INLINE void DecodeDXTBlockPairColors(const u8* src, __m128i* mmcolors0,
+                                                          __m128i* mmcolors1, u32* dxt0sel,
+                                                          u32* dxt1sel)
+{
+  // JSD NOTE: You may see many strange patterns of behavior in the below code, but they
+  // are for performance reasons. Sometimes, calculating what should be obvious hard-coded
+  // constants is faster than loading their values from memory. Unfortunately, there is no
+  // way to inline 128-bit constants from opcodes so they must be loaded from memory. This
+  // seems a little ridiculous to me in that you can't even generate a constant value of 1
+  // without having to load it from memory. So, I stored the minimal constant I could,
+  // 128-bits worth of 1s :). Then I use sequences of shifts to squash it to the appropriate
+  // size and bitpositions that I need.
+  const __m128i allFFs128 = _mm_cmpeq_epi32(_mm_setzero_si128(), _mm_setzero_si128());
+
+  // Load 128 bits, i.e. two DXTBlocks (64-bits each)
+  const __m128i dxt = _mm_loadu_si128((__m128i*)src);
+
+  // Copy the 2-bit indices from each DXT block:
+  alignas(16) u32 dxttmp[4];
+  _mm_store_si128((__m128i*)dxttmp, dxt);
+
+  *dxt0sel = dxttmp[1];
+  *dxt1sel = dxttmp[3];
+
+  __m128i argb888x4;
+  __m128i c1 = _mm_unpackhi_epi16(dxt, dxt);
+  c1 = _mm_slli_si128(c1, 8);
+  const __m128i c0 =
+      _mm_or_si128(c1, _mm_srli_si128(_mm_slli_si128(_mm_unpacklo_epi16(dxt, dxt), 8), 8));
+
+  // Compare rgb0 to rgb1:
+  // Each 32-bit word will contain either 0xFFFFFFFF or 0x00000000 for true/false.
+  const __m128i c0cmp = _mm_srli_epi32(_mm_slli_epi32(_mm_srli_epi64(c0, 8), 16), 16);
+  const __m128i c0shr = _mm_srli_epi64(c0cmp, 32);
+  const __m128i cmprgb0rgb1 = _mm_cmpgt_epi32(c0cmp, c0shr);
+
+  int cmp0 = _mm_extract_epi16(cmprgb0rgb1, 0);
+  int cmp1 = _mm_extract_epi16(cmprgb0rgb1, 4);
+
+  // green:
+  // NOTE: We start with the larger number of bits (6) firts for G and shift the mask down
+  // 1 bit to get a 5-bit mask later for R and B components.
+  // low6mask == _mm_set_epi32(0x0000FC00, 0x0000FC00, 0x0000FC00, 0x0000FC00)
+  const __m128i low6mask = _mm_slli_epi32(_mm_srli_epi32(allFFs128, 24 + 2), 8 + 2);
+  const __m128i gtmp = _mm_srli_epi32(c0, 3);
+  const __m128i g0 = _mm_and_si128(gtmp, low6mask);
+  // low3mask == _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300)
+  const __m128i g1 = _mm_and_si128(
+      _mm_srli_epi32(gtmp, 6), _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300));
+  argb888x4 = _mm_or_si128(g0, g1);
+  // red:
+  // low5mask == _mm_set_epi32(0x000000F8, 0x000000F8, 0x000000F8, 0x000000F8)
+  const __m128i low5mask = _mm_slli_epi32(_mm_srli_epi32(low6mask, 8 + 3), 3);
+  const __m128i r0 = _mm_and_si128(c0, low5mask);
+  const __m128i r1 = _mm_srli_epi32(r0, 5);
+  argb888x4 = _mm_or_si128(argb888x4, _mm_or_si128(r0, r1));
+  // blue:
+  // _mm_slli_epi32(low5mask, 16) == _mm_set_epi32(0x00F80000, 0x00F80000, 0x00F80000, 0x00F80000)
+  const __m128i b0 = _mm_and_si128(_mm_srli_epi32(c0, 5), _mm_slli_epi32(low5mask, 16));
+  const __m128i b1 = _mm_srli_epi16(b0, 5);
+  // OR in the fixed alpha component
+  // _mm_slli_epi32( allFFs128, 24 ) == _mm_set_epi32(0xFF000000, 0xFF000000, 0xFF000000,
+  // 0xFF000000)
+  argb888x4 = _mm_or_si128(_mm_or_si128(argb888x4, _mm_slli_epi32(allFFs128, 24)),
+                           _mm_or_si128(b0, b1));
+  // calculate RGB2 and RGB3:
+  const __m128i rgb0 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(2, 2, 0, 0));
+  const __m128i rgb1 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(3, 3, 1, 1));
+  const __m128i rrggbb0 =
+      _mm_and_si128(_mm_unpacklo_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
+  const __m128i rrggbb1 =
+      _mm_and_si128(_mm_unpacklo_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
+  const __m128i rrggbb01 =
+      _mm_and_si128(_mm_unpackhi_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
+  const __m128i rrggbb11 =
+      _mm_and_si128(_mm_unpackhi_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
+
+  __m128i rgb2, rgb3;
+
+  // if (rgb0 > rgb1):
+  if (cmp0 != 0)
+  {
+    // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
+    // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
+    const __m128i rrggbbsum = _mm_add_epi16(rrggbb0, rrggbb1);
+
+    const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb0, 1);
+    const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb0, 2);
+
+    const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb1, 1);
+    const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb1, 2);
+
+    const __m128i rrggbb2 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
+    const __m128i rrggbb3 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
+
+    const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
+    const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
+
+    rgb2 = _mm_and_si128(rgb2dup, _mm_srli_si128(allFFs128, 8));
+    rgb3 = _mm_and_si128(rgb3dup, _mm_srli_si128(allFFs128, 8));
+  }
+  else
+  {
+    // RGB2b = avg(RGB0, RGB1)
+    const __m128i rrggbb21 = _mm_srai_epi16(_mm_add_epi16(rrggbb0, rrggbb1), 1);
+    const __m128i rgb210 = _mm_srli_si128(_mm_packus_epi16(rrggbb21, rrggbb21), 8);
+    rgb2 = rgb210;
+    rgb3 = _mm_and_si128(rgb210, _mm_srli_epi32(allFFs128, 8));
+  }
+
+  // if (rgb0 > rgb1):
+  if (cmp1 != 0)
+  {
+    // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
+    // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
+    const __m128i rrggbbsum = _mm_add_epi16(rrggbb01, rrggbb11);
+
+    const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb01, 1);
+    const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb01, 2);
+
+    const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb11, 1);
+    const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb11, 2);
+
+    const __m128i rrggbb2 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
+    const __m128i rrggbb3 =
+        _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
+
+    const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
+    const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
+
+    rgb2 = _mm_or_si128(rgb2, _mm_and_si128(rgb2dup, _mm_slli_si128(allFFs128, 8)));
+    rgb3 = _mm_or_si128(rgb3, _mm_and_si128(rgb3dup, _mm_slli_si128(allFFs128, 8)));
+  }
+  else
+  {
+    // RGB2b = avg(RGB0, RGB1)
+    const __m128i rrggbb211 = _mm_srai_epi16(_mm_add_epi16(rrggbb01, rrggbb11), 1);
+    const __m128i rgb211 = _mm_slli_si128(_mm_packus_epi16(rrggbb211, rrggbb211), 8);
+    rgb2 = _mm_or_si128(rgb2, rgb211);
+
+    // _mm_srli_epi32( allFFs128, 8 ) == _mm_set_epi32(0x00FFFFFF, 0x00FFFFFF, 0x00FFFFFF,
+    // 0x00FFFFFF)
+    // Make this color fully transparent:
+    rgb3 = _mm_or_si128(rgb3, _mm_and_si128(_mm_and_si128(rgb2, _mm_srli_epi32(allFFs128, 8)),
+                                            _mm_slli_si128(allFFs128, 8)));
+  }
+
+  // Create an array for color lookups for DXT0 so we can use the 2-bit indices:
+  *mmcolors0 = _mm_or_si128(
+      _mm_or_si128(_mm_srli_si128(_mm_slli_si128(argb888x4, 8), 8),
+                   _mm_slli_si128(_mm_srli_si128(_mm_slli_si128(rgb2, 8), 8 + 4), 8)),
+      _mm_slli_si128(_mm_srli_si128(rgb3, 4), 8 + 4));
+
+  // Create an array for color lookups for DXT1 so we can use the 2-bit indices:
+  *mmcolors1 = _mm_or_si128(_mm_or_si128(_mm_srli_si128(argb888x4, 8),
+                                         _mm_slli_si128(_mm_srli_si128(rgb2, 8 + 4), 8)),
+                            _mm_slli_si128(_mm_srli_si128(rgb3, 8 + 4), 8 + 4));
+}
+
 static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int height,
                                        TextureFormat texformat, const u8* tlut, TLUTFormat tlutfmt,
                                        int Wsteps4, int Wsteps8)
@@ -1176,164 +1341,10 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
       // parallelizable at this level, so we do.
       for (int z = 0, xStep = 2 * yStep; z < 2; ++z, xStep++)
       {
-        // JSD NOTE: You may see many strange patterns of behavior in the below code, but they
-        // are for performance reasons. Sometimes, calculating what should be obvious hard-coded
-        // constants is faster than loading their values from memory. Unfortunately, there is no
-        // way to inline 128-bit constants from opcodes so they must be loaded from memory. This
-        // seems a little ridiculous to me in that you can't even generate a constant value of 1
-        // without having to load it from memory. So, I stored the minimal constant I could,
-        // 128-bits worth of 1s :). Then I use sequences of shifts to squash it to the appropriate
-        // size and bitpositions that I need.
-        const __m128i allFFs128 = _mm_cmpeq_epi32(_mm_setzero_si128(), _mm_setzero_si128());
-
-        // Load 128 bits, i.e. two DXTBlocks (64-bits each)
-        const __m128i dxt = _mm_loadu_si128((__m128i*)(src + sizeof(struct DXTBlock) * 2 * xStep));
-
-        // Copy the 2-bit indices from each DXT block:
-        alignas(16) u32 dxttmp[4];
-        _mm_store_si128((__m128i*)dxttmp, dxt);
-
-        u32 dxt0sel = dxttmp[1];
-        u32 dxt1sel = dxttmp[3];
-
-        __m128i argb888x4;
-        __m128i c1 = _mm_unpackhi_epi16(dxt, dxt);
-        c1 = _mm_slli_si128(c1, 8);
-        const __m128i c0 =
-            _mm_or_si128(c1, _mm_srli_si128(_mm_slli_si128(_mm_unpacklo_epi16(dxt, dxt), 8), 8));
-
-        // Compare rgb0 to rgb1:
-        // Each 32-bit word will contain either 0xFFFFFFFF or 0x00000000 for true/false.
-        const __m128i c0cmp = _mm_srli_epi32(_mm_slli_epi32(_mm_srli_epi64(c0, 8), 16), 16);
-        const __m128i c0shr = _mm_srli_epi64(c0cmp, 32);
-        const __m128i cmprgb0rgb1 = _mm_cmpgt_epi32(c0cmp, c0shr);
-
-        int cmp0 = _mm_extract_epi16(cmprgb0rgb1, 0);
-        int cmp1 = _mm_extract_epi16(cmprgb0rgb1, 4);
-
-        // green:
-        // NOTE: We start with the larger number of bits (6) firts for G and shift the mask down
-        // 1 bit to get a 5-bit mask later for R and B components.
-        // low6mask == _mm_set_epi32(0x0000FC00, 0x0000FC00, 0x0000FC00, 0x0000FC00)
-        const __m128i low6mask = _mm_slli_epi32(_mm_srli_epi32(allFFs128, 24 + 2), 8 + 2);
-        const __m128i gtmp = _mm_srli_epi32(c0, 3);
-        const __m128i g0 = _mm_and_si128(gtmp, low6mask);
-        // low3mask == _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300)
-        const __m128i g1 = _mm_and_si128(
-            _mm_srli_epi32(gtmp, 6), _mm_set_epi32(0x00000300, 0x00000300, 0x00000300, 0x00000300));
-        argb888x4 = _mm_or_si128(g0, g1);
-        // red:
-        // low5mask == _mm_set_epi32(0x000000F8, 0x000000F8, 0x000000F8, 0x000000F8)
-        const __m128i low5mask = _mm_slli_epi32(_mm_srli_epi32(low6mask, 8 + 3), 3);
-        const __m128i r0 = _mm_and_si128(c0, low5mask);
-        const __m128i r1 = _mm_srli_epi32(r0, 5);
-        argb888x4 = _mm_or_si128(argb888x4, _mm_or_si128(r0, r1));
-        // blue:
-        // _mm_slli_epi32(low5mask, 16) == _mm_set_epi32(0x00F80000, 0x00F80000, 0x00F80000,
-        // 0x00F80000)
-        const __m128i b0 = _mm_and_si128(_mm_srli_epi32(c0, 5), _mm_slli_epi32(low5mask, 16));
-        const __m128i b1 = _mm_srli_epi16(b0, 5);
-        // OR in the fixed alpha component
-        // _mm_slli_epi32( allFFs128, 24 ) == _mm_set_epi32(0xFF000000, 0xFF000000, 0xFF000000,
-        // 0xFF000000)
-        argb888x4 = _mm_or_si128(_mm_or_si128(argb888x4, _mm_slli_epi32(allFFs128, 24)),
-                                 _mm_or_si128(b0, b1));
-        // calculate RGB2 and RGB3:
-        const __m128i rgb0 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(2, 2, 0, 0));
-        const __m128i rgb1 = _mm_shuffle_epi32(argb888x4, _MM_SHUFFLE(3, 3, 1, 1));
-        const __m128i rrggbb0 =
-            _mm_and_si128(_mm_unpacklo_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
-        const __m128i rrggbb1 =
-            _mm_and_si128(_mm_unpacklo_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
-        const __m128i rrggbb01 =
-            _mm_and_si128(_mm_unpackhi_epi8(rgb0, rgb0), _mm_srli_epi16(allFFs128, 8));
-        const __m128i rrggbb11 =
-            _mm_and_si128(_mm_unpackhi_epi8(rgb1, rgb1), _mm_srli_epi16(allFFs128, 8));
-
-        __m128i rgb2, rgb3;
-
-        // if (rgb0 > rgb1):
-        if (cmp0 != 0)
-        {
-          // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
-          // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
-          const __m128i rrggbbsum = _mm_add_epi16(rrggbb0, rrggbb1);
-
-          const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb0, 1);
-          const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb0, 2);
-
-          const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb1, 1);
-          const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb1, 2);
-
-          const __m128i rrggbb2 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
-          const __m128i rrggbb3 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
-
-          const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
-          const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
-
-          rgb2 = _mm_and_si128(rgb2dup, _mm_srli_si128(allFFs128, 8));
-          rgb3 = _mm_and_si128(rgb3dup, _mm_srli_si128(allFFs128, 8));
-        }
-        else
-        {
-          // RGB2b = avg(RGB0, RGB1)
-          const __m128i rrggbb21 = _mm_srai_epi16(_mm_add_epi16(rrggbb0, rrggbb1), 1);
-          const __m128i rgb210 = _mm_srli_si128(_mm_packus_epi16(rrggbb21, rrggbb21), 8);
-          rgb2 = rgb210;
-          rgb3 = _mm_and_si128(rgb210, _mm_srli_epi32(allFFs128, 8));
-        }
-
-        // if (rgb0 > rgb1):
-        if (cmp1 != 0)
-        {
-          // RGB2 = (RGB0 * 5 + RGB1 * 3) / 8 = (RGB0 << 2 + RGB1 << 1 + (RGB0 + RGB1)) >> 3
-          // RGB3 = (RGB0 * 3 + RGB1 * 5) / 8 = (RGB0 << 1 + RGB1 << 2 + (RGB0 + RGB1)) >> 3
-          const __m128i rrggbbsum = _mm_add_epi16(rrggbb01, rrggbb11);
-
-          const __m128i rrggbb0shl1 = _mm_slli_epi16(rrggbb01, 1);
-          const __m128i rrggbb0shl2 = _mm_slli_epi16(rrggbb01, 2);
-
-          const __m128i rrggbb1shl1 = _mm_slli_epi16(rrggbb11, 1);
-          const __m128i rrggbb1shl2 = _mm_slli_epi16(rrggbb11, 2);
-
-          const __m128i rrggbb2 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl2, rrggbb1shl1), rrggbbsum), 3);
-          const __m128i rrggbb3 =
-              _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(rrggbb0shl1, rrggbb1shl2), rrggbbsum), 3);
-
-          const __m128i rgb2dup = _mm_packus_epi16(rrggbb2, rrggbb2);
-          const __m128i rgb3dup = _mm_packus_epi16(rrggbb3, rrggbb3);
-
-          rgb2 = _mm_or_si128(rgb2, _mm_and_si128(rgb2dup, _mm_slli_si128(allFFs128, 8)));
-          rgb3 = _mm_or_si128(rgb3, _mm_and_si128(rgb3dup, _mm_slli_si128(allFFs128, 8)));
-        }
-        else
-        {
-          // RGB2b = avg(RGB0, RGB1)
-          const __m128i rrggbb211 = _mm_srai_epi16(_mm_add_epi16(rrggbb01, rrggbb11), 1);
-          const __m128i rgb211 = _mm_slli_si128(_mm_packus_epi16(rrggbb211, rrggbb211), 8);
-          rgb2 = _mm_or_si128(rgb2, rgb211);
-
-          // _mm_srli_epi32( allFFs128, 8 ) == _mm_set_epi32(0x00FFFFFF, 0x00FFFFFF, 0x00FFFFFF,
-          // 0x00FFFFFF)
-          // Make this color fully transparent:
-          rgb3 = _mm_or_si128(rgb3, _mm_and_si128(_mm_and_si128(rgb2, _mm_srli_epi32(allFFs128, 8)),
-                                                  _mm_slli_si128(allFFs128, 8)));
-        }
-
-        // Create an array for color lookups for DXT0 so we can use the 2-bit indices:
-        const __m128i mmcolors0 = _mm_or_si128(
-            _mm_or_si128(_mm_srli_si128(_mm_slli_si128(argb888x4, 8), 8),
-                         _mm_slli_si128(_mm_srli_si128(_mm_slli_si128(rgb2, 8), 8 + 4), 8)),
-            _mm_slli_si128(_mm_srli_si128(rgb3, 4), 8 + 4));
-
-        // Create an array for color lookups for DXT1 so we can use the 2-bit indices:
-        const __m128i mmcolors1 =
-            _mm_or_si128(_mm_or_si128(_mm_srli_si128(argb888x4, 8),
-                                      _mm_slli_si128(_mm_srli_si128(rgb2, 8 + 4), 8)),
-                         _mm_slli_si128(_mm_srli_si128(rgb3, 8 + 4), 8 + 4));
+        __m128i mmcolors0, mmcolors1;
+        u32 dxt0sel, dxt1sel;
+        DecodeDXTBlockPairColors(src + sizeof(struct DXTBlock) * 2 * xStep, &mmcolors0, &mmcolors1,
+                                 &dxt0sel, &dxt1sel);
 
 // The #ifdef CHECKs here and below are to compare correctness of output against the reference code.
 // Don't use them in a normal build.
@@ -1413,6 +1424,277 @@ static void TexDecoder_DecodeImpl_CMPR(u32* dst, const u8* src, int width, int h
   }
 }
 
+// Converts 16 texels or TLUT entries in one of the 16-bit formats, as they are stored in memory,
+// to RGBA8. Like _mm256_unpack*_epi16, this works within 128-bit lanes, so *lo receives texels 0-3
+// and 8-11, and *hi receives texels 4-7 and 12-15.
+template <TLUTFormat format>
+FUNCTION_TARGET_AVX2
+static inline void Decode16BitTexels_AVX2(__m256i raw, __m256i* lo, __m256i* hi)
+{
+  const __m256i kMask_x1f = _mm256_set1_epi16(0x1f);
+  const __m256i kMask_x0f = _mm256_set1_epi16(0x0f);
+  const __m256i kAlpha = _mm256_set1_epi16(static_cast<short>(0xff00));
+
+  // Each 16-bit word ends up holding two channels: rg = r | (g << 8) and ba = b | (a << 8).
+  __m256i rg, ba;
+  if constexpr (format == TLUTFormat::IA8)
+  {
+    // The intensity is stored in the second byte, the alpha in the first.
+    const __m256i i = _mm256_srli_epi16(raw, 8);
+    rg = _mm256_or_si256(i, _mm256_slli_epi16(i, 8));
+    ba = _mm256_or_si256(i, _mm256_slli_epi16(raw, 8));
+  }
+  else
+  {
+    const __m256i val = _mm256_or_si256(_mm256_srli_epi16(raw, 8), _mm256_slli_epi16(raw, 8));
+    if constexpr (format == TLUTFormat::RGB565)
+    {
+      const __m256i r5 = _mm256_srli_epi16(val, 11);
+      const __m256i g6 = _mm256_and_si256(_mm256_srli_epi16(val, 5), _mm256_set1_epi16(0x3f));
+      const __m256i b5 = _mm256_and_si256(val, kMask_x1f);
+      const __m256i r = _mm256_or_si256(_mm256_slli_epi16(r5, 3), _mm256_srli_epi16(r5, 2));
+      const __m256i g = _mm256_or_si256(_mm256_slli_epi16(g6, 2), _mm256_srli_epi16(g6, 4));
+      const __m256i b = _mm256_or_si256(_mm256_slli_epi16(b5, 3), _mm256_srli_epi16(b5, 2));
+      rg = _mm256_or_si256(r, _mm256_slli_epi16(g, 8));
+      ba = _mm256_or_si256(b, kAlpha);
+    }
+    else
+    {
+      // Decode every texel as both RGB555 and RGBA4443, then select by the top bit.
+      const __m256i r5 = _mm256_and_si256(_mm256_srli_epi16(val, 10), kMask_x1f);
+      const __m256i g5 = _mm256_and_si256(_mm256_srli_epi16(val, 5), kMask_x1f);
+      const __m256i b5 = _mm256_and_si256(val, kMask_x1f);
+      const __m256i r555 = _mm256_or_si256(_mm256_slli_epi16(r5, 3), _mm256_srli_epi16(r5, 2));
+      const __m256i g555 = _mm256_or_si256(_mm256_slli_epi16(g5, 3), _mm256_srli_epi16(g5, 2));
+      const __m256i b555 = _mm256_or_si256(_mm256_slli_epi16(b5, 3), _mm256_srli_epi16(b5, 2));
+
+      const __m256i a3 = _mm256_and_si256(_mm256_srli_epi16(val, 12), _mm256_set1_epi16(0x07));
+      const __m256i r4 = _mm256_and_si256(_mm256_srli_epi16(val, 8), kMask_x0f);
+      const __m256i g4 = _mm256_and_si256(_mm256_srli_epi16(val, 4), kMask_x0f);
+      const __m256i b4 = _mm256_and_si256(val, kMask_x0f);
+      const __m256i a4443 =
+          _mm256_or_si256(_mm256_slli_epi16(a3, 5),
+                          _mm256_or_si256(_mm256_slli_epi16(a3, 2), _mm256_srli_epi16(a3, 1)));
+      const __m256i r4443 = _mm256_or_si256(_mm256_slli_epi16(r4, 4), r4);
+      const __m256i g4443 = _mm256_or_si256(_mm256_slli_epi16(g4, 4), g4);
+      const __m256i b4443 = _mm256_or_si256(_mm256_slli_epi16(b4, 4), b4);
+
+      const __m256i is_rgb555 = _mm256_srai_epi16(val, 15);
+      rg = _mm256_blendv_epi8(_mm256_or_si256(r4443, _mm256_slli_epi16(g4443, 8)),
+                              _mm256_or_si256(r555, _mm256_slli_epi16(g555, 8)), is_rgb555);
+      ba = _mm256_blendv_epi8(_mm256_or_si256(b4443, _mm256_slli_epi16(a4443, 8)),
+                              _mm256_or_si256(b555, kAlpha), is_rgb555);
+    }
+  }
+
+  *lo = _mm256_unpacklo_epi16(rg, ba);
+  *hi = _mm256_unpackhi_epi16(rg, ba);
+}
+
+// Stores the output of Decode16BitTexels_AVX2 for a 4x4 block of texels.
+FUNCTION_TARGET_AVX2
+static inline void Store4x4Block_AVX2(u32* dst, int width, __m256i lo, __m256i hi)
+{
+  _mm_storeu_si128((__m128i*)(dst + width * 0), _mm256_castsi256_si128(lo));
+  _mm_storeu_si128((__m128i*)(dst + width * 1), _mm256_castsi256_si128(hi));
+  _mm_storeu_si128((__m128i*)(dst + width * 2), _mm256_extracti128_si256(lo, 1));
+  _mm_storeu_si128((__m128i*)(dst + width * 3), _mm256_extracti128_si256(hi, 1));
+}
+
+// Decodes RGB565 and RGB5A3 textures one 4x4 block, i.e. 32 bytes, at a time. This also handles
+// mixed RGB555 and RGBA4443 blocks without falling back to scalar code.
+template <TLUTFormat format>
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_16Bit_AVX2(u32* dst, const u8* src, int width, int height,
+                                             int Wsteps4)
+{
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      __m256i lo, hi;
+      Decode16BitTexels_AVX2<format>(_mm256_loadu_si256((const __m256i*)(src + 32 * yStep)), &lo,
+                                     &hi);
+      Store4x4Block_AVX2(dst + y * width + x, width, lo, hi);
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_IA8_AVX2(u32* dst, const u8* src, int width, int height,
+                                           TextureFormat texformat, const u8* tlut,
+                                           TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Same shuffle as the SSSE3 version, but for a whole 4x4 block at once. Each 128-bit lane holds
+  // two rows of the block, so one mask expands the first row of each lane and the other the second
+  // one.
+  const __m256i mask_first = _mm256_setr_epi8(1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6, 1, 1,
+                                              1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6);
+  const __m256i mask_second =
+      _mm256_setr_epi8(9, 9, 9, 8, 11, 11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14, 9, 9, 9, 8, 11,
+                       11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const __m256i block = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      Store4x4Block_AVX2(dst + y * width + x, width, _mm256_shuffle_epi8(block, mask_first),
+                         _mm256_shuffle_epi8(block, mask_second));
+    }
+  }
+}
+
+template <TLUTFormat tlutfmt>
+FUNCTION_TARGET_AVX2
+static void DecodeC8_AVX2(u32* dst, const u8* src, int width, int height, const u8* tlut,
+                          int Wsteps8)
+{
+  // Converting all 256 palette entries up front is cheaper than converting every texel on its own,
+  // and leaves a single load per texel.
+  alignas(32) u32 palette[256];
+  for (int i = 0; i < 256; i += 16)
+  {
+    __m256i lo, hi;
+    Decode16BitTexels_AVX2<tlutfmt>(_mm256_loadu_si256((const __m256i*)(tlut + 2 * i)), &lo, &hi);
+    _mm256_store_si256((__m256i*)(palette + i), _mm256_permute2x128_si256(lo, hi, 0x20));
+    _mm256_store_si256((__m256i*)(palette + i + 8), _mm256_permute2x128_si256(lo, hi, 0x31));
+  }
+
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int iy = 0, xStep = 4 * yStep; iy < 4; iy++, xStep++)
+      {
+        u32* newdst = dst + (y + iy) * width + x;
+        const u8* newsrc = src + 8 * xStep;
+        for (int i = 0; i < 8; i++)
+          newdst[i] = palette[newsrc[i]];
+      }
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C8_AVX2(u32* dst, const u8* src, int width, int height,
+                                          TextureFormat texformat, const u8* tlut,
+                                          TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  switch (tlutfmt)
+  {
+  case TLUTFormat::RGB5A3:
+    DecodeC8_AVX2<TLUTFormat::RGB5A3>(dst, src, width, height, tlut, Wsteps8);
+    break;
+
+  case TLUTFormat::IA8:
+    DecodeC8_AVX2<TLUTFormat::IA8>(dst, src, width, height, tlut, Wsteps8);
+    break;
+
+  case TLUTFormat::RGB565:
+    DecodeC8_AVX2<TLUTFormat::RGB565>(dst, src, width, height, tlut, Wsteps8);
+    break;
+
+  default:
+    break;
+  }
+}
+
+template <TLUTFormat tlutfmt>
+FUNCTION_TARGET_AVX2
+static void DecodeC14X2_AVX2(u32* dst, const u8* src, int width, int height, const u8* tlut,
+                             int Wsteps4)
+{
+  // The palette is too large to convert up front, so look up the raw entries of a 4x4 block and
+  // convert them together. Gathers are avoided on purpose, as they are slow on many CPUs.
+  const u16* tlut16 = (const u16*)tlut;
+  const __m256i kMask_x3fff = _mm256_set1_epi16(0x3fff);
+  for (int y = 0; y < height; y += 4)
+  {
+    for (int x = 0, yStep = (y / 4) * Wsteps4; x < width; x += 4, yStep++)
+    {
+      const __m256i raw = _mm256_loadu_si256((const __m256i*)(src + 32 * yStep));
+      alignas(32) u16 indices[16];
+      _mm256_store_si256(
+          (__m256i*)indices,
+          _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi16(raw, 8), _mm256_slli_epi16(raw, 8)),
+                           kMask_x3fff));
+
+      alignas(32) u16 entries[16];
+      for (int i = 0; i < 16; i++)
+        entries[i] = tlut16[indices[i]];
+
+      __m256i lo, hi;
+      Decode16BitTexels_AVX2<tlutfmt>(_mm256_load_si256((const __m256i*)entries), &lo, &hi);
+      Store4x4Block_AVX2(dst + y * width + x, width, lo, hi);
+    }
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_C14X2_AVX2(u32* dst, const u8* src, int width, int height,
+                                             TextureFormat texformat, const u8* tlut,
+                                             TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  switch (tlutfmt)
+  {
+  case TLUTFormat::RGB5A3:
+    DecodeC14X2_AVX2<TLUTFormat::RGB5A3>(dst, src, width, height, tlut, Wsteps4);
+    break;
+
+  case TLUTFormat::IA8:
+    DecodeC14X2_AVX2<TLUTFormat::IA8>(dst, src, width, height, tlut, Wsteps4);
+    break;
+
+  case TLUTFormat::RGB565:
+    DecodeC14X2_AVX2<TLUTFormat::RGB565>(dst, src, width, height, tlut, Wsteps4);
+    break;
+
+  default:
+    break;
+  }
+}
+
+FUNCTION_TARGET_AVX2
+static void TexDecoder_DecodeImpl_CMPR_AVX2(u32* dst, const u8* src, int width, int height,
+                                            TextureFormat texformat, const u8* tlut,
+                                            TLUTFormat tlutfmt, int Wsteps4, int Wsteps8)
+{
+  // Both DXT blocks of a pair sit next to each other in the output, so with their colors in one
+  // register a row of 8 texels is a single permute. The 2-bit indices of the first texel in a row
+  // are the most significant ones.
+  const __m256i kColorOffset = _mm256_setr_epi32(0, 0, 0, 0, 4, 4, 4, 4);
+  const __m256i kMask_x3 = _mm256_set1_epi32(3);
+  const __m256i kRowShift = _mm256_set1_epi32(8);
+  for (int y = 0; y < height; y += 8)
+  {
+    for (int x = 0, yStep = (y / 8) * Wsteps8; x < width; x += 8, yStep++)
+    {
+      for (int z = 0, xStep = 2 * yStep; z < 2; ++z, xStep++)
+      {
+        __m128i mmcolors0, mmcolors1;
+        u32 dxt0sel, dxt1sel;
+        DecodeDXTBlockPairColors(src + sizeof(struct DXTBlock) * 2 * xStep, &mmcolors0, &mmcolors1,
+                                 &dxt0sel, &dxt1sel);
+
+        const __m256i colors = _mm256_set_m128i(mmcolors1, mmcolors0);
+        const __m256i sel = _mm256_setr_epi32(dxt0sel, dxt0sel, dxt0sel, dxt0sel, dxt1sel, dxt1sel,
+                                              dxt1sel, dxt1sel);
+        __m256i shift = _mm256_setr_epi32(6, 4, 2, 0, 6, 4, 2, 0);
+
+        u32* dst32 = (dst + (y + z * 4) * width + x);
+        for (int row = 0; row < 4; row++)
+        {
+          const __m256i index = _mm256_add_epi32(
+              _mm256_and_si256(_mm256_srlv_epi32(sel, shift), kMask_x3), kColorOffset);
+          _mm256_storeu_si256((__m256i*)(dst32 + width * row),
+                              _mm256_permutevar8x32_epi32(colors, index));
+          shift = _mm256_add_epi32(shift, kRowShift);
+        }
+      }
+    }
+  }
+}
+
 void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, TextureFormat texformat,
                             const u8* tlut, TLUTFormat tlutfmt)
 {
@@ -1442,7 +1724,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C8:
-    TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    // Building the palette only pays off when there are more texels than palette entries.
+    if (cpu_info.bAVX2 && width * height >= 256)
+      TexDecoder_DecodeImpl_C8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                    Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C8(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
     break;
 
   case TextureFormat::IA4:
@@ -1450,7 +1737,10 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::IA8:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_IA8_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                     Wsteps8);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_IA8_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                       Wsteps8);
     else
@@ -1459,17 +1749,26 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::C14X2:
-    TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_C14X2_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                       Wsteps8);
+    else
+      TexDecoder_DecodeImpl_C14X2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                  Wsteps8);
     break;
 
   case TextureFormat::RGB565:
-    TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
-                                 Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_16Bit_AVX2<TLUTFormat::RGB565>(dst, src, width, height, Wsteps4);
+    else
+      TexDecoder_DecodeImpl_RGB565(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                   Wsteps8);
     break;
 
   case TextureFormat::RGB5A3:
-    if (cpu_info.bSSSE3)
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_16Bit_AVX2<TLUTFormat::RGB5A3>(dst, src, width, height, Wsteps4);
+    else if (cpu_info.bSSSE3)
       TexDecoder_DecodeImpl_RGB5A3_SSSE3(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
                                          Wsteps8);
     else
@@ -1487,7 +1786,12 @@ void _TexDecoder_DecodeImpl(u32* dst, const u8* src, int width, int height, Text
     break;
 
   case TextureFormat::CMPR:
-    TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4, Wsteps8);
+    if (cpu_info.bAVX2)
+      TexDecoder_DecodeImpl_CMPR_AVX2(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                      Wsteps8);
+    else
+      TexDecoder_DecodeImpl_CMPR(dst, src, width, height, texformat, tlut, tlutfmt, Wsteps4,
+                                 Wsteps8);
     break;
 
   case TextureFormat::XFB:
@@ -7,6 +7,7 @@
 #include <iterator>
 #include <memory>
 #include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <type_traits>
 #include <unordered_map>
@@ -25,6 +26,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/CPMemory.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/NativeVertexFormat.h"
 #include "VideoCommon/Statistics.h"
@@ -48,9 +50,30 @@ static NativeVertexFormat* s_current_vtx_fmt;
 u32 g_current_components;
 
 typedef std::unordered_map<VertexLoaderUID, std::unique_ptr<VertexLoaderBase>> VertexLoaderMap;
-static std::mutex s_vertex_loader_map_lock;
+// The main and preprocessing threads only need a unique lock to add a loader to the map.
+static std::shared_mutex s_vertex_loader_map_lock;
 static VertexLoaderMap s_vertex_loader_map;
-// TODO - change into array of pointers. Keep a map of all seen so far.
+
+// Games often switch a VAT group between a few formats, or rewrite it with the same values, so each
+// thread remembers the loaders it looked up recently. This is checked before the map, and as every
+// cache is only used by a single thread, a hit doesn't need to lock anything.
+struct VertexLoaderCacheEntry
+{
+  VertexLoaderUID uid;
+  VertexLoaderBase* loader = nullptr;
+};
+constexpr u32 VERTEX_LOADER_CACHE_BITS = 6;
+using VertexLoaderCache = std::array<VertexLoaderCacheEntry, 1 << VERTEX_LOADER_CACHE_BITS>;
+static VertexLoaderCache s_main_loader_cache;
+static VertexLoaderCache s_preprocess_loader_cache;
+
+static VertexLoaderCacheEntry& GetLoaderCacheEntry(VertexLoaderCache& cache,
+                                                   const VertexLoaderUID& uid)
+{
+  // The UID hash only mixes upwards, so use the top bits of a multiplicative hash as the index.
+  const u64 index = (u64{uid.GetHash()} * 0x9E3779B97F4A7C15ull) >> (64 - VERTEX_LOADER_CACHE_BITS);
+  return cache[index];
+}
 
 Common::EnumMap<u8*, CPArray::TexCoord7> cached_arraybases;
 
@@ -66,12 +89,16 @@ void Init()
   MarkAllDirty();
   g_main_vertex_loaders.fill(nullptr);
   g_preprocess_vertex_loaders.fill(nullptr);
+  s_main_loader_cache.fill({});
+  s_preprocess_loader_cache.fill({});
   SETSTAT(g_stats.num_vertex_loaders, 0);
 }
 
 void Clear()
 {
-  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
+  std::lock_guard lk(s_vertex_loader_map_lock);
+  s_main_loader_cache.fill({});
+  s_preprocess_loader_cache.fill({});
   s_vertex_loader_map.clear();
   s_native_vertex_map.clear();
 }
@@ -213,30 +240,38 @@ VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group)
   constexpr BitSet8& attr_dirty = IsPreprocess ? g_preprocess_vat_dirty : g_main_vat_dirty;
   constexpr auto& vertex_loaders =
       IsPreprocess ? g_preprocess_vertex_loaders : g_main_vertex_loaders;
+  constexpr auto& loader_cache = IsPreprocess ? s_preprocess_loader_cache : s_main_loader_cache;
 
-  VertexLoaderBase* loader;
+  const VertexLoaderUID uid(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
+  VertexLoaderCacheEntry& cache_entry = GetLoaderCacheEntry(loader_cache, uid);
+  VertexLoaderBase* loader = cache_entry.loader;
+  if (!loader || cache_entry.uid != uid) [[unlikely]]
+  {
+    {
+      std::shared_lock lk(s_vertex_loader_map_lock);
+      const auto iter = s_vertex_loader_map.find(uid);
+      loader = iter != s_vertex_loader_map.end() ? iter->second.get() : nullptr;
+    }
 
-  // We are not allowed to create a native vertex format on preprocessing as this is on the wrong
-  // thread
-  bool check_for_native_format = !IsPreprocess;
+    if (!loader)
+    {
+      // Create the loader outside of the lock, the other thread might have added the same one in
+      // the meantime though.
+      auto new_loader =
+          VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
+      std::lock_guard lk(s_vertex_loader_map_lock);
+      auto [it, added] = s_vertex_loader_map.try_emplace(uid, std::move(new_loader));
+      loader = it->second.get();
+      if (added)
+        INCSTAT(g_stats.num_vertex_loaders);
+    }
 
-  VertexLoaderUID uid(state->vtx_desc, state->vtx_attr[vtx_attr_group]);
-  std::lock_guard<std::mutex> lk(s_vertex_loader_map_lock);
-  VertexLoaderMap::iterator iter = s_vertex_loader_map.find(uid);
-  if (iter != s_vertex_loader_map.end())
-  {
-    loader = iter->second.get();
-    check_for_native_format &= !loader->m_native_vertex_format;
+    cache_entry = {uid, loader};
   }
-  else
-  {
-    auto [it, added] = s_vertex_loader_map.try_emplace(
-        uid,
-        VertexLoaderBase::CreateVertexLoader(state->vtx_desc, state->vtx_attr[vtx_attr_group]));
-    loader = it->second.get();
-    INCSTAT(g_stats.num_vertex_loaders);
-  }
-  if (check_for_native_format)
+
+  // We are not allowed to create a native vertex format on preprocessing as this is on the wrong
+  // thread
+  if (!IsPreprocess && !loader->m_native_vertex_format)
   {
     // search for a cached native vertex format
     loader->m_native_vertex_format = GetOrCreateMatchingFormat(loader->m_native_vtx_decl);
@@ -382,12 +417,26 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
     return 0;
   ASSERT(count > 0);
 
-  VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
+  const int size = count * RefreshLoader<IsPreprocess>(vtx_attr_group)->m_vertex_size;
+  const PrimitiveCommand command{primitive, static_cast<u16>(count), src};
+  RunVertexBatch<IsPreprocess>(vtx_attr_group, {&command, 1});
+  return size;
+}
 
-  int size = count * loader->m_vertex_size;
+template int RunVertices<false>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
+                                const u8* src);
+template int RunVertices<true>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
+                               const u8* src);
+
+template <bool IsPreprocess>
+void RunVertexBatch(int vtx_attr_group, std::span<const PrimitiveCommand> commands)
+{
+  VertexLoaderBase* loader = RefreshLoader<IsPreprocess>(vtx_attr_group);
 
   if constexpr (!IsPreprocess)
   {
+    VideoCommon::FrameProfilerScope profiler_scope(VideoCommon::FrameProfilerPhase::VertexLoading);
+
     // Doing early return for the opposite case would be cleaner
     // but triggers a false unreachable code warning in MSVC debug builds.
 
@@ -411,46 +460,51 @@ int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int coun
                                             loader->m_native_vertex_format->GetVertexDeclaration());
     }
 
-    // CPUCull's performance increase comes from encoding fewer GPU commands, not sending less data
-    // Therefore it's only useful to check if culling could remove a flush
-    const bool can_cpu_cull = g_ActiveConfig.bCPUCull &&
-                              primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES &&
-                              !g_vertex_manager->HasSendableVertices();
+    // Nothing between the commands can change the vertex format, or the state read below.
+    const int stride = loader->m_native_vtx_decl.stride;
+    const bool cpu_cull = g_ActiveConfig.bCPUCull;
+    const bool cull_all_triangles = bpmem.genMode.cullmode == CullMode::All;
+    for (const PrimitiveCommand& command : commands)
+    {
+      const OpcodeDecoder::Primitive primitive = command.primitive;
 
-    // if cull mode is CULL_ALL, tell VertexManager to skip triangles and quads.
-    // They still need to go through vertex loading, because we need to calculate a zfreeze
-    // reference slope.
-    const bool cullall = (bpmem.genMode.cullmode == CullMode::All &&
-                          primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES);
+      // CPUCull's performance increase comes from encoding fewer GPU commands, not sending less
+      // data. Therefore it's only useful to check if culling could remove a flush
+      const bool can_cpu_cull = cpu_cull && primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES &&
+                                !g_vertex_manager->HasSendableVertices();
 
-    const int stride = loader->m_native_vtx_decl.stride;
-    DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, count, stride,
-                                                                cullall || can_cpu_cull);
+      // if cull mode is CULL_ALL, tell VertexManager to skip triangles and quads.
+      // They still need to go through vertex loading, because we need to calculate a zfreeze
+      // reference slope.
+      const bool cullall =
+          cull_all_triangles && primitive < OpcodeDecoder::Primitive::GX_DRAW_LINES;
 
-    count = loader->RunVertices(src, dst.GetPointer(), count);
+      DataReader dst = g_vertex_manager->PrepareForAdditionalData(primitive, command.count, stride,
+                                                                  cullall || can_cpu_cull);
 
-    if (can_cpu_cull && !cullall)
-    {
-      if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
+      const int count = loader->RunVertices(command.src, dst.GetPointer(), command.count);
+
+      if (can_cpu_cull && !cullall)
       {
-        DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
-        memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
+        if (!g_vertex_manager->AreAllVerticesCulled(loader, primitive, dst.GetPointer(), count))
+        {
+          DataReader new_dst = g_vertex_manager->DisableCullAll(stride);
+          memmove(new_dst.GetPointer(), dst.GetPointer(), count * stride);
+        }
       }
-    }
 
-    g_vertex_manager->AddIndices(primitive, count);
-    g_vertex_manager->FlushData(count, loader->m_native_vtx_decl.stride);
+      g_vertex_manager->AddIndices(primitive, count);
+      g_vertex_manager->FlushData(count, stride);
 
-    ADDSTAT(g_stats.this_frame.num_prims, count);
-    INCSTAT(g_stats.this_frame.num_primitive_joins);
+      ADDSTAT(g_stats.this_frame.num_prims, count);
+      INCSTAT(g_stats.this_frame.num_primitive_joins);
+    }
   }
-  return size;
 }
 
-template int RunVertices<false>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
-                                const u8* src);
-template int RunVertices<true>(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count,
-                               const u8* src);
+template void RunVertexBatch<false>(int vtx_attr_group,
+                                    std::span<const PrimitiveCommand> commands);
+template void RunVertexBatch<true>(int vtx_attr_group, std::span<const PrimitiveCommand> commands);
 
 NativeVertexFormat* GetCurrentVertexFormat()
 {
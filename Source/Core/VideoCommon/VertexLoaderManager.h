@@ -5,6 +5,7 @@
 
 #include <array>
 #include <memory>
+#include <span>
 #include <string>
 #include <unordered_map>
 
@@ -44,9 +45,23 @@ NativeVertexFormat* GetUberVertexFormat(const PortableVertexDeclaration& decl);
 template <bool IsPreprocess = false>
 int RunVertices(int vtx_attr_group, OpcodeDecoder::Primitive primitive, int count, const u8* src);
 
+struct PrimitiveCommand
+{
+  OpcodeDecoder::Primitive primitive;
+  u16 count;
+  const u8* src;
+};
+
+// Loads consecutive primitive commands which use the same vertex attribute group, with no other
+// commands between them. The vertex loader and vertex format only have to be checked once.
+// Unlike RunVertices, empty commands must not be passed.
+template <bool IsPreprocess = false>
+void RunVertexBatch(int vtx_attr_group, std::span<const PrimitiveCommand> commands);
+
 namespace detail
 {
-// This will look for an existing loader in the global hashmap or create a new one if there is none.
+// This will look for an existing loader in the per-thread loader cache, then in the global hashmap,
+// and create a new one if there is none.
 // It should not be used directly because RefreshLoaders() has another cache for fast lookups.
 template <bool IsPreprocess = false>
 VertexLoaderBase* GetOrCreateLoader(int vtx_attr_group);
@@ -3,6 +3,7 @@
 
 #include "VideoCommon/VertexLoaderX64.h"
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include <string>
@@ -43,10 +44,71 @@ static OpArg MPIC(const void* ptr)
   return MDisp(base_reg, PtrOffset(ptr, memory_base_ptr));
 }
 
+using ShuffleRow = std::array<__m128i, 3>;
+static const Common::EnumMap<ShuffleRow, ComponentFormat::InvalidFloat7> shuffle_lut = {
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
+               _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
+               _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
+               _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x invalid
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x invalid
+               _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x invalid
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x invalid
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x invalid
+               _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x invalid
+    ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x invalid
+               _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x invalid
+               _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x invalid
+};
+static const __m128 scale_factors[32] = {
+    _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
+    _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
+    _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
+    _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
+    _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
+    _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
+    _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
+    _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
+    _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
+    _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
+    _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
+};
+
+// The tables above with every row repeated in both lanes, for loading two vertices at once.
+alignas(32) static const auto shuffle_lut_ymm = [] {
+  Common::EnumMap<std::array<std::array<__m128i, 2>, 3>, ComponentFormat::InvalidFloat7> lut{};
+  for (size_t format = 0; format <= static_cast<size_t>(ComponentFormat::InvalidFloat7); format++)
+  {
+    for (size_t count = 0; count < 3; count++)
+    {
+      const __m128i row = shuffle_lut[static_cast<ComponentFormat>(format)][count];
+      lut[static_cast<ComponentFormat>(format)][count] = {row, row};
+    }
+  }
+  return lut;
+}();
+alignas(32) static const auto scale_factors_ymm = [] {
+  std::array<std::array<__m128, 2>, 32> factors{};
+  for (size_t i = 0; i < factors.size(); i++)
+    factors[i] = {scale_factors[i], scale_factors[i]};
+  return factors;
+}();
+
 VertexLoaderX64::VertexLoaderX64(const TVtxDesc& vtx_desc, const VAT& vtx_att)
     : VertexLoaderBase(vtx_desc, vtx_att)
 {
-  AllocCodeSpace(4096);
+  AllocCodeSpace(8192);
   ClearCodeSpace();
   GenerateVertexLoader();
   WriteProtect(true);
@@ -83,47 +145,6 @@ void VertexLoaderX64::ReadVertex(OpArg data, VertexComponentFormat attribute,
                                  bool dequantize, u8 scaling_exponent,
                                  AttributeFormat* native_format)
 {
-  using ShuffleRow = std::array<__m128i, 3>;
-  static const Common::EnumMap<ShuffleRow, ComponentFormat::InvalidFloat7> shuffle_lut = {
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF00L),   // 1x u8
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFF01L, 0xFFFFFF00L),   // 2x u8
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFF02L, 0xFFFFFF01L, 0xFFFFFF00L)},  // 3x u8
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00FFFFFFL),   // 1x s8
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL),   // 2x s8
-                 _mm_set_epi32(0xFFFFFFFFL, 0x02FFFFFFL, 0x01FFFFFFL, 0x00FFFFFFL)},  // 3x s8
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0001L),   // 1x u16
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFF0203L, 0xFFFF0001L),   // 2x u16
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFF0405L, 0xFFFF0203L, 0xFFFF0001L)},  // 3x u16
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x0001FFFFL),   // 1x s16
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x0203FFFFL, 0x0001FFFFL),   // 2x s16
-                 _mm_set_epi32(0xFFFFFFFFL, 0x0405FFFFL, 0x0203FFFFL, 0x0001FFFFL)},  // 3x s16
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x float
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x float
-                 _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x float
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x invalid
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x invalid
-                 _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x invalid
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x invalid
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x invalid
-                 _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x invalid
-      ShuffleRow{_mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0xFFFFFFFFL, 0x00010203L),   // 1x invalid
-                 _mm_set_epi32(0xFFFFFFFFL, 0xFFFFFFFFL, 0x04050607L, 0x00010203L),   // 2x invalid
-                 _mm_set_epi32(0xFFFFFFFFL, 0x08090A0BL, 0x04050607L, 0x00010203L)},  // 3x invalid
-  };
-  static const __m128 scale_factors[32] = {
-      _mm_set_ps1(1. / (1u << 0)),  _mm_set_ps1(1. / (1u << 1)),  _mm_set_ps1(1. / (1u << 2)),
-      _mm_set_ps1(1. / (1u << 3)),  _mm_set_ps1(1. / (1u << 4)),  _mm_set_ps1(1. / (1u << 5)),
-      _mm_set_ps1(1. / (1u << 6)),  _mm_set_ps1(1. / (1u << 7)),  _mm_set_ps1(1. / (1u << 8)),
-      _mm_set_ps1(1. / (1u << 9)),  _mm_set_ps1(1. / (1u << 10)), _mm_set_ps1(1. / (1u << 11)),
-      _mm_set_ps1(1. / (1u << 12)), _mm_set_ps1(1. / (1u << 13)), _mm_set_ps1(1. / (1u << 14)),
-      _mm_set_ps1(1. / (1u << 15)), _mm_set_ps1(1. / (1u << 16)), _mm_set_ps1(1. / (1u << 17)),
-      _mm_set_ps1(1. / (1u << 18)), _mm_set_ps1(1. / (1u << 19)), _mm_set_ps1(1. / (1u << 20)),
-      _mm_set_ps1(1. / (1u << 21)), _mm_set_ps1(1. / (1u << 22)), _mm_set_ps1(1. / (1u << 23)),
-      _mm_set_ps1(1. / (1u << 24)), _mm_set_ps1(1. / (1u << 25)), _mm_set_ps1(1. / (1u << 26)),
-      _mm_set_ps1(1. / (1u << 27)), _mm_set_ps1(1. / (1u << 28)), _mm_set_ps1(1. / (1u << 29)),
-      _mm_set_ps1(1. / (1u << 30)), _mm_set_ps1(1. / (1u << 31)),
-  };
-
   X64Reg coords = XMM0;
 
   const auto write_zfreeze = [&]() {  // zfreeze
@@ -433,6 +454,15 @@ void VertexLoaderX64::GenerateVertexLoader()
 
   // TODO: load constants into registers outside the main loop
 
+  // The last three vertices are always loaded one at a time, as they go into the zfreeze caches.
+  const bool load_pairs = CanLoadVertexPairs();
+  FixupBranch pair_loop;
+  if (load_pairs)
+  {
+    CMP(32, R(remaining_reg), Imm8(4));
+    pair_loop = J_CC(CC_AE, Jump::Near);
+  }
+
   const u8* loop_start = GetCodePtr();
 
   if (m_VtxDesc.low.PosMatIdx)
@@ -597,6 +627,144 @@ void VertexLoaderX64::GenerateVertexLoader()
              m_src_ofs, m_vertex_size, m_VtxDesc.low.Hex, m_VtxDesc.high.Hex, m_VtxAttr.g0.Hex,
              m_VtxAttr.g1.Hex, m_VtxAttr.g2.Hex);
   m_native_vtx_decl.stride = m_dst_ofs;
+
+  if (load_pairs)
+  {
+    SetJumpTarget(pair_loop);
+    GenerateVertexPairLoop(loop_start);
+  }
+}
+
+bool VertexLoaderX64::CanLoadVertexPairs() const
+{
+  if (!cpu_info.bAVX2)
+    return false;
+
+  const auto is_absent = [](VertexComponentFormat attribute) {
+    return attribute == VertexComponentFormat::NotPresent;
+  };
+  const auto is_enabled = [](bool enabled) { return enabled; };
+
+  const auto& tex_mat_idx = m_VtxDesc.low.TexMatIdx;
+  const auto& colors = m_VtxDesc.low.Color;
+  const auto& tex_coords = m_VtxDesc.high.TexCoord;
+  return m_VtxDesc.low.Position == VertexComponentFormat::Direct &&
+         std::none_of(tex_mat_idx.begin(), tex_mat_idx.end(), is_enabled) &&
+         is_absent(m_VtxDesc.low.Normal) && std::all_of(colors.begin(), colors.end(), is_absent) &&
+         std::all_of(tex_coords.begin(), tex_coords.end(), is_absent);
+}
+
+void VertexLoaderX64::ReadVertexPair(u32 src_ofs, ComponentFormat format, int count_in,
+                                     int count_out, bool dequantize, u8 scaling_exponent,
+                                     const AttributeFormat& native_format)
+{
+  const int load_bytes = GetElementSize(format) * count_in;
+  const auto load = [&](X64Reg reg, u32 offset) {
+    const OpArg data = MDisp(src_reg, offset);
+    if (load_bytes > 8)
+      VMOVDQU(reg, data);
+    else if (load_bytes > 4)
+      VMOVQ_xmm(reg, data);
+    else
+      VMOVD_xmm(reg, data);
+  };
+
+  // Everything here is VEX encoded, mixing in SSE instructions would be very slow.
+  // The second vertex can be inserted straight from memory if the 16 byte load doesn't go past the
+  // three vertices which are always left for the single vertex loop.
+  const u32 second_src_ofs = src_ofs + m_vertex_size;
+  load(XMM0, src_ofs);
+  if (second_src_ofs + 16 <= 5 * m_vertex_size)
+  {
+    VINSERTI128(YMM0, YMM0, MDisp(src_reg, second_src_ofs), 1);
+  }
+  else
+  {
+    load(XMM1, second_src_ofs);
+    VINSERTI128(YMM0, YMM0, R(XMM1), 1);
+  }
+  VPSHUFB_ymm(YMM0, YMM0, MPIC(&shuffle_lut_ymm[format][count_in - 1]));
+
+  // Sign-extend.
+  if (format == ComponentFormat::Byte)
+    VPSRAD_ymm(YMM0, YMM0, 24);
+  if (format == ComponentFormat::Short)
+    VPSRAD_ymm(YMM0, YMM0, 16);
+
+  if (format < ComponentFormat::Float)
+  {
+    VCVTDQ2PS_ymm(YMM0, R(YMM0));
+
+    if (dequantize && scaling_exponent)
+      VMULPS_ymm(YMM0, YMM0, MPIC(&scale_factors_ymm[scaling_exponent]));
+  }
+
+  // Attributes are written in order, so a 16 byte store only overwrites attributes which are
+  // written later, or the next vertices. The exception is the end of the first vertex, which
+  // would overwrite the start of the second one.
+  const u32 dst_ofs = native_format.offset;
+  const OpArg dest = MDisp(dst_reg, dst_ofs);
+  if (dst_ofs + 16 <= m_native_vtx_decl.stride)
+  {
+    VMOVUPS(dest, XMM0);
+  }
+  else
+  {
+    switch (count_out)
+    {
+    case 1:
+      VMOVSS(dest, XMM0);
+      break;
+    case 2:
+      VMOVQ_xmm(dest, XMM0);
+      break;
+    case 3:
+      VMOVQ_xmm(dest, XMM0);
+      VEXTRACTPS(MDisp(dst_reg, dst_ofs + 2 * sizeof(float)), XMM0, 2);
+      break;
+    }
+  }
+  VEXTRACTI128(MDisp(dst_reg, dst_ofs + m_native_vtx_decl.stride), YMM0, 1);
+}
+
+void VertexLoaderX64::GenerateVertexPairLoop(const u8* single_vertex_loop)
+{
+  const u32 src_stride = m_vertex_size;
+  const u32 dst_stride = m_native_vtx_decl.stride;
+  u32 src_ofs = 0;
+
+  const u8* loop_start = GetCodePtr();
+
+  if (m_VtxDesc.low.PosMatIdx)
+  {
+    for (u32 i = 0; i < 2; i++)
+    {
+      MOVZX(32, 8, scratch1, MDisp(src_reg, i * src_stride));
+      AND(32, R(scratch1), Imm8(0x3F));
+      MOV(32, MDisp(dst_reg, m_native_vtx_decl.posmtx.offset + i * dst_stride), R(scratch1));
+    }
+    src_ofs += sizeof(u8);
+  }
+
+  const ComponentFormat pos_format = m_VtxAttr.g0.PosFormat;
+  const int pos_elements = m_VtxAttr.g0.PosElements == CoordComponentCount::XY ? 2 : 3;
+  ReadVertexPair(src_ofs, pos_format, pos_elements, pos_elements, m_VtxAttr.g0.ByteDequant,
+                 m_VtxAttr.g0.PosFrac, m_native_vtx_decl.position);
+  src_ofs += GetElementSize(pos_format) * pos_elements;
+
+  ADD(64, R(src_reg), Imm32(2 * src_stride));
+  ADD(64, R(dst_reg), Imm32(2 * dst_stride));
+  SUB(32, R(remaining_reg), Imm8(2));
+  CMP(32, R(remaining_reg), Imm8(4));
+  J_CC(CC_AE, loop_start);
+
+  // Avoid the AVX-SSE transition penalty in the single vertex loop.
+  VZEROUPPER();
+  JMP(single_vertex_loop, Jump::Near);
+
+  ASSERT_MSG(VIDEO, src_ofs == src_stride,
+             "Vertex size from paired vertex loader ({}) does not match expected vertex size ({})!",
+             src_ofs, src_stride);
 }
 
 int VertexLoaderX64::RunVertices(const u8* src, u8* dst, int count)
@@ -30,4 +30,12 @@ private:
                   AttributeFormat* native_format);
   void ReadColor(Gen::OpArg data, VertexComponentFormat attribute, ColorFormat format);
   void GenerateVertexLoader();
+
+  // With AVX2, vertices which only have a direct position and optionally a position matrix index
+  // are loaded in pairs, with one vertex in each 128-bit lane. With more attributes, the loop is
+  // bound by the shuffles and stores and the single vertex loop is faster.
+  bool CanLoadVertexPairs() const;
+  void ReadVertexPair(u32 src_ofs, ComponentFormat format, int count_in, int count_out,
+                      bool dequantize, u8 scaling_exponent, const AttributeFormat& native_format);
+  void GenerateVertexPairLoop(const u8* single_vertex_loop);
 };
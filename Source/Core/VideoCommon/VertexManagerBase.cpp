@@ -22,6 +22,7 @@
 #include "VideoCommon/BPMemory.h"
 #include "VideoCommon/BoundingBox.h"
 #include "VideoCommon/DataReader.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/CustomShaderCache.h"
@@ -122,9 +123,11 @@ bool VertexManagerBase::Initialize()
   m_after_present_event = AfterPresentEvent::Register(
       [this](const PresentInfo& pi) { m_ticks_elapsed = pi.emulated_timestamp; },
       "VertexManagerBase");
-  m_index_generator.Init();
+  m_vertex_processing_workers.Reset("Vertex Processing",
+                                    g_ActiveConfig.GetVertexProcessingThreads());
+  m_index_generator.Init(&m_vertex_processing_workers);
   m_custom_shader_cache = std::make_unique<CustomShaderCache>();
-  m_cpu_cull.Init();
+  m_cpu_cull.Init(&m_vertex_processing_workers);
   return true;
 }
 
@@ -135,6 +138,8 @@ u32 VertexManagerBase::GetRemainingSize() const
 
 void VertexManagerBase::AddIndices(OpcodeDecoder::Primitive primitive, u32 num_vertices)
 {
+  // Includes waiting for the worker threads, if the draw is split across them.
+  VideoCommon::FrameProfilerScope profiler_scope(VideoCommon::FrameProfilerPhase::IndexGeneration);
   m_index_generator.AddIndices(primitive, num_vertices);
 }
 
@@ -142,6 +147,7 @@ bool VertexManagerBase::AreAllVerticesCulled(VertexLoaderBase* loader,
                                              OpcodeDecoder::Primitive primitive, const u8* src,
                                              u32 count)
 {
+  VideoCommon::FrameProfilerScope profiler_scope(VideoCommon::FrameProfilerPhase::CPUCulling);
   return m_cpu_cull.AreAllVerticesCulled(loader, primitive, src, count);
 }
 
@@ -439,6 +445,9 @@ void VertexManagerBase::Flush()
 
   m_is_flushed = true;
 
+  VideoCommon::FrameProfilerScope profiler_scope(
+      VideoCommon::FrameProfilerPhase::BackendSubmission);
+
   if (m_draw_counter == 0)
   {
     // This is more or less the start of the Frame
@@ -930,8 +939,14 @@ void VertexManagerBase::UpdatePipelineObject()
 
 void VertexManagerBase::OnConfigChange()
 {
+  if (g_ActiveConfig.GetVertexProcessingThreads() != m_vertex_processing_workers.GetWorkerCount())
+  {
+    m_vertex_processing_workers.Reset("Vertex Processing",
+                                      g_ActiveConfig.GetVertexProcessingThreads());
+  }
+
   // Reload index generator function tables in case VS expand config changed
-  m_index_generator.Init();
+  m_index_generator.Init(&m_vertex_processing_workers);
 }
 
 void VertexManagerBase::OnDraw()
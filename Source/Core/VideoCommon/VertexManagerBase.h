@@ -9,6 +9,7 @@
 #include "Common/BitSet.h"
 #include "Common/CommonTypes.h"
 #include "Common/MathUtil.h"
+#include "Common/WorkerPool.h"
 #include "VideoCommon/CPUCull.h"
 #include "VideoCommon/IndexGenerator.h"
 #include "VideoCommon/RenderState.h"
@@ -216,6 +217,8 @@ protected:
   bool m_blending_state_changed = true;
   bool m_cull_all = false;
 
+  // Helps the GPU thread cull large draws and generate their indices.
+  Common::WorkerPool m_vertex_processing_workers;
   IndexGenerator m_index_generator;
   CPUCull m_cpu_cull;
 
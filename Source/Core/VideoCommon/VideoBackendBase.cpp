@@ -5,10 +5,12 @@
 
 #include <algorithm>
 #include <cstring>
+#include <ctime>
 #include <memory>
 #include <string>
 #include <vector>
 
+#include <fmt/chrono.h>
 #include <fmt/format.h>
 
 #include "Common/ChunkFile.h"
@@ -48,6 +50,7 @@
 #include "VideoCommon/CommandProcessor.h"
 #include "VideoCommon/Fifo.h"
 #include "VideoCommon/FrameDumper.h"
+#include "VideoCommon/FrameProfiler.h"
 #include "VideoCommon/FramebufferManager.h"
 #include "VideoCommon/GeometryShaderManager.h"
 #include "VideoCommon/GraphicsModSystem/Runtime/GraphicsModManager.h"
@@ -396,6 +399,15 @@ bool VideoBackendBase::InitializeShared(std::unique_ptr<AbstractGfx> gfx,
                     OSD::Duration::NORMAL);
   }
 
+  // Traces until the backend shuts down, so stutter can be looked into after the fact. Only the
+  // newest events of each thread and the newest frames are kept (see FrameProfiler), so a long
+  // session's trace covers its end rather than all of it.
+  if (g_ActiveConfig.bDumpFrameTrace)
+  {
+    VideoCommon::g_frame_profiler.SetEnabled(true);
+    VideoCommon::g_frame_profiler.SetTracingEnabled(true);
+  }
+
   g_shader_cache->InitializeShaderCache();
 
   return true;
@@ -403,6 +415,20 @@ bool VideoBackendBase::InitializeShared(std::unique_ptr<AbstractGfx> gfx,
 
 void VideoBackendBase::ShutdownShared()
 {
+  if (VideoCommon::g_frame_profiler.IsTracingEnabled())
+  {
+    VideoCommon::g_frame_profiler.SetTracingEnabled(false);
+    VideoCommon::g_frame_profiler.SetEnabled(false);
+
+    const std::string path = File::GetUserPath(D_DUMPDEBUG_IDX);
+    File::CreateFullPath(path);
+    const std::string filename =
+        fmt::format("{}{}_{:%Y-%m-%d_%H-%M-%S}.trace.json", path,
+                    SConfig::GetInstance().GetGameID(), fmt::localtime(std::time(nullptr)));
+    if (VideoCommon::g_frame_profiler.WriteChromeTrace(filename))
+      OSD::AddMessage(fmt::format("Frame trace saved to {}", filename));
+  }
+
   g_frame_dumper.reset();
   g_presenter.reset();
 
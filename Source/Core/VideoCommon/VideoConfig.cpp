@@ -118,9 +118,12 @@ void VideoConfig::Refresh()
   bDumpBaseTextures = Config::Get(Config::GFX_DUMP_BASE_TEXTURES);
   bHiresTextures = Config::Get(Config::GFX_HIRES_TEXTURES);
   bCacheHiresTextures = Config::Get(Config::GFX_CACHE_HIRES_TEXTURES);
+  bHiresTexturesDiskCache = Config::Get(Config::GFX_HIRES_TEXTURES_DISK_CACHE);
   bDumpEFBTarget = Config::Get(Config::GFX_DUMP_EFB_TARGET);
   bDumpXFBTarget = Config::Get(Config::GFX_DUMP_XFB_TARGET);
   bDumpFramesAsImages = Config::Get(Config::GFX_DUMP_FRAMES_AS_IMAGES);
+  bDumpFramesDropWhenBehind = Config::Get(Config::GFX_DUMP_FRAMES_DROP_WHEN_BEHIND);
+  bDumpFrameTrace = Config::Get(Config::GFX_DUMP_FRAME_TRACE);
   bUseFFV1 = Config::Get(Config::GFX_USE_FFV1);
   sDumpFormat = Config::Get(Config::GFX_DUMP_FORMAT);
   sDumpCodec = Config::Get(Config::GFX_DUMP_CODEC);
@@ -130,6 +133,8 @@ void VideoConfig::Refresh()
   iBitrateKbps = Config::Get(Config::GFX_BITRATE_KBPS);
   frame_dumps_resolution_type = Config::Get(Config::GFX_FRAME_DUMPS_RESOLUTION_TYPE);
   bEnableGPUTextureDecoding = Config::Get(Config::GFX_ENABLE_GPU_TEXTURE_DECODING);
+  iTextureDecodingThreads = Config::Get(Config::GFX_TEXTURE_DECODING_THREADS);
+  bLegacyTextureHash = Config::Get(Config::GFX_LEGACY_TEXTURE_HASH);
   bPreferVSForLinePointExpansion = Config::Get(Config::GFX_PREFER_VS_FOR_LINE_POINT_EXPANSION);
   bEnablePixelLighting = Config::Get(Config::GFX_ENABLE_PIXEL_LIGHTING);
   bFastDepthCalc = Config::Get(Config::GFX_FAST_DEPTH_CALC);
@@ -149,7 +154,9 @@ void VideoConfig::Refresh()
   iShaderCompilationMode = Config::Get(Config::GFX_SHADER_COMPILATION_MODE);
   iShaderCompilerThreads = Config::Get(Config::GFX_SHADER_COMPILER_THREADS);
   iShaderPrecompilerThreads = Config::Get(Config::GFX_SHADER_PRECOMPILER_THREADS);
+  iSWRasterizerThreads = Config::Get(Config::GFX_SW_RASTERIZER_THREADS);
   bCPUCull = Config::Get(Config::GFX_CPU_CULL);
+  iVertexProcessingThreads = Config::Get(Config::GFX_VERTEX_PROCESSING_THREADS);
 
   texture_filtering_mode = Config::Get(Config::GFX_ENHANCE_FORCE_TEXTURE_FILTERING);
   iMaxAnisotropy = Config::Get(Config::GFX_ENHANCE_MAX_ANISOTROPY);
@@ -277,6 +284,34 @@ u32 VideoConfig::GetShaderPrecompilerThreads() const
     return 1;
 }
 
+u32 VideoConfig::GetSWRasterizerThreads() const
+{
+  if (iSWRasterizerThreads >= 0)
+    return static_cast<u32>(iSWRasterizerThreads);
+
+  // Automatic number. The GPU thread rasterizes as well, and the CPU thread is usually busy.
+  return static_cast<u32>(std::max(cpu_info.num_cores - 2, 0));
+}
+
+u32 VideoConfig::GetTextureDecodingThreads() const
+{
+  if (iTextureDecodingThreads >= 0)
+    return static_cast<u32>(iTextureDecodingThreads);
+
+  // Automatic number. Decoding is mostly bound by memory bandwidth, so more threads than this
+  // rarely help.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 0, 3));
+}
+
+u32 VideoConfig::GetVertexProcessingThreads() const
+{
+  if (iVertexProcessingThreads >= 0)
+    return static_cast<u32>(iVertexProcessingThreads);
+
+  // Automatic number. Only a few draws are large enough to be split, and each piece is short.
+  return static_cast<u32>(std::clamp(cpu_info.num_cores - 2, 0, 2));
+}
+
 void CheckForConfigChanges()
 {
   const ShaderHostConfig old_shader_host_config = ShaderHostConfig::GetCurrent();
@@ -190,9 +190,12 @@ struct VideoConfig final
   bool bDumpBaseTextures = false;
   bool bHiresTextures = false;
   bool bCacheHiresTextures = false;
+  bool bHiresTexturesDiskCache = false;
   bool bDumpEFBTarget = false;
   bool bDumpXFBTarget = false;
   bool bDumpFramesAsImages = false;
+  bool bDumpFramesDropWhenBehind = false;
+  bool bDumpFrameTrace = false;
   bool bUseFFV1 = false;
   std::string sDumpCodec;
   std::string sDumpPixelFormat;
@@ -276,6 +279,21 @@ struct VideoConfig final
   int iShaderCompilerThreads = 0;
   int iShaderPrecompilerThreads = 0;
 
+  // Number of threads the software renderer rasterizes on in addition to the GPU thread.
+  // -1 uses an automatic number based on the CPU threads.
+  int iSWRasterizerThreads = 0;
+
+  // Number of threads which help the GPU thread decode large textures on the CPU.
+  // -1 uses an automatic number based on the CPU threads.
+  int iTextureDecodingThreads = 0;
+
+  // Number of threads which help the GPU thread cull large draws on the CPU and generate their
+  // indices. -1 uses an automatic number based on the CPU threads.
+  int iVertexProcessingThreads = 0;
+
+  // Hash whole textures with GetHash64 instead of XXH3. XFB copies always use XXH3.
+  bool bLegacyTextureHash = true;
+
   // Loading custom drivers on Android
   std::string customDriverLibraryName;
 
@@ -382,6 +400,9 @@ struct VideoConfig final
   bool UsingUberShaders() const;
   u32 GetShaderCompilerThreads() const;
   u32 GetShaderPrecompilerThreads() const;
+  u32 GetSWRasterizerThreads() const;
+  u32 GetTextureDecodingThreads() const;
+  u32 GetVertexProcessingThreads() const;
 
   float GetCustomAspectRatio() const { return (float)custom_aspect_width / custom_aspect_height; }
 };
@@ -0,0 +1,74 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Hash.h"
+
+namespace
+{
+std::vector<u8> GetRandomBytes(size_t size)
+{
+  std::vector<u8> data(size);
+  std::mt19937 rng(static_cast<u32>(size));
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (u8& byte : data)
+    byte = static_cast<u8>(dist(rng));
+  return data;
+}
+}  // namespace
+
+TEST(Hash, XXH3)
+{
+  // Reference values from the XXH3 specification.
+  EXPECT_EQ(0x2D06800538D394C2ull, Common::HashXXH3(nullptr, 0));
+
+  const std::vector<u8> data = GetRandomBytes(4096);
+  const u64 hash = Common::HashXXH3(data.data(), data.size());
+  EXPECT_EQ(hash, Common::HashXXH3(data.data(), data.size()));
+  EXPECT_NE(hash, Common::HashXXH3(data.data(), data.size(), 1));
+  EXPECT_NE(hash, Common::HashXXH3(data.data(), data.size() - 1));
+
+  // Every bit of the input must matter.
+  std::vector<u8> changed = data;
+  changed[1234] ^= 0x10;
+  EXPECT_NE(hash, Common::HashXXH3(changed.data(), changed.size()));
+}
+
+class HashSpeedTest : public ::testing::TestWithParam<u32>
+{
+};
+
+// 64x64 CMPR, 128x128 RGB5A3, 512x512 RGBA8, and a 640x528 XFB copy.
+INSTANTIATE_TEST_SUITE_P(TextureSizes, HashSpeedTest,
+                         ::testing::Values(2 * 1024, 32 * 1024, 1024 * 1024, 640 * 528 * 2));
+
+TEST_P(HashSpeedTest, TextureHashes)
+{
+  using Clock = std::chrono::steady_clock;
+  const u32 size = GetParam();
+  const std::vector<u8> data = GetRandomBytes(size);
+  // Hash roughly 1 GiB with every function.
+  const int iterations = 1024 * 1024 * 1024 / size;
+
+  const auto measure = [&](const char* name, auto hash_function) {
+    u64 result = 0;
+    const auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+      result += hash_function();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    fmt::print("size: {} KiB, {}: {:.0f} MB/s ({:x})\n", size / 1024, name,
+               static_cast<double>(iterations) * size / seconds / 1e6, result);
+  };
+
+  measure("GetHash64, 128 samples", [&] { return Common::GetHash64(data.data(), size, 128); });
+  measure("GetHash64, all data", [&] { return Common::GetHash64(data.data(), size, 0); });
+  measure("XXH3", [&] { return Common::HashXXH3(data.data(), size); });
+}
@@ -0,0 +1,64 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/Image.h"
+
+namespace
+{
+std::vector<u8> ReferenceRGBAToRGB(const u8* input, u32 width, u32 height, u32 row_stride)
+{
+  std::vector<u8> output;
+  for (u32 y = 0; y < height; ++y)
+  {
+    for (u32 x = 0; x < width; ++x)
+    {
+      const u8* pixel = input + y * row_stride + x * 4;
+      output.insert(output.end(), pixel, pixel + 3);
+    }
+  }
+  return output;
+}
+
+void CheckAllWidths()
+{
+  constexpr u32 HEIGHT = 3;
+  constexpr u32 MAX_WIDTH = 70;
+  // The padding at the end of each row must not end up in the output.
+  constexpr u32 ROW_STRIDE = MAX_WIDTH * 4 + 12;
+
+  std::vector<u8> input(ROW_STRIDE * HEIGHT);
+  for (size_t i = 0; i < input.size(); ++i)
+    input[i] = static_cast<u8>(i * 7 + (i >> 8));
+
+  for (u32 width = 0; width <= MAX_WIDTH; ++width)
+  {
+    SCOPED_TRACE(width);
+    EXPECT_EQ(ReferenceRGBAToRGB(input.data(), width, HEIGHT, ROW_STRIDE),
+              Common::RGBAToRGB(input.data(), width, HEIGHT, ROW_STRIDE));
+    // Tightly packed rows.
+    EXPECT_EQ(ReferenceRGBAToRGB(input.data(), width, HEIGHT, width * 4),
+              Common::RGBAToRGB(input.data(), width, HEIGHT, width * 4));
+  }
+}
+}  // namespace
+
+TEST(Image, RGBAToRGB)
+{
+  CheckAllWidths();
+}
+
+#ifdef _M_X86_64
+TEST(Image, RGBAToRGBWithoutSSSE3)
+{
+  const bool ssse3 = cpu_info.bSSSE3;
+  cpu_info.bSSSE3 = false;
+  CheckAllWidths();
+  cpu_info.bSSSE3 = ssse3;
+}
+#endif
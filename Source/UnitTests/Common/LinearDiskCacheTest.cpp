@@ -0,0 +1,256 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Common/LinearDiskCache.h"
+
+namespace
+{
+using Cache = Common::LinearDiskCache<u32, u8>;
+
+class Reader final : public Common::LinearDiskCacheReader<u32, u8>
+{
+public:
+  void Read(const u32& key, const u8* value, u32 value_size) override
+  {
+    entries.emplace_back(key, std::vector<u8>(value, value + value_size));
+  }
+
+  std::vector<std::pair<u32, std::vector<u8>>> entries;
+};
+
+std::vector<u8> MakeValue(u32 key, u32 size)
+{
+  std::vector<u8> value(size);
+  for (u32 i = 0; i < size; i++)
+    value[i] = static_cast<u8>(key * 7 + i);
+  return value;
+}
+
+void Append(Cache& cache, u32 key, u32 size)
+{
+  const std::vector<u8> value = MakeValue(key, size);
+  cache.Append(key, value.data(), size);
+}
+
+bool HasValue(const Cache& cache, u32 key, u32 size)
+{
+  const auto value = cache.Lookup(key);
+  return value && std::vector<u8>(value->begin(), value->end()) == MakeValue(key, size);
+}
+}  // namespace
+
+class LinearDiskCacheTest : public testing::Test
+{
+protected:
+  LinearDiskCacheTest() : m_directory(File::CreateTempDir()), m_path(m_directory + "/test.cache")
+  {
+  }
+
+  ~LinearDiskCacheTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  const std::string m_directory;
+  const std::string m_path;
+};
+
+TEST_F(LinearDiskCacheTest, AppendAndReopen)
+{
+  {
+    Cache cache;
+    EXPECT_EQ(0u, cache.Open(m_path));
+    Append(cache, 1, 10);
+    Append(cache, 2, 0);
+    Append(cache, 3, 300);
+
+    // Appended values can be looked up before the cache is reopened.
+    EXPECT_TRUE(HasValue(cache, 1, 10));
+    EXPECT_TRUE(HasValue(cache, 3, 300));
+  }
+
+  Cache cache;
+  Reader reader;
+  EXPECT_EQ(3u, cache.OpenAndRead(m_path, reader));
+  ASSERT_EQ(3u, reader.entries.size());
+  EXPECT_EQ(1u, reader.entries[0].first);
+  EXPECT_EQ(MakeValue(1, 10), reader.entries[0].second);
+  EXPECT_EQ(2u, reader.entries[1].first);
+  EXPECT_TRUE(reader.entries[1].second.empty());
+  EXPECT_EQ(3u, reader.entries[2].first);
+  EXPECT_EQ(MakeValue(3, 300), reader.entries[2].second);
+
+  EXPECT_TRUE(HasValue(cache, 2, 0));
+  EXPECT_TRUE(cache.Contains(3));
+  EXPECT_FALSE(cache.Contains(4));
+  EXPECT_FALSE(cache.Lookup(4));
+
+  // Appending to a cache which was opened with an index.
+  Append(cache, 4, 20);
+  cache.Close();
+  EXPECT_EQ(4u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 1, 10));
+  EXPECT_TRUE(HasValue(cache, 4, 20));
+}
+
+TEST_F(LinearDiskCacheTest, AppendReplacesValue)
+{
+  Cache cache;
+  cache.Open(m_path);
+  Append(cache, 1, 10);
+  Append(cache, 2, 10);
+  Append(cache, 1, 30);
+  EXPECT_EQ(2u, cache.GetEntryCount());
+  EXPECT_TRUE(HasValue(cache, 1, 30));
+
+  cache.Close();
+  EXPECT_EQ(2u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 1, 30));
+  EXPECT_TRUE(HasValue(cache, 2, 10));
+}
+
+TEST_F(LinearDiskCacheTest, RecoversFromMissingIndex)
+{
+  {
+    Cache cache;
+    cache.Open(m_path);
+    for (u32 key = 0; key < 5; key++)
+      Append(cache, key, 50);
+  }
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(m_path, contents));
+
+  {
+    // Appending without closing leaves the file without an index.
+    Cache cache;
+    cache.Open(m_path);
+    Append(cache, 5, 50);
+    Append(cache, 0, 60);
+    cache.Sync();
+
+    std::string unclosed;
+    ASSERT_TRUE(File::ReadFileToString(m_path, unclosed));
+    ASSERT_TRUE(File::WriteStringToFile(m_path + ".unclosed", unclosed));
+  }
+  File::Copy(m_path + ".unclosed", m_path);
+
+  Cache cache;
+  EXPECT_EQ(6u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 0, 60));
+  EXPECT_TRUE(HasValue(cache, 5, 50));
+  cache.Close();
+
+  // A torn write only loses the incomplete record.
+  std::string unclosed;
+  ASSERT_TRUE(File::ReadFileToString(m_path + ".unclosed", unclosed));
+  ASSERT_TRUE(File::WriteStringToFile(m_path, unclosed.substr(0, unclosed.size() - 3)));
+  EXPECT_EQ(6u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 0, 50));
+  EXPECT_TRUE(HasValue(cache, 5, 50));
+  Append(cache, 6, 10);
+  cache.Close();
+  EXPECT_EQ(7u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 6, 10));
+  cache.Close();
+
+  // So does a corrupted one.
+  unclosed[unclosed.size() - 10] ^= 1;
+  ASSERT_TRUE(File::WriteStringToFile(m_path, unclosed));
+  EXPECT_EQ(6u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 0, 50));
+  cache.Close();
+
+  // And a corrupted index.
+  contents[contents.size() - 40] ^= 1;
+  ASSERT_TRUE(File::WriteStringToFile(m_path, contents));
+  EXPECT_EQ(5u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 4, 50));
+}
+
+TEST_F(LinearDiskCacheTest, DiscardsInvalidFiles)
+{
+  ASSERT_TRUE(File::WriteStringToFile(m_path, "not a cache"));
+  Cache cache;
+  EXPECT_EQ(0u, cache.Open(m_path));
+  Append(cache, 1, 1);
+  cache.Close();
+  EXPECT_EQ(1u, cache.Open(m_path));
+
+  // A cache with different key or value types is rejected.
+  cache.Close();
+  Common::LinearDiskCache<u64, u8> other_cache;
+  EXPECT_EQ(0u, other_cache.Open(m_path));
+}
+
+TEST_F(LinearDiskCacheTest, Compaction)
+{
+  Cache cache;
+  cache.Open(m_path);
+  for (u32 i = 0; i < 200; i++)
+    Append(cache, i % 100, 100);
+  cache.Close();
+  const u64 uncompacted_size = File::GetSize(m_path);
+
+  // Half of the records are stale, so the cache is compacted when opened.
+  EXPECT_EQ(100u, cache.Open(m_path));
+  EXPECT_LT(File::GetSize(m_path), uncompacted_size * 3 / 5);
+  EXPECT_FALSE(File::Exists(m_path + ".tmp"));
+  for (u32 key = 0; key < 100; key++)
+    EXPECT_TRUE(HasValue(cache, key, 100));
+
+  Append(cache, 100, 100);
+  cache.Close();
+  EXPECT_EQ(101u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 100, 100));
+  EXPECT_TRUE(HasValue(cache, 50, 100));
+}
+
+TEST_F(LinearDiskCacheTest, RemapsAppendedRecords)
+{
+  {
+    Cache cache;
+    cache.Open(m_path);
+    Append(cache, 0, 10);
+  }
+
+  // The appended records add up to more than the copies which are kept until the file is mapped
+  // again, so lookups have to switch from the copies to the mapping in between.
+  Cache cache;
+  EXPECT_EQ(1u, cache.Open(m_path));
+  for (u32 key = 1; key <= 40; key++)
+  {
+    Append(cache, key, 100 * 1024);
+    EXPECT_TRUE(HasValue(cache, key, 100 * 1024));
+    EXPECT_TRUE(HasValue(cache, key / 2, key / 2 == 0 ? 10 : 100 * 1024));
+  }
+  for (u32 key = 1; key <= 40; key++)
+    EXPECT_TRUE(HasValue(cache, key, 100 * 1024));
+  EXPECT_TRUE(HasValue(cache, 0, 10));
+
+  // Replacing a value which is only in the mapping.
+  Append(cache, 1, 20);
+  EXPECT_TRUE(HasValue(cache, 1, 20));
+  EXPECT_EQ(41u, cache.GetEntryCount());
+
+  cache.Close();
+  EXPECT_EQ(41u, cache.Open(m_path));
+  EXPECT_TRUE(HasValue(cache, 0, 10));
+  EXPECT_TRUE(HasValue(cache, 1, 20));
+  EXPECT_TRUE(HasValue(cache, 40, 100 * 1024));
+}
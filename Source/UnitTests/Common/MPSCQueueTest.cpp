@@ -0,0 +1,82 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <array>
+#include <thread>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/MPSCQueue.h"
+
+TEST(MPSCQueue, Simple)
+{
+  Common::MPSCQueue<u32> q;
+
+  EXPECT_TRUE(q.Empty());
+
+  q.Push(1);
+  EXPECT_FALSE(q.Empty());
+
+  u32 v;
+  EXPECT_TRUE(q.Pop(v));
+  EXPECT_EQ(1u, v);
+  EXPECT_TRUE(q.Empty());
+  EXPECT_FALSE(q.Pop(v));
+
+  // Test the FIFO order.
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  for (u32 i = 0; i < 1000; ++i)
+  {
+    u32 v2;
+    EXPECT_TRUE(q.Pop(v2));
+    EXPECT_EQ(i, v2);
+  }
+  EXPECT_TRUE(q.Empty());
+
+  for (u32 i = 0; i < 1000; ++i)
+    q.Push(i);
+  EXPECT_FALSE(q.Empty());
+  q.Clear();
+  EXPECT_TRUE(q.Empty());
+}
+
+TEST(MPSCQueue, MultiThreaded)
+{
+  constexpr u32 PRODUCERS = 4;
+  constexpr u32 COUNT = 100000;
+
+  // The upper bits identify the producer, the lower bits its sequence number.
+  Common::MPSCQueue<u32> q;
+
+  auto inserter = [&q](u32 producer) {
+    for (u32 i = 0; i < COUNT; ++i)
+      q.Push((producer << 24) | i);
+  };
+
+  std::vector<std::thread> inserter_threads;
+  for (u32 i = 0; i < PRODUCERS; ++i)
+    inserter_threads.emplace_back(inserter, i);
+
+  // Elements from different producers may interleave, but each producer's own elements must come
+  // out in the order they were pushed.
+  std::array<u32, PRODUCERS> next_expected{};
+  for (u32 popped = 0; popped < PRODUCERS * COUNT;)
+  {
+    u32 v;
+    if (!q.Pop(v))
+      continue;
+
+    const u32 producer = v >> 24;
+    ASSERT_LT(producer, PRODUCERS);
+    EXPECT_EQ(next_expected[producer], v & 0xFFFFFF);
+    next_expected[producer] = (v & 0xFFFFFF) + 1;
+    ++popped;
+  }
+
+  for (std::thread& thread : inserter_threads)
+    thread.join();
+
+  EXPECT_TRUE(q.Empty());
+}
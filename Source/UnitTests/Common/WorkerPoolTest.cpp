@@ -0,0 +1,47 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
+
+TEST(WorkerPool, RunsOnEveryThread)
+{
+  Common::WorkerPool pool("WorkerPoolTest", 3);
+  EXPECT_EQ(3u, pool.GetWorkerCount());
+
+  for (int run = 0; run < 1000; ++run)
+  {
+    std::vector<std::atomic<u32>> calls(pool.GetWorkerCount() + 1);
+    pool.Run([&](u32 index) { ++calls[index]; });
+
+    // Run() must not return before every thread is done.
+    for (const std::atomic<u32>& count : calls)
+      EXPECT_EQ(1u, count.load());
+  }
+}
+
+TEST(WorkerPool, SharesWork)
+{
+  constexpr u32 ITEMS = 100000;
+
+  Common::WorkerPool pool;
+  for (u32 worker_count : {0u, 1u, 4u, 2u})
+  {
+    pool.Reset("WorkerPoolTest", worker_count);
+    EXPECT_EQ(worker_count, pool.GetWorkerCount());
+
+    std::vector<u32> items(ITEMS);
+    std::atomic<u32> next_item = 0;
+    pool.Run([&](u32) {
+      for (u32 i = next_item++; i < ITEMS; i = next_item++)
+        items[i] += i;
+    });
+
+    for (u32 i = 0; i < ITEMS; ++i)
+      EXPECT_EQ(i, items[i]);
+  }
+}
@@ -105,6 +105,7 @@ protected:
     cpu_info.bSSE4_2 = true;
     cpu_info.bLZCNT = true;
     cpu_info.bAVX = true;
+    cpu_info.bAVX2 = true;
     cpu_info.bBMI1 = true;
     cpu_info.bBMI2 = true;
     cpu_info.bBMI2FastParallelBitOps = true;
@@ -239,6 +240,7 @@ TEST_INSTR_NO_OPERANDS(CWDE, "cwde")
 TEST_INSTR_NO_OPERANDS(CDQE, "cdqe")
 TEST_INSTR_NO_OPERANDS(XCHG_AHAL, "xchg al, ah")
 TEST_INSTR_NO_OPERANDS(RDTSC, "rdtsc")
+TEST_INSTR_NO_OPERANDS(VZEROUPPER, "vzeroupper")
 
 TEST_F(x64EmitterTest, NOP_MultiByte)
 {
@@ -1276,6 +1278,104 @@ AVX_RRM_TEST(VPANDN, "dqword")
 AVX_RRM_TEST(VPOR, "dqword")
 AVX_RRM_TEST(VPXOR, "dqword")
 
+// for VEX moves that take the form op r/m, reg
+#define VEX_STORE_TEST(Name, MemBits)                                                              \
+  TEST_F(x64EmitterTest, Name)                                                                     \
+  {                                                                                                \
+    for (const auto& r : xmmnames)                                                                 \
+    {                                                                                              \
+      emitter->Name(MatR(R12), r.reg);                                                             \
+      ExpectDisassembly(#Name " " MemBits " ptr ds:[r12], " + r.name);                             \
+    }                                                                                              \
+  }
+
+VEX_STORE_TEST(VMOVSS, "dword")
+VEX_STORE_TEST(VMOVUPS, "dqword")
+
+TEST_F(x64EmitterTest, VMOVDQU)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VMOVDQU(r.reg, MatR(R12));
+    ExpectDisassembly("vmovdqu " + r.name + ", dqword ptr ds:[r12]");
+  }
+}
+
+TEST_F(x64EmitterTest, VMOVD_VMOVQ_xmm)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VMOVD_xmm(r.reg, MatR(R12));
+    emitter->VMOVQ_xmm(r.reg, MatR(R12));
+    emitter->VMOVQ_xmm(MatR(R12), r.reg);
+    ExpectDisassembly("vmovd " + r.name + ", dword ptr ds:[r12] vmovq " + r.name +
+                      ", qword ptr ds:[r12] vmovq qword ptr ds:[r12], " + r.name);
+  }
+}
+
+TEST_F(x64EmitterTest, VEXTRACTPS)
+{
+  for (const auto& r : xmmnames)
+  {
+    emitter->VEXTRACTPS(MatR(R12), r.reg, 2);
+    ExpectDisassembly("vextractps dword ptr ds:[r12], " + r.name + ", 0x02");
+  }
+}
+
+TEST_F(x64EmitterTest, VCVTDQ2PS_ymm)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VCVTDQ2PS_ymm(r.reg, R(YMM0));
+    emitter->VCVTDQ2PS_ymm(YMM0, R(r.reg));
+    emitter->VCVTDQ2PS_ymm(r.reg, MatR(R12));
+    ExpectDisassembly("vcvtdq2ps " + r.name + ", ymm0 vcvtdq2ps ymm0, " + r.name + " vcvtdq2ps " +
+                      r.name + ", qqword ptr ds:[r12]");
+  }
+}
+
+TEST_F(x64EmitterTest, VPSRAD_ymm)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VPSRAD_ymm(r.reg, YMM0, 16);
+    emitter->VPSRAD_ymm(YMM0, r.reg, 24);
+    ExpectDisassembly("vpsrad " + r.name + ", ymm0, 0x10 vpsrad ymm0, " + r.name + ", 0x18");
+  }
+}
+
+// The disassembler shows the 128-bit operand of these with the size of the other operands.
+TEST_F(x64EmitterTest, VINSERTI128_VEXTRACTI128)
+{
+  for (const auto& r : ymmnames)
+  {
+    emitter->VINSERTI128(r.reg, YMM0, R(r.reg), 1);
+    emitter->VINSERTI128(YMM0, r.reg, MatR(R12), 1);
+    emitter->VEXTRACTI128(R(r.reg), YMM0, 1);
+    emitter->VEXTRACTI128(MatR(R12), r.reg, 1);
+    ExpectDisassembly("vinserti128 " + r.name + ", ymm0, " + r.name + ", 0x01 vinserti128 ymm0, " +
+                      r.name + ", qqword ptr ds:[r12], 0x01 vextracti128 " + r.name +
+                      ", ymm0, 0x01 vextracti128 qqword ptr ds:[r12], " + r.name + ", 0x01");
+  }
+}
+
+// for 256-bit instructions that take the form op reg, reg, r/m
+#define AVX_RRM_YMM_TEST(Name, Disasm)                                                             \
+  TEST_F(x64EmitterTest, Name)                                                                     \
+  {                                                                                                \
+    for (const auto& r : ymmnames)                                                                 \
+    {                                                                                              \
+      emitter->Name(r.reg, YMM0, R(YMM0));                                                         \
+      emitter->Name(YMM0, YMM0, R(r.reg));                                                         \
+      emitter->Name(YMM0, r.reg, MatR(R12));                                                       \
+      ExpectDisassembly(Disasm " " + r.name + ", ymm0, ymm0 " Disasm " ymm0, ymm0, " + r.name +   \
+                        " " Disasm " ymm0, " + r.name + ", qqword ptr ds:[r12]");                 \
+    }                                                                                              \
+  }
+
+AVX_RRM_YMM_TEST(VMULPS_ymm, "vmulps")
+AVX_RRM_YMM_TEST(VPSHUFB_ymm, "vpshufb")
+
 #define FMA3_TEST(Name, P, packed)                                                                 \
   AVX_RRM_TEST(Name##132##P##S, packed ? "dqword" : "dword")                                       \
   AVX_RRM_TEST(Name##213##P##S, packed ? "dqword" : "dword")                                       \
@@ -0,0 +1,374 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "Common/Align.h"
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Core/CheatSearch.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+// These tests compare the bulk and parallel scans of the cheat search with a plain per-address
+// scan through the MMU, which is how the cheat search used to read memory.
+
+namespace
+{
+constexpr u32 BAT_BLOCK_SIZE = 0x20000;
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(Core::System& system) : m_system(system), m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    system.GetMemory().Init();
+    system.GetPowerPC().Init(PowerPC::CPUCore::Interpreter);
+    system.GetCoreTiming().Init();
+  }
+  ~ScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+    m_system.GetCoreTiming().Shutdown();
+    m_system.GetPowerPC().Shutdown();
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  Core::System& m_system;
+  std::string m_profile_path;
+};
+
+template <typename T>
+using Bits = std::conditional_t<
+    sizeof(T) == 1, u8,
+    std::conditional_t<sizeof(T) == 2, u16, std::conditional_t<sizeof(T) == 4, u32, u64>>>;
+
+template <typename T>
+std::optional<PowerPC::ReadResult<T>> ReferenceRead(const Core::CPUThreadGuard& guard, u32 address,
+                                                    PowerPC::RequestedAddressSpace space)
+{
+  std::optional<PowerPC::ReadResult<Bits<T>>> result;
+  if constexpr (sizeof(T) == 1)
+    result = PowerPC::MMU::HostTryReadU8(guard, address, space);
+  else if constexpr (sizeof(T) == 2)
+    result = PowerPC::MMU::HostTryReadU16(guard, address, space);
+  else if constexpr (sizeof(T) == 4)
+    result = PowerPC::MMU::HostTryReadU32(guard, address, space);
+  else
+    result = PowerPC::MMU::HostTryReadU64(guard, address, space);
+  if (!result)
+    return std::nullopt;
+  return PowerPC::ReadResult<T>(result->translated, std::bit_cast<T>(result->value));
+}
+
+Cheats::SearchResultValueState ValueState(bool translated)
+{
+  return translated ? Cheats::SearchResultValueState::ValueFromVirtualMemory :
+                      Cheats::SearchResultValueState::ValueFromPhysicalMemory;
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+ReferenceNewSearch(const Core::CPUThreadGuard& guard,
+                   const std::vector<Cheats::MemoryRange>& memory_ranges,
+                   PowerPC::RequestedAddressSpace address_space, bool aligned,
+                   const std::function<bool(const T& value)>& validator)
+{
+  std::vector<Cheats::SearchResult<T>> results;
+  for (const Cheats::MemoryRange& range : memory_ranges)
+  {
+    if (range.m_length < sizeof(T))
+      continue;
+
+    const u32 increment_per_loop = aligned ? sizeof(T) : 1;
+    const u32 start_address = aligned ? Common::AlignUp(range.m_start, sizeof(T)) : range.m_start;
+    const u64 aligned_length = range.m_length - (start_address - range.m_start);
+    if (aligned_length < sizeof(T))
+      continue;
+
+    const u64 length = aligned_length - (sizeof(T) - 1);
+    for (u64 i = 0; i < length; i += increment_per_loop)
+    {
+      const u32 addr = start_address + static_cast<u32>(i);
+      const auto current_value = ReferenceRead<T>(guard, addr, address_space);
+      if (current_value && validator(current_value->value))
+        results.push_back({current_value->value, ValueState(current_value->translated), addr});
+    }
+  }
+  return results;
+}
+
+template <typename T>
+std::vector<Cheats::SearchResult<T>>
+ReferenceNextSearch(const Core::CPUThreadGuard& guard,
+                    const std::vector<Cheats::SearchResult<T>>& previous_results,
+                    PowerPC::RequestedAddressSpace address_space,
+                    const std::function<bool(const T& new_value, const T& old_value)>& validator)
+{
+  std::vector<Cheats::SearchResult<T>> results;
+  for (const auto& previous_result : previous_results)
+  {
+    const u32 addr = previous_result.m_address;
+    const auto current_value = ReferenceRead<T>(guard, addr, address_space);
+    if (!current_value)
+    {
+      results.push_back({T{}, Cheats::SearchResultValueState::AddressNotAccessible, addr});
+      continue;
+    }
+
+    if (!previous_result.IsValueValid() || validator(current_value->value, previous_result.m_value))
+      results.push_back({current_value->value, ValueState(current_value->translated), addr});
+  }
+  return results;
+}
+
+// Compares bit patterns, so that NaNs compare equal and the results have to match in order.
+template <typename T>
+void ExpectSameResults(const std::vector<Cheats::SearchResult<T>>& expected,
+                       const std::vector<Cheats::SearchResult<T>>& actual)
+{
+  ASSERT_EQ(expected.size(), actual.size());
+  for (size_t i = 0; i < expected.size(); ++i)
+  {
+    SCOPED_TRACE(i);
+    EXPECT_EQ(expected[i].m_address, actual[i].m_address);
+    EXPECT_EQ(expected[i].m_value_state, actual[i].m_value_state);
+    if (expected[i].IsValueValid())
+    {
+      EXPECT_EQ(std::bit_cast<Bits<T>>(expected[i].m_value),
+                std::bit_cast<Bits<T>>(actual[i].m_value));
+    }
+  }
+}
+
+template <typename T>
+bool KeepValue(const T& value)
+{
+  return std::bit_cast<Bits<T>>(value) % 3 == 0;
+}
+
+template <typename T>
+bool KeepChangedValue(const T& new_value, const T& old_value)
+{
+  return std::bit_cast<Bits<T>>(new_value) != std::bit_cast<Bits<T>>(old_value);
+}
+
+void FillRandom(Core::System& system, u32 physical_address, u32 size, u32 seed)
+{
+  std::mt19937 rng(seed);
+  std::vector<u8> data(size);
+  for (u8& byte : data)
+    byte = static_cast<u8>(rng() % 4);
+  system.GetMemory().CopyToEmu(physical_address, data.data(), data.size());
+}
+
+// Changes every fourth page, so that the next search has both changed and unchanged values.
+void ChangeSomePages(Core::System& system, u32 physical_address, u32 size, u32 seed)
+{
+  for (u32 page = 0; page < size; page += 4 * PowerPC::HW_PAGE_SIZE)
+    FillRandom(system, physical_address + page, PowerPC::HW_PAGE_SIZE, seed + page);
+}
+
+template <typename T>
+void CompareScans(const Core::CPUThreadGuard& guard,
+                  const std::vector<Cheats::MemoryRange>& ranges,
+                  PowerPC::RequestedAddressSpace space, const std::function<void()>& change_memory)
+{
+  for (const bool aligned : {true, false})
+  {
+    SCOPED_TRACE(aligned ? "aligned" : "unaligned");
+    const auto expected = ReferenceNewSearch<T>(guard, ranges, space, aligned, KeepValue<T>);
+    ASSERT_FALSE(expected.empty());
+
+    for (const bool parallel : {false, true})
+    {
+      SCOPED_TRACE(parallel ? "parallel" : "single thread");
+      ExpectSameResults(expected, Cheats::NewSearchUnchecked<T>(guard, ranges, space, aligned,
+                                                                KeepValue<T>, parallel));
+    }
+
+    // Mark some of the previous results as invalid; those are refreshed unconditionally.
+    auto previous = expected;
+    for (size_t i = 0; i < previous.size(); i += 7)
+      previous[i].m_value_state = Cheats::SearchResultValueState::AddressNotAccessible;
+
+    change_memory();
+    const auto expected_next = ReferenceNextSearch<T>(guard, previous, space, KeepChangedValue<T>);
+    for (const bool parallel : {false, true})
+    {
+      SCOPED_TRACE(parallel ? "parallel next" : "single thread next");
+      ExpectSameResults(expected_next, Cheats::NextSearchUnchecked<T>(
+                                           guard, previous, space, KeepChangedValue<T>, parallel));
+    }
+  }
+}
+
+template <typename... Ts>
+void CompareScansForTypes(const Core::CPUThreadGuard& guard,
+                             const std::vector<Cheats::MemoryRange>& ranges,
+                             PowerPC::RequestedAddressSpace space,
+                             const std::function<void()>& change_memory)
+{
+  (
+      [&] {
+        SCOPED_TRACE(sizeof(Ts));
+        CompareScans<Ts>(guard, ranges, space, change_memory);
+      }(),
+      ...);
+}
+
+void CompareScansForAllTypes(const Core::CPUThreadGuard& guard,
+                             const std::vector<Cheats::MemoryRange>& ranges,
+                             PowerPC::RequestedAddressSpace space,
+                             const std::function<void()>& change_memory)
+{
+  CompareScansForTypes<u8, u16, u32, u64, s8, s16, s32, s64, float, double>(guard, ranges, space,
+                                                                            change_memory);
+}
+}  // namespace
+
+TEST(CheatSearch, PhysicalScanMatchesPerAddressScan)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit scope(system);
+  ASSERT_TRUE(scope.UserDirectoryExists());
+
+  const u32 ram_size = system.GetMemory().GetRamSizeReal();
+  constexpr u32 FILL_SIZE = 0x200000;
+  const u32 fill_start = ram_size - FILL_SIZE;
+  FillRandom(system, fill_start, FILL_SIZE, 1);
+
+  // The first range is large enough for the parallel path and runs past the end of RAM, the others
+  // start at odd addresses, are shorter than some of the value sizes or lie entirely outside of
+  // RAM.
+  const std::vector<Cheats::MemoryRange> ranges = {
+      {fill_start, FILL_SIZE + 0x1003},
+      {fill_start + 0x1001, 0x2001},
+      {fill_start + 0x3003, 3},
+      {fill_start + 0x4005, 7},
+      {ram_size - 5, 10},
+      {0x10000000, 0x1000},
+  };
+
+  u32 seed = 2;
+  const Core::CPUThreadGuard guard(system);
+  CompareScansForAllTypes(guard, ranges, PowerPC::RequestedAddressSpace::Physical,
+                          [&] { ChangeSomePages(system, fill_start, FILL_SIZE, seed++ << 24); });
+}
+
+TEST(CheatSearch, EffectiveScanMatchesPerAddressScan)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit scope(system);
+  ASSERT_TRUE(scope.UserDirectoryExists());
+
+  constexpr u32 PHYSICAL_ADDRESS = 0x00400000;
+  constexpr u32 EFFECTIVE_ADDRESS = 0x80000000;
+  FillRandom(system, PHYSICAL_ADDRESS, BAT_BLOCK_SIZE, 1);
+
+  // Map a single 128 KiB block. Everything around it goes through the empty page table and can't
+  // be read.
+  UReg_BAT_Up batu;
+  batu.BEPI = EFFECTIVE_ADDRESS >> PowerPC::BAT_INDEX_SHIFT;
+  batu.VS = 1;
+  batu.VP = 1;
+  UReg_BAT_Lo batl;
+  batl.BRPN = PHYSICAL_ADDRESS >> PowerPC::BAT_INDEX_SHIFT;
+  batl.PP = 2;
+  auto& ppc_state = system.GetPPCState();
+  ppc_state.spr[SPR_DBAT0U] = batu.Hex;
+  ppc_state.spr[SPR_DBAT0L] = batl.Hex;
+  system.GetMMU().DBATUpdated();
+  ppc_state.msr.DR = 1;
+
+  const std::vector<Cheats::MemoryRange> ranges = {
+      {EFFECTIVE_ADDRESS - 0x1001, BAT_BLOCK_SIZE + 0x2003},
+      {EFFECTIVE_ADDRESS + BAT_BLOCK_SIZE - 3, 6},
+  };
+
+  u32 seed = 2;
+  const Core::CPUThreadGuard guard(system);
+  CompareScansForAllTypes(
+      guard, ranges, PowerPC::RequestedAddressSpace::Effective,
+      [&] { ChangeSomePages(system, PHYSICAL_ADDRESS, BAT_BLOCK_SIZE, seed++ << 24); });
+}
+
+// Not a pass/fail test: measures a first and a next scan of all of MEM1, against the per-address
+// scan through the MMU.
+TEST(CheatSearch, ScanSpeed)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit scope(system);
+  ASSERT_TRUE(scope.UserDirectoryExists());
+
+  const u32 ram_size = system.GetMemory().GetRamSizeReal();
+  FillRandom(system, 0, ram_size, 1);
+  const std::vector<Cheats::MemoryRange> ranges = {{0, ram_size}};
+  constexpr auto space = PowerPC::RequestedAddressSpace::Physical;
+
+  using Clock = std::chrono::steady_clock;
+  const auto measure = [ram_size](const char* name, const auto& scan) {
+    const auto start = Clock::now();
+    auto results = scan();
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+    fmt::print("{} MiB, {}: {:.1f} ms, {} results\n", ram_size >> 20, name, seconds * 1000,
+               results.size());
+    return results;
+  };
+
+  const Core::CPUThreadGuard guard(system);
+  const auto first = measure("per-address first scan", [&] {
+    return ReferenceNewSearch<u32>(guard, ranges, space, true, KeepValue<u32>);
+  });
+  for (const bool parallel : {false, true})
+  {
+    const auto results = measure(parallel ? "parallel first scan" : "first scan", [&] {
+      return Cheats::NewSearchUnchecked<u32>(guard, ranges, space, true, KeepValue<u32>, parallel);
+    });
+    EXPECT_EQ(first.size(), results.size());
+  }
+
+  ChangeSomePages(system, 0, ram_size, 2 << 24);
+  const auto next = measure("per-address next scan", [&] {
+    return ReferenceNextSearch<u32>(guard, first, space, KeepChangedValue<u32>);
+  });
+  for (const bool parallel : {false, true})
+  {
+    const auto results = measure(parallel ? "parallel next scan" : "next scan", [&] {
+      return Cheats::NextSearchUnchecked<u32>(guard, first, space, KeepChangedValue<u32>, parallel);
+    });
+    EXPECT_EQ(next.size(), results.size());
+  }
+}
@@ -5,7 +5,12 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
+#include <thread>
+#include <vector>
+
+#include <fmt/format.h>
 
 #include "Common/Config/Config.h"
 #include "Common/FileUtil.h"
@@ -327,6 +332,106 @@ TEST(CoreTiming, ScheduleIntoPast)
   AdvanceAndCheck(system, 0, MAX_SLICE_LENGTH, 1000);
 }
 
+namespace MultiThreadedScheduleTest
+{
+static int s_count = 0;
+static u64 s_sum = 0;
+
+static void CountingCallback(Core::System& system, u64 userdata, s64 lateness)
+{
+  ++s_count;
+  s_sum += userdata;
+}
+}  // namespace MultiThreadedScheduleTest
+
+// Events scheduled concurrently from several non-CPU threads must all be picked up by the next
+// Advance(), exactly once.
+TEST(CoreTiming, ScheduleFromMultipleThreads)
+{
+  using namespace MultiThreadedScheduleTest;
+
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  CoreTiming::EventType* cb = core_timing.RegisterEvent("callbackCount", CountingCallback);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  constexpr u64 THREADS = 4;
+  constexpr u64 EVENTS_PER_THREAD = 1000;
+  std::vector<std::thread> threads;
+  for (u64 t = 0; t < THREADS; ++t)
+  {
+    threads.emplace_back([&core_timing, cb, t] {
+      for (u64 i = 0; i < EVENTS_PER_THREAD; ++i)
+      {
+        core_timing.ScheduleEvent(0, cb, t * EVENTS_PER_THREAD + i,
+                                  CoreTiming::FromThread::NON_CPU);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  s_count = 0;
+  s_sum = 0;
+  ppc_state.downcount = 0;
+  core_timing.Advance();
+
+  constexpr u64 TOTAL = THREADS * EVENTS_PER_THREAD;
+  EXPECT_EQ(static_cast<int>(TOTAL), s_count);
+  EXPECT_EQ(TOTAL * (TOTAL - 1) / 2, s_sum);
+  EXPECT_EQ(MAX_SLICE_LENGTH, ppc_state.downcount);
+}
+
+// Not a pass/fail test: measures how fast several non-CPU threads can schedule events at once.
+TEST(CoreTiming, ScheduleThroughputFromMultipleThreads)
+{
+  using namespace MultiThreadedScheduleTest;
+
+  auto& system = Core::System::GetInstance();
+
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& core_timing = system.GetCoreTiming();
+  auto& ppc_state = system.GetPPCState();
+
+  CoreTiming::EventType* cb = core_timing.RegisterEvent("callbackCount", CountingCallback);
+
+  // Enter slice 0
+  core_timing.Advance();
+
+  constexpr u64 THREADS = 4;
+  constexpr u64 EVENTS_PER_THREAD = 250000;
+  const auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (u64 t = 0; t < THREADS; ++t)
+  {
+    threads.emplace_back([&core_timing, cb] {
+      for (u64 i = 0; i < EVENTS_PER_THREAD; ++i)
+        core_timing.ScheduleEvent(0, cb, 0, CoreTiming::FromThread::NON_CPU);
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+  const double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  s_count = 0;
+  ppc_state.downcount = 0;
+  core_timing.Advance();
+
+  fmt::print("{} threads x {} events: {:.1f} ms\n", THREADS, EVENTS_PER_THREAD, seconds * 1000);
+  EXPECT_EQ(static_cast<int>(THREADS * EVENTS_PER_THREAD), s_count);
+}
+
 TEST(CoreTiming, Overclocking)
 {
   auto& system = Core::System::GetInstance();
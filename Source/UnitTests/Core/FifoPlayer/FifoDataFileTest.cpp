@@ -0,0 +1,375 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "Core/FifoPlayer/FifoDataFile.h"
+#include "Core/HW/Memmap.h"
+#include "Core/System.h"
+
+namespace
+{
+// The on-disk layout of the structures FifoDataFile reads, as written by older versions.
+#pragma pack(push, 1)
+
+struct FileHeader
+{
+  u32 fileId;
+  u32 file_version;
+  u32 min_loader_version;
+  u64 bpMemOffset;
+  u32 bpMemSize;
+  u64 cpMemOffset;
+  u32 cpMemSize;
+  u64 xfMemOffset;
+  u32 xfMemSize;
+  u64 xfRegsOffset;
+  u32 xfRegsSize;
+  u64 frameListOffset;
+  u32 frameCount;
+  u32 flags;
+  u64 texMemOffset;
+  u32 texMemSize;
+  u32 mem1_size;
+  u32 mem2_size;
+  u64 blobListOffset;
+  u32 blobCount;
+  u8 reserved[20];
+};
+static_assert(sizeof(FileHeader) == 128);
+
+struct FileFrameInfo
+{
+  u64 fifoDataOffset;
+  u32 fifoDataSize;
+  u32 fifoStart;
+  u32 fifoEnd;
+  u64 memoryUpdatesOffset;
+  u32 numMemoryUpdates;
+  u8 reserved[32];
+};
+static_assert(sizeof(FileFrameInfo) == 64);
+
+struct FileMemoryUpdate
+{
+  u32 fifoPosition;
+  u32 address;
+  u64 dataOffset;
+  u32 dataSize;
+  u8 type;
+  u8 reserved[3];
+};
+static_assert(sizeof(FileMemoryUpdate) == 24);
+
+#pragma pack(pop)
+
+constexpr u32 FILE_ID = 0x0d01f1f0;
+
+class TempDir final
+{
+public:
+  TempDir() : m_path(File::CreateTempDir()) {}
+  ~TempDir()
+  {
+    if (!m_path.empty())
+      File::DeleteDirRecursively(m_path);
+  }
+  bool Exists() const { return !m_path.empty(); }
+  std::string GetPath(const std::string& name) const { return m_path + "/" + name; }
+
+private:
+  std::string m_path;
+};
+
+std::vector<u8> MakeData(size_t size, u32 seed)
+{
+  // Pseudo-random, so the data doesn't compress and deduplication shows in the file size.
+  std::vector<u8> data(size);
+  u32 state = seed;
+  for (u8& byte : data)
+  {
+    state = state * 1664525 + 1013904223;
+    byte = static_cast<u8>(state >> 24);
+  }
+  return data;
+}
+
+FifoFrameInfo MakeFrame(u32 frame, const std::vector<u8>& shared_update)
+{
+  FifoFrameInfo info;
+  info.fifoData = MakeData(100 + frame * 10, frame);
+  info.fifoStart = 0x00100000 + frame;
+  info.fifoEnd = 0x00200000 + frame;
+
+  MemoryUpdate small_update;
+  small_update.fifoPosition = 4;
+  small_update.address = 0x00300000 + frame * 0x20;
+  small_update.data = MakeData(32, frame + 1000);
+  small_update.type = MemoryUpdate::Type::XFData;
+  info.memoryUpdates.push_back(std::move(small_update));
+
+  MemoryUpdate large_update;
+  large_update.fifoPosition = 50;
+  large_update.address = 0x00400000;
+  large_update.data = shared_update;
+  large_update.type = MemoryUpdate::Type::TextureMap;
+  info.memoryUpdates.push_back(std::move(large_update));
+
+  return info;
+}
+
+void ExpectSameFrame(const FifoFrameInfo& expected, const FifoFrameInfo& actual)
+{
+  EXPECT_EQ(expected.fifoData, actual.fifoData);
+  EXPECT_EQ(expected.fifoStart, actual.fifoStart);
+  EXPECT_EQ(expected.fifoEnd, actual.fifoEnd);
+  ASSERT_EQ(expected.memoryUpdates.size(), actual.memoryUpdates.size());
+  for (size_t i = 0; i < expected.memoryUpdates.size(); ++i)
+  {
+    EXPECT_EQ(expected.memoryUpdates[i].fifoPosition, actual.memoryUpdates[i].fifoPosition);
+    EXPECT_EQ(expected.memoryUpdates[i].address, actual.memoryUpdates[i].address);
+    EXPECT_EQ(expected.memoryUpdates[i].type, actual.memoryUpdates[i].type);
+    EXPECT_EQ(expected.memoryUpdates[i].data, actual.memoryUpdates[i].data);
+  }
+}
+
+std::vector<FifoFrameInfo> MakeFrames(u32 count)
+{
+  const std::vector<u8> shared_update = MakeData(0x10000, 12345);
+  std::vector<FifoFrameInfo> frames;
+  for (u32 i = 0; i < count; ++i)
+    frames.push_back(MakeFrame(i, shared_update));
+  return frames;
+}
+
+std::unique_ptr<FifoDataFile> MakeFile(const std::vector<FifoFrameInfo>& frames, bool deduplicate)
+{
+  auto file = std::make_unique<FifoDataFile>();
+  file->SetIsWii(true);
+  file->SetDeduplicateMemoryUpdates(deduplicate);
+  for (u32 i = 0; i < FifoDataFile::BP_MEM_SIZE; ++i)
+    file->GetBPMem()[i] = i * 3;
+  for (u32 i = 0; i < FifoDataFile::XF_REGS_SIZE; ++i)
+    file->GetXFRegs()[i] = i * 5;
+  file->GetTexMem()[1234] = 0x56;
+  for (const FifoFrameInfo& frame : frames)
+    file->AddFrame(frame);
+  return file;
+}
+}  // namespace
+
+TEST(FifoDataFile, RoundTrip)
+{
+  TempDir dir;
+  ASSERT_TRUE(dir.Exists());
+
+  const std::vector<FifoFrameInfo> frames = MakeFrames(5);
+  const auto file = MakeFile(frames, false);
+  ASSERT_EQ(frames.size(), file->GetFrameCount());
+  // Frames can be read back before they were saved, whether they were compressed yet or not.
+  ExpectSameFrame(frames[4], *file->GetFrame(4));
+  ASSERT_TRUE(file->Save(dir.GetPath("log.dff")));
+
+  const auto loaded = FifoDataFile::Load(dir.GetPath("log.dff"), false);
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(loaded->GetIsWii());
+  EXPECT_EQ(6u, loaded->GetBPMem()[2]);
+  EXPECT_EQ(10u, loaded->GetXFRegs()[2]);
+  EXPECT_EQ(0x56, loaded->GetTexMem()[1234]);
+  ASSERT_EQ(frames.size(), loaded->GetFrameCount());
+  for (u32 i = 0; i < frames.size(); ++i)
+  {
+    EXPECT_EQ(frames[i].fifoData.size(), loaded->GetFrameFifoSize(i));
+    EXPECT_EQ(32u + 0x10000u, loaded->GetFrameMemoryUpdateSize(i));
+    const auto frame = loaded->GetFrame(i);
+    ASSERT_TRUE(frame);
+    ExpectSameFrame(frames[i], *frame);
+  }
+
+  // Saving a loaded file copies its chunks.
+  ASSERT_TRUE(loaded->Save(dir.GetPath("copy.dff")));
+  const auto copy = FifoDataFile::Load(dir.GetPath("copy.dff"), false);
+  ASSERT_TRUE(copy);
+  ASSERT_EQ(frames.size(), copy->GetFrameCount());
+  ExpectSameFrame(frames[3], *copy->GetFrame(3));
+}
+
+TEST(FifoDataFile, DeduplicatedMemoryUpdates)
+{
+  TempDir dir;
+  ASSERT_TRUE(dir.Exists());
+
+  const std::vector<FifoFrameInfo> frames = MakeFrames(8);
+  ASSERT_TRUE(MakeFile(frames, false)->Save(dir.GetPath("plain.dff")));
+  ASSERT_TRUE(MakeFile(frames, true)->Save(dir.GetPath("dedup.dff")));
+
+  // The 64 KiB update shared by every frame is only stored once.
+  const u64 plain_size = File::GetSize(dir.GetPath("plain.dff"));
+  const u64 dedup_size = File::GetSize(dir.GetPath("dedup.dff"));
+  EXPECT_GE(plain_size, dedup_size + 6 * 0x10000);
+
+  const auto loaded = FifoDataFile::Load(dir.GetPath("dedup.dff"), false);
+  ASSERT_TRUE(loaded);
+  ASSERT_EQ(frames.size(), loaded->GetFrameCount());
+  for (u32 i = 0; i < frames.size(); ++i)
+  {
+    const auto frame = loaded->GetFrame(i);
+    ASSERT_TRUE(frame);
+    ExpectSameFrame(frames[i], *frame);
+  }
+
+  // The blobs are carried over when a loaded file is saved again.
+  ASSERT_TRUE(loaded->Save(dir.GetPath("copy.dff")));
+  EXPECT_EQ(dedup_size, File::GetSize(dir.GetPath("copy.dff")));
+  const auto copy = FifoDataFile::Load(dir.GetPath("copy.dff"), false);
+  ASSERT_TRUE(copy);
+  ExpectSameFrame(frames[7], *copy->GetFrame(7));
+}
+
+TEST(FifoDataFile, LoadVersion5)
+{
+  TempDir dir;
+  ASSERT_TRUE(dir.Exists());
+
+  const std::vector<FifoFrameInfo> frames = MakeFrames(3);
+  const std::string path = dir.GetPath("v5.dff");
+  {
+    File::IOFile out(path, "wb");
+    ASSERT_TRUE(out);
+
+    FileHeader header{};
+    out.WriteBytes(&header, sizeof(header));
+
+    std::vector<u32> bp_mem(FifoDataFile::BP_MEM_SIZE, 0x11);
+    header.bpMemOffset = out.Tell();
+    header.bpMemSize = FifoDataFile::BP_MEM_SIZE;
+    out.WriteArray(bp_mem.data(), bp_mem.size());
+
+    std::vector<u32> cp_mem(FifoDataFile::CP_MEM_SIZE, 0x22);
+    header.cpMemOffset = out.Tell();
+    header.cpMemSize = FifoDataFile::CP_MEM_SIZE;
+    out.WriteArray(cp_mem.data(), cp_mem.size());
+
+    std::vector<u32> xf_mem(FifoDataFile::XF_MEM_SIZE, 0x33);
+    header.xfMemOffset = out.Tell();
+    header.xfMemSize = FifoDataFile::XF_MEM_SIZE;
+    out.WriteArray(xf_mem.data(), xf_mem.size());
+
+    std::vector<u32> xf_regs(FifoDataFile::XF_REGS_SIZE, 0x44);
+    header.xfRegsOffset = out.Tell();
+    header.xfRegsSize = FifoDataFile::XF_REGS_SIZE;
+    out.WriteArray(xf_regs.data(), xf_regs.size());
+
+    std::vector<u8> tex_mem(FifoDataFile::TEX_MEM_SIZE, 0x55);
+    header.texMemOffset = out.Tell();
+    header.texMemSize = FifoDataFile::TEX_MEM_SIZE;
+    out.WriteArray(tex_mem.data(), tex_mem.size());
+
+    // Version 5 stores every frame uncompressed: the FIFO data, the memory update list and the
+    // data of each update are written separately.
+    std::vector<FileFrameInfo> frame_list(frames.size());
+    for (size_t i = 0; i < frames.size(); ++i)
+    {
+      const FifoFrameInfo& src = frames[i];
+      FileFrameInfo& dst = frame_list[i];
+      dst = {};
+      dst.fifoDataOffset = out.Tell();
+      dst.fifoDataSize = static_cast<u32>(src.fifoData.size());
+      dst.fifoStart = src.fifoStart;
+      dst.fifoEnd = src.fifoEnd;
+      out.WriteBytes(src.fifoData.data(), src.fifoData.size());
+
+      std::vector<FileMemoryUpdate> updates(src.memoryUpdates.size());
+      for (size_t j = 0; j < updates.size(); ++j)
+      {
+        updates[j] = {};
+        updates[j].fifoPosition = src.memoryUpdates[j].fifoPosition;
+        updates[j].address = src.memoryUpdates[j].address;
+        updates[j].dataOffset = out.Tell();
+        updates[j].dataSize = static_cast<u32>(src.memoryUpdates[j].data.size());
+        updates[j].type = static_cast<u8>(src.memoryUpdates[j].type);
+        out.WriteBytes(src.memoryUpdates[j].data.data(), src.memoryUpdates[j].data.size());
+      }
+      dst.memoryUpdatesOffset = out.Tell();
+      dst.numMemoryUpdates = static_cast<u32>(updates.size());
+      out.WriteArray(updates.data(), updates.size());
+    }
+
+    header.frameListOffset = out.Tell();
+    header.frameCount = static_cast<u32>(frame_list.size());
+    out.WriteArray(frame_list.data(), frame_list.size());
+
+    auto& memory = Core::System::GetInstance().GetMemory();
+    header.fileId = FILE_ID;
+    header.file_version = 5;
+    header.min_loader_version = 1;
+    header.flags = 1;
+    header.mem1_size = memory.GetRamSizeReal();
+    header.mem2_size = memory.GetExRamSizeReal();
+    out.Seek(0, File::SeekOrigin::Begin);
+    out.WriteBytes(&header, sizeof(header));
+    ASSERT_TRUE(out.Close());
+  }
+
+  const auto loaded = FifoDataFile::Load(path, false);
+  ASSERT_TRUE(loaded);
+  EXPECT_TRUE(loaded->GetIsWii());
+  EXPECT_EQ(0x11u, loaded->GetBPMem()[7]);
+  EXPECT_EQ(0x22u, loaded->GetCPMem()[7]);
+  EXPECT_EQ(0x33u, loaded->GetXFMem()[7]);
+  EXPECT_EQ(0x44u, loaded->GetXFRegs()[7]);
+  EXPECT_EQ(0x55, loaded->GetTexMem()[7]);
+  ASSERT_EQ(frames.size(), loaded->GetFrameCount());
+  for (u32 i = 0; i < frames.size(); ++i)
+  {
+    EXPECT_EQ(frames[i].fifoData.size(), loaded->GetFrameFifoSize(i));
+    EXPECT_EQ(32u + 0x10000u, loaded->GetFrameMemoryUpdateSize(i));
+    const auto frame = loaded->GetFrame(i);
+    ASSERT_TRUE(frame);
+    ExpectSameFrame(frames[i], *frame);
+  }
+
+  // Saving converts the file to the current version.
+  ASSERT_TRUE(loaded->Save(dir.GetPath("v6.dff")));
+  const auto converted = FifoDataFile::Load(dir.GetPath("v6.dff"), false);
+  ASSERT_TRUE(converted);
+  ASSERT_EQ(frames.size(), converted->GetFrameCount());
+  ExpectSameFrame(frames[1], *converted->GetFrame(1));
+}
+
+TEST(FifoDataFile, CorruptFrameFailsToLoad)
+{
+  TempDir dir;
+  ASSERT_TRUE(dir.Exists());
+
+  const std::vector<FifoFrameInfo> frames = MakeFrames(2);
+  const std::string path = dir.GetPath("log.dff");
+  ASSERT_TRUE(MakeFile(frames, false)->Save(path));
+
+  // Overwrite the start of the first chunk, so it isn't a zstd frame anymore.
+  {
+    File::IOFile file(path, "r+b");
+    FileHeader header;
+    ASSERT_TRUE(file.ReadBytes(&header, sizeof(header)));
+    u64 chunk_offset;
+    ASSERT_TRUE(file.Seek(header.frameListOffset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.ReadBytes(&chunk_offset, sizeof(chunk_offset)));
+    const std::vector<u8> garbage(16, 0xff);
+    ASSERT_TRUE(file.Seek(chunk_offset, File::SeekOrigin::Begin));
+    ASSERT_TRUE(file.WriteBytes(garbage.data(), garbage.size()));
+  }
+
+  const auto loaded = FifoDataFile::Load(path, false);
+  ASSERT_TRUE(loaded);
+  EXPECT_FALSE(loaded->GetFrame(0));
+  const auto frame = loaded->GetFrame(1);
+  ASSERT_TRUE(frame);
+  ExpectSameFrame(frames[1], *frame);
+}
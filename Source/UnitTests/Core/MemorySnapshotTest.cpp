@@ -0,0 +1,205 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Common/CommonTypes.h"
+#include "Common/Config/Config.h"
+#include "Common/FileUtil.h"
+#include "Common/Swap.h"
+#include "Core/ConfigManager.h"
+#include "Core/Core.h"
+#include "Core/CoreTiming.h"
+#include "Core/HW/Memmap.h"
+#include "Core/HW/MemorySnapshot.h"
+#include "Core/PowerPC/Gekko.h"
+#include "Core/PowerPC/MMU.h"
+#include "Core/PowerPC/PowerPC.h"
+#include "Core/System.h"
+#include "UICommon/UICommon.h"
+
+namespace
+{
+constexpr u32 PAGE_A = 0x00200000;
+
+class ScopeInit final
+{
+public:
+  explicit ScopeInit(Core::System& system) : m_system(system), m_profile_path(File::CreateTempDir())
+  {
+    if (!UserDirectoryExists())
+      return;
+    Core::DeclareAsCPUThread();
+    UICommon::SetUserDirectory(m_profile_path);
+    Config::Init();
+    SConfig::Init();
+    system.GetMemory().Init();
+    system.GetPowerPC().Init(PowerPC::CPUCore::Interpreter);
+    system.GetCoreTiming().Init();
+  }
+  ~ScopeInit()
+  {
+    if (!UserDirectoryExists())
+      return;
+    m_system.GetCoreTiming().Shutdown();
+    m_system.GetPowerPC().Shutdown();
+    m_system.GetMemory().Shutdown();
+    SConfig::Shutdown();
+    Config::Shutdown();
+    Core::UndeclareAsCPUThread();
+    File::DeleteDirRecursively(m_profile_path);
+  }
+  bool UserDirectoryExists() const { return !m_profile_path.empty(); }
+
+private:
+  Core::System& m_system;
+  std::string m_profile_path;
+};
+
+void Update(Core::System& system)
+{
+  const Core::CPUThreadGuard guard(system);
+  system.GetMemory().GetSnapshot().Update(guard);
+}
+}  // namespace
+
+TEST(MemorySnapshot, CaptureAndRead)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& memory = system.GetMemory();
+  auto& snapshot = memory.GetSnapshot();
+  EXPECT_FALSE(snapshot.Acquire().IsValid());
+
+  // Nothing is captured until a range is registered.
+  Update(system);
+  EXPECT_FALSE(snapshot.Acquire().IsValid());
+
+  // The range spans a page boundary.
+  const auto id = snapshot.AddRange(PAGE_A + 0xff8, 0x10);
+  EXPECT_TRUE(snapshot.HasRanges());
+  memory.Write_U32(0x12345678, PAGE_A + 0xff8);
+  memory.Write_U64(0x0123456789abcdef, PAGE_A + 0xffc);
+  Update(system);
+
+  const auto view = snapshot.Acquire();
+  EXPECT_TRUE(view.IsValid());
+  EXPECT_NE(0u, view.GetFrame());
+  EXPECT_EQ(0x12345678u, view.Read<u32>(PAGE_A + 0xff8));
+  EXPECT_EQ(0x0123456789abcdefu, view.Read<u64>(PAGE_A + 0xffc));
+  EXPECT_EQ(u8(0xef), view.Read<u8>(PAGE_A + 0x1003));
+  bool translated = true;
+  u32 value = 0;
+  EXPECT_TRUE(view.Read(PAGE_A + 0xff8, &value, sizeof(value),
+                        PowerPC::RequestedAddressSpace::Physical, &translated));
+  EXPECT_FALSE(translated);
+
+  // Reads have to be fully covered by a range of the same address space.
+  EXPECT_FALSE(view.Read<u32>(PAGE_A + 0xff4));
+  EXPECT_FALSE(view.Read<u64>(PAGE_A + 0x1004));
+  EXPECT_FALSE(view.Read<u32>(PAGE_A + 0xff8, PowerPC::RequestedAddressSpace::Effective));
+
+  snapshot.RemoveRange(id);
+  EXPECT_FALSE(snapshot.HasRanges());
+}
+
+TEST(MemorySnapshot, RefreshKeepsPinnedViews)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& memory = system.GetMemory();
+  auto& snapshot = memory.GetSnapshot();
+  const auto id = snapshot.AddRange(PAGE_A, 4);
+
+  memory.Write_U32(1, PAGE_A);
+  Update(system);
+  auto first = snapshot.Acquire();
+
+  memory.Write_U32(2, PAGE_A);
+  Update(system);
+  auto second = snapshot.Acquire();
+
+  // Pinned copies stay untouched by later updates.
+  memory.Write_U32(3, PAGE_A);
+  Update(system);
+  const auto third = snapshot.Acquire();
+  EXPECT_EQ(1u, first.Read<u32>(PAGE_A));
+  EXPECT_EQ(2u, second.Read<u32>(PAGE_A));
+  EXPECT_EQ(3u, third.Read<u32>(PAGE_A));
+  EXPECT_EQ(first.GetFrame() + 2, third.GetFrame());
+
+  // With every copy pinned, the update is skipped rather than waiting for the readers.
+  memory.Write_U32(4, PAGE_A);
+  Update(system);
+  EXPECT_EQ(third.GetFrame(), snapshot.Acquire().GetFrame());
+  EXPECT_EQ(3u, snapshot.Acquire().Read<u32>(PAGE_A));
+
+  first = {};
+  Update(system);
+  EXPECT_EQ(third.GetFrame() + 1, snapshot.Acquire().GetFrame());
+  EXPECT_EQ(4u, snapshot.Acquire().Read<u32>(PAGE_A));
+  EXPECT_EQ(2u, second.Read<u32>(PAGE_A));
+
+  // Removed ranges aren't captured anymore.
+  second = {};
+  snapshot.RemoveRange(id);
+  Update(system);
+  EXPECT_EQ(4u, snapshot.Acquire().Read<u32>(PAGE_A));
+  const auto other_id = snapshot.AddRange(PAGE_A + 4, 4);
+  Update(system);
+  EXPECT_FALSE(snapshot.Acquire().Read<u32>(PAGE_A));
+  EXPECT_TRUE(snapshot.Acquire().Read<u32>(PAGE_A + 4));
+  snapshot.RemoveRange(other_id);
+}
+
+TEST(MemorySnapshot, EffectiveAddressRanges)
+{
+  auto& system = Core::System::GetInstance();
+  ScopeInit guard(system);
+  ASSERT_TRUE(guard.UserDirectoryExists());
+
+  auto& memory = system.GetMemory();
+  auto& ppc_state = system.GetPPCState();
+  auto& snapshot = memory.GetSnapshot();
+
+  // Map the 128 KiB block at 0x80000000 to PAGE_A.
+  UReg_BAT_Up batu;
+  batu.BEPI = 0x80000000 >> PowerPC::BAT_INDEX_SHIFT;
+  batu.VS = 1;
+  batu.VP = 1;
+  UReg_BAT_Lo batl;
+  batl.BRPN = PAGE_A >> PowerPC::BAT_INDEX_SHIFT;
+  batl.PP = 2;
+  ppc_state.spr[SPR_DBAT0U] = batu.Hex;
+  ppc_state.spr[SPR_DBAT0L] = batl.Hex;
+  system.GetMMU().DBATUpdated();
+
+  const auto id = snapshot.AddRange(0x80000010, 4, PowerPC::RequestedAddressSpace::Effective);
+  memory.Write_U32(0xcafef00d, PAGE_A + 0x10);
+
+  ppc_state.msr.DR = 1;
+  Update(system);
+  {
+    const auto view = snapshot.Acquire();
+    bool translated = false;
+    u32 value = 0;
+    EXPECT_TRUE(view.Read(0x80000010, &value, sizeof(value),
+                          PowerPC::RequestedAddressSpace::Effective, &translated));
+    EXPECT_EQ(0xcafef00du, Common::swap32(value));
+    EXPECT_TRUE(translated);
+    EXPECT_FALSE(view.Read<u32>(0x80000010, PowerPC::RequestedAddressSpace::Physical));
+  }
+
+  // Without translation, 0x80000000 isn't backed by memory, so the range can't be captured.
+  ppc_state.msr.DR = 0;
+  Update(system);
+  EXPECT_FALSE(
+      snapshot.Acquire().Read<u32>(0x80000010, PowerPC::RequestedAddressSpace::Effective));
+  snapshot.RemoveRange(id);
+}
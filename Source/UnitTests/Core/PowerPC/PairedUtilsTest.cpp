@@ -0,0 +1,113 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Core/PowerPC/Interpreter/Interpreter_PairedUtils.h"
+
+#include "TestValues.h"
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+namespace
+{
+// Same values as the GQR scale tables: 2^0 .. 2^31 followed by 2^-32 .. 2^-1
+float QuantizeScale(u32 scale)
+{
+  return std::ldexp(1.0f, scale < 32 ? int(scale) : int(scale) - 64);
+}
+
+float DequantizeScale(u32 scale)
+{
+  return 1.0f / QuantizeScale(scale);
+}
+
+std::vector<double> MakeQuantizeInputs()
+{
+  std::vector<double> inputs;
+  for (const u64 value : double_test_values)
+  {
+    // Converting a NaN to an integer is undefined behavior in the scalar reference
+    if (!std::isnan(std::bit_cast<double>(value)))
+      inputs.push_back(std::bit_cast<double>(value));
+  }
+
+  std::mt19937_64 rng(0x5EED);
+  std::uniform_real_distribution<double> small(-70000.0, 70000.0);
+  std::uniform_int_distribution<u64> bits;
+  for (int i = 0; i < 2000; ++i)
+  {
+    inputs.push_back(small(rng));
+    inputs.push_back(std::round(small(rng)) + 0.5);
+
+    const double random = std::bit_cast<double>(bits(rng));
+    if (!std::isnan(random))
+      inputs.push_back(random);
+  }
+  return inputs;
+}
+
+template <typename SType>
+void TestQuantize()
+{
+  const std::vector<double> inputs = MakeQuantizeInputs();
+  for (u32 scale_index = 0; scale_index < 64; ++scale_index)
+  {
+    const float scale = QuantizeScale(scale_index);
+    for (size_t i = 0; i + 1 < inputs.size(); ++i)
+    {
+      const auto expected = QuantizePairScalar<SType>(inputs[i], inputs[i + 1], scale);
+      const auto actual = QuantizePair<SType>(inputs[i], inputs[i + 1], scale);
+
+      EXPECT_EQ(expected, actual) << fmt::format("ps0={} ps1={} scale={}", inputs[i],
+                                                 inputs[i + 1], scale_index);
+    }
+  }
+}
+
+template <typename SType>
+void TestDequantize()
+{
+  using U = std::make_unsigned_t<SType>;
+
+  std::mt19937 rng(0x5EED);
+  std::uniform_int_distribution<u32> dist(0, std::numeric_limits<U>::max());
+  for (u32 scale_index = 0; scale_index < 64; ++scale_index)
+  {
+    const float scale = DequantizeScale(scale_index);
+    for (u32 i = 0; i <= std::numeric_limits<U>::max(); ++i)
+    {
+      const SType first = SType(U(i));
+      const SType second = SType(U(dist(rng)));
+      const auto expected = DequantizePairScalar<SType>(first, second, scale);
+      const auto actual = DequantizePair<SType>(first, second, scale);
+
+      EXPECT_EQ(std::bit_cast<u64>(expected.first), std::bit_cast<u64>(actual.first));
+      EXPECT_EQ(std::bit_cast<u64>(expected.second), std::bit_cast<u64>(actual.second));
+    }
+  }
+}
+}  // namespace
+
+TEST(PairedUtils, Quantize)
+{
+  TestQuantize<u8>();
+  TestQuantize<s8>();
+  TestQuantize<u16>();
+  TestQuantize<s16>();
+}
+
+TEST(PairedUtils, Dequantize)
+{
+  TestDequantize<u8>();
+  TestDequantize<s8>();
+  TestDequantize<u16>();
+  TestDequantize<s16>();
+}
@@ -0,0 +1,206 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/Event.h"
+#include "VideoCommon/AsyncShaderCompiler.h"
+
+using VideoCommon::AsyncShaderCompiler;
+
+namespace
+{
+// Records the order in which the synthetic work items were compiled and retrieved.
+struct Log
+{
+  std::mutex lock;
+  std::vector<u32> compiled;
+  std::vector<u32> retrieved;
+};
+
+class TestWorkItem final : public AsyncShaderCompiler::WorkItem
+{
+public:
+  TestWorkItem(Log* log_, u32 id_, Common::Event* gate_ = nullptr, u32 spin_iterations_ = 0)
+      : log(log_), id(id_), gate(gate_), spin_iterations(spin_iterations_)
+  {
+  }
+
+  bool Compile() override
+  {
+    if (gate)
+      gate->Wait();
+
+    // Stands in for the driver's compile time.
+    volatile u32 value = 0;
+    for (u32 i = 0; i < spin_iterations; i++)
+      value = value + i;
+
+    std::lock_guard<std::mutex> guard(log->lock);
+    log->compiled.push_back(id);
+    return true;
+  }
+
+  void Retrieve() override { log->retrieved.push_back(id); }
+
+private:
+  Log* log;
+  u32 id;
+  Common::Event* gate;
+  u32 spin_iterations;
+};
+
+void WaitForWork(AsyncShaderCompiler& compiler)
+{
+  while (compiler.HasPendingWork() || compiler.HasCompletedWork())
+  {
+    compiler.RetrieveWorkItems();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+}
+
+// Queues an item which blocks the worker until the returned event is set, and waits for it to
+// be started.
+void BlockWorker(AsyncShaderCompiler& compiler, Log* log, Common::Event* gate)
+{
+  compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(log, 0, gate), 0);
+  while (compiler.GetQueueStatistics()[0].num_items == 0)
+    std::this_thread::yield();
+}
+}  // namespace
+
+TEST(AsyncShaderCompiler, CompilesSynchronouslyWithoutWorkers)
+{
+  Log log;
+  AsyncShaderCompiler compiler;
+  compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, 1), 2);
+  EXPECT_EQ(std::vector<u32>{1}, log.compiled);
+  EXPECT_TRUE(compiler.HasCompletedWork());
+  compiler.RetrieveWorkItems();
+  EXPECT_EQ(std::vector<u32>{1}, log.retrieved);
+}
+
+TEST(AsyncShaderCompiler, PriorityLanes)
+{
+  Log log;
+  Common::Event gate;
+  AsyncShaderCompiler compiler;
+  ASSERT_TRUE(compiler.StartWorkerThreads(1));
+  BlockWorker(compiler, &log, &gate);
+
+  // Precompile work queued first is still started after work needed for the current frame.
+  for (u32 id = 1; id <= 3; id++)
+    compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, id), 2);
+  for (u32 id = 4; id <= 6; id++)
+    compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, id), 1);
+  // Priorities past the last lane share it.
+  compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, 7), 100);
+  compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, 8), 0);
+
+  gate.Set();
+  WaitForWork(compiler);
+  compiler.StopWorkerThreads();
+
+  EXPECT_EQ((std::vector<u32>{0, 8, 4, 5, 6, 1, 2, 3, 7}), log.compiled);
+  EXPECT_EQ(log.compiled, log.retrieved);
+
+  const auto statistics = compiler.GetQueueStatistics();
+  EXPECT_EQ(2u, statistics[0].num_items);
+  EXPECT_EQ(3u, statistics[1].num_items);
+  EXPECT_EQ(4u, statistics[2].num_items);
+  EXPECT_GE(statistics[2].total_wait, statistics[2].max_wait);
+  EXPECT_GE(statistics[2].max_wait, statistics[1].max_wait);
+
+  compiler.ResetQueueStatistics();
+  EXPECT_EQ(0u, compiler.GetQueueStatistics()[2].num_items);
+}
+
+TEST(AsyncShaderCompiler, CancelPendingWork)
+{
+  Log log;
+  Common::Event gate;
+  AsyncShaderCompiler compiler;
+  ASSERT_TRUE(compiler.StartWorkerThreads(1));
+  BlockWorker(compiler, &log, &gate);
+
+  for (u32 id = 1; id <= 10; id++)
+    compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, id), id % 3);
+  compiler.CancelPendingWork();
+
+  // The item which was already started finishes, but isn't retrieved.
+  gate.Set();
+  WaitForWork(compiler);
+  EXPECT_EQ(std::vector<u32>{0}, log.compiled);
+  EXPECT_TRUE(log.retrieved.empty());
+
+  // Work queued afterwards is unaffected.
+  compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, 11), 1);
+  WaitForWork(compiler);
+  compiler.StopWorkerThreads();
+  EXPECT_EQ((std::vector<u32>{0, 11}), log.compiled);
+  EXPECT_EQ(std::vector<u32>{11}, log.retrieved);
+}
+
+TEST(AsyncShaderCompiler, ResizeKeepsPendingWork)
+{
+  Log log;
+  Common::Event gate;
+  AsyncShaderCompiler compiler;
+  ASSERT_TRUE(compiler.StartWorkerThreads(1));
+  BlockWorker(compiler, &log, &gate);
+
+  for (u32 id = 1; id <= 20; id++)
+    compiler.QueueWorkItem(AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, id), 1);
+
+  // Stopping lets the blocked item finish, and leaves the rest queued.
+  std::thread release([&gate] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    gate.Set();
+  });
+  ASSERT_TRUE(compiler.ResizeWorkerThreads(3));
+  release.join();
+
+  WaitForWork(compiler);
+  compiler.StopWorkerThreads();
+  EXPECT_EQ(21u, log.retrieved.size());
+}
+
+TEST(AsyncShaderCompiler, SyntheticWorkload)
+{
+  constexpr u32 NUM_ITEMS = 2000;
+
+  Log log;
+  AsyncShaderCompiler compiler;
+  ASSERT_TRUE(compiler.StartWorkerThreads(4));
+
+  // Like a game switch, where lots of ubershader and shader cache pipelines are queued at once,
+  // followed by the pipelines needed for the first frames.
+  for (u32 id = 0; id < NUM_ITEMS; id++)
+  {
+    compiler.QueueWorkItem(
+        AsyncShaderCompiler::CreateWorkItem<TestWorkItem>(&log, id, nullptr, 2000 + id % 7 * 1000),
+        id < NUM_ITEMS - 50 ? 1 + id % 2 : 0);
+  }
+
+  WaitForWork(compiler);
+  compiler.StopWorkerThreads();
+
+  ASSERT_EQ(NUM_ITEMS, log.retrieved.size());
+  std::vector<bool> seen(NUM_ITEMS);
+  for (const u32 id : log.retrieved)
+  {
+    EXPECT_FALSE(seen[id]);
+    seen[id] = true;
+  }
+
+  const auto statistics = compiler.GetQueueStatistics();
+  EXPECT_EQ(NUM_ITEMS, statistics[0].num_items + statistics[1].num_items + statistics[2].num_items);
+  EXPECT_EQ(50u, statistics[0].num_items);
+}
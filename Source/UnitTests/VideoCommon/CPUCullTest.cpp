@@ -0,0 +1,156 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
+#include "Core/System.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/CPUCull.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VertexLoaderBase.h"
+#include "VideoCommon/VertexShaderManager.h"
+#include "VideoCommon/XFMemory.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u32 NUM_WORKERS = 3;
+constexpr u32 MAX_VERTICES = 65532;
+}  // namespace
+
+class CPUCullTest : public ::testing::TestWithParam<Primitive>
+{
+protected:
+  void SetUp() override
+  {
+    // Identity matrices, so the positions are in clip space already.
+    auto& vertex_shader_manager = Core::System::GetInstance().GetVertexShaderManager();
+    vertex_shader_manager.Init();
+    xfmem.projection.type = ProjectionType::Orthographic;
+    xfmem.projection.rawProjection = {1.0f, 0.0f, 1.0f, 0.0f, 1.0f, 0.0f};
+    for (size_t i = 0; i < vertex_shader_manager.constants.projection.size(); i++)
+    {
+      vertex_shader_manager.constants.projection[i] = {};
+      vertex_shader_manager.constants.projection[i][i] = 1.0f;
+    }
+    std::fill(std::begin(xfmem.posMatrices), std::end(xfmem.posMatrices), 0.0f);
+    xfmem.posMatrices[0] = xfmem.posMatrices[5] = xfmem.posMatrices[10] = 1.0f;
+    g_main_cp_state.matrix_index_a.PosNormalMtxIdx = 0;
+    xfmem.viewport.ht = 0.0f;
+    bpmem.genMode.cullmode = CullMode::None;
+
+    TVtxDesc vtx_desc{};
+    vtx_desc.low.Position = VertexComponentFormat::Direct;
+    VAT vtx_attr{};
+    vtx_attr.g0.PosFormat = ComponentFormat::Float;
+    vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+    m_loader = VertexLoaderBase::CreateVertexLoader(vtx_desc, vtx_attr);
+
+    m_workers.Reset("CPU Cull Test", NUM_WORKERS);
+    m_serial_cull.Init(nullptr);
+    m_parallel_cull.Init(&m_workers);
+  }
+
+  // Places all vertices right of the screen, except for one triangle.
+  void SetVertices(u32 count, std::optional<u32> visible_vertex)
+  {
+    // The transform loads 16 bytes per vertex.
+    m_positions.assign(count * 3 + 1, 0.0f);
+    for (u32 i = 0; i < count; i++)
+    {
+      m_positions[i * 3 + 0] = 2.0f + (i % 7) * 0.25f;
+      m_positions[i * 3 + 1] = (i % 5) * 0.25f - 0.5f;
+      m_positions[i * 3 + 2] = 0.5f;
+    }
+
+    if (visible_vertex)
+    {
+      static constexpr float triangle[] = {-0.5f, -0.5f, 0.5f,  //
+                                           0.5f,  -0.5f, 0.5f,  //
+                                           0.0f,  0.5f,  0.5f};
+      std::copy(std::begin(triangle), std::end(triangle),
+                m_positions.begin() + *visible_vertex * 3);
+    }
+  }
+
+  bool AreAllVerticesCulled(bool parallel, u32 count)
+  {
+    CPUCull& cull = parallel ? m_parallel_cull : m_serial_cull;
+    return cull.AreAllVerticesCulled(m_loader.get(), GetParam(),
+                                     reinterpret_cast<const u8*>(m_positions.data()), count);
+  }
+
+  std::unique_ptr<VertexLoaderBase> m_loader;
+  std::vector<float> m_positions;
+  Common::WorkerPool m_workers;
+  CPUCull m_serial_cull;
+  CPUCull m_parallel_cull;
+};
+
+INSTANTIATE_TEST_SUITE_P(Primitives, CPUCullTest,
+                         ::testing::Values(Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_TRIANGLES,
+                                           Primitive::GX_DRAW_TRIANGLE_STRIP,
+                                           Primitive::GX_DRAW_TRIANGLE_FAN));
+
+TEST_P(CPUCullTest, FindsVisibleTriangle)
+{
+  for (const u32 count : {12u, 1536u, 9996u, MAX_VERTICES})
+  {
+    // Around the chunk boundaries, and anywhere in the later chunks.
+    for (const std::optional<u32> visible_vertex :
+         {std::optional<u32>(), std::optional<u32>(0), std::optional<u32>(1533),
+          std::optional<u32>(1534), std::optional<u32>(1535), std::optional<u32>(count / 2),
+          std::optional<u32>(count - 3)})
+    {
+      if (visible_vertex && *visible_vertex + 3 > count)
+        continue;
+
+      SetVertices(count, visible_vertex);
+      for (const bool parallel : {false, true})
+      {
+        EXPECT_EQ(!visible_vertex, AreAllVerticesCulled(parallel, count))
+            << "vertices: " << count << ", visible: " << visible_vertex.value_or(-1)
+            << ", parallel: " << parallel;
+      }
+    }
+  }
+
+  bpmem.genMode.cullmode = CullMode::All;
+  SetVertices(MAX_VERTICES, MAX_VERTICES / 2);
+  EXPECT_TRUE(AreAllVerticesCulled(true, MAX_VERTICES));
+}
+
+TEST_P(CPUCullTest, Speed)
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr int ITERATIONS = 500;
+
+  const auto measure = [&](const char* name) {
+    for (const bool parallel : {false, true})
+    {
+      const auto start = Clock::now();
+      for (int i = 0; i < ITERATIONS; ++i)
+        AreAllVerticesCulled(parallel, MAX_VERTICES);
+      const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+      fmt::print("primitive: {}, {}, workers: {}: {:.1f} us per draw\n", GetParam(), name,
+                 parallel ? NUM_WORKERS : 0, seconds / ITERATIONS * 1e6);
+    }
+  };
+
+  SetVertices(MAX_VERTICES, std::nullopt);
+  measure("culled");
+  SetVertices(MAX_VERTICES, 0);
+  measure("visible");
+}
@@ -0,0 +1,130 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "VideoCommon/Assets/CustomAssetLibrary.h"
+#include "VideoCommon/Assets/CustomAssetLoader.h"
+#include "VideoCommon/Assets/TextureAsset.h"
+
+namespace
+{
+constexpr std::size_t TEXTURE_SIZE = 100;
+
+// Every texture is a single RGBA8 pixel, which counts as TEXTURE_SIZE bytes
+class TestAssetLibrary final : public VideoCommon::CustomAssetLibrary
+{
+public:
+  LoadInfo LoadTexture(const AssetID& asset_id, VideoCommon::TextureData* data) override
+  {
+    {
+      std::lock_guard lk(m_lock);
+      m_load_counts[asset_id]++;
+    }
+    data->m_type = VideoCommon::TextureData::Type::Type_Texture2D;
+    auto& level = data->m_texture.m_slices.emplace_back().m_levels.emplace_back();
+    level.width = 1;
+    level.height = 1;
+    level.row_length = 1;
+    level.data.resize(4);
+    return {TEXTURE_SIZE, std::chrono::system_clock::now()};
+  }
+  TimeType GetLastAssetWriteTime(const AssetID&) const override { return {}; }
+  LoadInfo LoadPixelShader(const AssetID&, VideoCommon::PixelShaderData*) override { return {}; }
+  LoadInfo LoadMaterial(const AssetID&, VideoCommon::MaterialData*) override { return {}; }
+  LoadInfo LoadMesh(const AssetID&, VideoCommon::MeshData*) override { return {}; }
+
+  int GetLoadCount(const AssetID& asset_id)
+  {
+    std::lock_guard lk(m_lock);
+    return m_load_counts[asset_id];
+  }
+
+private:
+  std::mutex m_lock;
+  std::map<AssetID, int> m_load_counts;
+};
+
+// Loading happens on other threads, so the tests have to wait for it
+bool WaitFor(const std::function<bool()>& condition)
+{
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+  while (!condition())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+      return false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+
+bool IsLoaded(const std::shared_ptr<VideoCommon::GameTextureAsset>& asset)
+{
+  return asset->GetData() != nullptr;
+}
+}  // namespace
+
+TEST(CustomAssetLoader, EvictsLeastRecentlyUsedTexture)
+{
+  VideoCommon::CustomAssetLoader loader;
+  loader.Init();
+  // Room for two textures
+  loader.SetMemoryBudget(TEXTURE_SIZE * 5 / 2);
+  auto library = std::make_shared<TestAssetLibrary>();
+  {
+    const auto a = loader.LoadGameTexture("a", library);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(a); }));
+    const auto b = loader.LoadGameTexture("b", library);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(b); }));
+
+    // Using a makes b the least recently used texture
+    loader.UseAsset(a);
+    const auto c = loader.LoadGameTexture("c", library);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(c) && !IsLoaded(b); }));
+    EXPECT_TRUE(IsLoaded(a));
+    EXPECT_EQ(1, library->GetLoadCount("b"));
+
+    // Using the evicted texture loads it again, and evicts a in turn
+    loader.UseAsset(b);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(b) && !IsLoaded(a); }));
+    EXPECT_TRUE(IsLoaded(c));
+    EXPECT_EQ(2, library->GetLoadCount("b"));
+    EXPECT_EQ(1, library->GetLoadCount("a"));
+
+    // Requesting an evicted texture through the loader counts as using it
+    EXPECT_EQ(a, loader.LoadGameTexture("a", library));
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(a) && !IsLoaded(c); }));
+    EXPECT_TRUE(IsLoaded(b));
+    EXPECT_EQ(2, library->GetLoadCount("a"));
+  }
+  loader.Shutdown();
+}
+
+TEST(CustomAssetLoader, ReleasedTexturesFreeTheBudget)
+{
+  VideoCommon::CustomAssetLoader loader;
+  loader.Init();
+  loader.SetMemoryBudget(TEXTURE_SIZE * 3 / 2);
+  auto library = std::make_shared<TestAssetLibrary>();
+  {
+    auto a = loader.LoadGameTexture("a", library);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(a); }));
+
+    // Once a texture is no longer referenced, its memory doesn't count anymore, so nothing has
+    // to be evicted for the next one
+    a.reset();
+    const auto b = loader.LoadGameTexture("b", library);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(b); }));
+    const auto c = loader.LoadGameTexture("c", library);
+    ASSERT_TRUE(WaitFor([&] { return IsLoaded(c) && !IsLoaded(b); }));
+    EXPECT_EQ(1, library->GetLoadCount("b"));
+  }
+  loader.Shutdown();
+}
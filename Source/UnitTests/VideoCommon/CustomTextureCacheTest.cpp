@@ -0,0 +1,157 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/Image.h"
+#include "Common/StringUtil.h"
+#include "VideoCommon/Assets/CustomTextureCache.h"
+#include "VideoCommon/Assets/CustomTextureData.h"
+
+namespace
+{
+using Level = VideoCommon::CustomTextureData::ArraySlice::Level;
+
+class TempDir final
+{
+public:
+  TempDir() : m_path(File::CreateTempDir()) {}
+  ~TempDir()
+  {
+    if (!m_path.empty())
+      File::DeleteDirRecursively(m_path);
+  }
+  bool Exists() const { return !m_path.empty(); }
+  std::string GetPath(const std::string& name) const { return m_path + "/" + name; }
+
+private:
+  std::string m_path;
+};
+
+std::vector<u8> MakePixels(u32 width, u32 height, u8 seed)
+{
+  std::vector<u8> pixels(width * height * 4);
+  for (size_t i = 0; i < pixels.size(); ++i)
+    pixels[i] = static_cast<u8>(seed + i * 13);
+  return pixels;
+}
+
+bool WritePNG(const std::string& path, u32 width, u32 height, u8 seed)
+{
+  const std::vector<u8> pixels = MakePixels(width, height, seed);
+  return Common::SavePNG(path, pixels.data(), Common::ImageByteFormat::RGBA, width, height,
+                         width * 4);
+}
+
+// Replaces the file with garbage which can't be decoded, keeping its size and write time, so a
+// successful load has to come from the cache
+void Clobber(const std::string& path)
+{
+  const std::filesystem::path fs_path = StringToPath(path);
+  const auto write_time = std::filesystem::last_write_time(fs_path);
+  const std::string garbage(std::filesystem::file_size(fs_path), 'x');
+  ASSERT_TRUE(File::WriteStringToFile(path, garbage));
+  std::filesystem::last_write_time(fs_path, write_time);
+}
+
+void SetWriteTime(const std::string& path, std::filesystem::file_time_type write_time)
+{
+  std::filesystem::last_write_time(StringToPath(path), write_time);
+}
+
+std::optional<Level> Load(VideoCommon::CustomTextureCache& cache, const std::string& path)
+{
+  Level level;
+  if (!cache.LoadPNGTexture(&level, StringToPath(path)))
+    return std::nullopt;
+  return level;
+}
+
+void ExpectPixels(const std::optional<Level>& level, u32 width, u32 height, u8 seed)
+{
+  ASSERT_TRUE(level);
+  EXPECT_EQ(AbstractTextureFormat::RGBA8, level->format);
+  EXPECT_EQ(width, level->width);
+  EXPECT_EQ(height, level->height);
+  EXPECT_EQ(width, level->row_length);
+  EXPECT_EQ(MakePixels(width, height, seed), level->data);
+}
+}  // namespace
+
+TEST(CustomTextureCache, HitsUntilTheFileChanges)
+{
+  TempDir dir;
+  ASSERT_TRUE(dir.Exists());
+  const std::string png = dir.GetPath("texture.png");
+  VideoCommon::CustomTextureCache cache(dir.GetPath("textures.texcache"));
+
+  ASSERT_TRUE(WritePNG(png, 4, 4, 1));
+  ExpectPixels(Load(cache, png), 4, 4, 1);
+
+  Clobber(png);
+  ExpectPixels(Load(cache, png), 4, 4, 1);
+
+  // A newer write time invalidates the entry
+  ASSERT_TRUE(WritePNG(png, 4, 4, 2));
+  const auto write_time = std::filesystem::last_write_time(StringToPath(png));
+  SetWriteTime(png, write_time + std::chrono::seconds(10));
+  ExpectPixels(Load(cache, png), 4, 4, 2);
+  Clobber(png);
+  ExpectPixels(Load(cache, png), 4, 4, 2);
+
+  // So does a different size, even with the same write time
+  const auto file_size = std::filesystem::file_size(StringToPath(png));
+  ASSERT_TRUE(WritePNG(png, 8, 4, 3));
+  ASSERT_NE(file_size, std::filesystem::file_size(StringToPath(png)));
+  SetWriteTime(png, write_time + std::chrono::seconds(10));
+  ExpectPixels(Load(cache, png), 8, 4, 3);
+
+  // Files which can't be decoded aren't cached
+  const std::string missing = dir.GetPath("missing.png");
+  EXPECT_FALSE(Load(cache, missing));
+  ASSERT_TRUE(File::WriteStringToFile(missing, "not a png"));
+  EXPECT_FALSE(Load(cache, missing));
+}
+
+TEST(CustomTextureCache, KeepsEntriesWhenReopened)
+{
+  TempDir dir;
+  ASSERT_TRUE(dir.Exists());
+  const std::string cache_path = dir.GetPath("textures.texcache");
+  const std::string first = dir.GetPath("first.png");
+  const std::string second = dir.GetPath("second.png");
+
+  ASSERT_TRUE(WritePNG(first, 4, 4, 1));
+  ASSERT_TRUE(WritePNG(second, 2, 2, 2));
+  {
+    VideoCommon::CustomTextureCache cache(cache_path);
+    ExpectPixels(Load(cache, first), 4, 4, 1);
+    ExpectPixels(Load(cache, second), 2, 2, 2);
+  }
+
+  Clobber(first);
+  Clobber(second);
+  {
+    VideoCommon::CustomTextureCache cache(cache_path);
+    ExpectPixels(Load(cache, first), 4, 4, 1);
+    ExpectPixels(Load(cache, second), 2, 2, 2);
+
+    // Entries added after reopening are kept as well
+    const std::string third = dir.GetPath("third.png");
+    ASSERT_TRUE(WritePNG(third, 1, 1, 3));
+    ExpectPixels(Load(cache, third), 1, 1, 3);
+    Clobber(third);
+  }
+  {
+    VideoCommon::CustomTextureCache cache(cache_path);
+    ExpectPixels(Load(cache, dir.GetPath("third.png")), 1, 1, 3);
+  }
+}
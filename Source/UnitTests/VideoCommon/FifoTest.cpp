@@ -0,0 +1,240 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <deque>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoCommon/Fifo.h"
+
+using Fifo::PendingVideoBufferSegments;
+using Fifo::VideoBufferSegment;
+
+namespace
+{
+constexpr size_t BUFFER_SIZE = 1000;
+}  // namespace
+
+class PendingVideoBufferSegmentsTest : public testing::Test
+{
+protected:
+  VideoBufferSegment Segment(size_t begin, size_t end, u64 cycles)
+  {
+    return {&m_buffer[begin], &m_buffer[end], cycles};
+  }
+  bool Overlaps(size_t begin, size_t end) const
+  {
+    return m_segments.Overlaps(&m_buffer[begin], &m_buffer[end]);
+  }
+
+  // One past the end is a valid pointer, which the segments end at before they wrap around.
+  std::vector<u8> m_buffer = std::vector<u8>(BUFFER_SIZE + 1);
+  PendingVideoBufferSegments m_segments;
+};
+
+TEST_F(PendingVideoBufferSegmentsTest, RetiresByStamp)
+{
+  EXPECT_TRUE(m_segments.IsEmpty());
+  EXPECT_FALSE(Overlaps(0, BUFFER_SIZE));
+
+  m_segments.Add(Segment(0, 100, 10));
+  m_segments.Add(Segment(100, 200, 20));
+  m_segments.Add(Segment(200, 300, 30));
+
+  m_segments.Retire(9);
+  EXPECT_TRUE(Overlaps(0, 1));
+
+  // The GPU thread only ever reports the stamp of a segment it ran, but anything in between
+  // behaves the same way.
+  m_segments.Retire(25);
+  EXPECT_FALSE(Overlaps(0, 200));
+  EXPECT_TRUE(Overlaps(0, 201));
+
+  m_segments.Retire(30);
+  EXPECT_TRUE(m_segments.IsEmpty());
+  EXPECT_FALSE(Overlaps(0, BUFFER_SIZE));
+}
+
+TEST_F(PendingVideoBufferSegmentsTest, Overlaps)
+{
+  m_segments.Add(Segment(100, 200, 1));
+  m_segments.Add(Segment(200, 300, 2));
+
+  EXPECT_FALSE(Overlaps(0, 100));
+  EXPECT_TRUE(Overlaps(0, 101));
+  EXPECT_TRUE(Overlaps(150, 250));
+  EXPECT_TRUE(Overlaps(299, 300));
+  EXPECT_TRUE(Overlaps(0, BUFFER_SIZE));
+  EXPECT_FALSE(Overlaps(300, BUFFER_SIZE));
+}
+
+TEST_F(PendingVideoBufferSegmentsTest, OverlapsWhenWrapped)
+{
+  // The commands before the wrap didn't reach the end of the buffer. The space after them still
+  // counts as used until the GPU thread is done with them.
+  m_segments.Add(Segment(800, 900, 1));
+  m_segments.Add(Segment(0, 50, 2));
+  m_segments.Add(Segment(50, 100, 3));
+
+  EXPECT_TRUE(Overlaps(0, 1));
+  EXPECT_TRUE(Overlaps(99, 100));
+  EXPECT_FALSE(Overlaps(100, 800));
+  EXPECT_TRUE(Overlaps(700, 801));
+  EXPECT_TRUE(Overlaps(900, BUFFER_SIZE));
+  EXPECT_TRUE(Overlaps(99, 801));
+
+  // Once the segment before the wrap is done, the end of the buffer is free again.
+  m_segments.Retire(1);
+  EXPECT_FALSE(Overlaps(100, BUFFER_SIZE));
+  EXPECT_TRUE(Overlaps(0, 1));
+}
+
+TEST_F(PendingVideoBufferSegmentsTest, OverlapsWhenFull)
+{
+  // The newest segment ends where the oldest begins, so nothing is free.
+  m_segments.Add(Segment(500, 900, 1));
+  m_segments.Add(Segment(0, 500, 2));
+
+  EXPECT_TRUE(Overlaps(0, 1));
+  EXPECT_TRUE(Overlaps(499, 500));
+  EXPECT_TRUE(Overlaps(500, 501));
+  EXPECT_TRUE(Overlaps(950, BUFFER_SIZE));
+
+  m_segments.Retire(1);
+  EXPECT_FALSE(Overlaps(500, BUFFER_SIZE));
+  EXPECT_TRUE(Overlaps(499, 500));
+}
+
+// Follows what FifoManager::ReadDataFromFifoOnCPU does with the video buffer: it copies 32 byte
+// blocks to the write pointer, preprocesses the whole commands in them, hands those to the GPU
+// thread as segments, and moves the incomplete command back to the start of the buffer when
+// there is no room for another block at the end. The GPU thread runs the segments in order, but
+// only as far as it has to. Every byte the CPU thread writes to must not be in a segment the GPU
+// thread hasn't run yet.
+TEST(PendingVideoBufferSegments, RingBuffer)
+{
+  constexpr size_t BLOCK_SIZE = 32;
+  constexpr size_t SEGMENT_SIZE = 256;
+  constexpr size_t RING_SIZE = 4000;
+
+  std::vector<u8> buffer(RING_SIZE);
+  u8* const base = buffer.data();
+  // The stamp of the segment each byte is in, or 0 if it is free.
+  std::vector<u64> owner(RING_SIZE, 0);
+
+  PendingVideoBufferSegments pending;
+  std::deque<VideoBufferSegment> gpu_queue;
+  u64 gpu_cycles_executed = 0;
+  size_t wraps = 0;
+
+  const auto run_gpu = [&] {
+    const VideoBufferSegment segment = gpu_queue.front();
+    gpu_queue.pop_front();
+    for (const u8* p = segment.begin; p < segment.end; p++)
+    {
+      ASSERT_EQ(segment.cycles, owner[p - base]);
+      owner[p - base] = 0;
+    }
+    gpu_cycles_executed = segment.cycles;
+  };
+  const auto wait_for_gpu_to_leave = [&](const u8* begin, const u8* end) {
+    for (;;)
+    {
+      pending.Retire(gpu_cycles_executed);
+      if (!pending.Overlaps(begin, end))
+        break;
+      ASSERT_FALSE(gpu_queue.empty());
+      run_gpu();
+    }
+    for (const u8* p = begin; p < end; p++)
+      ASSERT_EQ(0u, owner[p - base]) << "at " << p - base;
+  };
+
+  u8* write_ptr = base;
+  u8* pp_read_ptr = base;
+  u8* publish_ptr = base;
+  u64 preprocessed_cycles = 0;
+  const auto publish = [&] {
+    if (publish_ptr == pp_read_ptr)
+      return;
+    const VideoBufferSegment segment{publish_ptr, pp_read_ptr, preprocessed_cycles};
+    for (u8* p = publish_ptr; p < pp_read_ptr; p++)
+    {
+      ASSERT_EQ(0u, owner[p - base]);
+      owner[p - base] = segment.cycles;
+    }
+    pending.Add(segment);
+    gpu_queue.push_back(segment);
+    publish_ptr = pp_read_ptr;
+  };
+
+  std::mt19937 rng(1234);
+  u32 gpu_stall = 0;
+  for (int i = 0; i < 100000; i++)
+  {
+    if (BLOCK_SIZE > static_cast<size_t>(base + RING_SIZE - write_ptr))
+    {
+      const size_t existing_len = write_ptr - pp_read_ptr;
+      publish();
+      wait_for_gpu_to_leave(base, base + existing_len + BLOCK_SIZE);
+      if (HasFatalFailure())
+        return;
+      std::memmove(base, pp_read_ptr, existing_len);
+      write_ptr = base + existing_len;
+      pp_read_ptr = base;
+      publish_ptr = base;
+      wraps++;
+    }
+    else
+    {
+      wait_for_gpu_to_leave(write_ptr, write_ptr + BLOCK_SIZE);
+      if (HasFatalFailure())
+        return;
+    }
+    write_ptr += BLOCK_SIZE;
+
+    // Commands can be longer than a block, so sometimes nothing is preprocessed.
+    const size_t preprocessed = rng() % (write_ptr - pp_read_ptr + 1);
+    if (preprocessed != 0)
+    {
+      pp_read_ptr += preprocessed;
+      preprocessed_cycles += 1 + rng() % 100;
+    }
+
+    // Segments are published once they are big enough, and at the end of each time slot.
+    if (static_cast<size_t>(pp_read_ptr - publish_ptr) >= SEGMENT_SIZE || rng() % 8 == 0)
+      publish();
+    if (HasFatalFailure())
+      return;
+
+    // The GPU thread sometimes keeps up, and sometimes stalls until the CPU thread has to wait
+    // for it.
+    if (gpu_stall != 0)
+    {
+      gpu_stall--;
+    }
+    else if (rng() % 64 == 0)
+    {
+      gpu_stall = rng() % 300;
+    }
+    else
+    {
+      const u32 gpu_segments = rng() % 3;
+      for (u32 j = 0; j < gpu_segments && !gpu_queue.empty(); j++)
+        run_gpu();
+    }
+    if (HasFatalFailure())
+      return;
+  }
+
+  EXPECT_GT(wraps, 100u);
+
+  while (!gpu_queue.empty())
+    run_gpu();
+  pending.Retire(gpu_cycles_executed);
+  EXPECT_TRUE(pending.IsEmpty());
+}
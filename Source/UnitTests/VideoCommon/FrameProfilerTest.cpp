@@ -0,0 +1,231 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+#include <picojson.h>
+
+#include "Common/FileUtil.h"
+#include "Common/JsonUtil.h"
+#include "VideoCommon/FrameProfiler.h"
+
+using VideoCommon::FrameProfilerPhase;
+using VideoCommon::FrameProfilerScope;
+using VideoCommon::g_frame_profiler;
+
+namespace
+{
+constexpr auto SLEEP_TIME = std::chrono::milliseconds(5);
+constexpr u64 SLEEP_NS = std::chrono::nanoseconds(SLEEP_TIME).count();
+
+u64 GetPhase(const VideoCommon::FrameProfile& frame, FrameProfilerPhase phase)
+{
+  return frame.phase_ns[static_cast<u32>(phase)];
+}
+}  // namespace
+
+TEST(FrameProfiler, DisabledByDefault)
+{
+  EXPECT_FALSE(g_frame_profiler.IsEnabled());
+
+  {
+    FrameProfilerScope scope(FrameProfilerPhase::OpcodeDecoding);
+    std::this_thread::sleep_for(SLEEP_TIME);
+  }
+  g_frame_profiler.SetEnabled(true);
+  g_frame_profiler.EndFrame();
+  g_frame_profiler.SetEnabled(false);
+
+  const auto frames = g_frame_profiler.TakeFrames();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(0u, GetPhase(frames[0], FrameProfilerPhase::OpcodeDecoding));
+}
+
+TEST(FrameProfiler, NestedScopesAreExclusive)
+{
+  g_frame_profiler.SetEnabled(true);
+
+  {
+    FrameProfilerScope outer(FrameProfilerPhase::OpcodeDecoding);
+    {
+      FrameProfilerScope inner(FrameProfilerPhase::VertexLoading);
+      std::this_thread::sleep_for(SLEEP_TIME);
+    }
+  }
+  g_frame_profiler.EndFrame();
+
+  {
+    FrameProfilerScope scope(FrameProfilerPhase::TextureCache);
+    std::this_thread::sleep_for(SLEEP_TIME);
+  }
+  g_frame_profiler.EndFrame();
+
+  g_frame_profiler.SetEnabled(false);
+  const auto frames = g_frame_profiler.TakeFrames();
+  ASSERT_EQ(2u, frames.size());
+
+  // The outer scope only waited for the inner one, which must not be counted twice.
+  EXPECT_GE(GetPhase(frames[0], FrameProfilerPhase::VertexLoading), SLEEP_NS);
+  EXPECT_LT(GetPhase(frames[0], FrameProfilerPhase::OpcodeDecoding), SLEEP_NS);
+  EXPECT_EQ(0u, GetPhase(frames[0], FrameProfilerPhase::TextureCache));
+  EXPECT_GE(frames[0].frame_ns, GetPhase(frames[0], FrameProfilerPhase::VertexLoading));
+
+  // Time is reset at the end of each frame.
+  EXPECT_EQ(0u, GetPhase(frames[1], FrameProfilerPhase::VertexLoading));
+  EXPECT_GE(GetPhase(frames[1], FrameProfilerPhase::TextureCache), SLEEP_NS);
+
+  EXPECT_TRUE(g_frame_profiler.TakeFrames().empty());
+}
+
+TEST(FrameProfiler, TraceKeepsNewestEvents)
+{
+  constexpr FrameProfilerPhase phases[] = {
+      FrameProfilerPhase::OpcodeDecoding, FrameProfilerPhase::VertexLoading,
+      FrameProfilerPhase::TextureCache,   FrameProfilerPhase::ShaderCompileWait,
+      FrameProfilerPhase::Present,        FrameProfilerPhase::BackendSubmission};
+
+  g_frame_profiler.SetEnabled(true);
+  g_frame_profiler.SetTracingEnabled(true, 4);
+  for (const FrameProfilerPhase phase : phases)
+  {
+    FrameProfilerScope scope(phase);
+  }
+  g_frame_profiler.EndFrame();
+  g_frame_profiler.SetTracingEnabled(false);
+
+  // Nothing is recorded while tracing is disabled.
+  {
+    FrameProfilerScope scope(FrameProfilerPhase::OpcodeDecoding);
+  }
+  g_frame_profiler.EndFrame();
+  g_frame_profiler.SetEnabled(false);
+  g_frame_profiler.TakeFrames();
+
+  const auto events = g_frame_profiler.GetTraceEvents();
+  ASSERT_EQ(4u, events.size());
+  for (size_t i = 0; i < events.size(); ++i)
+  {
+    EXPECT_EQ(phases[i + 2], events[i].phase);
+    EXPECT_EQ(events[0].thread_id, events[i].thread_id);
+    if (i != 0)
+      EXPECT_GE(events[i].start_timestamp, events[i - 1].start_timestamp);
+  }
+
+  const auto frames = g_frame_profiler.GetTraceFrames();
+  ASSERT_EQ(1u, frames.size());
+  EXPECT_EQ(0u, frames[0].frame_number);
+  EXPECT_GE(frames[0].end_timestamp,
+            events.back().start_timestamp + events.back().duration_ns);
+
+  // The trace can be queried more than once.
+  EXPECT_EQ(4u, g_frame_profiler.GetTraceEvents().size());
+}
+
+TEST(FrameProfiler, TraceKeepsNewestEventsOfEachThread)
+{
+  constexpr size_t CAPACITY = 100;
+  constexpr int THREAD_COUNT = 4;
+
+  g_frame_profiler.SetEnabled(true);
+  g_frame_profiler.SetTracingEnabled(true, CAPACITY);
+
+  // One thread records far more events than the others, which must not push theirs out.
+  std::vector<std::thread> threads;
+  for (int i = 0; i < THREAD_COUNT; ++i)
+  {
+    threads.emplace_back([i] {
+      const int count = i == 0 ? 10000 : 50 + i;
+      for (int j = 0; j < count; ++j)
+      {
+        FrameProfilerScope scope(j < count - 10 ? FrameProfilerPhase::OpcodeDecoding :
+                                                  FrameProfilerPhase::Present);
+      }
+    });
+  }
+  for (std::thread& thread : threads)
+    thread.join();
+
+  g_frame_profiler.SetTracingEnabled(false);
+  g_frame_profiler.SetEnabled(false);
+  g_frame_profiler.TakeFrames();
+
+  const auto events = g_frame_profiler.GetTraceEvents();
+  std::map<u32, std::vector<VideoCommon::FrameProfilerEvent>> threads_events;
+  for (const auto& event : events)
+    threads_events[event.thread_id].push_back(event);
+
+  ASSERT_EQ(size_t(THREAD_COUNT), threads_events.size());
+  std::vector<size_t> counts;
+  for (const auto& [thread_id, thread_events] : threads_events)
+  {
+    counts.push_back(thread_events.size());
+    // The newest events of every thread are kept, in order.
+    for (size_t i = 0; i < thread_events.size(); ++i)
+    {
+      EXPECT_EQ(i + 10 < thread_events.size() ? FrameProfilerPhase::OpcodeDecoding :
+                                                FrameProfilerPhase::Present,
+                thread_events[i].phase);
+    }
+  }
+  std::sort(counts.begin(), counts.end());
+  EXPECT_EQ((std::vector<size_t>{51, 52, 53, CAPACITY}), counts);
+
+  // Events are ordered by the time they ended, across threads.
+  EXPECT_TRUE(std::is_sorted(events.begin(), events.end(), [](const auto& a, const auto& b) {
+    return a.start_timestamp + a.duration_ns < b.start_timestamp + b.duration_ns;
+  }));
+
+  // Enabling tracing again starts over.
+  g_frame_profiler.SetEnabled(true);
+  g_frame_profiler.SetTracingEnabled(true, CAPACITY);
+  g_frame_profiler.SetTracingEnabled(false);
+  g_frame_profiler.SetEnabled(false);
+  EXPECT_TRUE(g_frame_profiler.GetTraceEvents().empty());
+}
+
+TEST(FrameProfiler, WriteChromeTrace)
+{
+  g_frame_profiler.SetEnabled(true);
+  g_frame_profiler.SetTracingEnabled(true);
+  {
+    FrameProfilerScope outer(FrameProfilerPhase::OpcodeDecoding);
+    FrameProfilerScope inner(FrameProfilerPhase::VertexLoading);
+    std::this_thread::sleep_for(SLEEP_TIME);
+  }
+  g_frame_profiler.EndFrame();
+  g_frame_profiler.SetTracingEnabled(false);
+  g_frame_profiler.SetEnabled(false);
+  g_frame_profiler.TakeFrames();
+
+  const std::string directory = File::CreateTempDir();
+  ASSERT_FALSE(directory.empty());
+  const std::string filename = directory + "/trace.json";
+  ASSERT_TRUE(g_frame_profiler.WriteChromeTrace(filename));
+
+  picojson::value root;
+  std::string error;
+  ASSERT_TRUE(JsonFromFile(filename, &root, &error)) << error;
+  File::DeleteDirRecursively(directory);
+
+  const auto& trace_events = root.get("traceEvents").get<picojson::array>();
+  // The track name, the frame, and both scopes
+  ASSERT_EQ(4u, trace_events.size());
+  EXPECT_EQ("M", trace_events[0].get("ph").to_str());
+  EXPECT_EQ("Frame 0", trace_events[1].get("name").to_str());
+  EXPECT_EQ("Vertex loading", trace_events[2].get("name").to_str());
+  EXPECT_EQ("Opcode decoding", trace_events[3].get("name").to_str());
+
+  // Events span their nested scopes, which is how the trace viewer shows them nested.
+  const double outer_start = trace_events[3].get("ts").get<double>();
+  const double inner_start = trace_events[2].get("ts").get<double>();
+  EXPECT_LE(outer_start, inner_start);
+  EXPECT_GE(outer_start + trace_events[3].get("dur").get<double>(),
+            inner_start + trace_events[2].get("dur").get<double>());
+  EXPECT_GE(trace_events[2].get("dur").get<double>(), SLEEP_NS / 1000.0);
+}
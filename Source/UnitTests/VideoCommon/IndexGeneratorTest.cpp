@@ -0,0 +1,96 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <tuple>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
+#include "VideoCommon/IndexGenerator.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/VideoConfig.h"
+
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+constexpr u32 NUM_WORKERS = 3;
+// Enough for the indices of 0xFFFF vertices of any primitive.
+constexpr size_t BUFFER_SIZE = 0x10000 * 6;
+}  // namespace
+
+class IndexGeneratorTest : public ::testing::TestWithParam<std::tuple<Primitive, bool>>
+{
+protected:
+  void SetUp() override
+  {
+    g_Config.backend_info.bSupportsPrimitiveRestart = std::get<1>(GetParam());
+    m_workers.Reset("Index Generator Test", NUM_WORKERS);
+  }
+
+  // Adds a small draw followed by a large one, and returns the generated indices.
+  std::vector<u16> Generate(Common::WorkerPool* workers, u32 num_vertices)
+  {
+    const Primitive primitive = std::get<0>(GetParam());
+    std::vector<u16> buffer(BUFFER_SIZE, 0x1234);
+
+    IndexGenerator generator;
+    generator.Init(workers);
+    generator.Start(buffer.data());
+    generator.AddIndices(primitive, 7);
+    generator.AddIndices(primitive, num_vertices);
+    EXPECT_EQ(7 + num_vertices, generator.GetNumVerts());
+
+    buffer.resize(generator.GetIndexLen());
+    return buffer;
+  }
+
+  Common::WorkerPool m_workers;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    PrimitivesAndRestart, IndexGeneratorTest,
+    ::testing::Combine(::testing::Values(Primitive::GX_DRAW_QUADS, Primitive::GX_DRAW_TRIANGLES,
+                                         Primitive::GX_DRAW_TRIANGLE_STRIP,
+                                         Primitive::GX_DRAW_TRIANGLE_FAN),
+                       ::testing::Bool()));
+
+TEST_P(IndexGeneratorTest, ParallelMatchesSerial)
+{
+  // Sizes around the chunk boundaries of the parallel version.
+  for (const u32 num_vertices : {12287u, 12288u, 12289u, 12290u, 12291u, 18431u, 18432u, 18433u,
+                                 18434u, 18435u, 65000u, 65521u})
+  {
+    EXPECT_EQ(Generate(nullptr, num_vertices), Generate(&m_workers, num_vertices))
+        << "vertices: " << num_vertices;
+  }
+}
+
+TEST_P(IndexGeneratorTest, Speed)
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr int ITERATIONS = 2000;
+  constexpr u32 NUM_VERTICES = 65520;
+  std::vector<u16> buffer(BUFFER_SIZE);
+
+  for (Common::WorkerPool* workers : {static_cast<Common::WorkerPool*>(nullptr), &m_workers})
+  {
+    IndexGenerator generator;
+    generator.Init(workers);
+    const auto start = Clock::now();
+    for (int i = 0; i < ITERATIONS; ++i)
+    {
+      generator.Start(buffer.data());
+      generator.AddIndices(std::get<0>(GetParam()), NUM_VERTICES);
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    fmt::print("primitive: {}, restart: {}, workers: {}: {:.1f} us per draw\n",
+               std::get<0>(GetParam()), std::get<1>(GetParam()),
+               workers ? workers->GetWorkerCount() : 0, seconds / ITERATIONS * 1e6);
+  }
+}
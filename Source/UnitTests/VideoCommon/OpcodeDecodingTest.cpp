@@ -0,0 +1,344 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <bit>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Core/System.h"
+#include "VideoBackends/Null/NullGfx.h"
+#include "VideoCommon/BPMemory.h"
+#include "VideoCommon/BPStructs.h"
+#include "VideoCommon/CPMemory.h"
+#include "VideoCommon/DataReader.h"
+#include "VideoCommon/OpcodeDecoding.h"
+#include "VideoCommon/PixelShaderManager.h"
+#include "VideoCommon/VertexLoaderManager.h"
+#include "VideoCommon/VertexManagerBase.h"
+#include "VideoCommon/VideoConfig.h"
+#include "VideoCommon/XFMemory.h"
+
+using OpcodeDecoder::Opcode;
+using OpcodeDecoder::Primitive;
+
+namespace
+{
+struct RecordedDraw
+{
+  Primitive primitive;
+  u32 count;
+  u32 stride;
+  bool cullall;
+
+  bool operator==(const RecordedDraw&) const = default;
+};
+
+// Keeps everything the vertex loaders write, instead of drawing it.
+class RecordingVertexManager final : public VertexManagerBase
+{
+public:
+  RecordingVertexManager() { m_index_generator.Init(nullptr); }
+
+  void Reset()
+  {
+    m_cur_buffer_pointer = m_base_buffer_pointer = m_cpu_vertex_buffer.data();
+    m_end_buffer_pointer = m_base_buffer_pointer + m_cpu_vertex_buffer.size();
+    m_index_generator.Start(m_cpu_index_buffer.data());
+    draws.clear();
+  }
+
+  DataReader PrepareForAdditionalData(Primitive primitive, u32 count, u32 stride,
+                                      bool cullall) override
+  {
+    draws.push_back({primitive, count, stride, cullall});
+    return DataReader(m_cur_buffer_pointer, m_end_buffer_pointer);
+  }
+
+  std::vector<u8> GetVertices() const { return {m_base_buffer_pointer, m_cur_buffer_pointer}; }
+  std::vector<u16> GetIndices() const
+  {
+    const u16* indices = m_cpu_index_buffer.data();
+    return {indices, indices + m_index_generator.GetIndexLen()};
+  }
+
+  std::vector<RecordedDraw> draws;
+};
+
+// Direct positions and colors. They are 3 floats and RGBA8888 with VAT 0, and 3 shorts (or
+// unsigned shorts) and RGB565 with VAT 1.
+constexpr u32 VCD_LO_VALUE = 0x2200;
+constexpr u32 VAT_0_VALUE = 0x16009;
+constexpr u32 VAT_1_VALUE = 0x7;
+constexpr u32 VAT_1_UNSIGNED_VALUE = 0x5;
+
+class CommandWriter
+{
+public:
+  void Nop() { m_data.push_back(static_cast<u8>(Opcode::GX_NOP)); }
+
+  void CP(u8 command, u32 value)
+  {
+    m_data.push_back(static_cast<u8>(Opcode::GX_LOAD_CP_REG));
+    m_data.push_back(command);
+    Write32(value);
+  }
+
+  void BP(u8 reg, u32 value)
+  {
+    m_data.push_back(static_cast<u8>(Opcode::GX_LOAD_BP_REG));
+    m_data.push_back(reg);
+    m_data.push_back(static_cast<u8>(value >> 16));
+    m_data.push_back(static_cast<u8>(value >> 8));
+    m_data.push_back(static_cast<u8>(value));
+  }
+
+  void Draw(Primitive primitive, u8 vat, u16 num_vertices)
+  {
+    m_data.push_back(static_cast<u8>(Opcode::GX_PRIMITIVE_START) |
+                     (static_cast<u8>(primitive) << OpcodeDecoder::GX_PRIMITIVE_SHIFT) | vat);
+    m_data.push_back(static_cast<u8>(num_vertices >> 8));
+    m_data.push_back(static_cast<u8>(num_vertices));
+    for (u16 i = 0; i < num_vertices; i++)
+    {
+      if (vat == 0)
+      {
+        for (int j = 0; j < 3; j++)
+          Write32(std::bit_cast<u32>(static_cast<float>(m_next_value++) * 0.5f));
+        Write32(0x10203040 + m_next_value++);
+      }
+      else
+      {
+        for (int j = 0; j < 3; j++)
+          Write16(static_cast<u16>(m_next_value++ * 3));
+        Write16(static_cast<u16>(m_next_value++ * 7));
+      }
+    }
+  }
+
+  const std::vector<u8>& GetData() const { return m_data; }
+
+private:
+  void Write16(u16 value)
+  {
+    m_data.push_back(static_cast<u8>(value >> 8));
+    m_data.push_back(static_cast<u8>(value));
+  }
+  void Write32(u32 value)
+  {
+    Write16(static_cast<u16>(value >> 16));
+    Write16(static_cast<u16>(value));
+  }
+
+  std::vector<u8> m_data;
+  u32 m_next_value = 1;
+};
+
+CommandWriter MakeCommands()
+{
+  CommandWriter writer;
+  writer.CP(VCD_LO, VCD_LO_VALUE);
+  writer.CP(CP_VAT_REG_A, VAT_0_VALUE);
+  writer.CP(CP_VAT_REG_A + 1, VAT_1_VALUE);
+
+  // Longer than a batch, with every primitive type and empty draws.
+  for (u32 i = 0; i < 70; i++)
+    writer.Draw(static_cast<Primitive>(i % 8), 0, static_cast<u16>(i % 5));
+  writer.Draw(Primitive::GX_DRAW_TRIANGLES, 1, 6);
+  writer.Draw(Primitive::GX_DRAW_TRIANGLE_STRIP, 1, 4);
+  writer.Nop();
+  writer.Nop();
+
+  // Longer than a batch as well, and with the mask register, which only affects the next write.
+  for (u32 i = 0; i < 70; i++)
+  {
+    switch (i % 5)
+    {
+    case 0:
+      writer.BP(BPMEM_TEV_KSEL + i % 8, 0x123456 * i);
+      break;
+    case 1:
+      writer.BP(BPMEM_TEV_COLOR_RA + (i % 4) * 2, 0x654321 + i);
+      break;
+    case 2:
+      writer.BP(BPMEM_FOGCOLOR, 0x010203 * i);
+      break;
+    case 3:
+      writer.BP(BPMEM_IND_MTXA + i % 9, 0x00ABCD + i);
+      break;
+    case 4:
+      writer.BP(BPMEM_BP_MASK, 0x00FF00);
+      break;
+    }
+  }
+
+  // Draws and state changes in between them end the batches.
+  for (u32 i = 0; i < 10; i++)
+  {
+    writer.Draw(Primitive::GX_DRAW_TRIANGLE_FAN, i % 2, 3 + i % 3);
+    if (i % 3 == 0)
+      writer.BP(BPMEM_TEV_KSEL + i % 8, 0xFEDCBA - i);
+    if (i == 5)
+      writer.CP(CP_VAT_REG_A + 1, VAT_1_UNSIGNED_VALUE);
+  }
+  writer.Draw(Primitive::GX_DRAW_QUADS, 1, 4);
+  return writer;
+}
+
+struct Result
+{
+  u32 size = 0;
+  u32 cycles = 0;
+  std::vector<RecordedDraw> draws;
+  std::vector<u8> vertices;
+  std::vector<u16> indices;
+  std::vector<u8> bp;
+  std::vector<u8> constants;
+  bool constants_dirty = false;
+};
+
+template <typename T>
+std::vector<u8> GetBytes(const T& value)
+{
+  const u8* bytes = reinterpret_cast<const u8*>(&value);
+  return {bytes, bytes + sizeof(T)};
+}
+
+void CopyCPState(CPState* dst, const CPState& src)
+{
+  std::memcpy(static_cast<void*>(dst), static_cast<const void*>(&src), sizeof(CPState));
+}
+}  // namespace
+
+class OpcodeDecodingTest : public testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    CopyCPState(&m_main_cp_state, g_main_cp_state);
+    CopyCPState(&m_preprocess_cp_state, g_preprocess_cp_state);
+    m_invtxspec = xfmem.invtxspec.hex;
+    auto& pixel_shader_manager = Core::System::GetInstance().GetPixelShaderManager();
+    m_constants = pixel_shader_manager.constants;
+    m_constants_dirty = pixel_shader_manager.dirty;
+
+    g_gfx = std::make_unique<Null::NullGfx>();
+    g_ActiveConfig.bCPUCull = false;
+    auto vertex_manager = std::make_unique<RecordingVertexManager>();
+    m_vertex_manager = vertex_manager.get();
+    g_vertex_manager = std::move(vertex_manager);
+    VertexLoaderManager::Init();
+
+    // The XF stage has to expect the color the vertices have.
+    xfmem.invtxspec.numcolors = 1;
+  }
+
+  void TearDown() override
+  {
+    VertexLoaderManager::Clear();
+    g_vertex_manager.reset();
+    g_gfx.reset();
+
+    xfmem.invtxspec.hex = m_invtxspec;
+    CopyCPState(&g_main_cp_state, m_main_cp_state);
+    CopyCPState(&g_preprocess_cp_state, m_preprocess_cp_state);
+    BPInit();
+    auto& pixel_shader_manager = Core::System::GetInstance().GetPixelShaderManager();
+    pixel_shader_manager.SetConstants();
+    pixel_shader_manager.constants = m_constants;
+    pixel_shader_manager.dirty = m_constants_dirty;
+  }
+
+  Result Run(std::vector<u8> data, bool batched)
+  {
+    auto& pixel_shader_manager = Core::System::GetInstance().GetPixelShaderManager();
+    CopyCPState(&g_main_cp_state, m_main_cp_state);
+    VertexLoaderManager::MarkAllDirty();
+    BPInit();
+    // PixelShaderManager::Init needs a framebuffer manager. Applying the changes left over from
+    // the last run and clearing the constants has the same effect for the registers used here.
+    pixel_shader_manager.SetConstants();
+    pixel_shader_manager.constants = {};
+    pixel_shader_manager.dirty = false;
+    m_vertex_manager->Reset();
+
+    Result result;
+    const DataReader src(data.data(), data.data() + data.size());
+    const u8* end = batched ? OpcodeDecoder::RunFifo(src, &result.cycles) :
+                              OpcodeDecoder::RunFifoUnbatched(src, &result.cycles);
+    result.size = static_cast<u32>(end - data.data());
+
+    result.draws = m_vertex_manager->draws;
+    result.vertices = m_vertex_manager->GetVertices();
+    result.indices = m_vertex_manager->GetIndices();
+    result.bp = GetBytes(bpmem);
+    pixel_shader_manager.SetConstants();
+    result.constants = GetBytes(pixel_shader_manager.constants);
+    result.constants_dirty = pixel_shader_manager.dirty;
+    return result;
+  }
+
+  Result RunPreprocess(std::vector<u8> data, bool batched)
+  {
+    CopyCPState(&g_preprocess_cp_state, m_preprocess_cp_state);
+    VertexLoaderManager::MarkAllDirty();
+
+    Result result;
+    const DataReader src(data.data(), data.data() + data.size());
+    const u8* end = batched ? OpcodeDecoder::RunFifo<true>(src, &result.cycles) :
+                              OpcodeDecoder::RunFifoUnbatched<true>(src, &result.cycles);
+    result.size = static_cast<u32>(end - data.data());
+    return result;
+  }
+
+  static void ExpectEqual(const Result& expected, const Result& actual)
+  {
+    EXPECT_EQ(expected.size, actual.size);
+    EXPECT_EQ(expected.cycles, actual.cycles);
+    EXPECT_EQ(expected.draws, actual.draws);
+    EXPECT_EQ(expected.vertices, actual.vertices);
+    EXPECT_EQ(expected.indices, actual.indices);
+    EXPECT_EQ(expected.bp, actual.bp);
+    EXPECT_EQ(expected.constants, actual.constants);
+    EXPECT_EQ(expected.constants_dirty, actual.constants_dirty);
+  }
+
+  RecordingVertexManager* m_vertex_manager = nullptr;
+  CPState m_main_cp_state;
+  CPState m_preprocess_cp_state;
+  u32 m_invtxspec = 0;
+  PixelShaderConstants m_constants{};
+  bool m_constants_dirty = false;
+};
+
+TEST_F(OpcodeDecodingTest, BatchedMatchesUnbatched)
+{
+  const std::vector<u8> data = MakeCommands().GetData();
+  const Result expected = Run(data, false);
+
+  // Make sure the commands actually did something.
+  EXPECT_EQ(data.size(), expected.size);
+  EXPECT_EQ(69u, expected.draws.size());
+  EXPECT_NE(0u, reinterpret_cast<const u32*>(expected.bp.data())[BPMEM_FOGCOLOR]);
+
+  ExpectEqual(expected, Run(data, true));
+  ExpectEqual(RunPreprocess(data, false), RunPreprocess(data, true));
+}
+
+TEST_F(OpcodeDecodingTest, BatchedMatchesUnbatchedWhenTruncated)
+{
+  // Cutting the commands off anywhere has to stop both at the same incomplete command.
+  const std::vector<u8> data = MakeCommands().GetData();
+  for (size_t size = 0; size < data.size(); size++)
+  {
+    SCOPED_TRACE(size);
+    const std::vector<u8> truncated(data.begin(), data.begin() + size);
+    ExpectEqual(Run(truncated, false), Run(truncated, true));
+    ExpectEqual(RunPreprocess(truncated, false), RunPreprocess(truncated, true));
+    if (HasFailure())
+      break;
+  }
+}
@@ -0,0 +1,168 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "Common/FileUtil.h"
+#include "Common/IOFile.h"
+#include "VideoCommon/GXPipelineTypes.h"
+#include "VideoCommon/ShaderCachePack.h"
+
+using VideoCommon::SerializedGXPipelineUid;
+using VideoCommon::SerializedGXUberPipelineUid;
+using VideoCommon::ShaderCachePack;
+using VideoCommon::ShaderCachePackError;
+
+class ShaderCachePackTest : public testing::Test
+{
+protected:
+  ShaderCachePackTest() : m_directory(File::CreateTempDir()) {}
+
+  ~ShaderCachePackTest() override
+  {
+    if (!m_directory.empty())
+      File::DeleteDirRecursively(m_directory);
+  }
+
+  void SetUp() override
+  {
+    if (m_directory.empty())
+      FAIL();
+  }
+
+  template <typename T>
+  static T MakeUID(u32 value)
+  {
+    T uid;
+    uid.rasterization_state_bits = value;
+    uid.blending_state_bits = value * 3;
+    return uid;
+  }
+
+  template <typename T>
+  std::string WriteUIDCache(const std::string& name, const std::vector<u32>& values,
+                            u32 uid_version = VideoCommon::GX_PIPELINE_UID_VERSION)
+  {
+    const std::string path = m_directory + "/" + name;
+    File::CreateFullPath(path);
+    File::IOFile file(path, "wb");
+    file.WriteArray(&VideoCommon::GX_PIPELINE_UID_CACHE_MAGIC, 1);
+    file.WriteArray(&uid_version, 1);
+    for (const u32 value : values)
+    {
+      const T uid = MakeUID<T>(value);
+      file.WriteArray(&uid, 1);
+    }
+    return path;
+  }
+
+  template <typename T>
+  static std::vector<u32> GetValues(const std::vector<T>& uids)
+  {
+    std::vector<u32> values;
+    for (const T& uid : uids)
+      values.push_back(uid.rasterization_state_bits);
+    return values;
+  }
+
+  const std::string m_directory;
+};
+
+TEST_F(ShaderCachePackTest, ImportSortsAndDeduplicates)
+{
+  const auto pack = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXPipelineUid>("GALE01.uidcache", {3, 1, 2, 3, 1}));
+  ASSERT_TRUE(pack);
+  EXPECT_EQ("GALE01", pack->GetGameID());
+  EXPECT_EQ((std::vector<u32>{1, 2, 3}), GetValues(pack->GetPipelineUIDs()));
+  EXPECT_TRUE(pack->GetUberPipelineUIDs().empty());
+
+  const auto uber_pack = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXUberPipelineUid>("GALE01.uberuidcache", {5, 4}));
+  ASSERT_TRUE(uber_pack);
+  EXPECT_TRUE(uber_pack->GetPipelineUIDs().empty());
+  EXPECT_EQ((std::vector<u32>{4, 5}), GetValues(uber_pack->GetUberPipelineUIDs()));
+}
+
+TEST_F(ShaderCachePackTest, MergeAddsOnlyNewUIDs)
+{
+  auto pack = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXPipelineUid>("a/GALE01.uidcache", {1, 2, 5}));
+  const auto other = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXPipelineUid>("b/GALE01.uidcache", {2, 3, 5, 6}));
+  const auto uber = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXUberPipelineUid>("GALE01.uberuidcache", {7}));
+  ASSERT_TRUE(pack && other && uber);
+
+  EXPECT_EQ(2u, pack->Merge(*other));
+  EXPECT_EQ(0u, pack->Merge(*other));
+  EXPECT_EQ(1u, pack->Merge(*uber));
+  EXPECT_EQ((std::vector<u32>{1, 2, 3, 5, 6}), GetValues(pack->GetPipelineUIDs()));
+  EXPECT_EQ((std::vector<u32>{7}), GetValues(pack->GetUberPipelineUIDs()));
+}
+
+TEST_F(ShaderCachePackTest, SaveAndLoad)
+{
+  auto pack = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXPipelineUid>("GALE01.uidcache", {9, 4, 6}));
+  const auto uber = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXUberPipelineUid>("GALE01.uberuidcache", {2, 1}));
+  ASSERT_TRUE(pack && uber);
+  pack->Merge(*uber);
+
+  const std::string path = m_directory + "/GALE01.dsp";
+  ASSERT_TRUE(pack->Save(path));
+
+  const auto loaded = ShaderCachePack::Load(path);
+  ASSERT_TRUE(loaded);
+  EXPECT_EQ("GALE01", loaded->GetGameID());
+  EXPECT_EQ((std::vector<u32>{4, 6, 9}), GetValues(loaded->GetPipelineUIDs()));
+  EXPECT_EQ((std::vector<u32>{1, 2}), GetValues(loaded->GetUberPipelineUIDs()));
+
+  // An empty pack is valid too.
+  ASSERT_TRUE(ShaderCachePack("RMCE01").Save(path));
+  const auto empty = ShaderCachePack::Load(path);
+  ASSERT_TRUE(empty);
+  EXPECT_EQ("RMCE01", empty->GetGameID());
+  EXPECT_TRUE(empty->GetPipelineUIDs().empty());
+}
+
+TEST_F(ShaderCachePackTest, RejectsInvalidFiles)
+{
+  EXPECT_EQ(ShaderCachePackError::FileError,
+            ShaderCachePack::Load(m_directory + "/missing.dsp").Error());
+  EXPECT_EQ(ShaderCachePackError::UIDVersionMismatch,
+            ShaderCachePack::ImportUIDCache(
+                WriteUIDCache<SerializedGXPipelineUid>(
+                    "GALE01.uidcache", {1}, VideoCommon::GX_PIPELINE_UID_VERSION - 1))
+                .Error());
+  EXPECT_EQ(ShaderCachePackError::InvalidHeader,
+            ShaderCachePack::ImportUIDCache(
+                WriteUIDCache<SerializedGXPipelineUid>("GALE01.txt", {1}))
+                .Error());
+
+  const auto pack = ShaderCachePack::ImportUIDCache(
+      WriteUIDCache<SerializedGXPipelineUid>("GALE01.uidcache", {1, 2, 3}));
+  ASSERT_TRUE(pack);
+  const std::string path = m_directory + "/GALE01.dsp";
+  ASSERT_TRUE(pack->Save(path));
+  std::string contents;
+  ASSERT_TRUE(File::ReadFileToString(path, contents));
+
+  // Flipping a bit of the last UID keeps the size, but changes the checksum.
+  std::string corrupted = contents;
+  corrupted[corrupted.size() - 1] ^= 1;
+  ASSERT_TRUE(File::WriteStringToFile(path, corrupted));
+  EXPECT_EQ(ShaderCachePackError::ChecksumMismatch, ShaderCachePack::Load(path).Error());
+
+  ASSERT_TRUE(File::WriteStringToFile(path, contents.substr(0, contents.size() - 1)));
+  EXPECT_EQ(ShaderCachePackError::SizeMismatch, ShaderCachePack::Load(path).Error());
+
+  ASSERT_TRUE(File::WriteStringToFile(path, "DCAC" + contents.substr(4)));
+  EXPECT_EQ(ShaderCachePackError::InvalidHeader, ShaderCachePack::Load(path).Error());
+}
@@ -0,0 +1,84 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <random>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CommonTypes.h"
+#include "VideoBackends/Software/TextureSampler.h"
+
+namespace
+{
+void RandomizeTexels(std::mt19937& rng, u8 (&texels)[4][4])
+{
+  for (auto& texel : texels)
+  {
+    for (u8& channel : texel)
+      channel = static_cast<u8>(rng());
+  }
+}
+
+void ExpectSameResults(const u8 (&texels)[4][4], const u32 (&weights)[4], int shift)
+{
+  u8 sample[4];
+  u8 expected[4];
+  TextureSampler::FilterTexels(texels, weights, shift, sample);
+  TextureSampler::FilterTexelsScalar(texels, weights, shift, expected);
+  for (int channel = 0; channel < 4; channel++)
+  {
+    EXPECT_EQ(expected[channel], sample[channel])
+        << fmt::format("channel {} weights {} {} {} {}", channel, weights[0], weights[1],
+                       weights[2], weights[3]);
+  }
+}
+}  // namespace
+
+// The weights SampleMip() uses for bilinear filtering, for every fractional position.
+TEST(SoftwareTextureSampler, FilterTexelsBilinear)
+{
+  std::mt19937 rng(1234);
+  u8 white[4][4];
+  for (auto& texel : white)
+  {
+    for (u8& channel : texel)
+      channel = 255;
+  }
+
+  for (u32 fract_t = 0; fract_t < 128; fract_t++)
+  {
+    for (u32 fract_s = 0; fract_s < 128; fract_s++)
+    {
+      const u32 weights[4] = {(128 - fract_s) * (128 - fract_t), fract_s * (128 - fract_t),
+                              (128 - fract_s) * fract_t, fract_s * fract_t};
+      ExpectSameResults(white, weights, 14);
+      for (int i = 0; i < 4; i++)
+      {
+        u8 texels[4][4];
+        RandomizeTexels(rng, texels);
+        ExpectSameResults(texels, weights, 14);
+      }
+      if (HasFailure())
+        return;
+    }
+  }
+}
+
+// The weights Sample() uses for blending two mipmap levels.
+TEST(SoftwareTextureSampler, FilterTexelsTrilinear)
+{
+  std::mt19937 rng(1234);
+  for (u32 lod_fract = 0; lod_fract < 16; lod_fract++)
+  {
+    const u32 weights[4] = {16 - lod_fract, lod_fract, 0, 0};
+    for (int i = 0; i < 1024; i++)
+    {
+      u8 texels[4][4];
+      RandomizeTexels(rng, texels);
+      ExpectSameResults(texels, weights, 4);
+    }
+    if (HasFailure())
+      return;
+  }
+}
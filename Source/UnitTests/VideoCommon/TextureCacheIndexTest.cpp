@@ -0,0 +1,146 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <map>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "VideoCommon/TextureCacheIndex.h"
+
+using VideoCommon::TextureCacheIndex;
+
+namespace
+{
+using Index = TextureCacheIndex<u32, std::shared_ptr<int>>;
+using Reference = std::multimap<u32, std::shared_ptr<int>>;
+
+std::vector<std::pair<u32, int>> ToVector(Index::iterator begin, Index::iterator end)
+{
+  std::vector<std::pair<u32, int>> result;
+  for (; begin != end; ++begin)
+    result.emplace_back(begin->first, *begin->second);
+  return result;
+}
+
+std::vector<std::pair<u32, int>> ToVector(Reference::iterator begin, Reference::iterator end)
+{
+  std::vector<std::pair<u32, int>> result;
+  for (; begin != end; ++begin)
+    result.emplace_back(begin->first, *begin->second);
+  return result;
+}
+}  // namespace
+
+TEST(TextureCacheIndex, Empty)
+{
+  Index index;
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.begin(), index.end());
+
+  const auto range = index.equal_range(0x1000);
+  EXPECT_EQ(range.first, range.second);
+  EXPECT_EQ(index.lower_bound(0), index.end());
+  EXPECT_EQ(index.upper_bound(0), index.end());
+}
+
+TEST(TextureCacheIndex, EqualKeysKeepInsertionOrder)
+{
+  Index index;
+  index.emplace(0x2000, std::make_shared<int>(1));
+  index.emplace(0x1000, std::make_shared<int>(2));
+  index.emplace(0x2000, std::make_shared<int>(3));
+  const auto middle = index.emplace(0x2000, std::make_shared<int>(4));
+  index.emplace(0x3000, std::make_shared<int>(5));
+  index.emplace(0x2000, std::make_shared<int>(6));
+
+  using Pairs = std::vector<std::pair<u32, int>>;
+  EXPECT_EQ(ToVector(index.begin(), index.end()),
+            (Pairs{{0x1000, 2}, {0x2000, 1}, {0x2000, 3}, {0x2000, 4}, {0x2000, 6}, {0x3000, 5}}));
+
+  // Erasing an element must not invalidate iterators to its neighbours.
+  auto range = index.equal_range(0x2000);
+  const auto next = index.erase(middle);
+  EXPECT_EQ(*next->second, 6);
+  EXPECT_EQ(ToVector(range.first, range.second), (Pairs{{0x2000, 1}, {0x2000, 3}, {0x2000, 6}}));
+
+  // The values are mutable in place.
+  range.first->second = std::make_shared<int>(7);
+  EXPECT_EQ(ToVector(index.lower_bound(0x1800), index.upper_bound(0x2000)),
+            (Pairs{{0x2000, 7}, {0x2000, 3}, {0x2000, 6}}));
+}
+
+TEST(TextureCacheIndex, MatchesMultimap)
+{
+  Index index;
+  Reference reference;
+  std::mt19937 rng(1234);
+  int next_value = 0;
+
+  // Use few distinct keys, so there are plenty of duplicates and keys which come and go.
+  std::uniform_int_distribution<u32> key_dist(0, 300);
+  std::uniform_int_distribution<int> op_dist(0, 99);
+
+  for (int i = 0; i < 20000; i++)
+  {
+    const u32 key = key_dist(rng) * 32;
+    const int op = op_dist(rng);
+    if (op < 55)
+    {
+      const auto value = std::make_shared<int>(next_value++);
+      index.emplace(key, value);
+      reference.emplace(key, value);
+    }
+    else if (op < 95)
+    {
+      // Erase the n-th element with this key from both.
+      auto index_range = index.equal_range(key);
+      auto reference_range = reference.equal_range(key);
+      ASSERT_EQ(ToVector(index_range.first, index_range.second),
+                ToVector(reference_range.first, reference_range.second));
+      const auto count = std::distance(reference_range.first, reference_range.second);
+      if (count == 0)
+        continue;
+
+      const auto n = std::uniform_int_distribution<long>(0, count - 1)(rng);
+      index.erase(std::next(index_range.first, n));
+      reference.erase(std::next(reference_range.first, n));
+    }
+    else
+    {
+      const u32 size = key_dist(rng) * 16;
+      ASSERT_EQ(ToVector(index.lower_bound(key), index.upper_bound(key + size)),
+                ToVector(reference.lower_bound(key), reference.upper_bound(key + size)));
+    }
+
+    ASSERT_EQ(index.size(), reference.size());
+  }
+
+  EXPECT_EQ(ToVector(index.begin(), index.end()), ToVector(reference.begin(), reference.end()));
+
+  index.clear();
+  EXPECT_TRUE(index.empty());
+  EXPECT_EQ(index.begin(), index.end());
+
+  // Every value is now only referenced by the reference map.
+  for (const auto& [key, value] : reference)
+    EXPECT_EQ(value.use_count(), 1);
+}
+
+TEST(TextureCacheEntryPool, RecyclesMemory)
+{
+  VideoCommon::TextureCacheEntryPool pool;
+  const VideoCommon::TextureCacheEntryAllocator<std::vector<int>> allocator(&pool);
+
+  auto first = std::allocate_shared<std::vector<int>>(allocator, 16, 1);
+  const void* first_address = first.get();
+  first.reset();
+
+  // The block of the destroyed object is handed out again.
+  auto second = std::allocate_shared<std::vector<int>>(allocator, 16, 2);
+  EXPECT_EQ(first_address, second.get());
+  EXPECT_EQ((*second)[15], 2);
+}
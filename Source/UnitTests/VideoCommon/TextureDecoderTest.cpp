@@ -0,0 +1,171 @@
+// Copyright 2026 Dolphin Emulator Project
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <chrono>
+#include <random>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <gtest/gtest.h>
+
+#include "Common/CPUDetect.h"
+#include "Common/CommonTypes.h"
+#include "Common/WorkerPool.h"
+#include "VideoCommon/TextureDecoder.h"
+
+namespace
+{
+constexpr u32 NUM_WORKERS = 3;
+// C14X2 can address 16384 palette entries.
+constexpr size_t TLUT_SIZE = 0x4000 * sizeof(u16);
+
+std::vector<u8> GetRandomBytes(size_t size)
+{
+  std::vector<u8> data(size);
+  std::mt19937 rng(static_cast<u32>(size));
+  std::uniform_int_distribution<int> dist(0, 255);
+  for (u8& byte : data)
+    byte = static_cast<u8>(dist(rng));
+  return data;
+}
+
+bool IsPaletted(TextureFormat format)
+{
+  return format == TextureFormat::C4 || format == TextureFormat::C8 ||
+         format == TextureFormat::C14X2;
+}
+
+// Selects which of the optimized decoders TexDecoder_Decode dispatches to.
+class ScopedCPUFeatures
+{
+public:
+  ScopedCPUFeatures(bool avx2, bool ssse3)
+      : m_avx2(std::exchange(cpu_info.bAVX2, avx2 && cpu_info.bAVX2)),
+        m_ssse3(std::exchange(cpu_info.bSSSE3, ssse3 && cpu_info.bSSSE3))
+  {
+  }
+  ~ScopedCPUFeatures()
+  {
+    cpu_info.bAVX2 = m_avx2;
+    cpu_info.bSSSE3 = m_ssse3;
+  }
+
+private:
+  bool m_avx2;
+  bool m_ssse3;
+};
+}  // namespace
+
+class TextureDecoderTest : public ::testing::TestWithParam<std::tuple<TextureFormat, int>>
+{
+protected:
+  void SetUp() override
+  {
+    std::tie(m_format, m_size) = GetParam();
+    m_src = GetRandomBytes(TexDecoder_GetTextureSizeInBytes(m_size, m_size, m_format));
+    m_tlut = GetRandomBytes(TLUT_SIZE);
+    m_workers.Reset("Texture Decoding Test", NUM_WORKERS);
+  }
+
+  void Decode(bool parallel, std::vector<u8>* dst, TLUTFormat tlut_format = TLUTFormat::RGB5A3)
+  {
+    dst->resize(m_size * m_size * sizeof(u32));
+    if (parallel)
+    {
+      TexDecoder_Decode(m_workers, dst->data(), m_src.data(), m_size, m_size, m_format,
+                        m_tlut.data(), tlut_format);
+    }
+    else
+    {
+      TexDecoder_Decode(dst->data(), m_src.data(), m_size, m_size, m_format, m_tlut.data(),
+                        tlut_format);
+    }
+  }
+
+  TextureFormat m_format{};
+  int m_size = 0;
+  std::vector<u8> m_src;
+  std::vector<u8> m_tlut;
+  Common::WorkerPool m_workers;
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    FormatsAndSizes, TextureDecoderTest,
+    ::testing::Combine(::testing::Values(TextureFormat::I4, TextureFormat::I8, TextureFormat::IA4,
+                                         TextureFormat::IA8, TextureFormat::RGB565,
+                                         TextureFormat::RGB5A3, TextureFormat::RGBA8,
+                                         TextureFormat::C4, TextureFormat::C8,
+                                         TextureFormat::C14X2, TextureFormat::CMPR),
+                       ::testing::Values(64, 256, 1024)));
+
+TEST_P(TextureDecoderTest, ParallelMatchesSerial)
+{
+  std::vector<u8> serial, parallel;
+  Decode(false, &serial);
+  Decode(true, &parallel);
+  EXPECT_EQ(serial, parallel);
+}
+
+// Compares every code path of the optimized decoders against the texel decoder of the software
+// renderer, which shares no code with them.
+TEST_P(TextureDecoderTest, MatchesTexelDecoder)
+{
+  std::vector<TLUTFormat> tlut_formats = {TLUTFormat::RGB5A3};
+  if (IsPaletted(m_format))
+    tlut_formats = {TLUTFormat::IA8, TLUTFormat::RGB565, TLUTFormat::RGB5A3};
+
+  std::vector<u8> reference(m_size * m_size * sizeof(u32));
+  std::vector<u8> dst;
+  for (const TLUTFormat tlut_format : tlut_formats)
+  {
+    for (int t = 0; t < m_size; ++t)
+    {
+      for (int s = 0; s < m_size; ++s)
+      {
+        TexDecoder_DecodeTexel(&reference[(t * m_size + s) * sizeof(u32)], m_src, s, t,
+                               m_size - 1, m_format, m_tlut, tlut_format);
+      }
+    }
+
+    for (const bool avx2 : {false, true})
+    {
+      for (const bool ssse3 : {false, true})
+      {
+        ScopedCPUFeatures features(avx2, ssse3);
+        Decode(false, &dst, tlut_format);
+        EXPECT_EQ(reference, dst) << "TLUT format: " << static_cast<int>(tlut_format)
+                                  << ", AVX2: " << cpu_info.bAVX2
+                                  << ", SSSE3: " << cpu_info.bSSSE3;
+      }
+    }
+  }
+}
+
+TEST_P(TextureDecoderTest, DecodeSpeed)
+{
+  using Clock = std::chrono::steady_clock;
+  // Decode roughly 64 megatexels for every format and size.
+  const int iterations = 64 * 1024 * 1024 / (m_size * m_size);
+  std::vector<u8> dst;
+
+  const auto measure = [&](const char* name, bool parallel) {
+    const auto start = Clock::now();
+    for (int i = 0; i < iterations; ++i)
+      Decode(parallel, &dst);
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    fmt::print("format: {}, size: {}x{}, {}: {:.1f} Mtexels/s, {:.1f} MB/s\n", m_format, m_size,
+               m_size, name, static_cast<double>(iterations) * m_size * m_size / seconds / 1e6,
+               static_cast<double>(iterations) * m_src.size() / seconds / 1e6);
+  };
+
+  if (cpu_info.bAVX2)
+  {
+    ScopedCPUFeatures features(false, true);
+    measure("serial without AVX2", false);
+  }
+  measure("serial", false);
+  measure("parallel", true);
+}
@@ -1,9 +1,12 @@
 // Copyright 2014 Dolphin Emulator Project
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <array>
 #include <bit>
+#include <chrono>
 #include <limits>
 #include <memory>
+#include <random>
 #include <tuple>
 #include <type_traits>
 #include <unordered_set>
@@ -18,6 +21,11 @@
 #include "VideoCommon/VertexLoaderBase.h"
 #include "VideoCommon/VertexLoaderManager.h"
 
+#ifdef _M_X86_64
+#include "Common/CPUDetect.h"
+#include "VideoCommon/VertexLoader.h"
+#endif
+
 TEST(VertexLoaderUID, UniqueEnough)
 {
   std::unordered_set<VertexLoaderUID> uids;
@@ -377,6 +385,81 @@ TEST_F(VertexLoaderTest, LargeFloatVertexSpeed)
     RunVertices(100000);
 }
 
+class VertexLoaderLookupTest : public VertexLoaderTest
+{
+protected:
+  void SetUp() override
+  {
+    VertexLoaderTest::SetUp();
+    VertexLoaderManager::Init();
+    g_preprocess_cp_state.vtx_desc.low.Hex = 0;
+    g_preprocess_cp_state.vtx_desc.high.Hex = 0;
+    g_preprocess_cp_state.vtx_desc.low.Position = VertexComponentFormat::Direct;
+  }
+  void TearDown() override { VertexLoaderManager::Clear(); }
+
+  // Emulates a VAT write for the preprocessing thread, which doesn't need a native vertex format.
+  VertexLoaderBase* SetFormat(int vtx_attr_group, ComponentFormat format,
+                              CoordComponentCount elements)
+  {
+    VAT& vat = g_preprocess_cp_state.vtx_attr[vtx_attr_group];
+    vat.g0.Hex = 0;
+    vat.g1.Hex = 0;
+    vat.g2.Hex = 0;
+    vat.g0.PosFormat = format;
+    vat.g0.PosElements = elements;
+    VertexLoaderManager::g_preprocess_vat_dirty[vtx_attr_group] = true;
+    return VertexLoaderManager::RefreshLoader<true>(vtx_attr_group);
+  }
+};
+
+TEST_F(VertexLoaderLookupTest, SameFormatSameLoader)
+{
+  VertexLoaderBase* const byte_loader =
+      SetFormat(0, ComponentFormat::Byte, CoordComponentCount::XY);
+  VertexLoaderBase* const float_loader =
+      SetFormat(0, ComponentFormat::Float, CoordComponentCount::XYZ);
+  EXPECT_NE(byte_loader, float_loader);
+  EXPECT_EQ(2u * sizeof(s8), byte_loader->m_vertex_size);
+  EXPECT_EQ(3u * sizeof(float), float_loader->m_vertex_size);
+
+  // Loaders are shared between VAT groups, and reused when a group switches back to a format.
+  EXPECT_EQ(byte_loader, SetFormat(1, ComponentFormat::Byte, CoordComponentCount::XY));
+  EXPECT_EQ(byte_loader, SetFormat(0, ComponentFormat::Byte, CoordComponentCount::XY));
+  EXPECT_EQ(float_loader, SetFormat(0, ComponentFormat::Float, CoordComponentCount::XYZ));
+
+  // A VAT write without changes must keep the loader.
+  EXPECT_EQ(float_loader, SetFormat(0, ComponentFormat::Float, CoordComponentCount::XYZ));
+  EXPECT_EQ(float_loader, VertexLoaderManager::RefreshLoader<true>(0));
+}
+
+// Draw call heavy games change the VAT between draws of a few vertices, so this measures the loader
+// lookup more than the loaders themselves.
+TEST_F(VertexLoaderLookupTest, DrawCallSpeed)
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr int NUM_DRAWS = 2000000;
+  constexpr int VERTICES_PER_DRAW = 4;
+  static constexpr std::array formats = {ComponentFormat::UByte, ComponentFormat::Byte,
+                                         ComponentFormat::UShort, ComponentFormat::Short,
+                                         ComponentFormat::Float};
+
+  for (const size_t num_formats : {size_t{1}, size_t{2}, formats.size()})
+  {
+    const auto start = Clock::now();
+    for (int i = 0; i < NUM_DRAWS; ++i)
+    {
+      const int vtx_attr_group = i % CP_NUM_VAT_REG;
+      VertexLoaderBase* loader =
+          SetFormat(vtx_attr_group, formats[i % num_formats], CoordComponentCount::XYZ);
+      loader->RunVertices(input_memory, output_memory, VERTICES_PER_DRAW);
+    }
+    const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    fmt::print("formats: {}, {:.1f} million draws/s\n", num_formats, NUM_DRAWS / seconds / 1e6);
+  }
+}
+
 TEST_F(VertexLoaderTest, DirectAllComponents)
 {
   m_vtx_desc.low.PosMatIdx = true;
@@ -1065,6 +1148,176 @@ TEST_P(VertexLoaderSkippedTexCoordsTest, SkippedTextures)
   }
 }
 
+#ifdef _M_X86_64
+// Compares the JIT vertex loader against the software one, with and without the AVX2 loop which
+// loads two vertices at once.
+class VertexLoaderX64Test : public VertexLoaderTest,
+                            public ::testing::WithParamInterface<
+                                std::tuple<ComponentFormat, CoordComponentCount, int, int>>
+{
+protected:
+  void SetUp() override
+  {
+    VertexLoaderTest::SetUp();
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<int> dist(0, 255);
+    for (size_t i = 0; i < 256 * 1024; i++)
+      input_memory[i] = static_cast<u8>(dist(rng));
+  }
+
+  // Sets up a few combinations of the attributes other than the position.
+  void SetAttributes(int normals, int others)
+  {
+    m_vtx_attr.g0.ByteDequant = true;
+    m_vtx_attr.g0.PosFrac = 5;
+
+    m_vtx_desc.low.Normal = normals != 0 ? VertexComponentFormat::Direct :
+                                           VertexComponentFormat::NotPresent;
+    m_vtx_attr.g0.NormalElements = normals == 2 ? NormalComponentCount::NTB :
+                                                  NormalComponentCount::N;
+    m_vtx_attr.g0.NormalFormat = normals == 1 ? ComponentFormat::Byte :
+                                 normals == 2 ? ComponentFormat::Short :
+                                                ComponentFormat::Float;
+
+    // Without normals, only the first two cases are loaded in pairs.
+    switch (others)
+    {
+    case 1:
+      m_vtx_desc.low.PosMatIdx = true;
+      break;
+    case 2:
+      m_vtx_desc.low.PosMatIdx = true;
+      m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+      m_vtx_attr.g0.Color0Comp = ColorFormat::RGB565;
+      m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+      m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Short;
+      m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+      m_vtx_attr.g0.Tex0Frac = 7;
+      break;
+    case 3:
+      m_vtx_desc.low.Color0 = VertexComponentFormat::Direct;
+      m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+      m_vtx_desc.low.Color1 = VertexComponentFormat::Direct;
+      m_vtx_attr.g0.Color1Comp = ColorFormat::RGBA6666;
+      m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+      m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Float;
+      m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+      m_vtx_desc.high.Tex1Coord = VertexComponentFormat::Direct;
+      m_vtx_attr.g1.Tex1CoordFormat = ComponentFormat::UByte;
+      m_vtx_attr.g1.Tex1CoordElements = TexComponentCount::S;
+      m_vtx_attr.g1.Tex1Frac = 3;
+      break;
+    case 4:
+      m_vtx_desc.low.Color0 = VertexComponentFormat::Index8;
+      m_vtx_attr.g0.Color0Comp = ColorFormat::RGBA8888;
+      VertexLoaderManager::cached_arraybases[CPArray::Color0] = input_memory;
+      g_main_cp_state.array_strides[CPArray::Color0] = 4;
+      m_vtx_desc.high.Tex0Coord = VertexComponentFormat::Direct;
+      m_vtx_attr.g0.Tex0CoordFormat = ComponentFormat::Byte;
+      m_vtx_attr.g0.Tex0CoordElements = TexComponentCount::ST;
+      break;
+    }
+  }
+
+  std::unique_ptr<VertexLoaderBase> CreateX64Loader(bool avx2)
+  {
+    const bool had_avx2 = cpu_info.bAVX2;
+    cpu_info.bAVX2 = avx2 && had_avx2;
+    // This creates a VertexLoaderX64.
+    auto loader = VertexLoaderBase::CreateVertexLoader(m_vtx_desc, m_vtx_attr);
+    cpu_info.bAVX2 = had_avx2;
+    return loader;
+  }
+};
+
+INSTANTIATE_TEST_SUITE_P(
+    FormatsAndAttributes, VertexLoaderX64Test,
+    ::testing::Combine(::testing::Values(ComponentFormat::UByte, ComponentFormat::Byte,
+                                         ComponentFormat::UShort, ComponentFormat::Short,
+                                         ComponentFormat::Float),
+                       ::testing::Values(CoordComponentCount::XY, CoordComponentCount::XYZ),
+                       ::testing::Values(0, 1, 2, 3), ::testing::Values(0, 1, 2, 3, 4)));
+
+TEST_P(VertexLoaderX64Test, MatchesSoftwareLoader)
+{
+  const auto [pos_format, pos_elements, normals, others] = GetParam();
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosFormat = pos_format;
+  m_vtx_attr.g0.PosElements = pos_elements;
+  SetAttributes(normals, others);
+
+  VertexLoader software_loader(m_vtx_desc, m_vtx_attr);
+  const u32 stride = software_loader.m_native_vtx_decl.stride;
+  std::vector<u8> expected;
+
+  for (const bool avx2 : {false, true})
+  {
+    std::unique_ptr<VertexLoaderBase> loader = CreateX64Loader(avx2);
+    ASSERT_EQ(software_loader.m_vertex_size, loader->m_vertex_size);
+    ASSERT_EQ(stride, loader->m_native_vtx_decl.stride);
+
+    // Cover the vertices which are left over after the pairs.
+    for (const int count : {1, 2, 3, 4, 5, 6, 7, 1000, 1001})
+    {
+      const size_t size = count * stride;
+      memset(output_memory, 0, size);
+      software_loader.RunVertices(input_memory, output_memory, count);
+      expected.assign(output_memory, output_memory + size);
+      const auto expected_position_cache = VertexLoaderManager::position_cache;
+
+      memset(output_memory, 0, size);
+      EXPECT_EQ(count, loader->RunVertices(input_memory, output_memory, count));
+      EXPECT_EQ(0, memcmp(expected.data(), output_memory, size))
+          << "AVX2: " << avx2 << ", vertices: " << count;
+
+      const size_t position_components = pos_elements == CoordComponentCount::XYZ ? 3 : 2;
+      for (int i = 0; i < std::min(count, 3); i++)
+      {
+        EXPECT_EQ(0, memcmp(expected_position_cache[i].data(),
+                            VertexLoaderManager::position_cache[i].data(),
+                            position_components * sizeof(float)));
+      }
+    }
+  }
+}
+
+TEST_F(VertexLoaderX64Test, PairSpeed)
+{
+  using Clock = std::chrono::steady_clock;
+  constexpr int NUM_VERTICES = 1000;
+  constexpr int ITERATIONS = 20000;
+
+  const auto measure = [&](const char* name) {
+    for (const bool avx2 : {false, true})
+    {
+      std::unique_ptr<VertexLoaderBase> loader = CreateX64Loader(avx2);
+      const auto start = Clock::now();
+      for (int i = 0; i < ITERATIONS; ++i)
+        loader->RunVertices(input_memory, output_memory, NUM_VERTICES);
+      const double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+      fmt::print("{}, AVX2: {}: {:.1f} million vertices/s\n", name, avx2 && cpu_info.bAVX2,
+                 static_cast<double>(NUM_VERTICES) * ITERATIONS / seconds / 1e6);
+    }
+  };
+
+  m_vtx_desc.low.Position = VertexComponentFormat::Direct;
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Short;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  SetAttributes(0, 0);
+  measure("s16 position");
+
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Byte;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XY;
+  measure("s8 XY position");
+
+  m_vtx_attr.g0.PosFormat = ComponentFormat::Float;
+  m_vtx_attr.g0.PosElements = CoordComponentCount::XYZ;
+  SetAttributes(0, 1);
+  measure("float position, matrix index");
+}
+#endif
+
 // For gtest, which doesn't know about our fmt::formatters by default
 static void PrintTo(const VertexComponentFormat& t, std::ostream* os)
 {